@@ -0,0 +1,256 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteAsyncAction.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Containers/Ticker.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+#include "Core/AccelByteError.h"
+
+namespace AccelByteAsyncAction
+{
+	// Keeps the running and the pooled proxies referenced, released proxies over the cap are not in here
+	class FAsyncActionPool : public FGCObject
+	{
+	public:
+		TMap<UClass*, TArray<UAccelByteAsyncAction*>> Free;
+		TArray<UAccelByteAsyncAction*> Active;
+		// Released during this tick, they go into Free on the next one
+		TArray<UAccelByteAsyncAction*> Released;
+		// Null for the core ticker
+		FTicker* ReturnTicker = nullptr;
+		FDelegateHandle ReturnTickerHandle;
+
+		FTicker& GetReturnTicker()
+		{
+			return ReturnTicker != nullptr ? *ReturnTicker : FTicker::GetCoreTicker();
+		}
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			for (TPair<UClass*, TArray<UAccelByteAsyncAction*>>& Pair : Free)
+			{
+				Collector.AddReferencedObjects(Pair.Value);
+			}
+			Collector.AddReferencedObjects(Active);
+			Collector.AddReferencedObjects(Released);
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("FAsyncActionPool");
+		}
+	};
+
+	static FAsyncActionPool& GetPool()
+	{
+		static FAsyncActionPool Pool;
+		return Pool;
+	}
+
+	static int32 MaxPooledPerClass = 8;
+	static float DefaultTimeoutSeconds = 30.0f;
+	static FAccelByteAsyncActionStats Stats;
+}
+
+using namespace AccelByteAsyncAction;
+
+void UAccelByteAsyncAction::SetMaxPooledPerClass(int32 InMaxPooledPerClass)
+{
+	MaxPooledPerClass = FMath::Max(0, InMaxPooledPerClass);
+
+	// Shrinking the cap lets the extra proxies go with the next collection
+	FAsyncActionPool& Pool = GetPool();
+	for (TPair<UClass*, TArray<UAccelByteAsyncAction*>>& Pair : Pool.Free)
+	{
+		if (Pair.Value.Num() > MaxPooledPerClass)
+		{
+			Stats.Pooled -= Pair.Value.Num() - MaxPooledPerClass;
+			Pair.Value.SetNum(MaxPooledPerClass);
+		}
+	}
+}
+
+void UAccelByteAsyncAction::SetDefaultTimeoutSeconds(float InTimeoutSeconds)
+{
+	DefaultTimeoutSeconds = FMath::Max(0.0f, InTimeoutSeconds);
+}
+
+void UAccelByteAsyncAction::SetPoolTicker(FTicker* InTicker)
+{
+	// Proxies already waiting for their return move over to the new ticker
+	FAsyncActionPool& Pool = GetPool();
+	const bool bReturnPending = Pool.ReturnTickerHandle.IsValid();
+	if (bReturnPending)
+	{
+		Pool.GetReturnTicker().RemoveTicker(Pool.ReturnTickerHandle);
+		Pool.ReturnTickerHandle.Reset();
+	}
+	Pool.ReturnTicker = InTicker;
+	if (bReturnPending)
+	{
+		Pool.ReturnTickerHandle = Pool.GetReturnTicker().AddTicker(FTickerDelegate::CreateStatic(&UAccelByteAsyncAction::ReturnReleased));
+	}
+}
+
+FAccelByteAsyncActionStats UAccelByteAsyncAction::GetStats()
+{
+	return Stats;
+}
+
+UAccelByteAsyncAction* UAccelByteAsyncAction::AcquireOfClass(UClass* Class)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	FAsyncActionPool& Pool = GetPool();
+
+	UAccelByteAsyncAction* Action = nullptr;
+	TArray<UAccelByteAsyncAction*>* Free = Pool.Free.Find(Class);
+	if (Free != nullptr && Free->Num() > 0)
+	{
+		Action = Free->Pop(false);
+		Stats.Reused++;
+		Stats.Pooled--;
+	}
+	else
+	{
+		Action = NewObject<UAccelByteAsyncAction>(GetTransientPackage(), Class);
+		Stats.Created++;
+	}
+
+	Action->bPooled = false;
+	Action->TimeoutSeconds = -1.0f;
+	Action->Use++;
+	Pool.Active.Add(Action);
+	Stats.Active++;
+	return Action;
+}
+
+void UAccelByteAsyncAction::Activate()
+{
+	bRunning = true;
+
+	const float Timeout = TimeoutSeconds < 0.0f ? DefaultTimeoutSeconds : TimeoutSeconds;
+	if (Timeout > 0.0f)
+	{
+		TimeoutHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAccelByteAsyncAction::OnTimeout), Timeout);
+	}
+
+	Start();
+}
+
+FAccelByteAsyncActionHandle UAccelByteAsyncAction::GetHandle() const
+{
+	FAccelByteAsyncActionHandle Handle;
+	Handle.Action = const_cast<UAccelByteAsyncAction*>(this);
+	Handle.Use = Use;
+	return Handle;
+}
+
+void UAccelByteAsyncAction::CancelAsyncAction(FAccelByteAsyncActionHandle const& Handle)
+{
+	UAccelByteAsyncAction* Action = Handle.Action.Get();
+	if (Action == nullptr || Action->Use != Handle.Use || !Action->bRunning)
+	{
+		return;
+	}
+
+	Stats.Cancelled++;
+	Action->Abort(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("async-action-cancelled"));
+}
+
+void UAccelByteAsyncAction::Abort(int32 ErrorCode, FString const& ErrorMessage)
+{
+	Finish([this, ErrorCode, &ErrorMessage]()
+	{
+		OnAborted(ErrorCode, ErrorMessage);
+	});
+}
+
+bool UAccelByteAsyncAction::OnTimeout(float DeltaSeconds)
+{
+	// Returning false removes the ticker, the handle must not be removed a second time
+	TimeoutHandle.Reset();
+	Stats.TimedOut++;
+	Abort(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("async-action-timed-out"));
+	return false;
+}
+
+void UAccelByteAsyncAction::Finish(TFunctionRef<void()> Broadcast)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	bRunning = false;
+	if (TimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+		TimeoutHandle.Reset();
+	}
+
+	Broadcast();
+	SetReadyToDestroy();
+}
+
+void UAccelByteAsyncAction::SetReadyToDestroy()
+{
+	Super::SetReadyToDestroy();
+
+	if (bPooled)
+	{
+		return;
+	}
+
+	bRunning = false;
+	if (TimeoutHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TimeoutHandle);
+		TimeoutHandle.Reset();
+	}
+	Use++;
+
+	// Nodes bound by the last user must not receive the broadcasts of the next one
+	for (TFieldIterator<FMulticastDelegateProperty> It(GetClass()); It; ++It)
+	{
+		It->ClearDelegate(this);
+	}
+	ResetState();
+
+	FAsyncActionPool& Pool = GetPool();
+	Pool.Active.RemoveSwap(this);
+	Stats.Active--;
+
+	// Not reused within the tick it finished in, so the node that started it can still take its handle
+	bPooled = true;
+	Pool.Released.Add(this);
+	if (!Pool.ReturnTickerHandle.IsValid())
+	{
+		Pool.ReturnTickerHandle = Pool.GetReturnTicker().AddTicker(FTickerDelegate::CreateStatic(&UAccelByteAsyncAction::ReturnReleased));
+	}
+}
+
+bool UAccelByteAsyncAction::ReturnReleased(float DeltaSeconds)
+{
+	FAsyncActionPool& Pool = GetPool();
+	for (UAccelByteAsyncAction* Action : Pool.Released)
+	{
+		// Over the cap the proxy is no longer referenced by the pool and goes with the next collection
+		TArray<UAccelByteAsyncAction*>& Free = Pool.Free.FindOrAdd(Action->GetClass());
+		if (Free.Num() < MaxPooledPerClass)
+		{
+			Free.Add(Action);
+			Stats.Pooled++;
+		}
+	}
+	Pool.Released.Reset();
+
+	// Returning false removes the ticker, the handle must not be removed a second time
+	Pool.ReturnTickerHandle.Reset();
+	return false;
+}
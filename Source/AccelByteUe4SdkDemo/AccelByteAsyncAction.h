@@ -0,0 +1,150 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AccelByteAsyncAction.generated.h"
+
+class FTicker;
+
+USTRUCT(BlueprintType)
+struct FAccelByteAsyncActionStats
+{
+	GENERATED_BODY()
+
+	// Proxies allocated with NewObject
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 Created = 0;
+
+	// Proxies taken back out of the pool
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 Reused = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 Active = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 Pooled = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 Cancelled = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Utilities")
+	int32 TimedOut = 0;
+};
+
+class UAccelByteAsyncAction;
+
+// One use of a pooled proxy, what a Blueprint cancels through instead of the proxy it got from the node
+USTRUCT(BlueprintType)
+struct FAccelByteAsyncActionHandle
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<UAccelByteAsyncAction> Action;
+	uint32 Use = 0;
+};
+
+/**
+ * Base of the async Blueprint nodes of the module, the proxies are pooled per class instead of allocated per call.
+ *
+ * Factories take a proxy with Acquire, the pool keeps it referenced from then on so it does not depend on a world
+ * to stay alive. Every path out of an action goes through Finish, which broadcasts once and calls
+ * SetReadyToDestroy; that clears every BlueprintAssignable delegate, resets the subclass state and puts the proxy
+ * back into the pool. Handlers given to the SDK are made with Bind, they hold the use they were made for and are
+ * ignored once that use has finished, so a late response cannot reach the next user of a recycled proxy.
+ *
+ * A Blueprint keeps the proxy of the node's Async Task pin after the action has finished, while the pool may hand it
+ * to another caller. Cancelling therefore goes through a handle taken with GetHandle, which is tied to one use: a
+ * stale handle does nothing to the next use. A released proxy only goes back into the pool on the next tick, so a
+ * handle taken from the node's Then pin refers to the use the node started even when the action finished right
+ * away. Cancel and the timeout finish the action through OnAborted. Only meant to be used from the game thread.
+ */
+UCLASS(Abstract, MinimalAPI)
+class UAccelByteAsyncAction : public UBlueprintAsyncActionBase
+{
+	GENERATED_BODY()
+public:
+	template <typename TAction>
+	static TAction* Acquire()
+	{
+		return CastChecked<TAction>(AcquireOfClass(TAction::StaticClass()));
+	}
+
+	// Proxies kept per class once released, the rest is left to the garbage collector
+	static void SetMaxPooledPerClass(int32 InMaxPooledPerClass);
+
+	// Used by the actions that do not set their own timeout, zero disables it
+	static void SetDefaultTimeoutSeconds(float InTimeoutSeconds);
+
+	// Ticker the released proxies are returned to the pool on, the core ticker when null. Benchmarks tick their own.
+	static void SetPoolTicker(FTicker* InTicker);
+
+	static FAccelByteAsyncActionStats GetStats();
+
+	// Take it from the node's Then pin, the proxy itself may belong to another caller later on
+	UFUNCTION(BlueprintPure, Category = "AccelByte | SampleApp | Utilities")
+	FAccelByteAsyncActionHandle GetHandle() const;
+
+	// Finishes the use the handle was taken for through its failure output, does nothing once that use has finished
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static void CancelAsyncAction(FAccelByteAsyncActionHandle const& Handle);
+
+	bool IsRunning() const { return bRunning; }
+
+	// UBlueprintAsyncActionBase interface
+	virtual void Activate() override final;
+	virtual void SetReadyToDestroy() override;
+	// End of UBlueprintAsyncActionBase interface
+
+protected:
+	// The work of the action, started by Activate
+	virtual void Start() PURE_VIRTUAL(UAccelByteAsyncAction::Start, );
+
+	// Broadcast the failure output for a cancel or a timeout
+	virtual void OnAborted(int32 ErrorCode, FString const& ErrorMessage) PURE_VIRTUAL(UAccelByteAsyncAction::OnAborted, );
+
+	// Drop what the last use set, delegates are cleared by the base
+	virtual void ResetState() {}
+
+	// Broadcasts through Broadcast and releases the proxy, does nothing once the action has finished
+	void Finish(TFunctionRef<void()> Broadcast);
+
+	// Negative uses the default timeout, set it from the factory
+	float TimeoutSeconds = -1.0f;
+
+	/**
+	 * Wraps a member function into a callable that only runs it for the use of the proxy it was made in,
+	 * for CreateLambda or CreateWeakLambda of the SDK and online subsystem delegates.
+	 */
+	template <typename TAction, typename... TArgs>
+	auto Bind(void (TAction::*Method)(TArgs...))
+	{
+		TWeakObjectPtr<TAction> WeakThis(CastChecked<TAction>(this));
+		const uint32 BoundUse = Use;
+		return [WeakThis, BoundUse, Method](TArgs... Args)
+		{
+			TAction* Action = WeakThis.Get();
+			if (Action != nullptr && Action->Use == BoundUse && Action->bRunning)
+			{
+				(Action->*Method)(Forward<TArgs>(Args)...);
+			}
+		};
+	}
+
+private:
+	static UAccelByteAsyncAction* AcquireOfClass(UClass* Class);
+	static bool ReturnReleased(float DeltaSeconds);
+
+	void Abort(int32 ErrorCode, FString const& ErrorMessage);
+	bool OnTimeout(float DeltaSeconds);
+
+	// Bumped by every acquire and release, tells the uses of a recycled proxy apart
+	uint32 Use = 0;
+	bool bRunning = false;
+	bool bPooled = false;
+	FDelegateHandle TimeoutHandle;
+};
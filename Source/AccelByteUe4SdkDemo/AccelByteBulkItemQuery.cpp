@@ -0,0 +1,91 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteBulkItemQuery.h"
+#include "AccelByteItemCache.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteMemoryReport.h"
+
+int32 FAccelByteBulkItemQuery::DefaultMaxConcurrency = 8;
+
+void FAccelByteBulkItemQuery::SetDefaultMaxConcurrency(int32 InMaxConcurrency)
+{
+	DefaultMaxConcurrency = FMath::Max(1, InMaxConcurrency);
+}
+
+void FAccelByteBulkItemQuery::Run(TArray<FString> const& Skus, int32 MaxConcurrency, FOnComplete&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	struct FQueryState
+	{
+		TArray<FAccelByteItemBySkuResult> UniqueResults;
+		TArray<int32> ResultIndices;
+		FOnComplete OnComplete;
+	};
+
+	TSharedRef<FQueryState> State = MakeShared<FQueryState>();
+	State->OnComplete = MoveTemp(OnComplete);
+	State->ResultIndices.Reserve(Skus.Num());
+
+	TMap<FString, int32> UniqueIndexBySku;
+	UniqueIndexBySku.Reserve(Skus.Num());
+	for (FString const& Sku : Skus)
+	{
+		if (const int32* Existing = UniqueIndexBySku.Find(Sku))
+		{
+			State->ResultIndices.Add(*Existing);
+			continue;
+		}
+
+		const int32 Index = State->UniqueResults.AddDefaulted();
+		State->UniqueResults[Index].Sku = Sku;
+		UniqueIndexBySku.Add(Sku, Index);
+		State->ResultIndices.Add(Index);
+	}
+
+	if (State->UniqueResults.Num() == 0)
+	{
+		State->OnComplete(TArray<FAccelByteItemBySkuResult>());
+		return;
+	}
+
+	TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(MaxConcurrency > 0 ? MaxConcurrency : DefaultMaxConcurrency);
+	Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([State]()
+	{
+		TArray<FAccelByteItemBySkuResult> Results;
+		Results.Reserve(State->ResultIndices.Num());
+		for (const int32 Index : State->ResultIndices)
+		{
+			Results.Add(State->UniqueResults[Index]);
+		}
+		State->OnComplete(MoveTemp(Results));
+	}));
+
+	TArray<FAccelByteTaskPipeline::FTask> Tasks;
+	Tasks.Reserve(State->UniqueResults.Num());
+	for (int32 Index = 0; Index < State->UniqueResults.Num(); Index++)
+	{
+		Tasks.Add([State, Index](FSimpleDelegate const& OnDone)
+		{
+			const AccelByte::THandler<FAccelByteModelsItemInfo> OnSuccess = AccelByte::THandler<FAccelByteModelsItemInfo>::CreateLambda([State, Index, OnDone](FAccelByteModelsItemInfo const& Item)
+			{
+				FAccelByteItemBySkuResult& Result = State->UniqueResults[Index];
+				Result.bSuccess = true;
+				Result.Item = Item;
+				OnDone.ExecuteIfBound();
+			});
+
+			const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([State, Index, OnDone](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				FAccelByteItemBySkuResult& Result = State->UniqueResults[Index];
+				Result.ErrorCode = ErrorCode;
+				Result.ErrorMessage = ErrorMessage;
+				OnDone.ExecuteIfBound();
+			});
+
+			FAccelByteItemCache::Get().GetItemBySku(State->UniqueResults[Index].Sku, OnSuccess, OnError);
+		});
+	}
+	Pipeline->EnqueueAll(MoveTemp(Tasks));
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteBulkItemQuery.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteItemBySkuResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	FString Sku;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	bool bSuccess = false;
+
+	// Only valid when bSuccess is set
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	FAccelByteModelsItemInfo Item;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 ErrorCode = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	FString ErrorMessage;
+};
+
+/**
+ * Resolves many SKUs at once with a bounded number of backend requests in flight.
+ *
+ * Duplicate SKUs are looked up once and every lookup goes through FAccelByteItemCache, so SKUs that are
+ * already cached or being fetched by another widget cost no extra request.
+ */
+class FAccelByteBulkItemQuery
+{
+public:
+	using FOnComplete = TFunction<void(TArray<FAccelByteItemBySkuResult>&& Results)>;
+
+	/**
+	 * @param Skus SKUs to resolve, the results are returned in the same order including duplicates.
+	 * @param MaxConcurrency Maximum number of item requests in flight, zero or less uses the configured default.
+	 * @param OnComplete Called once every SKU has either resolved or failed.
+	 */
+	static void Run(TArray<FString> const& Skus, int32 MaxConcurrency, FOnComplete&& OnComplete);
+
+	static void SetDefaultMaxConcurrency(int32 InMaxConcurrency);
+
+private:
+	static int32 DefaultMaxConcurrency;
+};
@@ -0,0 +1,289 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteByteConversion.h"
+
+namespace AccelByteByteConversion
+{
+	using FCodeUnit = TChooseClass<sizeof(TCHAR) == 2, uint16, uint32>::Result;
+
+	// Characters per ASCII block when encoding, bytes per block when decoding
+	constexpr int32 EncodeBlock = 16;
+	constexpr int32 DecodeBlock = 8;
+	constexpr uint64 DecodeBlockHighBits = 0x8080808080808080ull;
+	constexpr uint32 ReplacementChar = 0xFFFD;
+
+	static FORCEINLINE bool IsAsciiBlock(TCHAR const* Chars)
+	{
+		FCodeUnit Bits = 0;
+		for (int32 Lane = 0; Lane < EncodeBlock; Lane++)
+		{
+			Bits |= static_cast<FCodeUnit>(Chars[Lane]);
+		}
+		return Bits < 0x80;
+	}
+
+	// Reads the code point at Index and moves past it, unpaired surrogates read as U+FFFD
+	static FORCEINLINE uint32 ReadChar(TCHAR const* Chars, int32 Length, int32& Index)
+	{
+		const uint32 Codepoint = static_cast<FCodeUnit>(Chars[Index++]);
+		if (Codepoint < 0xD800 || (Codepoint > 0xDFFF && Codepoint <= 0x10FFFF))
+		{
+			return Codepoint;
+		}
+		if (sizeof(TCHAR) == 2 && Codepoint <= 0xDBFF && Index < Length)
+		{
+			const uint32 Low = static_cast<FCodeUnit>(Chars[Index]);
+			if (Low >= 0xDC00 && Low <= 0xDFFF)
+			{
+				Index++;
+				return 0x10000 + ((Codepoint - 0xD800) << 10) + (Low - 0xDC00);
+			}
+		}
+		return ReplacementChar;
+	}
+
+	static FORCEINLINE int32 GetEncodedSize(uint32 Codepoint)
+	{
+		return Codepoint < 0x80 ? 1 : Codepoint < 0x800 ? 2 : Codepoint < 0x10000 ? 3 : 4;
+	}
+
+	static FORCEINLINE uint8* WriteUtf8(uint32 Codepoint, uint8* Dest)
+	{
+		if (Codepoint < 0x80)
+		{
+			*Dest++ = static_cast<uint8>(Codepoint);
+		}
+		else if (Codepoint < 0x800)
+		{
+			*Dest++ = static_cast<uint8>(0xC0 | (Codepoint >> 6));
+			*Dest++ = static_cast<uint8>(0x80 | (Codepoint & 0x3F));
+		}
+		else if (Codepoint < 0x10000)
+		{
+			*Dest++ = static_cast<uint8>(0xE0 | (Codepoint >> 12));
+			*Dest++ = static_cast<uint8>(0x80 | ((Codepoint >> 6) & 0x3F));
+			*Dest++ = static_cast<uint8>(0x80 | (Codepoint & 0x3F));
+		}
+		else
+		{
+			*Dest++ = static_cast<uint8>(0xF0 | (Codepoint >> 18));
+			*Dest++ = static_cast<uint8>(0x80 | ((Codepoint >> 12) & 0x3F));
+			*Dest++ = static_cast<uint8>(0x80 | ((Codepoint >> 6) & 0x3F));
+			*Dest++ = static_cast<uint8>(0x80 | (Codepoint & 0x3F));
+		}
+		return Dest;
+	}
+
+	// Reads the sequence at Index, an invalid one reads as U+FFFD and only its first byte is consumed
+	static FORCEINLINE uint32 ReadUtf8(uint8 const* Bytes, int32 Size, int32& Index)
+	{
+		const uint32 Lead = Bytes[Index++];
+		if (Lead < 0x80)
+		{
+			return Lead;
+		}
+
+		int32 NumTrail;
+		uint32 Codepoint;
+		uint32 MinCodepoint;
+		if ((Lead & 0xE0) == 0xC0)
+		{
+			NumTrail = 1;
+			Codepoint = Lead & 0x1F;
+			MinCodepoint = 0x80;
+		}
+		else if ((Lead & 0xF0) == 0xE0)
+		{
+			NumTrail = 2;
+			Codepoint = Lead & 0x0F;
+			MinCodepoint = 0x800;
+		}
+		else if ((Lead & 0xF8) == 0xF0)
+		{
+			NumTrail = 3;
+			Codepoint = Lead & 0x07;
+			MinCodepoint = 0x10000;
+		}
+		else
+		{
+			return ReplacementChar;
+		}
+
+		if (Index + NumTrail > Size)
+		{
+			return ReplacementChar;
+		}
+		for (int32 Trail = 0; Trail < NumTrail; Trail++)
+		{
+			const uint32 Byte = Bytes[Index + Trail];
+			if ((Byte & 0xC0) != 0x80)
+			{
+				return ReplacementChar;
+			}
+			Codepoint = (Codepoint << 6) | (Byte & 0x3F);
+		}
+
+		// Overlong forms and encoded surrogates are rejected so every code point has a single encoding
+		if (Codepoint < MinCodepoint || Codepoint > 0x10FFFF || (Codepoint >= 0xD800 && Codepoint <= 0xDFFF))
+		{
+			return ReplacementChar;
+		}
+		Index += NumTrail;
+		return Codepoint;
+	}
+
+	// The caller has checked that Dest holds GetUtf8Size bytes
+	static int32 EncodeUtf8Unchecked(TCHAR const* Chars, int32 Length, uint8* Dest)
+	{
+		uint8* Out = Dest;
+		int32 Index = 0;
+		while (Index < Length)
+		{
+			for (; Index + EncodeBlock <= Length && IsAsciiBlock(Chars + Index); Index += EncodeBlock, Out += EncodeBlock)
+			{
+				for (int32 Lane = 0; Lane < EncodeBlock; Lane++)
+				{
+					Out[Lane] = static_cast<uint8>(Chars[Index + Lane]);
+				}
+			}
+
+			// A block with non-ASCII text is done one character at a time before trying blocks again
+			const int32 ScalarEnd = FMath::Min(Length, Index + EncodeBlock);
+			while (Index < ScalarEnd)
+			{
+				Out = WriteUtf8(ReadChar(Chars, Length, Index), Out);
+			}
+		}
+		return static_cast<int32>(Out - Dest);
+	}
+}
+
+using namespace AccelByteByteConversion;
+
+int32 FAccelByteByteConversion::GetUtf8Size(TCHAR const* Chars, int32 Length)
+{
+	int32 Size = 0;
+	int32 Index = 0;
+	while (Index < Length)
+	{
+		for (; Index + EncodeBlock <= Length && IsAsciiBlock(Chars + Index); Index += EncodeBlock)
+		{
+			Size += EncodeBlock;
+		}
+
+		const int32 ScalarEnd = FMath::Min(Length, Index + EncodeBlock);
+		while (Index < ScalarEnd)
+		{
+			Size += GetEncodedSize(ReadChar(Chars, Length, Index));
+		}
+	}
+	return Size;
+}
+
+int32 FAccelByteByteConversion::EncodeUtf8(TCHAR const* Chars, int32 Length, uint8* Dest, int32 Capacity)
+{
+	if (GetUtf8Size(Chars, Length) > Capacity)
+	{
+		return INDEX_NONE;
+	}
+	return EncodeUtf8Unchecked(Chars, Length, Dest);
+}
+
+int32 FAccelByteByteConversion::DecodeUtf8(uint8 const* Bytes, int32 Size, TCHAR* Dest, int32 Capacity)
+{
+	int32 Index = 0;
+	int32 Written = 0;
+	while (Index < Size)
+	{
+		for (; Index + DecodeBlock <= Size && Written + DecodeBlock <= Capacity; Index += DecodeBlock, Written += DecodeBlock)
+		{
+			uint64 Block;
+			FMemory::Memcpy(&Block, Bytes + Index, sizeof(Block));
+			if ((Block & DecodeBlockHighBits) != 0)
+			{
+				break;
+			}
+			for (int32 Lane = 0; Lane < DecodeBlock; Lane++)
+			{
+				Dest[Written + Lane] = static_cast<TCHAR>(Bytes[Index + Lane]);
+			}
+		}
+
+		const int32 ScalarEnd = FMath::Min(Size, Index + DecodeBlock);
+		while (Index < ScalarEnd)
+		{
+			const uint32 Codepoint = ReadUtf8(Bytes, Size, Index);
+			if (sizeof(TCHAR) == 2 && Codepoint > 0xFFFF)
+			{
+				if (Written + 2 > Capacity)
+				{
+					return INDEX_NONE;
+				}
+				Dest[Written++] = static_cast<TCHAR>(0xD800 + ((Codepoint - 0x10000) >> 10));
+				Dest[Written++] = static_cast<TCHAR>(0xDC00 + ((Codepoint - 0x10000) & 0x3FF));
+			}
+			else
+			{
+				if (Written + 1 > Capacity)
+				{
+					return INDEX_NONE;
+				}
+				Dest[Written++] = static_cast<TCHAR>(Codepoint);
+			}
+		}
+	}
+	return Written;
+}
+
+void FAccelByteByteConversion::StringToUtf8(FString const& String, TArray<uint8>& Out)
+{
+	const int32 Size = GetUtf8Size(*String, String.Len());
+	Out.SetNumUninitialized(Size, false);
+	EncodeUtf8Unchecked(*String, String.Len(), Out.GetData());
+}
+
+void FAccelByteByteConversion::Utf8ToString(uint8 const* Bytes, int32 Size, FString& Out)
+{
+	// One character per byte is the worst case, the array is trimmed without giving the slack back
+	TArray<TCHAR>& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(Size + 1, false);
+	const int32 Length = DecodeUtf8(Bytes, Size, Chars.GetData(), Size);
+	Chars[Length] = TEXT('\0');
+	Chars.SetNum(Length + 1, false);
+}
+
+int32 FAccelByteByteConversion::StringToBytes(FString const& String, uint8* Dest, int32 Capacity)
+{
+	const int32 Length = String.Len();
+	if (Length > Capacity)
+	{
+		return INDEX_NONE;
+	}
+
+	TCHAR const* Chars = *String;
+	for (int32 Index = 0; Index < Length; Index++)
+	{
+		Dest[Index] = static_cast<uint8>(Chars[Index] - 1);
+	}
+	return Length;
+}
+
+void FAccelByteByteConversion::StringToBytes(FString const& String, TArray<uint8>& Out)
+{
+	Out.SetNumUninitialized(String.Len(), false);
+	StringToBytes(String, Out.GetData(), Out.Num());
+}
+
+void FAccelByteByteConversion::BytesToString(uint8 const* Bytes, int32 Size, FString& Out)
+{
+	TArray<TCHAR>& Chars = Out.GetCharArray();
+	Chars.SetNumUninitialized(Size + 1, false);
+	TCHAR* Dest = Chars.GetData();
+	for (int32 Index = 0; Index < Size; Index++)
+	{
+		Dest[Index] = static_cast<TCHAR>(Bytes[Index] + 1);
+	}
+	Dest[Size] = TEXT('\0');
+}
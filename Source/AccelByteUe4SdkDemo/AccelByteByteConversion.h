@@ -0,0 +1,41 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Conversions between FString and byte buffers for save payloads of several megabytes.
+ *
+ * The pointer overloads work on a caller supplied buffer and never allocate. The FString and TArray overloads
+ * replace the content of the output and keep its allocation, so converting into the same output again only
+ * allocates when the payload grows. Runs of ASCII are handled a block at a time in loops the compiler vectorizes,
+ * everything else takes the scalar path.
+ *
+ * UTF-8 input that is not valid decodes to U+FFFD, as do unpaired surrogates when encoding. Valid text round trips
+ * exactly. The raw byte conversions store one character per byte, offset by one like the engine's BytesToString so
+ * zero bytes survive, and round trip any byte buffer.
+ */
+class FAccelByteByteConversion
+{
+public:
+	// Bytes needed to encode Length characters as UTF-8
+	static int32 GetUtf8Size(TCHAR const* Chars, int32 Length);
+
+	// Returns the number of bytes written, or INDEX_NONE without writing anything when Capacity is too small
+	static int32 EncodeUtf8(TCHAR const* Chars, int32 Length, uint8* Dest, int32 Capacity);
+
+	// Returns the number of characters written, or INDEX_NONE when Capacity is too small, Size characters always fit
+	static int32 DecodeUtf8(uint8 const* Bytes, int32 Size, TCHAR* Dest, int32 Capacity);
+
+	static void StringToUtf8(FString const& String, TArray<uint8>& Out);
+	static void Utf8ToString(uint8 const* Bytes, int32 Size, FString& Out);
+
+	// Returns the number of bytes written, or INDEX_NONE when Capacity is below the string length
+	static int32 StringToBytes(FString const& String, uint8* Dest, int32 Capacity);
+
+	static void StringToBytes(FString const& String, TArray<uint8>& Out);
+	static void BytesToString(uint8 const* Bytes, int32 Size, FString& Out);
+};
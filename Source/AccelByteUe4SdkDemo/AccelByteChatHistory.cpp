@@ -0,0 +1,193 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteChatHistory.h"
+#include "AccelByteMemoryReport.h"
+
+// Sender ids are user ids, anything longer is not a sender
+#define CHAT_HISTORY_MAX_FROM_CHARS 256
+
+FAccelByteChatHistory& FAccelByteChatHistory::Get()
+{
+	static FAccelByteChatHistory Instance;
+	return Instance;
+}
+
+void FAccelByteChatHistory::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.MessagesPerChannel = FMath::Max(1, Settings.MessagesPerChannel);
+	Settings.BudgetBytes = FMath::Max<int64>(PageBytes, Settings.BudgetBytes);
+	Reset();
+}
+
+void FAccelByteChatHistory::Reset()
+{
+	Channels.Reset();
+	FreePages.Reset();
+	AllPages.Reset();
+	TextChars = 0;
+}
+
+FString FAccelByteChatHistory::GetPartyChannel()
+{
+	return TEXT("party");
+}
+
+FString FAccelByteChatHistory::GetPrivateChannel(FString const& UserId)
+{
+	return TEXT("private/") + UserId;
+}
+
+FString FAccelByteChatHistory::GetLobbyChannel(FString const& ChannelSlug)
+{
+	return TEXT("lobby/") + ChannelSlug;
+}
+
+void FAccelByteChatHistory::Add(FString const& ChannelName, FStringView From, FStringView Text)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	From = From.Left(CHAT_HISTORY_MAX_FROM_CHARS);
+	Text = Text.Left(PageChars - From.Len());
+	const int32 Needed = From.Len() + Text.Len();
+
+	FChannel& Channel = Channels.FindOrAdd(ChannelName);
+	if (Channel.Entries.Num() == 0)
+	{
+		Channel.Entries.SetNum(Settings.MessagesPerChannel);
+	}
+	if (Channel.Count == Channel.Entries.Num())
+	{
+		DropOldest(Channel);
+	}
+
+	FPage* Page = Channel.Pages.Num() > 0 ? Channel.Pages.Last() : nullptr;
+	if (Page == nullptr || Page->Used + Needed > PageChars)
+	{
+		// May evict from this channel too, Channel stays valid since channels are never removed outside Reset
+		Page = AcquirePage();
+		Channel.Pages.Add(Page);
+	}
+
+	FEntry& Entry = Channel.Entries[(Channel.Head + Channel.Count) % Channel.Entries.Num()];
+	Entry.Page = Page;
+	Entry.Offset = Page->Used;
+	Entry.FromLength = From.Len();
+	Entry.TextLength = Text.Len();
+	Entry.Sequence = NextSequence++;
+	Entry.ReceivedAt = FDateTime::UtcNow();
+	FMemory::Memcpy(Page->Chars.Get() + Entry.Offset, From.GetData(), From.Len() * sizeof(TCHAR));
+	FMemory::Memcpy(Page->Chars.Get() + Entry.Offset + From.Len(), Text.GetData(), Text.Len() * sizeof(TCHAR));
+
+	Page->Used += Needed;
+	Page->Messages++;
+	Channel.Count++;
+	TextChars += Needed;
+}
+
+int32 FAccelByteChatHistory::Num(FString const& ChannelName) const
+{
+	FChannel const* Channel = Channels.Find(ChannelName);
+	return Channel != nullptr ? Channel->Count : 0;
+}
+
+int32 FAccelByteChatHistory::Read(FString const& ChannelName, int32 FromNewest, int32 Count, TArray<FMessageView>& OutMessages) const
+{
+	FChannel const* Channel = Channels.Find(ChannelName);
+	if (Channel == nullptr || FromNewest < 0 || FromNewest >= Channel->Count || Count <= 0)
+	{
+		return 0;
+	}
+
+	const int32 End = FMath::Min(Channel->Count, FromNewest + Count);
+	OutMessages.Reserve(OutMessages.Num() + End - FromNewest);
+	for (int32 Index = FromNewest; Index < End; Index++)
+	{
+		FEntry const& Entry = Channel->GetFromNewest(Index);
+		TCHAR const* Chars = Entry.Page->Chars.Get() + Entry.Offset;
+		OutMessages.Add({ FStringView(Chars, Entry.FromLength), FStringView(Chars + Entry.FromLength, Entry.TextLength), Entry.ReceivedAt });
+	}
+	return End - FromNewest;
+}
+
+FAccelByteChatHistoryStats FAccelByteChatHistory::GetStats() const
+{
+	FAccelByteChatHistoryStats Stats;
+	Stats.Channels = Channels.Num();
+	for (TPair<FString, FChannel> const& Pair : Channels)
+	{
+		Stats.Messages += Pair.Value.Count;
+	}
+	Stats.AllocatedBytes = static_cast<int64>(AllPages.Num()) * PageBytes;
+	Stats.TextBytes = TextChars * sizeof(TCHAR);
+	Stats.EvictedMessages = EvictedMessages;
+	return Stats;
+}
+
+FAccelByteChatHistory::FPage* FAccelByteChatHistory::AcquirePage()
+{
+	if (FreePages.Num() == 0)
+	{
+		if (AllPages.Num() == 0 || static_cast<int64>(AllPages.Num() + 1) * PageBytes <= Settings.BudgetBytes)
+		{
+			TUniquePtr<FPage>& Page = AllPages.Add_GetRef(MakeUnique<FPage>());
+			Page->Chars = MakeUnique<TCHAR[]>(PageChars);
+			return Page.Get();
+		}
+		// Every page is in use, the evicted one comes back through FreePages
+		EvictOldestPage();
+	}
+
+	FPage* Page = FreePages.Pop(false);
+	Page->Used = 0;
+	Page->Messages = 0;
+	return Page;
+}
+
+void FAccelByteChatHistory::ReleasePage(FPage* Page)
+{
+	FreePages.Add(Page);
+}
+
+void FAccelByteChatHistory::DropOldest(FChannel& Channel)
+{
+	FEntry& Entry = Channel.Entries[Channel.Head];
+	FPage* Page = Entry.Page;
+	TextChars -= Entry.FromLength + Entry.TextLength;
+	Entry.Page = nullptr;
+	Channel.Head = (Channel.Head + 1) % Channel.Entries.Num();
+	Channel.Count--;
+	EvictedMessages++;
+
+	// Pages empty out oldest first, the same way the entries do
+	if (--Page->Messages == 0)
+	{
+		check(Channel.Pages[0] == Page);
+		Channel.Pages.RemoveAt(0, 1, false);
+		ReleasePage(Page);
+	}
+}
+
+void FAccelByteChatHistory::EvictOldestPage()
+{
+	FChannel* Oldest = nullptr;
+	for (TPair<FString, FChannel>& Pair : Channels)
+	{
+		FChannel& Channel = Pair.Value;
+		if (Channel.Count > 0 && (Oldest == nullptr || Channel.Entries[Channel.Head].Sequence < Oldest->Entries[Oldest->Head].Sequence))
+		{
+			Oldest = &Channel;
+		}
+	}
+	if (Oldest == nullptr)
+	{
+		return;
+	}
+
+	FPage* Page = Oldest->Pages[0];
+	while (Oldest->Count > 0 && Oldest->Entries[Oldest->Head].Page == Page)
+	{
+		DropOldest(*Oldest);
+	}
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "AccelByteChatHistory.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteChatMessage
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString From;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString Text;
+
+	// When the message was added to the history
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FDateTime ReceivedAt;
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteChatHistoryStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int32 Channels = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int32 Messages = 0;
+
+	// Arena pages held, in use or pooled, this is what the budget caps
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int64 AllocatedBytes = 0;
+
+	// Text bytes of the messages still in the history
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int64 TextBytes = 0;
+
+	// Messages dropped because their channel was full or the budget was reached
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int64 EvictedMessages = 0;
+};
+
+/**
+ * Chat history per channel with a fixed number of messages per channel and a memory budget for the text.
+ *
+ * Every channel has a ring buffer of message entries. The sender and text of a message are copied next to each
+ * other into fixed size arena pages, a channel appends to its newest page and starts a new one when a message does
+ * not fit. Pages come from a pool shared by all channels. A full channel drops its oldest message and a page goes
+ * back to the pool once none of its messages are left. When the pool is empty and the budget does not allow another
+ * page, the oldest page of the channel holding the oldest message is evicted with its messages. Reads return views
+ * into the pages, so scrolling back copies nothing. Only meant to be used from the game thread.
+ */
+class FAccelByteChatHistory
+{
+public:
+	struct FSettings
+	{
+		int32 MessagesPerChannel = 500;
+		int64 BudgetBytes = 1024 * 1024;
+	};
+
+	// Valid until the next message is added to any channel or the history is reset
+	struct FMessageView
+	{
+		FStringView From;
+		FStringView Text;
+		FDateTime ReceivedAt;
+	};
+
+	static FAccelByteChatHistory& Get();
+
+	// Drops the whole history
+	void Configure(FSettings const& InSettings);
+
+	void Reset();
+
+	// Channel names used for the lobby notifications
+	static FString GetPartyChannel();
+	static FString GetPrivateChannel(FString const& UserId);
+	static FString GetLobbyChannel(FString const& ChannelSlug);
+
+	// Text longer than a page is truncated
+	void Add(FString const& Channel, FStringView From, FStringView Text);
+
+	int32 Num(FString const& Channel) const;
+
+	/**
+	 * Appends up to Count messages to OutMessages, newest first, skipping the FromNewest most recent ones.
+	 * @return The number of messages appended.
+	 */
+	int32 Read(FString const& Channel, int32 FromNewest, int32 Count, TArray<FMessageView>& OutMessages) const;
+
+	FAccelByteChatHistoryStats GetStats() const;
+
+	// Sized in bytes so a page takes the same memory whatever the width of TCHAR
+	static constexpr int32 PageBytes = 16 * 1024;
+	static constexpr int32 PageChars = PageBytes / sizeof(TCHAR);
+
+private:
+	struct FPage
+	{
+		TUniquePtr<TCHAR[]> Chars;
+		int32 Used = 0;
+		// Messages still referencing the page
+		int32 Messages = 0;
+	};
+
+	struct FEntry
+	{
+		FPage* Page = nullptr;
+		int32 Offset = 0;
+		int32 FromLength = 0;
+		int32 TextLength = 0;
+		int64 Sequence = 0;
+		FDateTime ReceivedAt;
+	};
+
+	struct FChannel
+	{
+		TArray<FEntry> Entries;
+		// Index of the oldest entry in Entries
+		int32 Head = 0;
+		int32 Count = 0;
+		// Oldest first, the last one is written to
+		TArray<FPage*> Pages;
+
+		FEntry const& GetFromNewest(int32 Index) const { return Entries[(Head + Count - 1 - Index) % Entries.Num()]; }
+	};
+
+	FPage* AcquirePage();
+	void ReleasePage(FPage* Page);
+	void DropOldest(FChannel& Channel);
+	void EvictOldestPage();
+
+	FSettings Settings;
+	TMap<FString, FChannel> Channels;
+	TArray<TUniquePtr<FPage>> AllPages;
+	TArray<FPage*> FreePages;
+	int64 NextSequence = 0;
+	int64 TextChars = 0;
+	int64 EvictedMessages = 0;
+};
@@ -0,0 +1,827 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteCloudSave.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteCloudStorageApi.h"
+
+#define CLOUD_SAVE_MANIFEST_MAGIC 0x4D434241 // "ABCM"
+#define CLOUD_SAVE_MANIFEST_VERSION 1
+#define CLOUD_SAVE_MANIFEST_KEY TEXT("manifest")
+#define CLOUD_SAVE_SLOT_TAG TEXT("accelbyte-cloudsave")
+// Bytes read from disk at a time while chunking and verifying
+#define CLOUD_SAVE_READ_BUFFER_SIZE (1024 * 1024)
+
+namespace AccelByteCloudSave
+{
+	struct FChunk
+	{
+		FSHAHash Hash;
+		int64 Offset = 0;
+		int32 Size = 0;
+	};
+
+	struct FManifest
+	{
+		int64 TotalSize = 0;
+		TArray<FChunk> Chunks;
+	};
+
+	struct FTransfer
+	{
+		TSharedPtr<IAccelByteCloudChunkStore> Store;
+		FString SlotName;
+		FString FilePath;
+		int32 AverageChunkSize = 0;
+		int32 MaxConcurrency = 1;
+		bool bUpload = true;
+		FManifest Manifest;
+		FAccelByteCloudSaveResult Result;
+		FAccelByteCloudSave::FOnComplete OnComplete;
+
+		bool HasFailed() const { return !Result.ErrorMessage.IsEmpty(); }
+
+		// The first error is the one reported
+		void Fail(FString const& ErrorMessage)
+		{
+			if (!HasFailed())
+			{
+				Result.ErrorMessage = ErrorMessage.IsEmpty() ? TEXT("Unknown error") : ErrorMessage;
+			}
+		}
+
+		void Complete()
+		{
+			Result.bSuccess = !HasFailed();
+			Result.NumChunks = Manifest.Chunks.Num();
+			Result.TotalBytes = Manifest.TotalSize;
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("Cloud save %s of %s: %d of %d chunks, %lld of %lld bytes transferred%s%s"),
+				bUpload ? TEXT("upload") : TEXT("download"), *SlotName, Result.ChunksTransferred, Result.NumChunks, Result.BytesTransferred, Result.TotalBytes,
+				Result.bSuccess ? TEXT("") : TEXT(" - "), *Result.ErrorMessage);
+			OnComplete(Result);
+		}
+	};
+
+	// Per byte values of the gear rolling hash, generated with SplitMix64 so every build cuts the same chunks
+	struct FGearTable
+	{
+		uint64 Values[256];
+
+		FGearTable()
+		{
+			uint64 State = 0;
+			for (uint64& Value : Values)
+			{
+				State += 0x9E3779B97F4A7C15ull;
+				uint64 Mixed = State;
+				Mixed = (Mixed ^ (Mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+				Mixed = (Mixed ^ (Mixed >> 27)) * 0x94D049BB133111EBull;
+				Value = Mixed ^ (Mixed >> 31);
+			}
+		}
+	};
+
+	static FGearTable const GearTable;
+
+	static FString GetChunkKey(FString const& SlotName, FSHAHash const& Hash)
+	{
+		return SlotName / Hash.ToString();
+	}
+
+	static FString GetManifestKey(FString const& SlotName)
+	{
+		return SlotName / CLOUD_SAVE_MANIFEST_KEY;
+	}
+
+	static FSHAHash HashBuffer(uint8 const* Data, int32 Size)
+	{
+		FSHAHash Hash;
+		FSHA1::HashBuffer(Data, Size, Hash.Hash);
+		return Hash;
+	}
+
+	/**
+	 * Content defined chunking: a cut is made where the top bits of the rolling hash of the last 64 bytes are zero,
+	 * bounded to a quarter and four times the average size. Runs on a worker thread and reads the file in blocks.
+	 */
+	static bool ChunkFile(FString const& FilePath, int32 AverageChunkSize, FManifest& OutManifest)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!Reader)
+		{
+			return false;
+		}
+
+		const int32 MinSize = AverageChunkSize / 4;
+		const int32 MaxSize = AverageChunkSize * 4;
+		const int32 CutShift = 64 - FMath::FloorLog2(static_cast<uint32>(AverageChunkSize));
+		const int64 TotalSize = Reader->TotalSize();
+
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(CLOUD_SAVE_READ_BUFFER_SIZE);
+		FSHA1 ChunkHash;
+		uint64 RollingHash = 0;
+		int64 ChunkOffset = 0;
+		int32 ChunkSize = 0;
+
+		auto FinishChunk = [&]()
+		{
+			ChunkHash.Final();
+			FChunk& Chunk = OutManifest.Chunks.AddDefaulted_GetRef();
+			ChunkHash.GetHash(Chunk.Hash.Hash);
+			Chunk.Offset = ChunkOffset;
+			Chunk.Size = ChunkSize;
+			ChunkHash.Reset();
+			ChunkOffset += ChunkSize;
+			ChunkSize = 0;
+		};
+
+		for (int64 Position = 0; Position < TotalSize;)
+		{
+			const int32 Count = static_cast<int32>(FMath::Min<int64>(Buffer.Num(), TotalSize - Position));
+			Reader->Serialize(Buffer.GetData(), Count);
+			if (Reader->IsError())
+			{
+				return false;
+			}
+			Position += Count;
+
+			int32 SegmentStart = 0;
+			for (int32 Index = 0; Index < Count; Index++)
+			{
+				RollingHash = (RollingHash << 1) + GearTable.Values[Buffer[Index]];
+				ChunkSize++;
+				if ((ChunkSize >= MinSize && (RollingHash >> CutShift) == 0) || ChunkSize >= MaxSize)
+				{
+					ChunkHash.Update(Buffer.GetData() + SegmentStart, Index + 1 - SegmentStart);
+					SegmentStart = Index + 1;
+					FinishChunk();
+				}
+			}
+			ChunkHash.Update(Buffer.GetData() + SegmentStart, Count - SegmentStart);
+		}
+		if (ChunkSize > 0)
+		{
+			FinishChunk();
+		}
+
+		OutManifest.TotalSize = TotalSize;
+		return true;
+	}
+
+	static bool ReadChunk(FString const& FilePath, FChunk const& Chunk, TArray<uint8>& OutData)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+		if (!Reader || Reader->TotalSize() < Chunk.Offset + Chunk.Size)
+		{
+			return false;
+		}
+		OutData.SetNumUninitialized(Chunk.Size);
+		Reader->Seek(Chunk.Offset);
+		Reader->Serialize(OutData.GetData(), Chunk.Size);
+		return !Reader->IsError() && HashBuffer(OutData.GetData(), OutData.Num()) == Chunk.Hash;
+	}
+
+	static TArray<uint8> SerializeManifest(FManifest& Manifest)
+	{
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		uint32 Magic = CLOUD_SAVE_MANIFEST_MAGIC;
+		uint32 Version = CLOUD_SAVE_MANIFEST_VERSION;
+		int32 NumChunks = Manifest.Chunks.Num();
+		Writer << Magic << Version << Manifest.TotalSize << NumChunks;
+		for (FChunk& Chunk : Manifest.Chunks)
+		{
+			Writer << Chunk.Hash << Chunk.Size;
+		}
+		return Data;
+	}
+
+	static bool ParseManifest(TArray<uint8> const& Data, FManifest& OutManifest)
+	{
+		FMemoryReader Reader(Data);
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		int32 NumChunks = 0;
+		Reader << Magic << Version << OutManifest.TotalSize << NumChunks;
+		if (Reader.IsError() || Magic != CLOUD_SAVE_MANIFEST_MAGIC || Version != CLOUD_SAVE_MANIFEST_VERSION || NumChunks < 0)
+		{
+			return false;
+		}
+
+		int64 Offset = 0;
+		for (int32 Index = 0; Index < NumChunks && !Reader.IsError(); Index++)
+		{
+			FChunk& Chunk = OutManifest.Chunks.AddDefaulted_GetRef();
+			Reader << Chunk.Hash << Chunk.Size;
+			Chunk.Offset = Offset;
+			Offset += Chunk.Size;
+		}
+		return !Reader.IsError() && Offset == OutManifest.TotalSize;
+	}
+
+	// Index of the first chunk the part file does not already hold, a part file that cannot belong to the manifest is deleted
+	static int32 VerifyPartFile(FString const& PartPath, FManifest const& Manifest)
+	{
+		const int64 PartSize = IFileManager::Get().FileSize(*PartPath);
+		if (PartSize <= 0)
+		{
+			return 0;
+		}
+		if (PartSize > Manifest.TotalSize)
+		{
+			IFileManager::Get().Delete(*PartPath, false, false, true);
+			return 0;
+		}
+
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*PartPath));
+		if (!Reader)
+		{
+			return 0;
+		}
+
+		TArray<uint8> Buffer;
+		int32 Index = 0;
+		for (; Index < Manifest.Chunks.Num(); Index++)
+		{
+			FChunk const& Chunk = Manifest.Chunks[Index];
+			if (Chunk.Offset + Chunk.Size > PartSize)
+			{
+				break;
+			}
+			Buffer.SetNumUninitialized(Chunk.Size, false);
+			Reader->Serialize(Buffer.GetData(), Chunk.Size);
+			if (Reader->IsError() || HashBuffer(Buffer.GetData(), Buffer.Num()) != Chunk.Hash)
+			{
+				break;
+			}
+		}
+		return Index;
+	}
+
+	static void DeleteStaleChunks(TSharedRef<FTransfer> Transfer, TArray<FString> const& StaleKeys)
+	{
+		if (StaleKeys.Num() == 0)
+		{
+			Transfer->Complete();
+			return;
+		}
+
+		// The new manifest is in place, a chunk that fails to delete only costs storage until the next upload
+		TArray<FAccelByteTaskPipeline::FTask> Tasks;
+		for (FString const& Key : StaleKeys)
+		{
+			Tasks.Add([Transfer, Key](FSimpleDelegate const& OnDone)
+			{
+				Transfer->Store->Delete(Key, [Key, OnDone](FString const& ErrorMessage)
+				{
+					if (!ErrorMessage.IsEmpty())
+					{
+						UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to delete the stale cloud save chunk %s: %s"), *Key, *ErrorMessage);
+					}
+					OnDone.ExecuteIfBound();
+				});
+			});
+		}
+
+		TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Transfer->MaxConcurrency);
+		Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([Transfer]()
+		{
+			Transfer->Complete();
+		}));
+		Pipeline->EnqueueAll(MoveTemp(Tasks));
+	}
+
+	static void PutManifest(TSharedRef<FTransfer> Transfer, TArray<FString> const& StaleKeys)
+	{
+		Transfer->Store->Put(GetManifestKey(Transfer->SlotName), SerializeManifest(Transfer->Manifest), [Transfer, StaleKeys](FString const& ErrorMessage)
+		{
+			if (!ErrorMessage.IsEmpty())
+			{
+				Transfer->Fail(ErrorMessage);
+				Transfer->Complete();
+				return;
+			}
+			DeleteStaleChunks(Transfer, StaleKeys);
+		});
+	}
+
+	static void UploadMissingChunks(TSharedRef<FTransfer> Transfer, TArray<FString> const& StoredKeys)
+	{
+		const FString KeyPrefix = Transfer->SlotName + TEXT("/");
+		TSet<FString> Stored;
+		for (FString const& Key : StoredKeys)
+		{
+			if (Key.StartsWith(KeyPrefix))
+			{
+				Stored.Add(Key);
+			}
+		}
+
+		TSet<FString> Referenced;
+		TArray<FAccelByteTaskPipeline::FTask> Tasks;
+		for (FChunk const& Chunk : Transfer->Manifest.Chunks)
+		{
+			const FString Key = GetChunkKey(Transfer->SlotName, Chunk.Hash);
+			bool bAlreadyReferenced = false;
+			Referenced.Add(Key, &bAlreadyReferenced);
+			if (bAlreadyReferenced || Stored.Contains(Key))
+			{
+				continue;
+			}
+
+			Tasks.Add([Transfer, Chunk, Key](FSimpleDelegate const& OnDone)
+			{
+				TArray<uint8> Data;
+				if (Transfer->HasFailed())
+				{
+					OnDone.ExecuteIfBound();
+					return;
+				}
+				if (!ReadChunk(Transfer->FilePath, Chunk, Data))
+				{
+					Transfer->Fail(FString::Printf(TEXT("%s changed or became unreadable during the upload"), *Transfer->FilePath));
+					OnDone.ExecuteIfBound();
+					return;
+				}
+
+				Transfer->Store->Put(Key, MoveTemp(Data), [Transfer, Chunk, OnDone](FString const& ErrorMessage)
+				{
+					if (ErrorMessage.IsEmpty())
+					{
+						Transfer->Result.ChunksTransferred++;
+						Transfer->Result.BytesTransferred += Chunk.Size;
+					}
+					else
+					{
+						Transfer->Fail(ErrorMessage);
+					}
+					OnDone.ExecuteIfBound();
+				});
+			});
+		}
+
+		TArray<FString> StaleKeys;
+		const FString ManifestKey = GetManifestKey(Transfer->SlotName);
+		for (FString const& Key : Stored)
+		{
+			if (!Referenced.Contains(Key) && Key != ManifestKey)
+			{
+				StaleKeys.Add(Key);
+			}
+		}
+
+		if (Tasks.Num() == 0)
+		{
+			PutManifest(Transfer, StaleKeys);
+			return;
+		}
+
+		// Uploaded chunks are kept on failure, the next upload of the slot finds them and skips them
+		TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Transfer->MaxConcurrency);
+		Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([Transfer, StaleKeys]()
+		{
+			if (Transfer->HasFailed())
+			{
+				Transfer->Complete();
+				return;
+			}
+			PutManifest(Transfer, StaleKeys);
+		}));
+		Pipeline->EnqueueAll(MoveTemp(Tasks));
+	}
+
+	static void DownloadChunks(TSharedRef<FTransfer> Transfer, int32 FirstChunk)
+	{
+		const FString PartPath = Transfer->FilePath + TEXT(".part");
+		TSharedPtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*PartPath, FILEWRITE_Append));
+		if (!Writer.IsValid())
+		{
+			Transfer->Fail(FString::Printf(TEXT("Cannot write %s"), *PartPath));
+			Transfer->Complete();
+			return;
+		}
+
+		TArray<FAccelByteTaskPipeline::FTask> Tasks;
+		for (int32 Index = FirstChunk; Index < Transfer->Manifest.Chunks.Num(); Index++)
+		{
+			Tasks.Add([Transfer, Writer, Index](FSimpleDelegate const& OnDone)
+			{
+				if (Transfer->HasFailed())
+				{
+					OnDone.ExecuteIfBound();
+					return;
+				}
+
+				FChunk const& Chunk = Transfer->Manifest.Chunks[Index];
+				Transfer->Store->Get(GetChunkKey(Transfer->SlotName, Chunk.Hash), [Transfer, Writer, Index, OnDone](TArray<uint8> const& Data, FString const& ErrorMessage)
+				{
+					FChunk const& Chunk = Transfer->Manifest.Chunks[Index];
+					if (!ErrorMessage.IsEmpty())
+					{
+						Transfer->Fail(ErrorMessage);
+					}
+					else if (Data.Num() != Chunk.Size || HashBuffer(Data.GetData(), Data.Num()) != Chunk.Hash)
+					{
+						Transfer->Fail(FString::Printf(TEXT("Chunk %d of %s does not match its hash"), Index, *Transfer->SlotName));
+					}
+					else
+					{
+						Writer->Seek(Chunk.Offset);
+						Writer->Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+						Transfer->Result.ChunksTransferred++;
+						Transfer->Result.BytesTransferred += Data.Num();
+					}
+					OnDone.ExecuteIfBound();
+				});
+			});
+		}
+
+		auto Finish = [Transfer, Writer, PartPath]()
+		{
+			const bool bWritten = Writer->Close();
+			if (!bWritten)
+			{
+				Transfer->Fail(FString::Printf(TEXT("Failed to write %s"), *PartPath));
+			}
+
+			// A failed download keeps the part file, the next attempt resumes from its verified chunks
+			if (!Transfer->HasFailed() && !IFileManager::Get().Move(*Transfer->FilePath, *PartPath, true))
+			{
+				Transfer->Fail(FString::Printf(TEXT("Cannot move %s to %s"), *PartPath, *Transfer->FilePath));
+			}
+			Transfer->Complete();
+		};
+
+		if (Tasks.Num() == 0)
+		{
+			Finish();
+			return;
+		}
+
+		TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Transfer->MaxConcurrency);
+		Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda(Finish));
+		Pipeline->EnqueueAll(MoveTemp(Tasks));
+	}
+
+	class FCloudStorageChunkStore : public IAccelByteCloudChunkStore, public TSharedFromThis<FCloudStorageChunkStore>
+	{
+	public:
+		explicit FCloudStorageChunkStore(float InListingCacheSeconds)
+			: ListingCacheSeconds(InListingCacheSeconds)
+		{
+		}
+
+		virtual void List(FOnList&& OnComplete) override
+		{
+			if (ListedTime >= 0.0 && FPlatformTime::Seconds() - ListedTime < ListingCacheSeconds)
+			{
+				TArray<FString> Keys;
+				SlotIds.GetKeys(Keys);
+				OnComplete(Keys, TEXT(""));
+				return;
+			}
+			FetchSlots(MoveTemp(OnComplete));
+		}
+
+		virtual void Put(FString const& Key, TArray<uint8>&& Data, FOnDone&& OnComplete) override
+		{
+			TSharedRef<FCloudStorageChunkStore> Self = AsShared();
+			const FOnDone Callback = MoveTemp(OnComplete);
+			const AccelByte::THandler<FAccelByteModelsSlot> OnSuccess = AccelByte::THandler<FAccelByteModelsSlot>::CreateLambda([Self, Key, Callback](FAccelByteModelsSlot const& Slot)
+			{
+				Self->SlotIds.Add(Key, Slot.SlotId);
+				Callback(TEXT(""));
+			});
+			const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([Self, Callback](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				Self->ListedTime = -1.0;
+				Callback(FormatError(ErrorCode, ErrorMessage));
+			});
+
+			const FString FileName = Key.Replace(TEXT("/"), TEXT("_")) + TEXT(".bin");
+			const TArray<FString> Tags = { CLOUD_SAVE_SLOT_TAG };
+			if (FString const* SlotId = SlotIds.Find(Key))
+			{
+				FRegistry::CloudStorage.UpdateSlot(*SlotId, Data, FileName, Tags, Key, TEXT(""), OnSuccess, FHttpRequestProgressDelegate(), OnError);
+			}
+			else
+			{
+				FRegistry::CloudStorage.CreateSlot(MoveTemp(Data), FileName, Tags, Key, TEXT(""), OnSuccess, FHttpRequestProgressDelegate(), OnError);
+			}
+		}
+
+		virtual void Get(FString const& Key, FOnGet&& OnComplete) override
+		{
+			TSharedRef<FCloudStorageChunkStore> Self = AsShared();
+			const FOnGet Callback = MoveTemp(OnComplete);
+			FString const* SlotId = SlotIds.Find(Key);
+			if (SlotId == nullptr)
+			{
+				// Slots created by another device are only known after a listing, a cached one may predate them
+				FetchSlots([Self, Key, Callback](TArray<FString> const& Keys, FString const& ErrorMessage)
+				{
+					if (!Keys.Contains(Key))
+					{
+						Callback({}, ErrorMessage.IsEmpty() ? FString::Printf(TEXT("No cloud storage slot for %s"), *Key) : ErrorMessage);
+						return;
+					}
+					FOnGet Retry = Callback;
+					Self->Get(Key, MoveTemp(Retry));
+				});
+				return;
+			}
+
+			FRegistry::CloudStorage.GetSlot(*SlotId,
+				AccelByte::THandler<TArray<uint8>>::CreateLambda([Callback](TArray<uint8> const& Data)
+				{
+					Callback(Data, TEXT(""));
+				}),
+				AccelByte::FErrorHandler::CreateLambda([Self, Callback](int32 ErrorCode, FString const& ErrorMessage)
+				{
+					Self->ListedTime = -1.0;
+					Callback({}, FormatError(ErrorCode, ErrorMessage));
+				}));
+		}
+
+		virtual void Delete(FString const& Key, FOnDone&& OnComplete) override
+		{
+			FString SlotId;
+			if (!SlotIds.RemoveAndCopyValue(Key, SlotId))
+			{
+				OnComplete(TEXT(""));
+				return;
+			}
+
+			TSharedRef<FCloudStorageChunkStore> Self = AsShared();
+			const FOnDone Callback = MoveTemp(OnComplete);
+			FRegistry::CloudStorage.DeleteSlot(SlotId,
+				FSimpleDelegate::CreateLambda([Callback]()
+				{
+					Callback(TEXT(""));
+				}),
+				AccelByte::FErrorHandler::CreateLambda([Self, Callback](int32 ErrorCode, FString const& ErrorMessage)
+				{
+					Self->ListedTime = -1.0;
+					Callback(FormatError(ErrorCode, ErrorMessage));
+				}));
+		}
+
+	private:
+		void FetchSlots(FOnList&& OnComplete)
+		{
+			TSharedRef<FCloudStorageChunkStore> Self = AsShared();
+			const FOnList Callback = MoveTemp(OnComplete);
+			const double RequestTime = FPlatformTime::Seconds();
+			FRegistry::CloudStorage.GetAllSlots(
+				AccelByte::THandler<TArray<FAccelByteModelsSlot>>::CreateLambda([Self, Callback, RequestTime](TArray<FAccelByteModelsSlot> const& Slots)
+				{
+					TArray<FString> Keys;
+					Self->SlotIds.Reset();
+					for (FAccelByteModelsSlot const& Slot : Slots)
+					{
+						if (Slot.Tags.Contains(CLOUD_SAVE_SLOT_TAG))
+						{
+							Self->SlotIds.Add(Slot.Label, Slot.SlotId);
+							Keys.Add(Slot.Label);
+						}
+					}
+					Self->ListedTime = RequestTime;
+					Callback(Keys, TEXT(""));
+				}),
+				AccelByte::FErrorHandler::CreateLambda([Self, Callback](int32 ErrorCode, FString const& ErrorMessage)
+				{
+					Self->ListedTime = -1.0;
+					Callback({}, FormatError(ErrorCode, ErrorMessage));
+				}));
+		}
+
+		static FString FormatError(int32 ErrorCode, FString const& ErrorMessage)
+		{
+			return FString::Printf(TEXT("code: %d - message: %s"), ErrorCode, *ErrorMessage);
+		}
+
+		// Slot ids by key, filled by a listing and by the slots this store created
+		TMap<FString, FString> SlotIds;
+		float ListingCacheSeconds = 0.0f;
+		// When the listing in SlotIds was requested, negative when it has to be fetched again
+		double ListedTime = -1.0;
+	};
+
+	class FLocalChunkStore : public IAccelByteCloudChunkStore
+	{
+	public:
+		FLocalChunkStore(FString const& InDirectory, float InLatencySeconds)
+			: Directory(InDirectory)
+			, LatencySeconds(InLatencySeconds)
+		{
+		}
+
+		virtual void List(FOnList&& OnComplete) override
+		{
+			TArray<FString> Files;
+			IFileManager::Get().FindFiles(Files, *(Directory / TEXT("*.chunk")), true, false);
+			TArray<FString> Keys;
+			for (FString const& File : Files)
+			{
+				Keys.Add(FPaths::GetBaseFilename(File).Replace(TEXT("~"), TEXT("/")));
+			}
+			Respond([Callback = MoveTemp(OnComplete), Keys]()
+			{
+				Callback(Keys, TEXT(""));
+			});
+		}
+
+		virtual void Put(FString const& Key, TArray<uint8>&& Data, FOnDone&& OnComplete) override
+		{
+			const bool bSaved = FFileHelper::SaveArrayToFile(Data, *GetPath(Key));
+			Respond([Callback = MoveTemp(OnComplete), bSaved, Key]()
+			{
+				Callback(bSaved ? TEXT("") : FString::Printf(TEXT("Failed to store %s"), *Key));
+			});
+		}
+
+		virtual void Get(FString const& Key, FOnGet&& OnComplete) override
+		{
+			TArray<uint8> Data;
+			const bool bLoaded = FFileHelper::LoadFileToArray(Data, *GetPath(Key), FILEREAD_Silent);
+			Respond([Callback = MoveTemp(OnComplete), bLoaded, Key, Data = MoveTemp(Data)]()
+			{
+				Callback(Data, bLoaded ? TEXT("") : FString::Printf(TEXT("No stored data for %s"), *Key));
+			});
+		}
+
+		virtual void Delete(FString const& Key, FOnDone&& OnComplete) override
+		{
+			IFileManager::Get().Delete(*GetPath(Key), false, false, true);
+			Respond([Callback = MoveTemp(OnComplete)]()
+			{
+				Callback(TEXT(""));
+			});
+		}
+
+	private:
+		FString GetPath(FString const& Key) const
+		{
+			return Directory / Key.Replace(TEXT("/"), TEXT("~")) + TEXT(".chunk");
+		}
+
+		// Always answers on a later tick like a real request would
+		void Respond(TFunction<void()>&& Callback) const
+		{
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Callback = MoveTemp(Callback)](float)
+			{
+				Callback();
+				return false;
+			}), LatencySeconds);
+		}
+
+		FString Directory;
+		float LatencySeconds = 0.0f;
+	};
+}
+
+using namespace AccelByteCloudSave;
+
+TSharedRef<IAccelByteCloudChunkStore> IAccelByteCloudChunkStore::CreateCloudStorageStore(float ListingCacheSeconds)
+{
+	return MakeShared<FCloudStorageChunkStore>(ListingCacheSeconds);
+}
+
+TSharedRef<IAccelByteCloudChunkStore> IAccelByteCloudChunkStore::CreateLocalStore(FString const& Directory, float LatencySeconds)
+{
+	return MakeShared<FLocalChunkStore>(Directory, LatencySeconds);
+}
+
+FAccelByteCloudSave& FAccelByteCloudSave::Get()
+{
+	static FAccelByteCloudSave Instance(IAccelByteCloudChunkStore::CreateCloudStorageStore());
+	return Instance;
+}
+
+FAccelByteCloudSave::FAccelByteCloudSave(TSharedRef<IAccelByteCloudChunkStore> const& InStore)
+	: Store(InStore)
+{
+}
+
+void FAccelByteCloudSave::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.AverageChunkSize = FMath::Clamp(Settings.AverageChunkSize, 4 * 1024, 4 * 1024 * 1024);
+	Settings.MaxConcurrency = FMath::Max(1, Settings.MaxConcurrency);
+	Settings.ListingCacheSeconds = FMath::Max(0.0f, Settings.ListingCacheSeconds);
+	Store = Settings.bLocalStore
+		? IAccelByteCloudChunkStore::CreateLocalStore(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("CloudStandIn"))
+		: IAccelByteCloudChunkStore::CreateCloudStorageStore(Settings.ListingCacheSeconds);
+}
+
+void FAccelByteCloudSave::UploadFile(FString const& SlotName, FString const& FilePath, FOnComplete&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+	TSharedRef<FTransfer> Transfer = MakeShared<FTransfer>();
+	Transfer->Store = Store;
+	Transfer->SlotName = SlotName;
+	Transfer->FilePath = FilePath;
+	Transfer->AverageChunkSize = Settings.AverageChunkSize;
+	Transfer->MaxConcurrency = Settings.MaxConcurrency;
+	Transfer->bUpload = true;
+	Transfer->OnComplete = MoveTemp(OnComplete);
+
+	Async(EAsyncExecution::ThreadPool, [Transfer]()
+	{
+		ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+		const bool bChunked = ChunkFile(Transfer->FilePath, Transfer->AverageChunkSize, Transfer->Manifest);
+		AsyncTask(ENamedThreads::GameThread, [Transfer, bChunked]()
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+			if (!bChunked)
+			{
+				Transfer->Fail(FString::Printf(TEXT("Cannot read %s"), *Transfer->FilePath));
+				Transfer->Complete();
+				return;
+			}
+
+			Transfer->Store->List([Transfer](TArray<FString> const& Keys, FString const& ErrorMessage)
+			{
+				if (!ErrorMessage.IsEmpty())
+				{
+					Transfer->Fail(ErrorMessage);
+					Transfer->Complete();
+					return;
+				}
+				UploadMissingChunks(Transfer, Keys);
+			});
+		});
+	});
+}
+
+void FAccelByteCloudSave::UploadBytes(FString const& SlotName, TArray<uint8> const& Payload, FOnComplete&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+	const FString StagingPath = FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("CloudSave") / SlotName + TEXT(".upload");
+	if (!FFileHelper::SaveArrayToFile(Payload, *StagingPath))
+	{
+		FAccelByteCloudSaveResult Result;
+		Result.ErrorMessage = FString::Printf(TEXT("Cannot stage the payload at %s"), *StagingPath);
+		OnComplete(Result);
+		return;
+	}
+	// The chunks are read from the staged file until the upload ends, whatever its outcome
+	UploadFile(SlotName, StagingPath, [StagingPath, OnComplete = MoveTemp(OnComplete)](FAccelByteCloudSaveResult const& Result)
+	{
+		IFileManager::Get().Delete(*StagingPath, false, false, true);
+		OnComplete(Result);
+	});
+}
+
+void FAccelByteCloudSave::DownloadFile(FString const& SlotName, FString const& FilePath, FOnComplete&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+	TSharedRef<FTransfer> Transfer = MakeShared<FTransfer>();
+	Transfer->Store = Store;
+	Transfer->SlotName = SlotName;
+	Transfer->FilePath = FilePath;
+	Transfer->MaxConcurrency = Settings.MaxConcurrency;
+	Transfer->bUpload = false;
+	Transfer->OnComplete = MoveTemp(OnComplete);
+
+	Store->Get(GetManifestKey(SlotName), [Transfer](TArray<uint8> const& Data, FString const& ErrorMessage)
+	{
+		if (!ErrorMessage.IsEmpty() || !ParseManifest(Data, Transfer->Manifest))
+		{
+			Transfer->Fail(!ErrorMessage.IsEmpty() ? ErrorMessage : FString::Printf(TEXT("The manifest of %s is corrupted"), *Transfer->SlotName));
+			Transfer->Complete();
+			return;
+		}
+
+		Async(EAsyncExecution::ThreadPool, [Transfer]()
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+			const int32 FirstChunk = VerifyPartFile(Transfer->FilePath + TEXT(".part"), Transfer->Manifest);
+			AsyncTask(ENamedThreads::GameThread, [Transfer, FirstChunk]()
+			{
+				ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+				if (FirstChunk > 0)
+				{
+					UE_LOG(LogAccelByteSampleApp, Display, TEXT("Resuming the download of %s after %d verified chunks"), *Transfer->SlotName, FirstChunk);
+				}
+				DownloadChunks(Transfer, FirstChunk);
+			});
+		});
+	});
+}
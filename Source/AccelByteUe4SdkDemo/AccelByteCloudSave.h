@@ -0,0 +1,107 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteCloudSave.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteCloudSaveResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	bool bSuccess = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	FString ErrorMessage;
+
+	// Chunks in the slot payload
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	int32 NumChunks = 0;
+
+	// Chunks sent or received by this transfer, the rest were already there
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	int32 ChunksTransferred = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	int64 BytesTransferred = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | CloudSave")
+	int64 TotalBytes = 0;
+};
+
+/**
+ * Key value blob storage the cloud save chunks are kept in.
+ *
+ * Keys are made of the slot name and a chunk hash separated by a slash. Every callback runs on the game thread
+ * with an empty error message on success.
+ */
+class IAccelByteCloudChunkStore
+{
+public:
+	using FOnList = TFunction<void(TArray<FString> const& Keys, FString const& ErrorMessage)>;
+	using FOnGet = TFunction<void(TArray<uint8> const& Data, FString const& ErrorMessage)>;
+	using FOnDone = TFunction<void(FString const& ErrorMessage)>;
+
+	virtual ~IAccelByteCloudChunkStore() = default;
+
+	virtual void List(FOnList&& OnComplete) = 0;
+	virtual void Put(FString const& Key, TArray<uint8>&& Data, FOnDone&& OnComplete) = 0;
+	virtual void Get(FString const& Key, FOnGet&& OnComplete) = 0;
+	virtual void Delete(FString const& Key, FOnDone&& OnComplete) = 0;
+
+	// One CloudStorage slot per key, the key is kept in the slot label. The slot listing is reused by the uploads of
+	// the next ListingCacheSeconds, kept up to date with what the store itself writes and dropped on any error. Slots
+	// another device changes in that window are missed until it expires.
+	static TSharedRef<IAccelByteCloudChunkStore> CreateCloudStorageStore(float ListingCacheSeconds = 0.0f);
+
+	// One file per key in Directory, answered after LatencySeconds, stands in for the backend in benchmarks and offline runs
+	static TSharedRef<IAccelByteCloudChunkStore> CreateLocalStore(FString const& Directory, float LatencySeconds = 0.0f);
+};
+
+/**
+ * Cloud save slots stored as content addressed chunks, so a save only uploads what changed.
+ *
+ * Payloads are split with a content defined chunker, an insertion only changes the chunks around it instead of
+ * shifting every fixed size block after it. Each chunk is stored under its SHA1 and a small manifest lists the
+ * chunks of the slot. An upload sends the chunks the store does not have yet, then the manifest, then deletes
+ * the chunks no longer referenced. An interrupted upload resumes for free since its finished chunks are found in
+ * the store. Downloads are written chunk by chunk to <File>.part, each chunk checked against its hash, and only
+ * renamed to the file once complete. A retry keeps the verified prefix of the part file.
+ *
+ * Slot names end up in store keys and file names, keep them to letters, digits, dashes and underscores.
+ */
+class FAccelByteCloudSave
+{
+public:
+	struct FSettings
+	{
+		int32 AverageChunkSize = 256 * 1024;
+		int32 MaxConcurrency = 4;
+		bool bLocalStore = false;
+		float ListingCacheSeconds = 300.0f;
+	};
+
+	using FOnComplete = TFunction<void(FAccelByteCloudSaveResult const& Result)>;
+
+	static FAccelByteCloudSave& Get();
+
+	explicit FAccelByteCloudSave(TSharedRef<IAccelByteCloudChunkStore> const& InStore);
+
+	void Configure(FSettings const& InSettings);
+
+	// The file must not change until OnComplete
+	void UploadFile(FString const& SlotName, FString const& FilePath, FOnComplete&& OnComplete);
+
+	// Stages the payload under Saved/AccelByte/CloudSave and uploads it from there, the staged file is deleted once done
+	void UploadBytes(FString const& SlotName, TArray<uint8> const& Payload, FOnComplete&& OnComplete);
+
+	void DownloadFile(FString const& SlotName, FString const& FilePath, FOnComplete&& OnComplete);
+
+private:
+	TSharedRef<IAccelByteCloudChunkStore> Store;
+	FSettings Settings;
+};
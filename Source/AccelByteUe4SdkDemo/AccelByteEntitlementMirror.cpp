@@ -0,0 +1,393 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteEntitlementMirror.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteSessionWarmup.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "HAL/PlatformTime.h"
+
+#include "Core/AccelByteError.h"
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteWalletApi.h"
+#include "Api/AccelByteEntitlementApi.h"
+
+using namespace AccelByte;
+
+namespace AccelByteEntitlementMirror
+{
+	static bool IsStageReady(FAccelByteSessionSnapshot const& Snapshot, EAccelByteWarmupStage Stage)
+	{
+		return Snapshot.StageTimings.ContainsByPredicate([Stage](FAccelByteWarmupStageTiming const& Timing)
+		{
+			return Timing.Stage == Stage && Timing.bSuccess;
+		});
+	}
+
+	static void AddCount(TMap<FString, int32>& Counts, FString const& Key, int32 Direction)
+	{
+		if (Key.IsEmpty())
+		{
+			return;
+		}
+
+		int32& Count = Counts.FindOrAdd(Key);
+		Count += Direction;
+		if (Count <= 0)
+		{
+			Counts.Remove(Key);
+		}
+	}
+}
+
+using namespace AccelByteEntitlementMirror;
+
+FAccelByteEntitlementMirror& FAccelByteEntitlementMirror::Get()
+{
+	static FAccelByteEntitlementMirror Instance;
+	return Instance;
+}
+
+void FAccelByteEntitlementMirror::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.PageSize = FMath::Max(1, Settings.PageSize);
+	Settings.FullRefreshSeconds = FMath::Max(0.0f, Settings.FullRefreshSeconds);
+	Settings.WalletCurrencyCodes.RemoveAll([](FString const& CurrencyCode) { return CurrencyCode.IsEmpty(); });
+}
+
+void FAccelByteEntitlementMirror::Reset()
+{
+	Generation++;
+	Entitlements.Reset();
+	OwnedItemIds.Reset();
+	OwnedSkus.Reset();
+	Wallets.Reset();
+	bComplete = false;
+
+	bRefreshing = false;
+	SeenIds.Reset();
+	WalletCodes.Reset();
+	PendingDelta = FAccelByteEntitlementDelta();
+	bFollowUp = false;
+	bFollowUpFull = false;
+
+	// Whoever waits on a refresh of the previous user still gets an answer
+	TArray<FOnRefreshed> Dropped = MoveTemp(RunningHandlers);
+	Dropped.Append(MoveTemp(FollowUpHandlers));
+	RunningHandlers.Reset();
+	FollowUpHandlers.Reset();
+	for (FOnRefreshed const& OnRefreshed : Dropped)
+	{
+		OnRefreshed(static_cast<int32>(ErrorCodes::UnknownError), TEXT("entitlement-mirror-reset"));
+	}
+}
+
+void FAccelByteEntitlementMirror::Seed(FAccelByteSessionSnapshot const& Snapshot)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	FAccelByteEntitlementDelta Delta;
+	if (IsStageReady(Snapshot, EAccelByteWarmupStage::Wallet) && SetWallet(Snapshot.Wallet))
+	{
+		Delta.Wallets.Add(Snapshot.Wallet);
+	}
+	if (Delta.Wallets.Num() > 0)
+	{
+		ChangedEvent.Broadcast(Delta);
+	}
+
+	if (IsStageReady(Snapshot, EAccelByteWarmupStage::Entitlements))
+	{
+		ApplyEntitlements(Snapshot.Entitlements.Data, Snapshot.Entitlements.Paging.Next.IsEmpty());
+	}
+}
+
+void FAccelByteEntitlementMirror::ApplyEntitlements(TArray<FAccelByteModelsEntitlementInfo> const& Listing, bool bInComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	FAccelByteEntitlementDelta Delta;
+	TSet<FString> ListedIds;
+	for (FAccelByteModelsEntitlementInfo const& Entitlement : Listing)
+	{
+		ListedIds.Add(Entitlement.Id);
+		if (Upsert(Entitlement))
+		{
+			Delta.Changed.Add(Entitlement);
+		}
+	}
+
+	if (bInComplete)
+	{
+		for (TPair<FString, FAccelByteModelsEntitlementInfo> const& Pair : Entitlements)
+		{
+			if (!ListedIds.Contains(Pair.Key))
+			{
+				Delta.RemovedIds.Add(Pair.Key);
+			}
+		}
+		for (FString const& EntitlementId : Delta.RemovedIds)
+		{
+			Remove(EntitlementId);
+		}
+		bComplete = true;
+		LastCompleteTime = FPlatformTime::Seconds();
+	}
+
+	Stats.EntitlementsChanged += Delta.Changed.Num() + Delta.RemovedIds.Num();
+	if (!Delta.IsEmpty())
+	{
+		ChangedEvent.Broadcast(Delta);
+	}
+}
+
+void FAccelByteEntitlementMirror::Refresh(bool bFull, FOnRefreshed&& OnRefreshed)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	if (bRefreshing)
+	{
+		Stats.Coalesced++;
+		bFollowUp = true;
+		bFollowUpFull |= bFull;
+		if (OnRefreshed)
+		{
+			FollowUpHandlers.Add(MoveTemp(OnRefreshed));
+		}
+		return;
+	}
+
+	bRefreshing = true;
+	const bool bFullDue = Settings.FullRefreshSeconds > 0.0f && FPlatformTime::Seconds() - LastCompleteTime >= Settings.FullRefreshSeconds;
+	bRefreshFull = bFull || !bComplete || bFullDue;
+	if (bRefreshFull)
+	{
+		Stats.FullRefreshes++;
+	}
+	else
+	{
+		Stats.DeltaRefreshes++;
+	}
+	SeenIds.Reset();
+	PendingDelta = FAccelByteEntitlementDelta();
+	if (OnRefreshed)
+	{
+		RunningHandlers.Add(MoveTemp(OnRefreshed));
+	}
+
+	WalletCodes = Settings.WalletCurrencyCodes;
+	for (TPair<FString, FAccelByteModelsWalletInfo> const& Pair : Wallets)
+	{
+		WalletCodes.AddUnique(Pair.Key);
+	}
+
+	FetchPage(Generation, 0);
+}
+
+TArray<FAccelByteModelsEntitlementInfo> FAccelByteEntitlementMirror::GetEntitlements() const
+{
+	TArray<FAccelByteModelsEntitlementInfo> Result;
+	Entitlements.GenerateValueArray(Result);
+	return Result;
+}
+
+FAccelByteEntitlementMirrorStats FAccelByteEntitlementMirror::GetStats() const
+{
+	FAccelByteEntitlementMirrorStats Result = Stats;
+	Result.Entitlements = Entitlements.Num();
+	return Result;
+}
+
+void FAccelByteEntitlementMirror::FetchPage(int32 InGeneration, int32 Offset)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	const FErrorHandler OnError = FErrorHandler::CreateLambda([this, InGeneration](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		FinishRefresh(InGeneration, ErrorCode, ErrorMessage);
+	});
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::QueryUserEntitlements);
+	FRegistry::Entitlement.QueryUserEntitlements(TEXT(""), TEXT(""), Offset, Settings.PageSize, FAccelByteTelemetry::WrapSuccess(Telemetry, THandler<FAccelByteModelsEntitlementPagingSlicedResult>::CreateLambda([this, InGeneration, Offset](FAccelByteModelsEntitlementPagingSlicedResult const& Result)
+	{
+		if (InGeneration != Generation)
+		{
+			return;
+		}
+
+		Stats.PagesFetched++;
+		Stats.EntitlementsFetched += Result.Data.Num();
+		int32 ChangedInPage = 0;
+		for (FAccelByteModelsEntitlementInfo const& Entitlement : Result.Data)
+		{
+			SeenIds.Add(Entitlement.Id);
+			if (Upsert(Entitlement))
+			{
+				PendingDelta.Changed.Add(Entitlement);
+				ChangedInPage++;
+			}
+		}
+
+		// Newest first, a delta is done at the first page the mirror already had in full
+		const bool bLastPage = Result.Paging.Next.IsEmpty() || Result.Data.Num() < Settings.PageSize;
+		if (!bLastPage && (bRefreshFull || ChangedInPage > 0))
+		{
+			FetchPage(InGeneration, Offset + Result.Data.Num());
+			return;
+		}
+
+		if (bRefreshFull)
+		{
+			for (TPair<FString, FAccelByteModelsEntitlementInfo> const& Pair : Entitlements)
+			{
+				if (!SeenIds.Contains(Pair.Key))
+				{
+					PendingDelta.RemovedIds.Add(Pair.Key);
+				}
+			}
+			for (FString const& EntitlementId : PendingDelta.RemovedIds)
+			{
+				Remove(EntitlementId);
+			}
+			bComplete = true;
+			LastCompleteTime = FPlatformTime::Seconds();
+		}
+		FetchWallets(InGeneration, 0);
+	})), FAccelByteTelemetry::WrapError(Telemetry, OnError), EAccelByteEntitlementClass::NONE, EAccelByteAppType::NONE);
+}
+
+void FAccelByteEntitlementMirror::FetchWallets(int32 InGeneration, int32 Index)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	if (!WalletCodes.IsValidIndex(Index))
+	{
+		FinishRefresh(InGeneration, 0, FString());
+		return;
+	}
+
+	Stats.WalletQueries++;
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::GetWalletInfo);
+	FRegistry::Wallet.GetWalletInfoByCurrencyCode(WalletCodes[Index], FAccelByteTelemetry::WrapSuccess(Telemetry, THandler<FAccelByteModelsWalletInfo>::CreateLambda([this, InGeneration, Index](FAccelByteModelsWalletInfo const& Result)
+	{
+		if (InGeneration != Generation)
+		{
+			return;
+		}
+
+		if (SetWallet(Result))
+		{
+			PendingDelta.Wallets.Add(Result);
+		}
+		FetchWallets(InGeneration, Index + 1);
+	})), FAccelByteTelemetry::WrapError(Telemetry, FErrorHandler::CreateLambda([this, InGeneration](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		FinishRefresh(InGeneration, ErrorCode, ErrorMessage);
+	})));
+}
+
+void FAccelByteEntitlementMirror::FinishRefresh(int32 InGeneration, int32 ErrorCode, FString const& ErrorMessage)
+{
+	if (InGeneration != Generation || !bRefreshing)
+	{
+		return;
+	}
+
+	if (ErrorCode != 0)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("AccelByte entitlement mirror refresh failed! code: %d - message: %s"), ErrorCode, *ErrorMessage);
+	}
+
+	// What was applied before a failure stays applied, it is reported like a successful refresh
+	bRefreshing = false;
+	const FAccelByteEntitlementDelta Delta = MoveTemp(PendingDelta);
+	PendingDelta = FAccelByteEntitlementDelta();
+	const TArray<FOnRefreshed> Handlers = MoveTemp(RunningHandlers);
+	RunningHandlers.Reset();
+
+	Stats.EntitlementsChanged += Delta.Changed.Num() + Delta.RemovedIds.Num();
+	if (!Delta.IsEmpty())
+	{
+		ChangedEvent.Broadcast(Delta);
+	}
+	for (FOnRefreshed const& OnRefreshed : Handlers)
+	{
+		OnRefreshed(ErrorCode, ErrorMessage);
+	}
+
+	// The handlers may have started a refresh already, it takes the follow-up handlers with it
+	if (bFollowUp && !bRefreshing)
+	{
+		const bool bFull = bFollowUpFull;
+		bFollowUp = false;
+		bFollowUpFull = false;
+		RunningHandlers = MoveTemp(FollowUpHandlers);
+		FollowUpHandlers.Reset();
+		Refresh(bFull);
+	}
+}
+
+bool FAccelByteEntitlementMirror::Upsert(FAccelByteModelsEntitlementInfo const& Entitlement)
+{
+	FAccelByteModelsEntitlementInfo* Existing = Entitlements.Find(Entitlement.Id);
+	if (Existing != nullptr
+		&& Existing->UpdatedAt == Entitlement.UpdatedAt
+		&& Existing->Status == Entitlement.Status
+		&& Existing->UseCount == Entitlement.UseCount
+		&& Existing->Quantity == Entitlement.Quantity)
+	{
+		return false;
+	}
+
+	if (Existing != nullptr)
+	{
+		UpdateOwnership(*Existing, -1);
+		*Existing = Entitlement;
+	}
+	else
+	{
+		Entitlements.Add(Entitlement.Id, Entitlement);
+	}
+	UpdateOwnership(Entitlement, 1);
+	return true;
+}
+
+void FAccelByteEntitlementMirror::Remove(FString const& EntitlementId)
+{
+	FAccelByteModelsEntitlementInfo Removed;
+	if (Entitlements.RemoveAndCopyValue(EntitlementId, Removed))
+	{
+		UpdateOwnership(Removed, -1);
+	}
+}
+
+bool FAccelByteEntitlementMirror::SetWallet(FAccelByteModelsWalletInfo const& Wallet)
+{
+	if (Wallet.CurrencyCode.IsEmpty())
+	{
+		return false;
+	}
+
+	FAccelByteModelsWalletInfo* Existing = Wallets.Find(Wallet.CurrencyCode);
+	if (Existing != nullptr && Existing->Balance == Wallet.Balance && Existing->Status == Wallet.Status)
+	{
+		return false;
+	}
+	Wallets.Add(Wallet.CurrencyCode, Wallet);
+	return true;
+}
+
+void FAccelByteEntitlementMirror::UpdateOwnership(FAccelByteModelsEntitlementInfo const& Entitlement, int32 Direction)
+{
+	if (!IsActive(Entitlement))
+	{
+		return;
+	}
+
+	AddCount(OwnedItemIds, Entitlement.ItemId, Direction);
+	AddCount(OwnedSkus, Entitlement.Sku, Direction);
+}
+
+bool FAccelByteEntitlementMirror::IsActive(FAccelByteModelsEntitlementInfo const& Entitlement)
+{
+	return Entitlement.Status == EAccelByteEntitlementStatus::ACTIVE;
+}
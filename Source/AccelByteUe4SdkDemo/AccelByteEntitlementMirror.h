@@ -0,0 +1,170 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteEntitlementMirror.generated.h"
+
+struct FAccelByteSessionSnapshot;
+
+/** What a refresh changed in the mirror. */
+USTRUCT(BlueprintType)
+struct FAccelByteEntitlementDelta
+{
+	GENERATED_BODY()
+
+	// Added or updated entitlements, after the change
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	TArray<FAccelByteModelsEntitlementInfo> Changed;
+
+	// Only a full refresh can tell that an entitlement is gone
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	TArray<FString> RemovedIds;
+
+	// Wallets whose balance or status changed
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	TArray<FAccelByteModelsWalletInfo> Wallets;
+
+	bool IsEmpty() const { return Changed.Num() == 0 && RemovedIds.Num() == 0 && Wallets.Num() == 0; }
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteEntitlementMirrorStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 FullRefreshes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 DeltaRefreshes = 0;
+
+	// Refresh requests merged into the one running
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 Coalesced = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 PagesFetched = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 EntitlementsFetched = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 EntitlementsChanged = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 WalletQueries = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Entitlements")
+	int32 Entitlements = 0;
+};
+
+/**
+ * Entitlements and wallets of the logged in user, mirrored locally so purchases do not reload the full lists.
+ *
+ * The mirror is seeded from the post login warm-up. After a purchase sync a delta refresh fetches entitlement
+ * pages and stops at the first page that holds nothing the mirror does not already have; only the changed rows are
+ * applied and broadcast. A full refresh pages through everything and also reports the entitlements that are gone.
+ * Refreshes requested while one is running are merged into a single follow-up. Ownership checks are answered from
+ * sets of the item ids and SKUs of the active entitlements. Only meant to be used from the game thread.
+ *
+ * The entitlement query takes no sort order, a delta relies on the service listing the newest entitlements first.
+ * It only finds grants: an entitlement consumed, revoked or changed on a later page is missed. Call Refresh(true)
+ * after consuming or revoking, and a delta refresh is made a full one once FullRefreshSeconds have passed since the
+ * last full listing, which bounds how long the mirror can be out of date.
+ */
+class FAccelByteEntitlementMirror
+{
+public:
+	struct FSettings
+	{
+		int32 PageSize = 50;
+		// A delta refresh requested this long after the last full listing is made a full one, zero never promotes it
+		float FullRefreshSeconds = 600.0f;
+		// Wallets refreshed with the entitlements, wallets seeded by the warm-up are refreshed too
+		TArray<FString> WalletCurrencyCodes;
+	};
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnChanged, FAccelByteEntitlementDelta const& /*Delta*/);
+
+	// ErrorCode is zero on success
+	using FOnRefreshed = TFunction<void(int32 ErrorCode, FString const& ErrorMessage)>;
+
+	static FAccelByteEntitlementMirror& Get();
+
+	void Configure(FSettings const& InSettings);
+
+	// Drops everything without reporting it as removed, used when another user logs in
+	void Reset();
+
+	// Applies the wallet and entitlements the warm-up fetched, a partial entitlement page is applied as a delta
+	void Seed(FAccelByteSessionSnapshot const& Snapshot);
+
+	// Applies a listing fetched elsewhere, bInComplete means the listing holds every entitlement of the user
+	void ApplyEntitlements(TArray<FAccelByteModelsEntitlementInfo> const& Listing, bool bInComplete);
+
+	// A delta refresh becomes a full one until the mirror has been complete once, and when the last full listing is
+	// older than FullRefreshSeconds. A delta only picks up new grants, see the class comment
+	void Refresh(bool bFull, FOnRefreshed&& OnRefreshed = nullptr);
+
+	bool IsItemOwned(FString const& ItemId) const { return OwnedItemIds.Contains(ItemId); }
+	bool IsSkuOwned(FString const& Sku) const { return OwnedSkus.Contains(Sku); }
+
+	FAccelByteModelsEntitlementInfo const* FindEntitlement(FString const& EntitlementId) const { return Entitlements.Find(EntitlementId); }
+	FAccelByteModelsWalletInfo const* FindWallet(FString const& CurrencyCode) const { return Wallets.Find(CurrencyCode); }
+
+	// Unordered
+	TArray<FAccelByteModelsEntitlementInfo> GetEntitlements() const;
+
+	bool IsComplete() const { return bComplete; }
+	bool IsRefreshing() const { return bRefreshing; }
+
+	FAccelByteEntitlementMirrorStats GetStats() const;
+
+	FOnChanged& OnChanged() { return ChangedEvent; }
+
+private:
+	void FetchPage(int32 InGeneration, int32 Offset);
+	void FetchWallets(int32 InGeneration, int32 Index);
+	void FinishRefresh(int32 InGeneration, int32 ErrorCode, FString const& ErrorMessage);
+
+	// Returns true when the entitlement is new or differs from the mirrored one
+	bool Upsert(FAccelByteModelsEntitlementInfo const& Entitlement);
+	void Remove(FString const& EntitlementId);
+	bool SetWallet(FAccelByteModelsWalletInfo const& Wallet);
+
+	void UpdateOwnership(FAccelByteModelsEntitlementInfo const& Entitlement, int32 Direction);
+	static bool IsActive(FAccelByteModelsEntitlementInfo const& Entitlement);
+
+	FSettings Settings;
+
+	TMap<FString, FAccelByteModelsEntitlementInfo> Entitlements;
+	// Active entitlements per item id and SKU, an item can be granted more than once
+	TMap<FString, int32> OwnedItemIds;
+	TMap<FString, int32> OwnedSkus;
+	TMap<FString, FAccelByteModelsWalletInfo> Wallets;
+	bool bComplete = false;
+	// When the mirror was last made complete by a full listing
+	double LastCompleteTime = 0.0;
+
+	// State of the running refresh
+	bool bRefreshing = false;
+	bool bRefreshFull = false;
+	TSet<FString> SeenIds;
+	TArray<FString> WalletCodes;
+	FAccelByteEntitlementDelta PendingDelta;
+	TArray<FOnRefreshed> RunningHandlers;
+
+	// Requested while a refresh was running
+	bool bFollowUp = false;
+	bool bFollowUpFull = false;
+	TArray<FOnRefreshed> FollowUpHandlers;
+
+	// Bumped by every Reset, responses tagged with an older generation are dropped
+	int32 Generation = 0;
+	FAccelByteEntitlementMirrorStats Stats;
+	FOnChanged ChangedEvent;
+};
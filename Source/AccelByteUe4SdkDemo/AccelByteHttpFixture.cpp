@@ -0,0 +1,1094 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteHttpFixture.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "Common/TcpListener.h"
+#include "Containers/Ticker.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HttpModule.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "IWebSocket.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Misc/Base64.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
+#include "WebSocketsModule.h"
+
+#include "Core/AccelByteRegistry.h"
+
+/**
+ * Trace layout, everything after the header is zlib compressed:
+ *   uint32 Magic, uint32 Version, int32 UncompressedSize
+ *   FString Origin, int32 NumEntries
+ *   per entry: FString Key, double OffsetSeconds, float LatencyMs, int32 ResponseCode, FString ContentType, TArray<uint8> ResponseBody
+ *   FString LobbyUrl, int32 NumLobbyConnections
+ *   per connection: int32 NumFrames
+ *   per frame: bool bFromServer, int32 ClientFramesBefore, double OffsetSeconds, float DelayMs, FString Text
+ */
+#define HTTP_FIXTURE_MAGIC 0x58464241 // "ABFX"
+#define HTTP_FIXTURE_VERSION 1
+
+namespace AccelByteHttpFixture
+{
+	// The SDK URLs that are pointed at the proxy, a recording needs all of them to share the origin of BaseUrl
+	static TArray<TPair<TCHAR const*, FString*>> GetSdkUrls()
+	{
+		return {
+			{ TEXT("BaseUrl"), &FRegistry::Settings.BaseUrl },
+			{ TEXT("IamServerUrl"), &FRegistry::Settings.IamServerUrl },
+			{ TEXT("PlatformServerUrl"), &FRegistry::Settings.PlatformServerUrl },
+			{ TEXT("BasicServerUrl"), &FRegistry::Settings.BasicServerUrl },
+			{ TEXT("CloudStorageServerUrl"), &FRegistry::Settings.CloudStorageServerUrl },
+			{ TEXT("CloudSaveServerUrl"), &FRegistry::Settings.CloudSaveServerUrl },
+			{ TEXT("StatisticServerUrl"), &FRegistry::Settings.StatisticServerUrl },
+			{ TEXT("LeaderboardServerUrl"), &FRegistry::Settings.LeaderboardServerUrl },
+			{ TEXT("AchievementServerUrl"), &FRegistry::Settings.AchievementServerUrl },
+			{ TEXT("AgreementServerUrl"), &FRegistry::Settings.AgreementServerUrl },
+		};
+	}
+
+	static FString GetOrigin(FString const& Url)
+	{
+		const int32 SchemeEnd = Url.Find(TEXT("://"));
+		if (SchemeEnd == INDEX_NONE)
+		{
+			return TEXT("");
+		}
+		const int32 PathStart = Url.Find(TEXT("/"), ESearchCase::CaseSensitive, ESearchDir::FromStart, SchemeEnd + 3);
+		return PathStart == INDEX_NONE ? Url : Url.Left(PathStart);
+	}
+
+	static TCHAR const* GetVerbName(EHttpServerRequestVerbs Verb)
+	{
+		switch (Verb)
+		{
+		case EHttpServerRequestVerbs::VERB_GET: return TEXT("GET");
+		case EHttpServerRequestVerbs::VERB_POST: return TEXT("POST");
+		case EHttpServerRequestVerbs::VERB_PUT: return TEXT("PUT");
+		case EHttpServerRequestVerbs::VERB_PATCH: return TEXT("PATCH");
+		case EHttpServerRequestVerbs::VERB_DELETE: return TEXT("DELETE");
+		case EHttpServerRequestVerbs::VERB_OPTIONS: return TEXT("OPTIONS");
+		default: return TEXT("");
+		}
+	}
+
+	// Path and query with the parameters sorted, the server hands them over as a map so the original order is lost anyway
+	static FString GetPathAndQuery(FHttpServerRequest const& Request)
+	{
+		FString PathAndQuery = Request.RelativePath.GetPath();
+		TArray<FString> Keys;
+		Request.QueryParams.GetKeys(Keys);
+		Keys.Sort();
+		for (int32 Index = 0; Index < Keys.Num(); Index++)
+		{
+			PathAndQuery += FString::Printf(TEXT("%s%s=%s")
+				, Index == 0 ? TEXT("?") : TEXT("&")
+				, *FGenericPlatformHttp::UrlEncode(Keys[Index])
+				, *FGenericPlatformHttp::UrlEncode(Request.QueryParams[Keys[Index]]));
+		}
+		return PathAndQuery;
+	}
+
+	static void Respond(FHttpResultCallback const& OnComplete, int32 ResponseCode, FString const& ContentType, TArray<uint8> const& Body)
+	{
+		TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+		Response->Code = static_cast<EHttpServerResponseCodes>(ResponseCode);
+		if (!ContentType.IsEmpty())
+		{
+			Response->Headers.Add(TEXT("content-type"), { ContentType });
+		}
+		Response->Body = Body;
+		OnComplete(MoveTemp(Response));
+	}
+
+	// RFC 6455, appended to Sec-WebSocket-Key before hashing it into Sec-WebSocket-Accept
+	static TCHAR const* const WebSocketGuid = TEXT("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+	static constexpr uint64 MaxLobbyFrameSize = 16 * 1024 * 1024;
+
+	enum class EWebSocketOpcode : uint8
+	{
+		Continuation = 0x0,
+		Text = 0x1,
+		Binary = 0x2,
+		Close = 0x8,
+		Ping = 0x9,
+		Pong = 0xA
+	};
+
+	static void AppendUtf8(TArray<uint8>& Out, FString const& Text)
+	{
+		FTCHARToUTF8 Utf8(*Text);
+		Out.Append(reinterpret_cast<uint8 const*>(Utf8.Get()), Utf8.Length());
+	}
+
+	static FString Utf8ToString(TArray<uint8> const& Utf8, int32 Num)
+	{
+		FUTF8ToTCHAR Converted(reinterpret_cast<ANSICHAR const*>(Utf8.GetData()), Num);
+		return FString(Converted.Length(), Converted.Get());
+	}
+
+	// Server frames are never masked
+	static void AppendFrame(TArray<uint8>& Out, EWebSocketOpcode Opcode, TArray<uint8> const& Payload)
+	{
+		const uint64 Length = Payload.Num();
+		Out.Add(0x80 | static_cast<uint8>(Opcode));
+		if (Length < 126)
+		{
+			Out.Add(static_cast<uint8>(Length));
+		}
+		else if (Length <= 0xFFFF)
+		{
+			Out.Add(126);
+			Out.Add(static_cast<uint8>(Length >> 8));
+			Out.Add(static_cast<uint8>(Length));
+		}
+		else
+		{
+			Out.Add(127);
+			for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+			{
+				Out.Add(static_cast<uint8>(Length >> Shift));
+			}
+		}
+		Out.Append(Payload);
+	}
+
+	// Returns the bytes the frame takes, zero while it is incomplete and INDEX_NONE when it cannot be a frame
+	static int32 ParseFrame(TArray<uint8> const& In, bool& bOutFinal, EWebSocketOpcode& OutOpcode, TArray<uint8>& OutPayload)
+	{
+		if (In.Num() < 2)
+		{
+			return 0;
+		}
+		bOutFinal = (In[0] & 0x80) != 0;
+		OutOpcode = static_cast<EWebSocketOpcode>(In[0] & 0x0F);
+		const bool bMasked = (In[1] & 0x80) != 0;
+
+		uint64 Length = In[1] & 0x7F;
+		int32 Offset = 2;
+		if (Length == 126)
+		{
+			if (In.Num() < 4)
+			{
+				return 0;
+			}
+			Length = (static_cast<uint64>(In[2]) << 8) | In[3];
+			Offset = 4;
+		}
+		else if (Length == 127)
+		{
+			if (In.Num() < 10)
+			{
+				return 0;
+			}
+			Length = 0;
+			for (int32 Index = 2; Index < 10; Index++)
+			{
+				Length = (Length << 8) | In[Index];
+			}
+			Offset = 10;
+		}
+		if (Length > MaxLobbyFrameSize)
+		{
+			return INDEX_NONE;
+		}
+
+		const int32 MaskOffset = Offset;
+		if (bMasked)
+		{
+			Offset += 4;
+		}
+		if (In.Num() < Offset + static_cast<int32>(Length))
+		{
+			return 0;
+		}
+
+		OutPayload.SetNumUninitialized(static_cast<int32>(Length));
+		for (int32 Index = 0; Index < OutPayload.Num(); Index++)
+		{
+			OutPayload[Index] = In[Offset + Index] ^ (bMasked ? In[MaskOffset + (Index & 3)] : 0);
+		}
+		return Offset + static_cast<int32>(Length);
+	}
+}
+
+// One accepted Lobby socket, and in a recording the upstream connection its frames are relayed to
+struct FAccelByteHttpFixture::FLobbyConnection
+{
+	FSocket* Socket = nullptr;
+	// Connection in LobbyTraces the frames are recorded to or replayed from
+	int32 Index = 0;
+	double UpgradeTime = 0.0;
+	bool bUpgraded = false;
+	// Nothing more is read once set, the socket goes as soon as the outbox is flushed
+	bool bClosing = false;
+	bool bClosed = false;
+	TArray<uint8> Inbox;
+	TArray<uint8> Outbox;
+	// Fragments of the client message being received
+	TArray<uint8> Message;
+	TArray<double> ClientFrameTimes;
+	// Time of the last server frame, received from upstream in a recording and sent in a replay
+	double LastServerTime = 0.0;
+	int32 NextFrame = 0;
+	TSharedPtr<IWebSocket> Upstream;
+
+	~FLobbyConnection()
+	{
+		if (Upstream.IsValid())
+		{
+			Upstream->Close();
+		}
+		if (Socket != nullptr)
+		{
+			Socket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		}
+	}
+
+	void Upgrade(FString const& Response)
+	{
+		AppendUtf8(Outbox, Response);
+		bUpgraded = true;
+		UpgradeTime = FPlatformTime::Seconds();
+	}
+
+	void Reject(TCHAR const* Status)
+	{
+		AppendUtf8(Outbox, FString::Printf(TEXT("HTTP/1.1 %s\r\nContent-Length: 0\r\nConnection: close\r\n\r\n"), Status));
+		bClosing = true;
+	}
+
+	void SendText(FString const& Text)
+	{
+		TArray<uint8> Payload;
+		AppendUtf8(Payload, Text);
+		AppendFrame(Outbox, EWebSocketOpcode::Text, Payload);
+	}
+
+	void Close()
+	{
+		if (!bClosing && bUpgraded)
+		{
+			AppendFrame(Outbox, EWebSocketOpcode::Close, {});
+		}
+		bClosing = true;
+	}
+
+	void Flush()
+	{
+		while (Outbox.Num() > 0)
+		{
+			int32 Sent = 0;
+			if (!Socket->Send(Outbox.GetData(), Outbox.Num(), Sent))
+			{
+				if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+				{
+					bClosed = true;
+				}
+				return;
+			}
+			if (Sent <= 0)
+			{
+				return;
+			}
+			Outbox.RemoveAt(0, Sent, false);
+		}
+		if (bClosing)
+		{
+			bClosed = true;
+		}
+	}
+};
+
+using namespace AccelByteHttpFixture;
+
+FAccelByteHttpFixture& FAccelByteHttpFixture::Get()
+{
+	static FAccelByteHttpFixture Instance;
+	return Instance;
+}
+
+FAccelByteHttpFixture::~FAccelByteHttpFixture() = default;
+
+bool FAccelByteHttpFixture::StartRecording(FString const& InPath, uint32 Port)
+{
+	Stop();
+
+	Origin = GetOrigin(FRegistry::Settings.BaseUrl);
+	if (Origin.IsEmpty())
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot record, BaseUrl %s has no origin"), *FRegistry::Settings.BaseUrl);
+		return false;
+	}
+
+	// Requests are forwarded to Origin, one going to another host would be recorded against the wrong service
+	for (TPair<TCHAR const*, FString*> const& Url : GetSdkUrls())
+	{
+		if (!Url.Value->IsEmpty() && GetOrigin(*Url.Value) != Origin)
+		{
+			UE_LOG(LogAccelByteSampleApp, Error, TEXT("Cannot record, %s %s is not on the origin of BaseUrl %s"), Url.Key, **Url.Value, *Origin);
+			return false;
+		}
+	}
+
+	Path = InPath;
+	LobbyUrl = FRegistry::Settings.LobbyServerUrl;
+	Mode = EMode::Record;
+	if (!Listen(Port))
+	{
+		Mode = EMode::Off;
+		return false;
+	}
+
+	// Keep what was recorded so far if the process exits without Stop
+	PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FAccelByteHttpFixture::Stop);
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Recording AccelByte HTTP traffic to %s from %s"), *Path, *Origin);
+	return true;
+}
+
+bool FAccelByteHttpFixture::StartReplay(FString const& InPath, float InSpeed, uint32 Port)
+{
+	Stop();
+
+	if (!LoadTrace(InPath))
+	{
+		return false;
+	}
+
+	Path = InPath;
+	Speed = InSpeed;
+	Mode = EMode::Replay;
+	if (!Listen(Port))
+	{
+		Mode = EMode::Off;
+		return false;
+	}
+
+	// The Lobby listener thread and sockets have to go before the socket subsystem does
+	PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FAccelByteHttpFixture::Stop);
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Replaying %d AccelByte HTTP responses recorded from %s and %d Lobby connections recorded from %s at speed %.2f")
+		, Entries.Num(), *Origin, LobbyTraces.Num(), *LobbyUrl, Speed);
+	return true;
+}
+
+void FAccelByteHttpFixture::Stop()
+{
+	if (Mode == EMode::Off)
+	{
+		return;
+	}
+
+	if (Router.IsValid())
+	{
+		Router->UnbindRoute(RouteHandle);
+		Router.Reset();
+	}
+	StopLobby();
+	RestoreSdk();
+	FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+
+	if (Mode == EMode::Record)
+	{
+		SaveTrace();
+	}
+	else if (NumMisses > 0)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Replay of %s had %d requests without a recorded response"), *Path, NumMisses);
+	}
+
+	Mode = EMode::Off;
+	Entries.Reset();
+	EntriesByKey.Reset();
+	ReplayCursors.Reset();
+	LobbyTraces.Reset();
+	NumLobbyConnections = 0;
+	NumMisses = 0;
+}
+
+bool FAccelByteHttpFixture::StartFromCommandLine(TCHAR const* CommandLine)
+{
+	uint32 Port = DefaultPort;
+	FParse::Value(CommandLine, TEXT("AccelByteFixturePort="), Port);
+
+	FString TracePath;
+	if (FParse::Value(CommandLine, TEXT("AccelByteRecord="), TracePath))
+	{
+		return StartRecording(TracePath, Port);
+	}
+	if (FParse::Value(CommandLine, TEXT("AccelByteReplay="), TracePath))
+	{
+		float ReplaySpeed = 1.0f;
+		FParse::Value(CommandLine, TEXT("AccelByteReplaySpeed="), ReplaySpeed);
+		return StartReplay(TracePath, ReplaySpeed, Port);
+	}
+	return false;
+}
+
+bool FAccelByteHttpFixture::Listen(uint32 Port)
+{
+	Router = FHttpServerModule::Get().GetHttpRouter(Port);
+	if (!Router.IsValid())
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot listen on port %u for the HTTP fixture"), Port);
+		return false;
+	}
+	if (!ListenLobby(Port + LobbyPortOffset))
+	{
+		Router.Reset();
+		return false;
+	}
+
+	const EHttpServerRequestVerbs AllVerbs = EHttpServerRequestVerbs::VERB_GET | EHttpServerRequestVerbs::VERB_POST | EHttpServerRequestVerbs::VERB_PUT
+		| EHttpServerRequestVerbs::VERB_PATCH | EHttpServerRequestVerbs::VERB_DELETE | EHttpServerRequestVerbs::VERB_OPTIONS;
+
+	// The router falls back to parent paths, so the root route sees every request
+	RouteHandle = Router->BindRoute(FHttpPath(TEXT("/")), AllVerbs, [this](FHttpServerRequest const& Request, FHttpResultCallback const& OnComplete)
+	{
+		const FString PathAndQuery = GetPathAndQuery(Request);
+		const FString Key = FString::Printf(TEXT("%s %s"), GetVerbName(Request.Verb), *PathAndQuery);
+
+		if (Mode == EMode::Replay)
+		{
+			TArray<int32> const* Candidates = EntriesByKey.Find(Key);
+			if (Candidates == nullptr)
+			{
+				NumMisses++;
+				UE_LOG(LogAccelByteSampleApp, Warning, TEXT("No recorded response for %s"), *Key);
+				const FString Error = FString::Printf(TEXT("{\"errorCode\":404,\"errorMessage\":\"No recorded response for %s\"}"), *Key.ReplaceCharWithEscapedChar());
+				FTCHARToUTF8 Utf8Error(*Error);
+				Respond(OnComplete, 404, TEXT("application/json"), TArray<uint8>(reinterpret_cast<uint8 const*>(Utf8Error.Get()), Utf8Error.Length()));
+				return true;
+			}
+
+			int32& Cursor = ReplayCursors.FindOrAdd(Key);
+			FEntry const& Entry = Entries[(*Candidates)[FMath::Min(Cursor, Candidates->Num() - 1)]];
+			Cursor++;
+
+			if (Speed <= 0.0f)
+			{
+				Respond(OnComplete, Entry.ResponseCode, Entry.ContentType, Entry.ResponseBody);
+				return true;
+			}
+
+			// Entries live until Stop, which also drops the route, copy what the delayed response needs
+			const int32 ResponseCode = Entry.ResponseCode;
+			const FString ContentType = Entry.ContentType;
+			const TArray<uint8> ResponseBody = Entry.ResponseBody;
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([OnComplete, ResponseCode, ContentType, ResponseBody](float)
+			{
+				Respond(OnComplete, ResponseCode, ContentType, ResponseBody);
+				return false;
+			}), Entry.LatencyMs / 1000.0f / Speed);
+			return true;
+		}
+
+		auto Upstream = FHttpModule::Get().CreateRequest();
+		Upstream->SetURL(Origin + PathAndQuery);
+		Upstream->SetVerb(GetVerbName(Request.Verb));
+		for (TPair<FString, TArray<FString>> const& Header : Request.Headers)
+		{
+			if (!Header.Key.Equals(TEXT("host"), ESearchCase::IgnoreCase) && !Header.Key.Equals(TEXT("content-length"), ESearchCase::IgnoreCase))
+			{
+				Upstream->SetHeader(Header.Key, FString::Join(Header.Value, TEXT(", ")));
+			}
+		}
+		Upstream->SetContent(Request.Body);
+
+		const double SentTime = FPlatformTime::Seconds();
+		Upstream->OnProcessRequestComplete().BindLambda([this, Key, SentTime, OnComplete](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+		{
+			FEntry Entry;
+			Entry.Key = Key;
+			Entry.OffsetSeconds = SentTime - StartTime;
+			Entry.LatencyMs = static_cast<float>((FPlatformTime::Seconds() - SentTime) * 1000.0);
+			if (bSucceeded && Response.IsValid())
+			{
+				Entry.ResponseCode = Response->GetResponseCode();
+				Entry.ContentType = Response->GetContentType();
+				Entry.ResponseBody = Response->GetContent();
+			}
+			else
+			{
+				// Recorded as is so replay fails the same way
+				Entry.ResponseCode = 502;
+			}
+
+			Respond(OnComplete, Entry.ResponseCode, Entry.ContentType, Entry.ResponseBody);
+			if (Mode == EMode::Record)
+			{
+				EntriesByKey.FindOrAdd(Entry.Key).Add(Entries.Num());
+				Entries.Add(MoveTemp(Entry));
+			}
+		});
+		Upstream->ProcessRequest();
+		return true;
+	});
+
+	FHttpServerModule::Get().StartAllListeners();
+	StartTime = FPlatformTime::Seconds();
+	RedirectSdk(Port);
+	return true;
+}
+
+void FAccelByteHttpFixture::RedirectSdk(uint32 Port)
+{
+	// Every service is redirected whatever origin it is configured with, a replay must never reach the network. A
+	// path that differs from the recorded one only misses the trace.
+	const FString ProxyOrigin = FString::Printf(TEXT("http://127.0.0.1:%u"), Port);
+	for (TPair<TCHAR const*, FString*> const& Url : GetSdkUrls())
+	{
+		SavedUrls.Add(Url.Key, *Url.Value);
+		const FString UrlOrigin = GetOrigin(*Url.Value);
+		if (!UrlOrigin.IsEmpty())
+		{
+			*Url.Value = ProxyOrigin + Url.Value->RightChop(UrlOrigin.Len());
+		}
+		else if (!Url.Value->IsEmpty())
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("%s %s is not an absolute URL, it is left as is"), Url.Key, **Url.Value);
+		}
+	}
+
+	FString& LobbyServerUrl = FRegistry::Settings.LobbyServerUrl;
+	SavedUrls.Add(TEXT("LobbyServerUrl"), LobbyServerUrl);
+	LobbyServerUrl = FString::Printf(TEXT("ws://127.0.0.1:%u"), Port + LobbyPortOffset) + LobbyServerUrl.RightChop(GetOrigin(LobbyServerUrl).Len());
+}
+
+void FAccelByteHttpFixture::RestoreSdk()
+{
+	for (TPair<TCHAR const*, FString*> const& Url : GetSdkUrls())
+	{
+		if (FString const* SavedUrl = SavedUrls.Find(Url.Key))
+		{
+			*Url.Value = *SavedUrl;
+		}
+	}
+	if (FString const* SavedUrl = SavedUrls.Find(TEXT("LobbyServerUrl")))
+	{
+		FRegistry::Settings.LobbyServerUrl = *SavedUrl;
+	}
+	SavedUrls.Reset();
+}
+
+bool FAccelByteHttpFixture::ListenLobby(uint32 Port)
+{
+	LobbyListener = MakeUnique<FTcpListener>(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port), FTimespan::FromMilliseconds(100), false);
+	if (LobbyListener->GetSocket() == nullptr)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot listen on port %u for the Lobby fixture"), Port);
+		LobbyListener.Reset();
+		return false;
+	}
+	LobbyListener->OnConnectionAccepted().BindRaw(this, &FAccelByteHttpFixture::OnLobbySocketAccepted);
+	LobbyTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAccelByteHttpFixture::TickLobby));
+	return true;
+}
+
+void FAccelByteHttpFixture::StopLobby()
+{
+	// Joins the listener thread, nothing is queued past this point
+	LobbyListener.Reset();
+	FSocket* Socket = nullptr;
+	while (AcceptedLobbySockets.Dequeue(Socket))
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+	}
+	LobbyConnections.Reset();
+	FTicker::GetCoreTicker().RemoveTicker(LobbyTickerHandle);
+	LobbyTickerHandle.Reset();
+}
+
+bool FAccelByteHttpFixture::OnLobbySocketAccepted(FSocket* Socket, FIPv4Endpoint const& Endpoint)
+{
+	AcceptedLobbySockets.Enqueue(Socket);
+	return true;
+}
+
+bool FAccelByteHttpFixture::TickLobby(float DeltaTime)
+{
+	FSocket* Socket = nullptr;
+	while (AcceptedLobbySockets.Dequeue(Socket))
+	{
+		Socket->SetNonBlocking(true);
+		TSharedRef<FLobbyConnection> Connection = MakeShared<FLobbyConnection>();
+		Connection->Socket = Socket;
+		LobbyConnections.Add(Connection);
+	}
+
+	for (TSharedRef<FLobbyConnection> const& Connection : LobbyConnections)
+	{
+		ReceiveLobbyFrames(Connection);
+		if (Mode == EMode::Replay && Connection->bUpgraded && !Connection->bClosing)
+		{
+			ReplayLobbyFrames(Connection);
+		}
+		if (!Connection->bClosed)
+		{
+			Connection->Flush();
+		}
+	}
+	LobbyConnections.RemoveAll([](TSharedRef<FLobbyConnection> const& Connection) { return Connection->bClosed; });
+	return true;
+}
+
+void FAccelByteHttpFixture::ReceiveLobbyFrames(TSharedRef<FLobbyConnection> const& Connection)
+{
+	// Recv fails once the client has gone and succeeds with nothing read while no data is pending
+	uint8 Buffer[16 * 1024];
+	int32 Read = 0;
+	while (!Connection->bClosed)
+	{
+		if (!Connection->Socket->Recv(Buffer, sizeof(Buffer), Read))
+		{
+			Connection->bClosed = true;
+		}
+		else if (Read <= 0)
+		{
+			break;
+		}
+		else
+		{
+			Connection->Inbox.Append(Buffer, Read);
+		}
+	}
+	if (Connection->bClosed || Connection->bClosing)
+	{
+		return;
+	}
+
+	if (!Connection->bUpgraded)
+	{
+		// A recording answers the upgrade once upstream has accepted it
+		if (Connection->Upstream.IsValid())
+		{
+			return;
+		}
+
+		int32 HeaderEnd = INDEX_NONE;
+		for (int32 Index = 0; Index + 3 < Connection->Inbox.Num(); Index++)
+		{
+			if (FMemory::Memcmp(Connection->Inbox.GetData() + Index, "\r\n\r\n", 4) == 0)
+			{
+				HeaderEnd = Index;
+				break;
+			}
+		}
+		if (HeaderEnd == INDEX_NONE)
+		{
+			if (Connection->Inbox.Num() > 64 * 1024)
+			{
+				Connection->Reject(TEXT("431 Request Header Fields Too Large"));
+			}
+			return;
+		}
+
+		TArray<FString> Lines;
+		Utf8ToString(Connection->Inbox, HeaderEnd).ParseIntoArrayLines(Lines);
+		Connection->Inbox.RemoveAt(0, HeaderEnd + 4, false);
+
+		TArray<FString> RequestLine;
+		if (Lines.Num() > 0)
+		{
+			Lines[0].ParseIntoArrayWS(RequestLine);
+		}
+		if (RequestLine.Num() < 2 || RequestLine[0] != TEXT("GET"))
+		{
+			Connection->Reject(TEXT("400 Bad Request"));
+			return;
+		}
+
+		TMap<FString, FString> Headers;
+		for (int32 Index = 1; Index < Lines.Num(); Index++)
+		{
+			FString Name;
+			FString Value;
+			if (Lines[Index].Split(TEXT(":"), &Name, &Value))
+			{
+				Headers.Add(Name.TrimStartAndEnd().ToLower(), Value.TrimStartAndEnd());
+			}
+		}
+		OnLobbyHandshake(Connection, RequestLine[1], Headers);
+		return;
+	}
+
+	bool bFinal = false;
+	EWebSocketOpcode Opcode = EWebSocketOpcode::Text;
+	TArray<uint8> Payload;
+	while (!Connection->bClosing)
+	{
+		const int32 FrameSize = ParseFrame(Connection->Inbox, bFinal, Opcode, Payload);
+		if (FrameSize == 0)
+		{
+			break;
+		}
+		if (FrameSize == INDEX_NONE)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Dropping a Lobby fixture connection that sent a frame over %llu bytes"), MaxLobbyFrameSize);
+			Connection->bClosed = true;
+			return;
+		}
+		Connection->Inbox.RemoveAt(0, FrameSize, false);
+
+		switch (Opcode)
+		{
+		case EWebSocketOpcode::Ping:
+			AppendFrame(Connection->Outbox, EWebSocketOpcode::Pong, Payload);
+			break;
+		case EWebSocketOpcode::Pong:
+			break;
+		case EWebSocketOpcode::Close:
+			Connection->Close();
+			break;
+		default:
+			// The Lobby only speaks text, a binary message is kept as text as well
+			Connection->Message.Append(Payload);
+			if (bFinal)
+			{
+				const FString Text = Utf8ToString(Connection->Message, Connection->Message.Num());
+				Connection->Message.Reset();
+				OnLobbyClientText(Connection, Text);
+			}
+			break;
+		}
+	}
+}
+
+void FAccelByteHttpFixture::OnLobbyHandshake(TSharedRef<FLobbyConnection> const& Connection, FString const& RequestPath, TMap<FString, FString> const& Headers)
+{
+	FString const* Key = Headers.Find(TEXT("sec-websocket-key"));
+	FString const* Upgrade = Headers.Find(TEXT("upgrade"));
+	if (Key == nullptr || Upgrade == nullptr || !Upgrade->Equals(TEXT("websocket"), ESearchCase::IgnoreCase))
+	{
+		Connection->Reject(TEXT("400 Bad Request"));
+		return;
+	}
+
+	// The first protocol the client offers is the one upstream is asked for and the one agreed on
+	FString Protocol;
+	if (FString const* Protocols = Headers.Find(TEXT("sec-websocket-protocol")))
+	{
+		if (!Protocols->Split(TEXT(","), &Protocol, nullptr))
+		{
+			Protocol = *Protocols;
+		}
+		Protocol.TrimStartAndEndInline();
+	}
+
+	FTCHARToUTF8 AcceptSource(*(*Key + WebSocketGuid));
+	uint8 AcceptHash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(AcceptSource.Get(), AcceptSource.Length(), AcceptHash);
+	FString Response = FString::Printf(TEXT("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n")
+		, *FBase64::Encode(AcceptHash, FSHA1::DigestSize));
+	if (!Protocol.IsEmpty())
+	{
+		Response += FString::Printf(TEXT("Sec-WebSocket-Protocol: %s\r\n"), *Protocol);
+	}
+	Response += TEXT("\r\n");
+
+	if (Mode == EMode::Replay)
+	{
+		if (LobbyTraces.Num() == 0)
+		{
+			NumMisses++;
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("No recorded Lobby connection for %s"), *RequestPath);
+			Connection->Reject(TEXT("404 Not Found"));
+			return;
+		}
+		Connection->Index = FMath::Min(NumLobbyConnections++, LobbyTraces.Num() - 1);
+		Connection->Upgrade(Response);
+		return;
+	}
+
+	const FString LobbyOrigin = GetOrigin(LobbyUrl);
+	if (LobbyOrigin.IsEmpty())
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot record the Lobby, LobbyServerUrl %s has no origin"), *LobbyUrl);
+		Connection->Reject(TEXT("502 Bad Gateway"));
+		return;
+	}
+
+	// The client's credentials and session headers go upstream, the handshake headers are the socket's own
+	TMap<FString, FString> UpgradeHeaders;
+	for (TPair<FString, FString> const& Header : Headers)
+	{
+		if (Header.Key != TEXT("host") && Header.Key != TEXT("upgrade") && Header.Key != TEXT("connection") && !Header.Key.StartsWith(TEXT("sec-websocket-")))
+		{
+			UpgradeHeaders.Add(Header.Key, Header.Value);
+		}
+	}
+
+	Connection->Upstream = FWebSocketsModule::Get().CreateWebSocket(LobbyOrigin + RequestPath, Protocol, UpgradeHeaders);
+	TWeakPtr<FLobbyConnection> WeakConnection = Connection;
+	Connection->Upstream->OnConnected().AddLambda([this, WeakConnection, Response]()
+	{
+		if (TSharedPtr<FLobbyConnection> Pinned = WeakConnection.Pin())
+		{
+			Pinned->Index = LobbyTraces.Num();
+			LobbyTraces.AddDefaulted();
+			Pinned->Upgrade(Response);
+		}
+	});
+	Connection->Upstream->OnConnectionError().AddLambda([WeakConnection](FString const& Error)
+	{
+		if (TSharedPtr<FLobbyConnection> Pinned = WeakConnection.Pin())
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Lobby fixture upstream failed: %s"), *Error);
+			if (Pinned->bUpgraded)
+			{
+				Pinned->Close();
+			}
+			else
+			{
+				Pinned->Reject(TEXT("502 Bad Gateway"));
+			}
+		}
+	});
+	Connection->Upstream->OnClosed().AddLambda([WeakConnection](int32 StatusCode, FString const& Reason, bool bWasClean)
+	{
+		if (TSharedPtr<FLobbyConnection> Pinned = WeakConnection.Pin())
+		{
+			Pinned->Close();
+		}
+	});
+	Connection->Upstream->OnMessage().AddLambda([this, WeakConnection](FString const& Text)
+	{
+		if (TSharedPtr<FLobbyConnection> Pinned = WeakConnection.Pin())
+		{
+			RecordLobbyFrame(*Pinned, true, Text);
+			Pinned->SendText(Text);
+		}
+	});
+	Connection->Upstream->Connect();
+}
+
+void FAccelByteHttpFixture::OnLobbyClientText(TSharedRef<FLobbyConnection> const& Connection, FString const& Text)
+{
+	RecordLobbyFrame(*Connection, false, Text);
+	Connection->ClientFrameTimes.Add(FPlatformTime::Seconds());
+	if (Mode == EMode::Record && Connection->Upstream.IsValid())
+	{
+		Connection->Upstream->Send(Text);
+	}
+}
+
+void FAccelByteHttpFixture::ReplayLobbyFrames(TSharedRef<FLobbyConnection> const& Connection)
+{
+	TArray<FLobbyFrame> const& Frames = LobbyTraces[Connection->Index];
+	const double Now = FPlatformTime::Seconds();
+	while (Connection->NextFrame < Frames.Num())
+	{
+		FLobbyFrame const& Frame = Frames[Connection->NextFrame];
+		if (!Frame.bFromServer)
+		{
+			Connection->NextFrame++;
+			continue;
+		}
+		if (Connection->ClientFrameTimes.Num() < Frame.ClientFramesBefore)
+		{
+			break;
+		}
+
+		const double GateTime = Frame.ClientFramesBefore > 0 ? Connection->ClientFrameTimes[Frame.ClientFramesBefore - 1] : Connection->UpgradeTime;
+		const double Delay = Speed > 0.0f ? Frame.DelayMs / 1000.0 / Speed : 0.0;
+		if (Now < FMath::Max(GateTime, Connection->LastServerTime) + Delay)
+		{
+			break;
+		}
+
+		Connection->SendText(Frame.Text);
+		Connection->LastServerTime = Now;
+		Connection->NextFrame++;
+	}
+}
+
+void FAccelByteHttpFixture::RecordLobbyFrame(FLobbyConnection& Connection, bool bFromServer, FString const& Text)
+{
+	if (Mode != EMode::Record)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	FLobbyFrame& Frame = LobbyTraces[Connection.Index].AddDefaulted_GetRef();
+	Frame.bFromServer = bFromServer;
+	Frame.ClientFramesBefore = Connection.ClientFrameTimes.Num();
+	Frame.OffsetSeconds = Now - Connection.UpgradeTime;
+	Frame.Text = Text;
+	if (bFromServer)
+	{
+		const double LastClientTime = Connection.ClientFrameTimes.Num() > 0 ? Connection.ClientFrameTimes.Last() : Connection.UpgradeTime;
+		Frame.DelayMs = static_cast<float>((Now - FMath::Max3(Connection.UpgradeTime, LastClientTime, Connection.LastServerTime)) * 1000.0);
+		Connection.LastServerTime = Now;
+	}
+}
+
+bool FAccelByteHttpFixture::SaveTrace()
+{
+	TArray<uint8> Payload;
+	FMemoryWriter PayloadWriter(Payload);
+	int32 NumEntries = Entries.Num();
+	PayloadWriter << Origin << NumEntries;
+	for (FEntry& Entry : Entries)
+	{
+		PayloadWriter << Entry.Key << Entry.OffsetSeconds << Entry.LatencyMs << Entry.ResponseCode << Entry.ContentType << Entry.ResponseBody;
+	}
+	int32 NumConnections = LobbyTraces.Num();
+	PayloadWriter << LobbyUrl << NumConnections;
+	for (TArray<FLobbyFrame>& Frames : LobbyTraces)
+	{
+		int32 NumFrames = Frames.Num();
+		PayloadWriter << NumFrames;
+		for (FLobbyFrame& Frame : Frames)
+		{
+			PayloadWriter << Frame.bFromServer << Frame.ClientFramesBefore << Frame.OffsetSeconds << Frame.DelayMs << Frame.Text;
+		}
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num());
+	TArray<uint8> Compressed;
+	Compressed.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num()))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to compress the HTTP trace"));
+		return false;
+	}
+	Compressed.SetNum(CompressedSize, false);
+
+	TArray<uint8> FileData;
+	FMemoryWriter FileWriter(FileData);
+	uint32 Magic = HTTP_FIXTURE_MAGIC;
+	uint32 Version = HTTP_FIXTURE_VERSION;
+	int32 UncompressedSize = Payload.Num();
+	FileWriter << Magic << Version << UncompressedSize;
+	FileWriter.Serialize(Compressed.GetData(), Compressed.Num());
+
+	if (!FFileHelper::SaveArrayToFile(FileData, *Path))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to write the HTTP trace to %s"), *Path);
+		return false;
+	}
+
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Recorded %d AccelByte HTTP responses and %d Lobby connections to %s, %d bytes"), Entries.Num(), LobbyTraces.Num(), *Path, FileData.Num());
+	return true;
+}
+
+bool FAccelByteHttpFixture::LoadTrace(FString const& InPath)
+{
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *InPath))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot read the HTTP trace %s"), *InPath);
+		return false;
+	}
+
+	FMemoryReader FileReader(FileData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 UncompressedSize = 0;
+	FileReader << Magic << Version << UncompressedSize;
+	if (FileReader.IsError() || Magic != HTTP_FIXTURE_MAGIC || Version != HTTP_FIXTURE_VERSION || UncompressedSize < 0)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("%s is not an HTTP trace of this version"), *InPath);
+		return false;
+	}
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(UncompressedSize);
+	const int32 HeaderSize = static_cast<int32>(FileReader.Tell());
+	if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), UncompressedSize, FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("The HTTP trace %s is corrupted"), *InPath);
+		return false;
+	}
+
+	FMemoryReader PayloadReader(Payload);
+	int32 NumEntries = 0;
+	PayloadReader << Origin << NumEntries;
+	Entries.Reset();
+	EntriesByKey.Reset();
+	for (int32 Index = 0; Index < NumEntries && !PayloadReader.IsError(); Index++)
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		PayloadReader << Entry.Key << Entry.OffsetSeconds << Entry.LatencyMs << Entry.ResponseCode << Entry.ContentType << Entry.ResponseBody;
+		EntriesByKey.FindOrAdd(Entry.Key).Add(Index);
+	}
+	int32 NumConnections = 0;
+	PayloadReader << LobbyUrl << NumConnections;
+	LobbyTraces.Reset();
+	for (int32 Index = 0; Index < NumConnections && !PayloadReader.IsError(); Index++)
+	{
+		int32 NumFrames = 0;
+		PayloadReader << NumFrames;
+		TArray<FLobbyFrame>& Frames = LobbyTraces.AddDefaulted_GetRef();
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames && !PayloadReader.IsError(); FrameIndex++)
+		{
+			FLobbyFrame& Frame = Frames.AddDefaulted_GetRef();
+			PayloadReader << Frame.bFromServer << Frame.ClientFramesBefore << Frame.OffsetSeconds << Frame.DelayMs << Frame.Text;
+		}
+	}
+
+	if (PayloadReader.IsError())
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("The HTTP trace %s is truncated"), *InPath);
+		Entries.Reset();
+		EntriesByKey.Reset();
+		LobbyTraces.Reset();
+		return false;
+	}
+	return true;
+}
+
+static FAutoConsoleCommand AccelByteFixtureRecordCommand(
+	TEXT("AccelByte.Sample.Fixture.Record"),
+	TEXT("Proxy the AccelByte HTTP and Lobby calls and record them. Usage: AccelByte.Sample.Fixture.Record Path [Port]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](TArray<FString> const& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Usage: AccelByte.Sample.Fixture.Record Path [Port]"));
+			return;
+		}
+		FAccelByteHttpFixture::Get().StartRecording(Args[0], Args.Num() > 1 ? FCString::Atoi(*Args[1]) : FAccelByteHttpFixture::DefaultPort);
+	}));
+
+static FAutoConsoleCommand AccelByteFixtureReplayCommand(
+	TEXT("AccelByte.Sample.Fixture.Replay"),
+	TEXT("Serve the AccelByte HTTP and Lobby calls from a recording. Usage: AccelByte.Sample.Fixture.Replay Path [Speed] [Port]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](TArray<FString> const& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Usage: AccelByte.Sample.Fixture.Replay Path [Speed] [Port]"));
+			return;
+		}
+		FAccelByteHttpFixture::Get().StartReplay(Args[0]
+			, Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.0f
+			, Args.Num() > 2 ? FCString::Atoi(*Args[2]) : FAccelByteHttpFixture::DefaultPort);
+	}));
+
+static FAutoConsoleCommand AccelByteFixtureStopCommand(
+	TEXT("AccelByte.Sample.Fixture.Stop"),
+	TEXT("Stop recording or replaying the AccelByte HTTP and Lobby calls, a recording is written out"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FAccelByteHttpFixture::Get().Stop();
+	}));
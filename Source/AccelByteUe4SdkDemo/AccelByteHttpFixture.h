@@ -0,0 +1,127 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HttpRouteHandle.h"
+
+class FSocket;
+class FTcpListener;
+class IHttpRouter;
+struct FIPv4Endpoint;
+
+/**
+ * Local HTTP proxy that records the AccelByte REST and Lobby traffic of the module to a trace file and serves it back later.
+ *
+ * While active the SDK server URLs point at http://127.0.0.1:<Port>, the original origin is kept in the trace.
+ * Recording requires every configured service to be on the origin of BaseUrl, replay redirects every service
+ * whatever its origin.
+ * Recording forwards every request upstream and stores the response with its latency. Replay never touches the
+ * network: requests are matched on verb, path and query, repeated requests get the recorded responses in order
+ * and the last one once they run out. Responses are delayed by the recorded latency divided by the speed, a speed
+ * of zero answers right away. The trace is a zlib compressed archive, see AccelByteHttpFixture.cpp for the layout.
+ *
+ * The Lobby WebSocket goes through a text frame proxy on Port + LobbyPortOffset. Recording relays the frames to the
+ * configured LobbyServerUrl and keeps them per connection. Replay answers the nth connection with the nth recorded
+ * one, each server frame is sent once the client has sent as many frames as it had when the frame was recorded and
+ * the recorded delay divided by the speed has passed. A replay without recorded connections refuses the upgrade.
+ */
+class FAccelByteHttpFixture
+{
+public:
+	enum class EMode : uint8
+	{
+		Off,
+		Record,
+		Replay
+	};
+
+	static constexpr uint32 DefaultPort = 18080;
+	static constexpr uint32 LobbyPortOffset = 10;
+
+	static FAccelByteHttpFixture& Get();
+
+	bool StartRecording(FString const& Path, uint32 Port = DefaultPort);
+	bool StartReplay(FString const& Path, float Speed = 1.0f, uint32 Port = DefaultPort);
+
+	// Restores the SDK URLs, a recording is written to its path
+	void Stop();
+
+	// Starts from -AccelByteRecord=Path or -AccelByteReplay=Path [-AccelByteReplaySpeed=1] [-AccelByteFixturePort=18080]
+	bool StartFromCommandLine(TCHAR const* CommandLine);
+
+	EMode GetMode() const { return Mode; }
+	int32 GetNumEntries() const { return Entries.Num(); }
+	// Replayed requests that had no recorded response
+	int32 GetNumMisses() const { return NumMisses; }
+	int32 GetNumLobbyConnections() const { return LobbyTraces.Num(); }
+
+private:
+	struct FEntry
+	{
+		FString Key;
+		double OffsetSeconds = 0.0;
+		float LatencyMs = 0.0f;
+		int32 ResponseCode = 0;
+		FString ContentType;
+		TArray<uint8> ResponseBody;
+	};
+
+	struct FLobbyFrame
+	{
+		bool bFromServer = false;
+		// Frames the client had sent on the connection before this one
+		int32 ClientFramesBefore = 0;
+		// Since the upgrade of the connection
+		double OffsetSeconds = 0.0;
+		// Server frames only, since the later of the last client frame and the previous server frame
+		float DelayMs = 0.0f;
+		FString Text;
+	};
+
+	struct FLobbyConnection;
+
+	~FAccelByteHttpFixture();
+
+	bool Listen(uint32 Port);
+	bool ListenLobby(uint32 Port);
+	void StopLobby();
+	bool OnLobbySocketAccepted(FSocket* Socket, FIPv4Endpoint const& Endpoint);
+	bool TickLobby(float DeltaTime);
+	void ReceiveLobbyFrames(TSharedRef<FLobbyConnection> const& Connection);
+	void OnLobbyHandshake(TSharedRef<FLobbyConnection> const& Connection, FString const& RequestPath, TMap<FString, FString> const& Headers);
+	void OnLobbyClientText(TSharedRef<FLobbyConnection> const& Connection, FString const& Text);
+	void ReplayLobbyFrames(TSharedRef<FLobbyConnection> const& Connection);
+	void RecordLobbyFrame(FLobbyConnection& Connection, bool bFromServer, FString const& Text);
+	void RedirectSdk(uint32 Port);
+	void RestoreSdk();
+	bool SaveTrace();
+	bool LoadTrace(FString const& InPath);
+
+	EMode Mode = EMode::Off;
+	FString Path;
+	FString Origin;
+	float Speed = 1.0f;
+	double StartTime = 0.0;
+	int32 NumMisses = 0;
+	TArray<FEntry> Entries;
+	TMap<FString, TArray<int32>> EntriesByKey;
+	TMap<FString, int32> ReplayCursors;
+	TMap<FString, FString> SavedUrls;
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+	FDelegateHandle PreExitHandle;
+
+	// LobbyServerUrl when the trace was recorded
+	FString LobbyUrl;
+	TArray<TArray<FLobbyFrame>> LobbyTraces;
+	TUniquePtr<FTcpListener> LobbyListener;
+	// Filled on the listener thread
+	TQueue<FSocket*, EQueueMode::Mpsc> AcceptedLobbySockets;
+	TArray<TSharedRef<FLobbyConnection>> LobbyConnections;
+	int32 NumLobbyConnections = 0;
+	FDelegateHandle LobbyTickerHandle;
+};
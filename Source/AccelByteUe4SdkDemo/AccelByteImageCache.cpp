@@ -0,0 +1,438 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteImageCache.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Async/Async.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HttpModule.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#define IMAGE_CACHE_FILE_MAGIC 0x4D494241 // "ABIM"
+#define IMAGE_CACHE_FILE_VERSION 1
+#define IMAGE_CACHE_FILE_EXTENSION TEXT(".img")
+
+FAccelByteImageCache& FAccelByteImageCache::Get()
+{
+	static FAccelByteImageCache Instance(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("ImageCache"));
+	return Instance;
+}
+
+FAccelByteImageCache::FAccelByteImageCache(FString const& InDirectory)
+	: Directory(InDirectory)
+{
+}
+
+void FAccelByteImageCache::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.MemoryBudgetBytes = FMath::Max<int64>(0, Settings.MemoryBudgetBytes);
+	Settings.DiskBudgetBytes = FMath::Max<int64>(0, Settings.DiskBudgetBytes);
+	EvictMemoryToBudget();
+	if (bDiskScanned)
+	{
+		EvictDiskToBudget();
+	}
+}
+
+void FAccelByteImageCache::Load(FString const& Url, FOnImage&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+	Stats.Requests++;
+	if (Url.IsEmpty())
+	{
+		Stats.Failures++;
+		OnComplete(nullptr, TEXT("No image URL"));
+		return;
+	}
+
+	if (FMemoryEntry* Entry = MemoryEntries.Find(Url))
+	{
+		Entry->LastAccess = ++AccessCounter;
+		Stats.MemoryHits++;
+		OnComplete(Entry->Texture, FString());
+		return;
+	}
+
+	if (TArray<FOnImage>* Waiting = InFlight.Find(Url))
+	{
+		Stats.Coalesced++;
+		Waiting->Add(MoveTemp(OnComplete));
+		return;
+	}
+	InFlight.Add(Url).Add(MoveTemp(OnComplete));
+
+	if (ImageWrapper == nullptr)
+	{
+		ImageWrapper = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	}
+	ScanDisk();
+	LoadFromDisk(Url);
+}
+
+void FAccelByteImageCache::ClearMemory()
+{
+	MemoryEntries.Reset();
+	MemoryBytes = 0;
+}
+
+void FAccelByteImageCache::ClearDisk()
+{
+	IFileManager::Get().DeleteDirectory(*Directory, false, true);
+	DiskEntries.Reset();
+	DiskBytes = 0;
+	bDiskScanned = true;
+}
+
+FAccelByteImageCacheStats FAccelByteImageCache::GetStats() const
+{
+	FAccelByteImageCacheStats Result = Stats;
+	Result.MemoryBytes = MemoryBytes;
+	Result.DiskBytes = DiskBytes;
+	return Result;
+}
+
+void FAccelByteImageCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (TPair<FString, FMemoryEntry>& Pair : MemoryEntries)
+	{
+		Collector.AddReferencedObject(Pair.Value.Texture);
+	}
+}
+
+FString FAccelByteImageCache::GetReferencerName() const
+{
+	return TEXT("FAccelByteImageCache");
+}
+
+void FAccelByteImageCache::LoadFromDisk(FString const& Url)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+	const FString FileName = GetFileName(Url);
+	if (!DiskEntries.Contains(FileName))
+	{
+		Download(Url, nullptr);
+		return;
+	}
+
+	const FString Path = GetFilePath(FileName);
+	IImageWrapperModule* Wrapper = ImageWrapper;
+	const double RevalidateSeconds = Settings.RevalidateSeconds;
+	Async(EAsyncExecution::ThreadPool, [this, Url, Path, Wrapper, RevalidateSeconds]()
+	{
+		ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+		TSharedPtr<FDecoded> Decoded = MakeShared<FDecoded>();
+		TArray<uint8> File;
+		if (FFileHelper::LoadFileToArray(File, *Path, FILEREAD_Silent))
+		{
+			FMemoryReader Reader(File);
+			uint32 Magic = 0;
+			int32 Version = 0;
+			FString StoredUrl;
+			int64 FetchedTicks = 0;
+			Reader << Magic << Version;
+			if (Magic == IMAGE_CACHE_FILE_MAGIC && Version == IMAGE_CACHE_FILE_VERSION)
+			{
+				Reader << StoredUrl << Decoded->ETag << FetchedTicks << Decoded->Encoded;
+				Decoded->bFound = !Reader.IsError() && StoredUrl == Url;
+				Decoded->FetchedAt = FDateTime(FetchedTicks);
+				Decoded->FileBytes = File.Num();
+			}
+		}
+
+		// A stale entry is only decoded once the server confirmed it
+		const bool bFresh = Decoded->bFound && (FDateTime::UtcNow() - Decoded->FetchedAt).GetTotalSeconds() < RevalidateSeconds;
+		if (bFresh && !Decode(*Wrapper, *Decoded))
+		{
+			Decoded->bFound = false;
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [this, Url, Decoded, bFresh]()
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+			if (!Decoded->bFound)
+			{
+				// Unreadable or corrupted, the download overwrites it
+				Download(Url, nullptr);
+			}
+			else if (!bFresh)
+			{
+				Download(Url, Decoded);
+			}
+			else
+			{
+				Stats.DiskHits++;
+				StoreAndComplete(Url, Decoded, false);
+			}
+		});
+	});
+}
+
+void FAccelByteImageCache::Download(FString const& Url, TSharedPtr<FDecoded> const& Stale)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+	auto Request = FHttpModule::Get().CreateRequest();
+	Request->SetURL(Url);
+	Request->SetVerb(TEXT("GET"));
+	if (Stale.IsValid() && !Stale->ETag.IsEmpty())
+	{
+		Request->SetHeader(TEXT("If-None-Match"), Stale->ETag);
+	}
+
+	Request->OnProcessRequestComplete().BindLambda([this, Url, Stale](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+	{
+		const int32 ResponseCode = bSucceeded && Response.IsValid() ? Response->GetResponseCode() : 0;
+		TSharedPtr<FDecoded> Decoded;
+		if (ResponseCode == EHttpResponseCodes::NotModified && Stale.IsValid())
+		{
+			Stats.NotModified++;
+			Decoded = Stale;
+		}
+		else if (EHttpResponseCodes::IsOk(ResponseCode))
+		{
+			Stats.Downloads++;
+			Decoded = MakeShared<FDecoded>();
+			Decoded->bFound = true;
+			Decoded->ETag = Response->GetHeader(TEXT("ETag"));
+			Decoded->Encoded = Response->GetContent();
+		}
+		else
+		{
+			Stats.Failures++;
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("AccelByte image download failed! URL: %s - code: %d"), *Url, ResponseCode);
+			Complete(Url, nullptr, FString::Printf(TEXT("Image download failed with HTTP %d"), ResponseCode));
+			return;
+		}
+		Decoded->FetchedAt = FDateTime::UtcNow();
+
+		IImageWrapperModule* Wrapper = ImageWrapper;
+		const FString Path = GetFilePath(GetFileName(Url));
+		Async(EAsyncExecution::ThreadPool, [this, Url, Path, Decoded, Wrapper]()
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+			bool bDecoded = Decode(*Wrapper, *Decoded);
+			if (bDecoded)
+			{
+				// Rewritten after a 304 too, the new fetch time starts the next revalidation period
+				TArray<uint8> File;
+				FMemoryWriter Writer(File);
+				uint32 Magic = IMAGE_CACHE_FILE_MAGIC;
+				int32 Version = IMAGE_CACHE_FILE_VERSION;
+				FString StoredUrl = Url;
+				int64 FetchedTicks = Decoded->FetchedAt.GetTicks();
+				Writer << Magic << Version << StoredUrl << Decoded->ETag << FetchedTicks << Decoded->Encoded;
+
+				const FString TempPath = Path + TEXT(".tmp");
+				Decoded->FileBytes = FFileHelper::SaveArrayToFile(File, *TempPath) && IFileManager::Get().Move(*Path, *TempPath, true, true) ? File.Num() : 0;
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [this, Url, Decoded, bDecoded]()
+			{
+				ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+				if (!bDecoded)
+				{
+					Stats.Failures++;
+					Complete(Url, nullptr, TEXT("The image format is not supported"));
+					return;
+				}
+				StoreAndComplete(Url, Decoded, true);
+			});
+		});
+	});
+	Request->ProcessRequest();
+}
+
+void FAccelByteImageCache::StoreAndComplete(FString const& Url, TSharedPtr<FDecoded> const& Decoded, bool bWritten)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+	const FString FileName = GetFileName(Url);
+	if (!bWritten)
+	{
+		TouchDisk(FileName);
+	}
+	else if (Decoded->FileBytes > 0)
+	{
+		FDiskEntry& Entry = DiskEntries.FindOrAdd(FileName);
+		DiskBytes += Decoded->FileBytes - Entry.Bytes;
+		Entry.Bytes = Decoded->FileBytes;
+		Entry.LastUse = FDateTime::UtcNow();
+		EvictDiskToBudget();
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Decoded->Width, Decoded->Height, PF_B8G8R8A8);
+	if (Texture == nullptr)
+	{
+		Stats.Failures++;
+		Complete(Url, nullptr, TEXT("Could not create the texture"));
+		return;
+	}
+
+	FTexture2DMipMap& Mip = Texture->PlatformData->Mips[0];
+	FMemory::Memcpy(Mip.BulkData.Lock(LOCK_READ_WRITE), Decoded->Bgra.GetData(), Decoded->Bgra.Num());
+	Mip.BulkData.Unlock();
+	Texture->UpdateResource();
+
+	AddToMemory(Url, Texture, Decoded->Bgra.Num());
+	Complete(Url, Texture, FString());
+}
+
+void FAccelByteImageCache::Complete(FString const& Url, UTexture2D* Texture, FString const& ErrorMessage)
+{
+	TArray<FOnImage> Waiting;
+	if (!InFlight.RemoveAndCopyValue(Url, Waiting))
+	{
+		return;
+	}
+
+	for (FOnImage const& OnComplete : Waiting)
+	{
+		OnComplete(Texture, ErrorMessage);
+	}
+}
+
+void FAccelByteImageCache::AddToMemory(FString const& Url, UTexture2D* Texture, int64 Bytes)
+{
+	FMemoryEntry& Entry = MemoryEntries.FindOrAdd(Url);
+	MemoryBytes += Bytes - Entry.Bytes;
+	Entry.Texture = Texture;
+	Entry.Bytes = Bytes;
+	Entry.LastAccess = ++AccessCounter;
+
+	// The texture just loaded is kept even when it is larger than the whole budget, its caller is about to show it
+	EvictMemoryToBudget();
+}
+
+void FAccelByteImageCache::EvictMemoryToBudget()
+{
+	// A store page shows a few dozen images, a linear scan for the oldest entry is cheaper than maintaining a list
+	while (MemoryBytes > Settings.MemoryBudgetBytes && MemoryEntries.Num() > 1)
+	{
+		const FString* OldestUrl = nullptr;
+		uint64 OldestAccess = MAX_uint64;
+		for (TPair<FString, FMemoryEntry> const& Pair : MemoryEntries)
+		{
+			if (Pair.Value.LastAccess < OldestAccess)
+			{
+				OldestAccess = Pair.Value.LastAccess;
+				OldestUrl = &Pair.Key;
+			}
+		}
+
+		FMemoryEntry Removed;
+		MemoryEntries.RemoveAndCopyValue(FString(*OldestUrl), Removed);
+		MemoryBytes -= Removed.Bytes;
+		Stats.MemoryEvictions++;
+	}
+}
+
+void FAccelByteImageCache::ScanDisk()
+{
+	if (bDiskScanned)
+	{
+		return;
+	}
+	bDiskScanned = true;
+
+	// Once per run, the last use of every file is its time stamp
+	IFileManager::Get().IterateDirectoryStat(*Directory, [this](TCHAR const* Path, FFileStatData const& Stat)
+	{
+		const FString FileName = FPaths::GetCleanFilename(Path);
+		if (!Stat.bIsDirectory && FileName.EndsWith(IMAGE_CACHE_FILE_EXTENSION))
+		{
+			DiskEntries.Add(FileName, { Stat.FileSize, Stat.ModificationTime });
+			DiskBytes += Stat.FileSize;
+		}
+		return true;
+	});
+	EvictDiskToBudget();
+}
+
+void FAccelByteImageCache::TouchDisk(FString const& FileName)
+{
+	FDiskEntry* Entry = DiskEntries.Find(FileName);
+	if (Entry == nullptr)
+	{
+		return;
+	}
+
+	const FDateTime Now = FDateTime::UtcNow();
+	Entry->LastUse = Now;
+	const FString Path = GetFilePath(FileName);
+	Async(EAsyncExecution::ThreadPool, [Path, Now]()
+	{
+		IFileManager::Get().SetTimeStamp(*Path, Now);
+	});
+}
+
+void FAccelByteImageCache::EvictDiskToBudget()
+{
+	while (DiskBytes > Settings.DiskBudgetBytes && DiskEntries.Num() > 0)
+	{
+		const FString* OldestFile = nullptr;
+		FDateTime OldestUse = FDateTime::MaxValue();
+		for (TPair<FString, FDiskEntry> const& Pair : DiskEntries)
+		{
+			if (Pair.Value.LastUse < OldestUse)
+			{
+				OldestUse = Pair.Value.LastUse;
+				OldestFile = &Pair.Key;
+			}
+		}
+
+		const FString FileName = *OldestFile;
+		DiskBytes -= DiskEntries.FindChecked(FileName).Bytes;
+		DiskEntries.Remove(FileName);
+		Stats.DiskEvictions++;
+
+		const FString Path = GetFilePath(FileName);
+		Async(EAsyncExecution::ThreadPool, [Path]()
+		{
+			IFileManager::Get().Delete(*Path, false, false, true);
+		});
+	}
+}
+
+FString FAccelByteImageCache::GetFilePath(FString const& FileName) const
+{
+	return Directory / FileName;
+}
+
+FString FAccelByteImageCache::GetFileName(FString const& Url)
+{
+	FTCHARToUTF8 Utf8Url(*Url);
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Utf8Url.Get(), Utf8Url.Length(), Hash.Hash);
+	return Hash.ToString() + IMAGE_CACHE_FILE_EXTENSION;
+}
+
+bool FAccelByteImageCache::Decode(IImageWrapperModule& Module, FDecoded& Decoded)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Images);
+	const EImageFormat Format = Module.DetectImageFormat(Decoded.Encoded.GetData(), Decoded.Encoded.Num());
+	if (Format == EImageFormat::Invalid)
+	{
+		return false;
+	}
+
+	TSharedPtr<IImageWrapper> Wrapper = Module.CreateImageWrapper(Format);
+	if (!Wrapper.IsValid() || !Wrapper->SetCompressed(Decoded.Encoded.GetData(), Decoded.Encoded.Num()) || !Wrapper->GetRaw(ERGBFormat::BGRA, 8, Decoded.Bgra))
+	{
+		return false;
+	}
+	Decoded.Width = Wrapper->GetWidth();
+	Decoded.Height = Wrapper->GetHeight();
+	return Decoded.Width > 0 && Decoded.Height > 0;
+}
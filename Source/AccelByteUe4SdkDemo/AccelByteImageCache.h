@@ -0,0 +1,160 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "AccelByteImageCache.generated.h"
+
+class UTexture2D;
+class IImageWrapperModule;
+
+USTRUCT(BlueprintType)
+struct FAccelByteImageCacheStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 Requests = 0;
+
+	// Textures already in memory
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 MemoryHits = 0;
+
+	// Images decoded from the disk cache without a download
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 DiskHits = 0;
+
+	// Stale disk entries the server confirmed with a 304
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 NotModified = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 Downloads = 0;
+
+	// Requests merged into a load already in flight for the same URL
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 Coalesced = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 Failures = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 MemoryEvictions = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int32 DiskEvictions = 0;
+
+	// Decoded texture bytes held in memory
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int64 MemoryBytes = 0;
+
+	// Encoded image bytes held on disk
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Images")
+	int64 DiskBytes = 0;
+};
+
+/**
+ * Store item images loaded through a memory and a disk cache.
+ *
+ * Decoded textures are kept in memory under a byte budget and evicted least recently used first. Downloaded
+ * images are written to one file per URL with the ETag of the response, the disk cache has its own budget and
+ * evicts by last use, which is kept in the file time stamp. A disk entry older than RevalidateSeconds is checked
+ * with If-None-Match before use. File reads, image decoding and file writes run on the thread pool, only the
+ * texture is created on the game thread. Concurrent loads of the same URL share one download and one decode.
+ * Handlers run on the game thread, the cache is only meant to be used from the game thread.
+ */
+class FAccelByteImageCache : public FGCObject
+{
+public:
+	struct FSettings
+	{
+		int64 MemoryBudgetBytes = 64 * 1024 * 1024;
+		int64 DiskBudgetBytes = 256 * 1024 * 1024;
+		double RevalidateSeconds = 24 * 60 * 60;
+	};
+
+	// Texture is null on failure, ErrorMessage is empty on success
+	using FOnImage = TFunction<void(UTexture2D* Texture, FString const& ErrorMessage)>;
+
+	static FAccelByteImageCache& Get();
+
+	explicit FAccelByteImageCache(FString const& InDirectory);
+
+	void Configure(FSettings const& InSettings);
+
+	void Load(FString const& Url, FOnImage&& OnComplete);
+
+	// Drops the textures, the disk cache and the counters stay
+	void ClearMemory();
+
+	// Deletes every cached file, loads in flight still write theirs
+	void ClearDisk();
+
+	FAccelByteImageCacheStats GetStats() const;
+
+	// FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override;
+	// End of FGCObject interface
+
+private:
+	struct FMemoryEntry
+	{
+		UTexture2D* Texture = nullptr;
+		int64 Bytes = 0;
+		uint64 LastAccess = 0;
+	};
+
+	struct FDiskEntry
+	{
+		int64 Bytes = 0;
+		FDateTime LastUse;
+	};
+
+	// Filled on the thread pool, consumed on the game thread
+	struct FDecoded
+	{
+		bool bFound = false;
+		FString ETag;
+		FDateTime FetchedAt;
+		TArray<uint8> Encoded;
+		TArray<uint8> Bgra;
+		int32 Width = 0;
+		int32 Height = 0;
+		int64 FileBytes = 0;
+	};
+
+	void LoadFromDisk(FString const& Url);
+	void Download(FString const& Url, TSharedPtr<FDecoded> const& Stale);
+	void StoreAndComplete(FString const& Url, TSharedPtr<FDecoded> const& Decoded, bool bWritten);
+	void Complete(FString const& Url, UTexture2D* Texture, FString const& ErrorMessage);
+
+	void AddToMemory(FString const& Url, UTexture2D* Texture, int64 Bytes);
+	void EvictMemoryToBudget();
+
+	void ScanDisk();
+	void TouchDisk(FString const& FileName);
+	void EvictDiskToBudget();
+
+	FString GetFilePath(FString const& FileName) const;
+	static FString GetFileName(FString const& Url);
+	static bool Decode(IImageWrapperModule& ImageWrapper, FDecoded& Decoded);
+
+	FString Directory;
+	FSettings Settings;
+	IImageWrapperModule* ImageWrapper = nullptr;
+
+	TMap<FString, FMemoryEntry> MemoryEntries;
+	int64 MemoryBytes = 0;
+	uint64 AccessCounter = 0;
+
+	TMap<FString, FDiskEntry> DiskEntries;
+	int64 DiskBytes = 0;
+	bool bDiskScanned = false;
+
+	TMap<FString, TArray<FOnImage>> InFlight;
+	FAccelByteImageCacheStats Stats;
+};
@@ -0,0 +1,238 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteItemCache.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "HAL/PlatformTime.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteItemApi.h"
+
+FAccelByteItemCache& FAccelByteItemCache::Get()
+{
+	static FAccelByteItemCache Instance;
+	return Instance;
+}
+
+void FAccelByteItemCache::Configure(double InTtlSeconds, int64 InBudgetBytes)
+{
+	TtlSeconds = FMath::Max(0.0, InTtlSeconds);
+	BudgetBytes = FMath::Max<int64>(0, InBudgetBytes);
+
+	if (TtlSeconds <= 0.0)
+	{
+		Entries.Empty();
+		TotalBytes = 0;
+	}
+	EvictToBudget();
+}
+
+void FAccelByteItemCache::GetItemBySku
+	( FString const& Sku
+	, AccelByte::THandler<FAccelByteModelsItemInfo> const& OnSuccess
+	, AccelByte::FErrorHandler const& OnError )
+{
+	if (const FEntry* Entry = FindValidEntry(Sku))
+	{
+		Stats.Hits++;
+		// Copy before calling out, the handler may call back into the cache and reallocate the map
+		const FAccelByteModelsItemInfo Item = Entry->Item;
+		OnSuccess.ExecuteIfBound(Item);
+		return;
+	}
+
+	if (FPendingLookup* Pending = InFlight.Find(Sku))
+	{
+		Stats.Coalesced++;
+		Pending->SuccessHandlers.Add(OnSuccess);
+		Pending->ErrorHandlers.Add(OnError);
+		return;
+	}
+
+	Stats.Misses++;
+	FPendingLookup& Pending = InFlight.Add(Sku);
+	Pending.SuccessHandlers.Add(OnSuccess);
+	Pending.ErrorHandlers.Add(OnError);
+	Pending.StartTime = FPlatformTime::Seconds();
+
+	const AccelByte::THandler<FAccelByteModelsItemInfo> OnBackendSuccess = AccelByte::THandler<FAccelByteModelsItemInfo>::CreateLambda([Sku](FAccelByteModelsItemInfo const& Response)
+	{
+		FAccelByteItemCache::Get().OnLookupSucceeded(Sku, Response);
+	});
+
+	const AccelByte::FErrorHandler OnBackendError = AccelByte::FErrorHandler::CreateLambda([Sku](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		FAccelByteItemCache::Get().OnLookupFailed(Sku, ErrorCode, ErrorMessage);
+	});
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::GetItemBySku);
+	FRegistry::Item.GetItemBySku(Sku, "", "", FAccelByteTelemetry::WrapSuccess(Telemetry, OnBackendSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnBackendError));
+}
+
+bool FAccelByteItemCache::TryGetCachedItem(FString const& Sku, FAccelByteModelsItemInfo& OutItem)
+{
+	if (const FEntry* Entry = FindValidEntry(Sku))
+	{
+		Stats.Hits++;
+		OutItem = Entry->Item;
+		return true;
+	}
+	return false;
+}
+
+void FAccelByteItemCache::AddItem(FAccelByteModelsItemInfo const& Item)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	if (TtlSeconds <= 0.0 || Item.Sku.IsEmpty())
+	{
+		return;
+	}
+
+	RemoveEntry(Item.Sku);
+
+	FEntry& Entry = Entries.Add(Item.Sku);
+	Entry.Item = Item;
+	Entry.ExpireTime = FPlatformTime::Seconds() + TtlSeconds;
+	Entry.Bytes = EstimateItemBytes(Item);
+	Entry.LastAccess = ++AccessCounter;
+	TotalBytes += Entry.Bytes;
+
+	EvictToBudget();
+}
+
+void FAccelByteItemCache::Invalidate(FString const& Sku)
+{
+	RemoveEntry(Sku);
+}
+
+void FAccelByteItemCache::Reset()
+{
+	Entries.Empty();
+	TotalBytes = 0;
+	Stats = FAccelByteItemCacheStats();
+	BackendRequests = 0;
+	TotalBackendLatency = 0.0;
+}
+
+FAccelByteItemCacheStats FAccelByteItemCache::GetStats() const
+{
+	FAccelByteItemCacheStats Result = Stats;
+	Result.CachedItems = Entries.Num();
+	Result.CachedBytes = TotalBytes;
+	Result.AverageBackendLatencyMs = BackendRequests > 0 ? static_cast<float>(TotalBackendLatency / BackendRequests * 1000.0) : 0.0f;
+	return Result;
+}
+
+FAccelByteItemCache::FEntry* FAccelByteItemCache::FindValidEntry(FString const& Sku)
+{
+	FEntry* Entry = Entries.Find(Sku);
+	if (Entry == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (Entry->ExpireTime <= FPlatformTime::Seconds())
+	{
+		Stats.Evictions++;
+		RemoveEntry(Sku);
+		return nullptr;
+	}
+
+	Entry->LastAccess = ++AccessCounter;
+	return Entry;
+}
+
+void FAccelByteItemCache::RemoveEntry(FString const& Sku)
+{
+	FEntry Removed;
+	if (Entries.RemoveAndCopyValue(Sku, Removed))
+	{
+		TotalBytes -= Removed.Bytes;
+	}
+}
+
+void FAccelByteItemCache::EvictToBudget()
+{
+	// Catalogs only hold a few hundred SKUs, a linear scan for the oldest entry is cheaper than maintaining a list
+	while (TotalBytes > BudgetBytes && Entries.Num() > 0)
+	{
+		const FString* OldestSku = nullptr;
+		uint64 OldestAccess = MAX_uint64;
+		for (const TPair<FString, FEntry>& Pair : Entries)
+		{
+			if (Pair.Value.LastAccess < OldestAccess)
+			{
+				OldestAccess = Pair.Value.LastAccess;
+				OldestSku = &Pair.Key;
+			}
+		}
+
+		const FString SkuToEvict = *OldestSku;
+		RemoveEntry(SkuToEvict);
+		Stats.Evictions++;
+	}
+}
+
+void FAccelByteItemCache::OnLookupSucceeded(FString const& Sku, FAccelByteModelsItemInfo const& Item)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	FPendingLookup Pending;
+	if (!InFlight.RemoveAndCopyValue(Sku, Pending))
+	{
+		return;
+	}
+
+	RecordBackendLatency(Pending.StartTime);
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("AccelByte get item by SKU succeed! SKU: %s - waiting callers: %d"), *Sku, Pending.SuccessHandlers.Num());
+
+	FAccelByteModelsItemInfo Response = Item;
+	if (Response.Sku.IsEmpty())
+	{
+		Response.Sku = Sku;
+	}
+	AddItem(Response);
+
+	for (const AccelByte::THandler<FAccelByteModelsItemInfo>& Handler : Pending.SuccessHandlers)
+	{
+		Handler.ExecuteIfBound(Response);
+	}
+}
+
+void FAccelByteItemCache::OnLookupFailed(FString const& Sku, int32 ErrorCode, FString const& ErrorMessage)
+{
+	FPendingLookup Pending;
+	if (!InFlight.RemoveAndCopyValue(Sku, Pending))
+	{
+		return;
+	}
+
+	RecordBackendLatency(Pending.StartTime);
+	UE_LOG(LogAccelByteSampleApp, Warning, TEXT("AccelByte Get Item by SKU failed! SKU: %s - code: %d - message: %s"), *Sku, ErrorCode, *ErrorMessage);
+
+	for (const AccelByte::FErrorHandler& Handler : Pending.ErrorHandlers)
+	{
+		Handler.ExecuteIfBound(ErrorCode, ErrorMessage);
+	}
+}
+
+void FAccelByteItemCache::RecordBackendLatency(double StartTime)
+{
+	BackendRequests++;
+	TotalBackendLatency += FPlatformTime::Seconds() - StartTime;
+}
+
+int64 FAccelByteItemCache::EstimateItemBytes(FAccelByteModelsItemInfo const& Item)
+{
+	// Only the fields that grow with the catalog content are counted, the rest is covered by the struct size
+	return sizeof(FAccelByteModelsItemInfo)
+		+ Item.Title.GetAllocatedSize()
+		+ Item.Description.GetAllocatedSize()
+		+ Item.LongDescription.GetAllocatedSize()
+		+ Item.ItemId.GetAllocatedSize()
+		+ Item.Sku.GetAllocatedSize()
+		+ Item.Images.GetAllocatedSize();
+}
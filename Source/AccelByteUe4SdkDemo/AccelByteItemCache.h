@@ -0,0 +1,116 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/AccelByteError.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteItemCache.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteItemCacheStats
+{
+	GENERATED_BODY()
+
+	// Lookups answered from the cache without touching the backend
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 Hits = 0;
+
+	// Lookups that had to start a backend request
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 Misses = 0;
+
+	// Lookups merged into a backend request that was already in flight for the same SKU
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 Coalesced = 0;
+
+	// Entries dropped because they expired or the memory budget was exceeded
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 Evictions = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 CachedItems = 0;
+
+	// Approximate memory held by the cached items
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int64 CachedBytes = 0;
+
+	// Mean wall time of the backend requests started by the cache
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	float AverageBackendLatencyMs = 0.0f;
+};
+
+/**
+ * SKU keyed cache in front of FRegistry::Item.GetItemBySku.
+ *
+ * Concurrent lookups of the same SKU share a single backend request and every waiting handler is
+ * called from its response. Entries live for a configurable TTL and the least recently used ones are
+ * evicted once the approximate memory budget is exceeded. The SDK invokes its handlers on the game
+ * thread, so the cache is only meant to be used from the game thread.
+ */
+class FAccelByteItemCache
+{
+public:
+	static FAccelByteItemCache& Get();
+
+	/**
+	 * @param InTtlSeconds How long a fetched item is served from memory. Zero keeps request coalescing but disables caching.
+	 * @param InBudgetBytes Upper bound of the approximate memory held by cached items.
+	 */
+	void Configure(double InTtlSeconds, int64 InBudgetBytes);
+
+	void GetItemBySku(FString const& Sku, AccelByte::THandler<FAccelByteModelsItemInfo> const& OnSuccess, AccelByte::FErrorHandler const& OnError);
+
+	// Returns the cached item without starting a request, refreshing its LRU position on a hit
+	bool TryGetCachedItem(FString const& Sku, FAccelByteModelsItemInfo& OutItem);
+
+	// Seeds the cache with an item fetched by other means, e.g. a catalog page
+	void AddItem(FAccelByteModelsItemInfo const& Item);
+
+	void Invalidate(FString const& Sku);
+
+	// Drops every cached item and resets the counters, in-flight requests are left untouched
+	void Reset();
+
+	FAccelByteItemCacheStats GetStats() const;
+
+private:
+	struct FEntry
+	{
+		FAccelByteModelsItemInfo Item;
+		double ExpireTime = 0.0;
+		int64 Bytes = 0;
+		uint64 LastAccess = 0;
+	};
+
+	struct FPendingLookup
+	{
+		TArray<AccelByte::THandler<FAccelByteModelsItemInfo>> SuccessHandlers;
+		TArray<AccelByte::FErrorHandler> ErrorHandlers;
+		double StartTime = 0.0;
+	};
+
+	FEntry* FindValidEntry(FString const& Sku);
+	void RemoveEntry(FString const& Sku);
+	void EvictToBudget();
+
+	void OnLookupSucceeded(FString const& Sku, FAccelByteModelsItemInfo const& Item);
+	void OnLookupFailed(FString const& Sku, int32 ErrorCode, FString const& ErrorMessage);
+	void RecordBackendLatency(double StartTime);
+
+	static int64 EstimateItemBytes(FAccelByteModelsItemInfo const& Item);
+
+	TMap<FString, FEntry> Entries;
+	TMap<FString, FPendingLookup> InFlight;
+
+	double TtlSeconds = 300.0;
+	int64 BudgetBytes = 2 * 1024 * 1024;
+	int64 TotalBytes = 0;
+	uint64 AccessCounter = 0;
+
+	FAccelByteItemCacheStats Stats;
+	int32 BackendRequests = 0;
+	double TotalBackendLatency = 0.0;
+};
@@ -0,0 +1,444 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteLoadTestCommandlet.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteHttpFixture.h"
+#include "AccelByteOnlineContext.h"
+#include "AccelByteServerValidation.h"
+#include "AccelByteTelemetry.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/CoreMisc.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+
+#include "Core/AccelByteMultiRegistry.h"
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteUserApi.h"
+#include "Api/AccelByteItemApi.h"
+#include "Api/AccelByteEntitlementApi.h"
+
+namespace AccelByteLoadTest
+{
+	struct FSettings
+	{
+		int32 NumUsers = 100;
+		float SpawnRate = 100.0f;
+		int32 Iterations = 1;
+		TArray<FString> Skus;
+		EAccelBytePlatformType PlatformType = EAccelBytePlatformType::Device;
+		float TimeoutSeconds = 600.0f;
+		// Server mode only, share of the receipts a user sends again, as a client retrying would
+		float DuplicateRatio = 0.1f;
+	};
+
+	struct FVirtualUser
+	{
+		int32 Index = 0;
+		AccelByte::FApiClientPtr ApiClient;
+		int32 Iteration = 0;
+		int32 SkuIndex = 0;
+	};
+
+	class FLoadTest : public TSharedFromThis<FLoadTest>
+	{
+	public:
+		explicit FLoadTest(FSettings const& InSettings)
+			: Settings(InSettings)
+		{
+		}
+
+		void Start()
+		{
+			StartTime = FPlatformTime::Seconds();
+		}
+
+		// Spawns the users due by now according to the spawn rate
+		void SpawnDue(double Now)
+		{
+			const int32 Due = FMath::Min(Settings.NumUsers, FMath::FloorToInt(static_cast<float>((Now - StartTime) * Settings.SpawnRate)) + 1);
+			while (Spawned < Due)
+			{
+				TSharedRef<FVirtualUser> User = MakeShared<FVirtualUser>();
+				User->Index = Spawned;
+				User->ApiClient = AccelByte::FMultiRegistry::GetApiClient(FString::Printf(TEXT("loadtest-%d"), Spawned));
+				Spawned++;
+				Login(User);
+			}
+		}
+
+		bool IsFinished() const
+		{
+			return Spawned == Settings.NumUsers && Finished == Settings.NumUsers;
+		}
+
+		void Report() const
+		{
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("Load test: %d users - %d flows completed - %d flows failed - %.1f s - %.1f flows/s"),
+				Settings.NumUsers, CompletedFlows, FailedFlows, Seconds, Seconds > 0.0 ? CompletedFlows / Seconds : 0.0);
+
+			for (FAccelByteTelemetry::FOpSummary const& Summary : FAccelByteTelemetry::Summarize())
+			{
+				UE_LOG(LogAccelByteSampleApp, Display, TEXT("  %-40s count %6lld - errors %5lld - %.1f req/s - p50 %.1f ms - p95 %.1f ms - p99 %.1f ms - max %.1f ms"),
+					*Summary.Operation, Summary.Count, Summary.Errors, Seconds > 0.0 ? Summary.Count / Seconds : 0.0, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs);
+			}
+		}
+
+		int32 GetFailedFlows() const { return FailedFlows; }
+		int32 GetUnfinishedUsers() const { return Settings.NumUsers - Finished; }
+
+	private:
+		void Login(TSharedRef<FVirtualUser> const& User)
+		{
+			TSharedRef<FLoadTest> Self = AsShared();
+			const FSimpleDelegate OnSuccess = FSimpleDelegate::CreateLambda([Self, User]()
+			{
+				Self->BrowseStore(User);
+			});
+			const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([Self, User](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				Self->FailFlow(User, TEXT("login"), ErrorCode, ErrorMessage);
+			});
+
+			const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::LoginWithOtherPlatform);
+			User->ApiClient->User.LoginWithOtherPlatform(Settings.PlatformType, FString::Printf(TEXT("loadtest-token-%d"), User->Index), FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+		}
+
+		void BrowseStore(TSharedRef<FVirtualUser> const& User)
+		{
+			if (User->SkuIndex >= Settings.Skus.Num())
+			{
+				SyncPurchase(User);
+				return;
+			}
+
+			TSharedRef<FLoadTest> Self = AsShared();
+			const AccelByte::THandler<FAccelByteModelsItemInfo> OnSuccess = AccelByte::THandler<FAccelByteModelsItemInfo>::CreateLambda([Self, User](FAccelByteModelsItemInfo const&)
+			{
+				User->SkuIndex++;
+				Self->BrowseStore(User);
+			});
+			const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([Self, User](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				Self->FailFlow(User, TEXT("get item by sku"), ErrorCode, ErrorMessage);
+			});
+
+			const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::GetItemBySku);
+			User->ApiClient->Item.GetItemBySku(Settings.Skus[User->SkuIndex], TEXT(""), TEXT(""), FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+		}
+
+		void SyncPurchase(TSharedRef<FVirtualUser> const& User)
+		{
+			FAccelByteModelsPlatformSyncMobileGoogle SyncRequest;
+			SyncRequest.OrderId = FString::Printf(TEXT("GPA.loadtest-%d-%d"), User->Index, User->Iteration);
+			SyncRequest.ProductId = Settings.Skus.Num() > 0 ? Settings.Skus[0] : TEXT("loadtest");
+			SyncRequest.PackageName = TEXT("net.accelbyte.loadtest");
+			SyncRequest.PurchaseToken = SyncRequest.OrderId;
+			SyncRequest.PurchaseTime = FDateTime::UtcNow().ToUnixTimestamp() * 1000;
+
+			TSharedRef<FLoadTest> Self = AsShared();
+			const AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse> OnSuccess = AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse>::CreateLambda([Self, User](FAccelByteModelsPlatformSyncMobileGoogleResponse const&)
+			{
+				Self->CompleteFlow(User);
+			});
+			const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([Self, User](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				Self->FailFlow(User, TEXT("sync purchase"), ErrorCode, ErrorMessage);
+			});
+
+			const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseGoogle);
+			User->ApiClient->Entitlement.SyncMobilePlatformPurchaseGooglePlay(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+		}
+
+		void CompleteFlow(TSharedRef<FVirtualUser> const& User)
+		{
+			CompletedFlows++;
+			NextIteration(User);
+		}
+
+		void FailFlow(TSharedRef<FVirtualUser> const& User, TCHAR const* Step, int32 ErrorCode, FString const& ErrorMessage)
+		{
+			FailedFlows++;
+			UE_LOG(LogAccelByteSampleApp, Verbose, TEXT("Virtual user %d failed at %s, code: %d - message: %s"), User->Index, Step, ErrorCode, *ErrorMessage);
+			NextIteration(User);
+		}
+
+		void NextIteration(TSharedRef<FVirtualUser> const& User)
+		{
+			User->Iteration++;
+			if (User->Iteration >= Settings.Iterations)
+			{
+				Finished++;
+				User->ApiClient.Reset();
+				return;
+			}
+
+			// The session stays valid, later iterations only repeat the store browse and the purchase
+			User->SkuIndex = 0;
+			BrowseStore(User);
+		}
+
+		FSettings Settings;
+		double StartTime = 0.0;
+		int32 Spawned = 0;
+		int32 Finished = 0;
+		int32 CompletedFlows = 0;
+		int32 FailedFlows = 0;
+	};
+
+	/**
+	 * Server mode: the virtual users are players connected to a dedicated server, each sending its receipts to
+	 * FAccelByteServerValidation in one burst with some of them repeated. The server makes the backend calls.
+	 */
+	class FServerLoadTest : public TSharedFromThis<FServerLoadTest>
+	{
+	public:
+		explicit FServerLoadTest(FSettings const& InSettings)
+			: Settings(InSettings)
+			, Random(0x5eed)
+		{
+		}
+
+		void Start()
+		{
+			StartTime = FPlatformTime::Seconds();
+		}
+
+		void SpawnDue(double Now)
+		{
+			const int32 Due = FMath::Min(Settings.NumUsers, FMath::FloorToInt(static_cast<float>((Now - StartTime) * Settings.SpawnRate)) + 1);
+			while (Spawned < Due)
+			{
+				SendReceipts(Spawned);
+				Spawned++;
+			}
+		}
+
+		bool IsFinished() const
+		{
+			return Spawned == Settings.NumUsers && Answered == Sent;
+		}
+
+		void Report() const
+		{
+			const double Seconds = FPlatformTime::Seconds() - StartTime;
+			const FAccelByteServerValidationStats Stats = FAccelByteServerValidation::Get().GetStats();
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("Server load test: %d users - %d receipts - %d validated - %d failed - %d rate limited - %d refused - %.1f s - %.1f receipts/s"),
+				Settings.NumUsers, Sent, Validated, FailedFlows, RateLimited, Refused, Seconds, Seconds > 0.0 ? Answered / Seconds : 0.0);
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("  deduplicated %d - logins %d - latency avg %.1f ms - max %.1f ms"),
+				Stats.Deduplicated, Stats.Logins, Stats.AverageLatencyMs, Stats.MaxLatencyMs);
+
+			for (FAccelByteTelemetry::FOpSummary const& Summary : FAccelByteTelemetry::Summarize())
+			{
+				UE_LOG(LogAccelByteSampleApp, Display, TEXT("  %-40s count %6lld - errors %5lld - %.1f req/s - p50 %.1f ms - p95 %.1f ms - p99 %.1f ms - max %.1f ms"),
+					*Summary.Operation, Summary.Count, Summary.Errors, Seconds > 0.0 ? Summary.Count / Seconds : 0.0, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs);
+			}
+		}
+
+		// Rate limited and refused receipts are the service doing its job, only backend failures count
+		int32 GetFailedFlows() const { return FailedFlows; }
+		int32 GetUnfinishedUsers() const
+		{
+			int32 Unfinished = Settings.NumUsers - Spawned;
+			for (int32 Count : Outstanding)
+			{
+				Unfinished += Count > 0 ? 1 : 0;
+			}
+			return Unfinished;
+		}
+
+	private:
+		void SendReceipts(int32 UserIndex)
+		{
+			Outstanding.Add(Settings.Iterations);
+			TArray<FString> OrderIds;
+			for (int32 Iteration = 0; Iteration < Settings.Iterations; Iteration++)
+			{
+				const bool bDuplicate = OrderIds.Num() > 0 && Random.FRand() < Settings.DuplicateRatio;
+				const FString OrderId = bDuplicate ? OrderIds[Random.RandHelper(OrderIds.Num())] : FString::Printf(TEXT("GPA.loadtest-%d-%d"), UserIndex, Iteration);
+				OrderIds.AddUnique(OrderId);
+
+				FAccelByteServerValidation::FRequest Request;
+				Request.Kind = FAccelByteServerValidation::EKind::GooglePurchase;
+				Request.UserId = FString::Printf(TEXT("loadtest-%d"), UserIndex);
+				Request.GoogleReceipt.OrderId = OrderId;
+				Request.GoogleReceipt.ProductId = Settings.Skus.Num() > 0 ? Settings.Skus[0] : TEXT("loadtest");
+				Request.GoogleReceipt.PackageName = TEXT("net.accelbyte.loadtest");
+				Request.GoogleReceipt.PurchaseToken = OrderId;
+				Request.GoogleReceipt.PurchaseTime = FDateTime::UtcNow().ToUnixTimestamp() * 1000;
+
+				Sent++;
+				TSharedRef<FServerLoadTest> Self = AsShared();
+				FAccelByteServerValidation::Get().Submit(Request, [Self, UserIndex](FAccelByteServerValidation::FResult const& Result)
+				{
+					Self->OnResult(UserIndex, Result);
+				});
+			}
+		}
+
+		void OnResult(int32 UserIndex, FAccelByteServerValidation::FResult const& Result)
+		{
+			Answered++;
+			Outstanding[UserIndex]--;
+			if (Result.bSuccess)
+			{
+				Validated++;
+			}
+			else if (Result.ErrorCode == EHttpResponseCodes::TooManyRequests)
+			{
+				RateLimited++;
+			}
+			else if (Result.ErrorCode == EHttpResponseCodes::ServiceUnavail)
+			{
+				Refused++;
+			}
+			else
+			{
+				FailedFlows++;
+				UE_LOG(LogAccelByteSampleApp, Verbose, TEXT("Virtual user %d receipt failed, code: %d - message: %s"), UserIndex, Result.ErrorCode, *Result.ErrorMessage);
+			}
+		}
+
+		FSettings Settings;
+		FRandomStream Random;
+		double StartTime = 0.0;
+		int32 Spawned = 0;
+		// Receipts of each user still waiting for a result
+		TArray<int32> Outstanding;
+		int32 Sent = 0;
+		int32 Answered = 0;
+		int32 Validated = 0;
+		int32 RateLimited = 0;
+		int32 Refused = 0;
+		int32 FailedFlows = 0;
+	};
+
+	// No engine loop runs in a commandlet, tick what the SDK relies on: HTTP, the core ticker and game thread tasks
+	template <typename TLoadTest>
+	static void RunUntilFinished(TLoadTest& LoadTest, float TimeoutSeconds)
+	{
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		double LastTickTime = FPlatformTime::Seconds();
+		while (!LoadTest.IsFinished() && !IsEngineExitRequested())
+		{
+			const double Now = FPlatformTime::Seconds();
+			if (Now > Deadline)
+			{
+				UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Load test timed out with %d users still running"), LoadTest.GetUnfinishedUsers());
+				break;
+			}
+
+			const float DeltaSeconds = static_cast<float>(Now - LastTickTime);
+			LastTickTime = Now;
+
+			LoadTest.SpawnDue(Now);
+			FHttpModule::Get().GetHttpManager().Tick(DeltaSeconds);
+			FTicker::GetCoreTicker().Tick(DeltaSeconds);
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+			FPlatformProcess::Sleep(0.001f);
+		}
+	}
+}
+
+UAccelByteLoadTestCommandlet::UAccelByteLoadTestCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UAccelByteLoadTestCommandlet::Main(FString const& Params)
+{
+	using namespace AccelByteLoadTest;
+
+	FSettings Settings;
+	FParse::Value(*Params, TEXT("users="), Settings.NumUsers);
+	FParse::Value(*Params, TEXT("spawnrate="), Settings.SpawnRate);
+	FParse::Value(*Params, TEXT("iterations="), Settings.Iterations);
+	FParse::Value(*Params, TEXT("timeout="), Settings.TimeoutSeconds);
+	FParse::Value(*Params, TEXT("duplicates="), Settings.DuplicateRatio);
+	Settings.NumUsers = FMath::Max(1, Settings.NumUsers);
+	Settings.SpawnRate = FMath::Max(0.001f, Settings.SpawnRate);
+	Settings.Iterations = FMath::Max(1, Settings.Iterations);
+
+	FString Skus;
+	if (FParse::Value(*Params, TEXT("skus="), Skus, false))
+	{
+		Skus.ParseIntoArray(Settings.Skus, TEXT(","));
+	}
+
+	FString Platform;
+	if (FParse::Value(*Params, TEXT("platform="), Platform))
+	{
+		Settings.PlatformType = FAccelByteOnlineContext::GetPlatformTypeFromName(FName(*Platform));
+	}
+
+	FString BaseUrl;
+	if (FParse::Value(*Params, TEXT("url="), BaseUrl))
+	{
+		BaseUrl.RemoveFromEnd(TEXT("/"));
+		FRegistry::Settings.BaseUrl = BaseUrl;
+		FRegistry::Settings.IamServerUrl = BaseUrl / TEXT("iam");
+		FRegistry::Settings.PlatformServerUrl = BaseUrl / TEXT("platform");
+		FRegistry::ServerSettings.BaseUrl = BaseUrl;
+		FRegistry::ServerSettings.IamServerUrl = BaseUrl / TEXT("iam");
+		FRegistry::ServerSettings.PlatformServerUrl = BaseUrl / TEXT("platform");
+	}
+
+	const bool bServer = FParse::Param(*Params, TEXT("server"));
+	if (bServer)
+	{
+		FAccelByteServerValidation::FSettings ServerSettings;
+		FParse::Value(*Params, TEXT("concurrency="), ServerSettings.MaxConcurrency);
+		FParse::Value(*Params, TEXT("maxqueued="), ServerSettings.MaxQueued);
+		FParse::Value(*Params, TEXT("ratelimit="), ServerSettings.RateLimitPerMinute);
+		FParse::Value(*Params, TEXT("burst="), ServerSettings.RateLimitBurst);
+		FAccelByteServerValidation::Get().Configure(ServerSettings);
+	}
+
+	FString CsvPath;
+	FParse::Value(*Params, TEXT("csv="), CsvPath);
+
+	// -AccelByteRecord= and -AccelByteReplay= run the test through the HTTP fixture, replays need no backend
+	FAccelByteHttpFixture::Get().StartFromCommandLine(*Params);
+
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("%s load test against %s: %d users at %.1f users/s, %d iterations, %d SKUs"),
+		bServer ? TEXT("Server") : TEXT("Client"), *FRegistry::Settings.BaseUrl, Settings.NumUsers, Settings.SpawnRate, Settings.Iterations, Settings.Skus.Num());
+
+	FAccelByteTelemetry::SetEnabled(true);
+	FAccelByteTelemetry::Reset();
+
+	bool bPassed;
+	if (bServer)
+	{
+		TSharedRef<FServerLoadTest> LoadTest = MakeShared<FServerLoadTest>(Settings);
+		LoadTest->Start();
+		RunUntilFinished(*LoadTest, Settings.TimeoutSeconds);
+		LoadTest->Report();
+		bPassed = LoadTest->IsFinished() && LoadTest->GetFailedFlows() == 0;
+	}
+	else
+	{
+		TSharedRef<FLoadTest> LoadTest = MakeShared<FLoadTest>(Settings);
+		LoadTest->Start();
+		RunUntilFinished(*LoadTest, Settings.TimeoutSeconds);
+		LoadTest->Report();
+		bPassed = LoadTest->IsFinished() && LoadTest->GetFailedFlows() == 0;
+	}
+
+	FAccelByteTelemetry::DumpCsv(CsvPath);
+	FAccelByteHttpFixture::Get().Stop();
+
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AccelByteLoadTestCommandlet.generated.h"
+
+/**
+ * Runs the login, store browse and purchase sync flow for many virtual users in one headless process.
+ *
+ * Every virtual user gets its own API client, so their sessions do not interfere, and makes the same SDK calls as
+ * UAccelByteLogin, GetItemBySku and SyncPurchaseGooglePlay. The platform tokens and receipts are synthetic, point it
+ * at a mock backend that accepts them. Latency percentiles come from FAccelByteTelemetry.
+ *
+ * UE4Editor-Cmd AccelByteUe4SdkDemo -run=AccelByteLoadTest -nullrhi -url=http://localhost:8080 -users=1000
+ *     [-spawnrate=100] [-iterations=1] [-skus=SKU1,SKU2] [-platform=Device] [-timeout=600] [-csv=Path]
+ *
+ * With -server the virtual users are players of a dedicated server instead: each sends its -iterations receipts at
+ * once to FAccelByteServerValidation, which validates them with the server's client credentials. A share of the
+ * receipts is sent twice to exercise the dedupe, rate limited and refused receipts are reported apart from failures.
+ *
+ * UE4Editor-Cmd AccelByteUe4SdkDemo -run=AccelByteLoadTest -nullrhi -server -url=http://localhost:8080 -users=1000
+ *     [-iterations=5] [-duplicates=0.1] [-concurrency=16] [-maxqueued=1024] [-ratelimit=30] [-burst=10]
+ */
+UCLASS()
+class UAccelByteLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UAccelByteLoadTestCommandlet();
+
+	virtual int32 Main(FString const& Params) override;
+};
@@ -0,0 +1,353 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteLobbyState.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteChatHistory.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Containers/Ticker.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteLobbyApi.h"
+#include "Models/AccelByteLobbyModels.h"
+
+using namespace AccelByte;
+
+FAccelByteLobbyState& FAccelByteLobbyState::Get()
+{
+	static FAccelByteLobbyState Instance;
+	return Instance;
+}
+
+FAccelByteLobbyState::~FAccelByteLobbyState()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+	}
+}
+
+void FAccelByteLobbyState::SyncLobby()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	Api::Lobby& Lobby = FRegistry::Lobby;
+	if (!bLobbyBound)
+	{
+		bLobbyBound = true;
+
+		Lobby.SetLoadFriendListResponseDelegate(Api::Lobby::FLoadFriendListResponse::CreateLambda([this](FAccelByteModelsLoadFriendListResponse const& Response)
+		{
+			SetRelationList(ERelation::Friend, Response.friendsId);
+		}));
+		Lobby.SetListIncomingFriendsResponseDelegate(Api::Lobby::FListIncomingFriendsResponse::CreateLambda([this](FAccelByteModelsListIncomingFriendsResponse const& Response)
+		{
+			SetRelationList(ERelation::IncomingFriendRequest, Response.friendsId);
+		}));
+		Lobby.SetListOutgoingFriendsResponseDelegate(Api::Lobby::FListOutgoingFriendsResponse::CreateLambda([this](FAccelByteModelsListOutgoingFriendsResponse const& Response)
+		{
+			SetRelationList(ERelation::OutgoingFriendRequest, Response.friendsId);
+		}));
+
+		Lobby.SetOnIncomingRequestFriendsNotifDelegate(Api::Lobby::FRequestFriendsNotif::CreateLambda([this](FAccelByteModelsRequestFriendsNotif const& Notif)
+		{
+			SetRelation(Notif.friendId, ERelation::IncomingFriendRequest, true);
+		}));
+		Lobby.SetOnCancelFriendsNotifDelegate(Api::Lobby::FCancelFriendsNotif::CreateLambda([this](FAccelByteModelsCancelFriendsNotif const& Notif)
+		{
+			SetRelation(Notif.userId, ERelation::IncomingFriendRequest, false);
+		}));
+		Lobby.SetOnFriendRequestAcceptedNotifDelegate(Api::Lobby::FAcceptFriendsNotif::CreateLambda([this](FAccelByteModelsAcceptFriendsNotif const& Notif)
+		{
+			SetRelation(Notif.friendId, ERelation::OutgoingFriendRequest, false);
+			SetRelation(Notif.friendId, ERelation::Friend, true);
+		}));
+		Lobby.SetOnRejectFriendsNotifDelegate(Api::Lobby::FRejectFriendsNotif::CreateLambda([this](FAccelByteModelsRejectFriendsNotif const& Notif)
+		{
+			SetRelation(Notif.userId, ERelation::OutgoingFriendRequest, false);
+		}));
+		Lobby.SetOnUnfriendNotifDelegate(Api::Lobby::FUnfriendNotif::CreateLambda([this](FAccelByteModelsUnfriendNotif const& Notif)
+		{
+			SetRelation(Notif.friendId, ERelation::Friend, false);
+		}));
+
+		Lobby.SetUserPresenceNotifDelegate(Api::Lobby::FFriendStatusNotif::CreateLambda([this](FAccelByteModelsUsersPresenceNotice const& Notice)
+		{
+			QueuePresence(Notice.UserID, Notice.Availability, Notice.Activity, Notice.LastSeenAt);
+		}));
+		Lobby.SetPrivateMessageNotifDelegate(Api::Lobby::FPersonalChatNotif::CreateLambda([this](FAccelByteModelsPersonalMessageNotice const& Notice)
+		{
+			FAccelByteChatHistory::Get().Add(FAccelByteChatHistory::GetPrivateChannel(Notice.From), Notice.From, Notice.Payload);
+			AddUnreadMessage(Notice.From);
+		}));
+		Lobby.SetPartyChatNotifDelegate(Api::Lobby::FPartyChatNotif::CreateLambda([](FAccelByteModelsPartyMessageNotice const& Notice)
+		{
+			FAccelByteChatHistory::Get().Add(FAccelByteChatHistory::GetPartyChannel(), Notice.From, Notice.Payload);
+		}));
+		Lobby.SetChannelMessageNotifDelegate(Api::Lobby::FChannelChatNotif::CreateLambda([](FAccelByteModelsChannelMessageNotice const& Notice)
+		{
+			FAccelByteChatHistory::Get().Add(FAccelByteChatHistory::GetLobbyChannel(Notice.ChannelSlug), Notice.From, Notice.Payload);
+		}));
+
+		// Party rows never include the local user
+		auto SetParty = [this](FString const& LeaderId, TArray<FString> Members)
+		{
+			const FString LocalUserId = FRegistry::Credentials.GetUserId();
+			Members.Remove(LocalUserId);
+			SetRelationList(ERelation::PartyMember, Members);
+			SetRelationList(ERelation::PartyLeader, LeaderId.IsEmpty() || LeaderId == LocalUserId ? TArray<FString>() : TArray<FString>{ LeaderId });
+		};
+		Lobby.SetInfoPartyResponseDelegate(Api::Lobby::FPartyInfoResponse::CreateLambda([SetParty](FAccelByteModelsInfoPartyResponse const& Response)
+		{
+			SetParty(Response.LeaderId, Response.Members);
+		}));
+		Lobby.SetPartyDataUpdateNotifDelegate(Api::Lobby::FPartyDataUpdateNotif::CreateLambda([SetParty](FAccelByteModelsPartyDataNotif const& Notif)
+		{
+			SetParty(Notif.Leader, Notif.Members);
+		}));
+		Lobby.SetPartyKickNotifDelegate(Api::Lobby::FPartyKickNotif::CreateLambda([SetParty](FAccelByteModelsGotKickedFromPartyNotice const&)
+		{
+			SetParty(FString(), TArray<FString>());
+		}));
+	}
+
+	Lobby.LoadFriendsList();
+	Lobby.ListIncomingFriends();
+	Lobby.ListOutgoingFriends();
+	Lobby.SendInfoPartyRequest();
+}
+
+void FAccelByteLobbyState::Reset()
+{
+	Users.Reset();
+	KnownPresence.Reset();
+	PendingPresence.Reset();
+	PendingChanges.Reset();
+}
+
+FAccelByteLobbyState::FRelationFlag FAccelByteLobbyState::GetRelationFlag(ERelation Relation)
+{
+	switch (Relation)
+	{
+	case ERelation::IncomingFriendRequest: return &FAccelByteLobbyUser::bIncomingFriendRequest;
+	case ERelation::OutgoingFriendRequest: return &FAccelByteLobbyUser::bOutgoingFriendRequest;
+	case ERelation::PartyMember: return &FAccelByteLobbyUser::bPartyMember;
+	case ERelation::PartyLeader: return &FAccelByteLobbyUser::bPartyLeader;
+	default: return &FAccelByteLobbyUser::bFriend;
+	}
+}
+
+bool FAccelByteLobbyState::HasAnyRelation(FAccelByteLobbyUser const& User)
+{
+	return User.bFriend || User.bIncomingFriendRequest || User.bOutgoingFriendRequest || User.bPartyMember || User.bPartyLeader;
+}
+
+void FAccelByteLobbyState::SetRelation(FString const& UserId, ERelation Relation, bool bSet)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	if (UserId.IsEmpty())
+	{
+		return;
+	}
+
+	FAccelByteLobbyUser* User = Users.Find(UserId);
+	if (User == nullptr)
+	{
+		if (!bSet)
+		{
+			return;
+		}
+		User = &Users.Add(UserId);
+		User->UserId = UserId;
+		if (FPresence const* Presence = KnownPresence.Find(UserId))
+		{
+			User->Availability = Presence->Availability;
+			User->Activity = Presence->Activity;
+			User->LastSeenAt = Presence->LastSeenAt;
+		}
+		User->*GetRelationFlag(Relation) = true;
+		MarkChanged(UserId, EAccelByteLobbyChange::Added);
+		return;
+	}
+
+	bool& bFlag = User->*GetRelationFlag(Relation);
+	if (bFlag == bSet)
+	{
+		return;
+	}
+	bFlag = bSet;
+	if (HasAnyRelation(*User))
+	{
+		MarkChanged(UserId, EAccelByteLobbyChange::Updated);
+	}
+	else
+	{
+		Users.Remove(UserId);
+		MarkChanged(UserId, EAccelByteLobbyChange::Removed);
+	}
+}
+
+void FAccelByteLobbyState::SetRelationList(ERelation Relation, TArray<FString> const& UserIds)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	const TSet<FString> Listed(UserIds);
+	const FRelationFlag Flag = GetRelationFlag(Relation);
+
+	TArray<FString> Lost;
+	for (TPair<FString, FAccelByteLobbyUser>& Pair : Users)
+	{
+		if (Pair.Value.*Flag && !Listed.Contains(Pair.Key))
+		{
+			Lost.Add(Pair.Key);
+		}
+	}
+	for (FString const& UserId : Lost)
+	{
+		SetRelation(UserId, Relation, false);
+	}
+	for (FString const& UserId : Listed)
+	{
+		SetRelation(UserId, Relation, true);
+	}
+}
+
+void FAccelByteLobbyState::QueuePresence(FString const& UserId, FString const& Availability, FString const& Activity, FString const& LastSeenAt)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	if (UserId.IsEmpty())
+	{
+		return;
+	}
+
+	FPresence& Presence = PendingPresence.FindOrAdd(UserId);
+	Presence.Availability = Availability;
+	Presence.Activity = Activity;
+	Presence.LastSeenAt = LastSeenAt;
+	ScheduleFlush();
+}
+
+void FAccelByteLobbyState::AddUnreadMessage(FString const& UserId)
+{
+	if (FAccelByteLobbyUser* User = Users.Find(UserId))
+	{
+		User->UnreadMessages++;
+		MarkChanged(UserId, EAccelByteLobbyChange::Updated);
+	}
+}
+
+void FAccelByteLobbyState::ClearUnreadMessages(FString const& UserId)
+{
+	FAccelByteLobbyUser* User = Users.Find(UserId);
+	if (User != nullptr && User->UnreadMessages > 0)
+	{
+		User->UnreadMessages = 0;
+		MarkChanged(UserId, EAccelByteLobbyChange::Updated);
+	}
+}
+
+void FAccelByteLobbyState::MarkChanged(FString const& UserId, EAccelByteLobbyChange Change)
+{
+	EAccelByteLobbyChange* Pending = PendingChanges.Find(UserId);
+	if (Pending == nullptr)
+	{
+		PendingChanges.Add(UserId, Change);
+	}
+	else if (*Pending == EAccelByteLobbyChange::Added && Change == EAccelByteLobbyChange::Removed)
+	{
+		// Never shown, nothing to report
+		PendingChanges.Remove(UserId);
+	}
+	else if (*Pending == EAccelByteLobbyChange::Removed && Change == EAccelByteLobbyChange::Added)
+	{
+		// The widget still has the row from before the removal
+		*Pending = EAccelByteLobbyChange::Updated;
+	}
+	else if (*Pending != EAccelByteLobbyChange::Added)
+	{
+		*Pending = Change;
+	}
+	ScheduleFlush();
+}
+
+void FAccelByteLobbyState::ScheduleFlush()
+{
+	if (FlushTickerHandle.IsValid())
+	{
+		return;
+	}
+
+	FlushTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+	{
+		FlushTickerHandle.Reset();
+		Flush();
+		return false;
+	}));
+}
+
+void FAccelByteLobbyState::Flush()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Lobby);
+	for (TPair<FString, FPresence>& Pair : PendingPresence)
+	{
+		FPresence& Known = KnownPresence.FindOrAdd(Pair.Key);
+		Known = MoveTemp(Pair.Value);
+
+		FAccelByteLobbyUser* User = Users.Find(Pair.Key);
+		if (User == nullptr)
+		{
+			continue;
+		}
+		if (User->Availability != Known.Availability || User->Activity != Known.Activity || User->LastSeenAt != Known.LastSeenAt)
+		{
+			User->Availability = Known.Availability;
+			User->Activity = Known.Activity;
+			User->LastSeenAt = Known.LastSeenAt;
+			MarkChanged(Pair.Key, EAccelByteLobbyChange::Updated);
+		}
+	}
+	PendingPresence.Reset();
+
+	// Changes made by the listeners schedule the next flush
+	if (FlushTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+
+	if (PendingChanges.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FAccelByteLobbyRowChange> Changes;
+	Changes.Reserve(PendingChanges.Num());
+	for (TPair<FString, EAccelByteLobbyChange> const& Pair : PendingChanges)
+	{
+		FAccelByteLobbyRowChange& Change = Changes.AddDefaulted_GetRef();
+		Change.Change = Pair.Value;
+		if (Pair.Value == EAccelByteLobbyChange::Removed)
+		{
+			Change.User.UserId = Pair.Key;
+		}
+		else
+		{
+			Change.User = Users.FindChecked(Pair.Key);
+		}
+	}
+	PendingChanges.Reset();
+
+	ChangedEvent.Broadcast(Changes);
+}
+
+FAccelByteLobbyUser const* FAccelByteLobbyState::FindUser(FString const& UserId) const
+{
+	return Users.Find(UserId);
+}
+
+TArray<FAccelByteLobbyUser> FAccelByteLobbyState::GetUsers() const
+{
+	TArray<FAccelByteLobbyUser> Result;
+	Users.GenerateValueArray(Result);
+	return Result;
+}
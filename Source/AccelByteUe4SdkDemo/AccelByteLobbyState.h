@@ -0,0 +1,155 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteLobbyState.generated.h"
+
+UENUM(BlueprintType)
+enum class EAccelByteLobbyChange : uint8
+{
+	Added,
+	Updated,
+	Removed
+};
+
+/** A user the lobby widget shows a row for, either through a friend relationship or the party. */
+USTRUCT(BlueprintType)
+struct FAccelByteLobbyUser
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString UserId;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	bool bFriend = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	bool bIncomingFriendRequest = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	bool bOutgoingFriendRequest = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	bool bPartyMember = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	bool bPartyLeader = false;
+
+	// Presence as sent by the lobby, empty until the first presence notification for the user
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString Availability;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString Activity;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FString LastSeenAt;
+
+	// Private messages received since the row was last marked as read
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	int32 UnreadMessages = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteLobbyRowChange
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	EAccelByteLobbyChange Change = EAccelByteLobbyChange::Updated;
+
+	// The row after the change, only UserId is set for a removed row
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Lobby")
+	FAccelByteLobbyUser User;
+};
+
+/**
+ * Friends, friend requests, party and presence of the logged in user, kept as rows keyed by user id.
+ *
+ * Lobby notifications are applied as diffs to the rows instead of rebuilding the lists. Changes are collected
+ * during the frame and broadcast once from the core ticker, merged per row: a row added then updated in the same
+ * frame is reported as added, a row added then removed is not reported at all. Presence notifications are only
+ * queued when they arrive and applied at the flush, so a burst for the same user costs a single map write per
+ * notification and at most one row change per frame. Only meant to be used from the game thread.
+ */
+class FAccelByteLobbyState
+{
+public:
+	enum class ERelation : uint8
+	{
+		Friend,
+		IncomingFriendRequest,
+		OutgoingFriendRequest,
+		PartyMember,
+		PartyLeader
+	};
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnChanged, TArray<FAccelByteLobbyRowChange> const& /*Changes*/);
+
+	static FAccelByteLobbyState& Get();
+
+	~FAccelByteLobbyState();
+
+	/**
+	 * Routes the friend, party, presence and chat notifications of FRegistry::Lobby to this store and the chat
+	 * history, then requests the current friend lists and party. The lobby keeps a single handler per notification, so widgets
+	 * listen to OnChanged instead of binding the same notifications. Call it again to refetch the lists.
+	 */
+	void SyncLobby();
+
+	// Drops every row without reporting them as removed, used when another user logs in
+	void Reset();
+
+	void SetRelation(FString const& UserId, ERelation Relation, bool bSet);
+
+	// Replaces the set of users with the relation, only the users that gained or lost it change
+	void SetRelationList(ERelation Relation, TArray<FString> const& UserIds);
+
+	void QueuePresence(FString const& UserId, FString const& Availability, FString const& Activity, FString const& LastSeenAt);
+
+	void AddUnreadMessage(FString const& UserId);
+	void ClearUnreadMessages(FString const& UserId);
+
+	// Applies the queued presence and broadcasts the pending changes, called once per frame by the ticker
+	void Flush();
+
+	FAccelByteLobbyUser const* FindUser(FString const& UserId) const;
+
+	// Unordered
+	TArray<FAccelByteLobbyUser> GetUsers() const;
+
+	int32 Num() const { return Users.Num(); }
+
+	FOnChanged& OnChanged() { return ChangedEvent; }
+
+private:
+	struct FPresence
+	{
+		FString Availability;
+		FString Activity;
+		FString LastSeenAt;
+	};
+
+	using FRelationFlag = bool FAccelByteLobbyUser::*;
+
+	static FRelationFlag GetRelationFlag(ERelation Relation);
+	static bool HasAnyRelation(FAccelByteLobbyUser const& User);
+
+	void MarkChanged(FString const& UserId, EAccelByteLobbyChange Change);
+	void ScheduleFlush();
+
+	TMap<FString, FAccelByteLobbyUser> Users;
+
+	// Last presence of every user seen, rows created later start from it
+	TMap<FString, FPresence> KnownPresence;
+	TMap<FString, FPresence> PendingPresence;
+	TMap<FString, EAccelByteLobbyChange> PendingChanges;
+
+	FOnChanged ChangedEvent;
+	FDelegateHandle FlushTickerHandle;
+	bool bLobbyBound = false;
+};
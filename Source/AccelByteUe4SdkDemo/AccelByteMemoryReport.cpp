@@ -0,0 +1,269 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteMemoryReport.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemStats.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte"), STAT_AccelByteSummaryLLM, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Items"), STAT_AccelByteItemsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Receipts"), STAT_AccelByteReceiptsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Lobby"), STAT_AccelByteLobbyLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Images"), STAT_AccelByteImagesLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Entitlements"), STAT_AccelByteEntitlementsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Session"), STAT_AccelByteSessionLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte Statistics"), STAT_AccelByteStatisticsLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("AccelByte CloudSave"), STAT_AccelByteCloudSaveLLM, STATGROUP_LLMFULL);
+#endif
+
+namespace AccelByteMemoryReport
+{
+	constexpr int32 NumFeatures = static_cast<int32>(EAccelByteMemoryFeature::Count);
+
+	struct FFeatureState
+	{
+		int64 BudgetBytes = 0;
+		int64 PeakBytes = 0;
+		int32 OverBudgetCount = 0;
+		bool bOverBudget = false;
+		FAccelByteMemoryReport::FSizeProvider SizeProvider;
+	};
+
+	static FFeatureState Features[NumFeatures];
+	static FDelegateHandle TickerHandle;
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	// The tracker keeps the name pointers, they have to outlive it
+	static TCHAR const* const TagNames[NumFeatures] =
+	{
+		TEXT("AccelByteItems"),
+		TEXT("AccelByteReceipts"),
+		TEXT("AccelByteLobby"),
+		TEXT("AccelByteImages"),
+		TEXT("AccelByteEntitlements"),
+		TEXT("AccelByteSession"),
+		TEXT("AccelByteStatistics"),
+		TEXT("AccelByteCloudSave"),
+	};
+
+	static bool RegisterTags()
+	{
+		const FName StatNames[NumFeatures] =
+		{
+			GET_STATFNAME(STAT_AccelByteItemsLLM),
+			GET_STATFNAME(STAT_AccelByteReceiptsLLM),
+			GET_STATFNAME(STAT_AccelByteLobbyLLM),
+			GET_STATFNAME(STAT_AccelByteImagesLLM),
+			GET_STATFNAME(STAT_AccelByteEntitlementsLLM),
+			GET_STATFNAME(STAT_AccelByteSessionLLM),
+			GET_STATFNAME(STAT_AccelByteStatisticsLLM),
+			GET_STATFNAME(STAT_AccelByteCloudSaveLLM),
+		};
+
+		for (int32 Index = 0; Index < NumFeatures; Index++)
+		{
+			FLowLevelMemTracker::Get().RegisterProjectTag(static_cast<int32>(ELLMTag::ProjectTagStart) + Index, TagNames[Index], StatNames[Index], GET_STATFNAME(STAT_AccelByteSummaryLLM));
+		}
+		return true;
+	}
+
+	static int64 GetTrackedBytes(EAccelByteMemoryFeature Feature)
+	{
+		if (!FLowLevelMemTracker::IsEnabled())
+		{
+			return -1;
+		}
+		return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, FAccelByteMemoryReport::GetLLMTag(Feature));
+	}
+#else
+	static int64 GetTrackedBytes(EAccelByteMemoryFeature Feature)
+	{
+		return -1;
+	}
+#endif
+
+	static bool Tick(float DeltaSeconds)
+	{
+		FAccelByteMemoryReport::Sample();
+		return true;
+	}
+
+	static FString FormatKB(int64 Bytes)
+	{
+		return Bytes < 0 ? FString(TEXT("-")) : FString::Printf(TEXT("%.1f"), Bytes / 1024.0);
+	}
+}
+
+using namespace AccelByteMemoryReport;
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+ELLMTag FAccelByteMemoryReport::GetLLMTag(EAccelByteMemoryFeature Feature)
+{
+	// Registered by the first scope, before anything is counted under the tags
+	static const bool bRegistered = RegisterTags();
+	(void)bRegistered;
+	return static_cast<ELLMTag>(static_cast<int32>(ELLMTag::ProjectTagStart) + static_cast<int32>(Feature));
+}
+#endif
+
+void FAccelByteMemoryReport::SetBudget(EAccelByteMemoryFeature Feature, int64 BudgetBytes)
+{
+	FFeatureState& State = Features[static_cast<int32>(Feature)];
+	State.BudgetBytes = FMath::Max<int64>(0, BudgetBytes);
+	State.bOverBudget = false;
+}
+
+void FAccelByteMemoryReport::SetSizeProvider(EAccelByteMemoryFeature Feature, FSizeProvider&& SizeProvider)
+{
+	Features[static_cast<int32>(Feature)].SizeProvider = MoveTemp(SizeProvider);
+}
+
+void FAccelByteMemoryReport::SetSampleInterval(float Seconds)
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	if (Seconds > 0.0f)
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&AccelByteMemoryReport::Tick), Seconds);
+	}
+}
+
+void FAccelByteMemoryReport::Sample()
+{
+	Summarize();
+}
+
+TArray<FAccelByteMemoryReport::FFeatureSummary> FAccelByteMemoryReport::Summarize()
+{
+	TArray<FFeatureSummary> Summaries;
+	Summaries.Reserve(NumFeatures);
+	for (int32 Index = 0; Index < NumFeatures; Index++)
+	{
+		const EAccelByteMemoryFeature Feature = static_cast<EAccelByteMemoryFeature>(Index);
+		FFeatureState& State = Features[Index];
+
+		FFeatureSummary& Summary = Summaries.AddDefaulted_GetRef();
+		Summary.Feature = GetFeatureName(Feature);
+		Summary.TrackedBytes = GetTrackedBytes(Feature);
+		Summary.EstimatedBytes = State.SizeProvider ? State.SizeProvider() : -1;
+		Summary.CurrentBytes = FMath::Max<int64>(0, Summary.TrackedBytes >= 0 ? Summary.TrackedBytes : Summary.EstimatedBytes);
+
+		State.PeakBytes = FMath::Max(State.PeakBytes, Summary.CurrentBytes);
+
+		const bool bOverBudget = State.BudgetBytes > 0 && Summary.CurrentBytes > State.BudgetBytes;
+		if (bOverBudget && !State.bOverBudget)
+		{
+			State.OverBudgetCount++;
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("%s memory is over its budget: %.1f KB of %.1f KB (%s)"),
+				*Summary.Feature, Summary.CurrentBytes / 1024.0, State.BudgetBytes / 1024.0, Summary.TrackedBytes >= 0 ? TEXT("tracked") : TEXT("estimated"));
+		}
+		State.bOverBudget = bOverBudget;
+
+		Summary.PeakBytes = State.PeakBytes;
+		Summary.BudgetBytes = State.BudgetBytes;
+		Summary.OverBudgetCount = State.OverBudgetCount;
+	}
+	return Summaries;
+}
+
+void FAccelByteMemoryReport::ResetPeaks()
+{
+	for (FFeatureState& State : Features)
+	{
+		State.PeakBytes = 0;
+		State.OverBudgetCount = 0;
+		State.bOverBudget = false;
+	}
+}
+
+void FAccelByteMemoryReport::LogReport()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	const bool bTracking = FLowLevelMemTracker::IsEnabled();
+#else
+	const bool bTracking = false;
+#endif
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("AccelByte memory (%s):"), bTracking ? TEXT("tracked by LLM") : TEXT("estimated, run with -llm to track every allocation"));
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("  %-14s %12s %12s %12s %12s %5s"), TEXT("Feature"), TEXT("Tracked KB"), TEXT("Estimate KB"), TEXT("Peak KB"), TEXT("Budget KB"), TEXT("Over"));
+	for (FFeatureSummary const& Summary : Summarize())
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("  %-14s %12s %12s %12s %12s %5d"),
+			*Summary.Feature, *FormatKB(Summary.TrackedBytes), *FormatKB(Summary.EstimatedBytes), *FormatKB(Summary.PeakBytes),
+			Summary.BudgetBytes > 0 ? *FormatKB(Summary.BudgetBytes) : TEXT("-"), Summary.OverBudgetCount);
+	}
+}
+
+FString FAccelByteMemoryReport::DumpCsv(FString const& Path)
+{
+	const FString OutputPath = !Path.IsEmpty()
+		? Path
+		: FPaths::ProjectSavedDir() / TEXT("AccelByte") / FString::Printf(TEXT("Memory-%s.csv"), *FDateTime::Now().ToString());
+
+	// -1 where the tracker is not running or the feature has no estimate
+	FString Csv = TEXT("Feature,TrackedBytes,EstimatedBytes,CurrentBytes,PeakBytes,BudgetBytes,OverBudgetCount\n");
+	for (FFeatureSummary const& Summary : Summarize())
+	{
+		Csv += FString::Printf(TEXT("%s,%lld,%lld,%lld,%lld,%lld,%d\n")
+			, *Summary.Feature
+			, Summary.TrackedBytes
+			, Summary.EstimatedBytes
+			, Summary.CurrentBytes
+			, Summary.PeakBytes
+			, Summary.BudgetBytes
+			, Summary.OverBudgetCount);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to write memory report to %s"), *OutputPath);
+		return TEXT("");
+	}
+
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Memory report written to %s"), *OutputPath);
+	return OutputPath;
+}
+
+TCHAR const* FAccelByteMemoryReport::GetFeatureName(EAccelByteMemoryFeature Feature)
+{
+	switch (Feature)
+	{
+	case EAccelByteMemoryFeature::Items: return TEXT("Items");
+	case EAccelByteMemoryFeature::Receipts: return TEXT("Receipts");
+	case EAccelByteMemoryFeature::Lobby: return TEXT("Lobby");
+	case EAccelByteMemoryFeature::Images: return TEXT("Images");
+	case EAccelByteMemoryFeature::Entitlements: return TEXT("Entitlements");
+	case EAccelByteMemoryFeature::Session: return TEXT("Session");
+	case EAccelByteMemoryFeature::Statistics: return TEXT("Statistics");
+	case EAccelByteMemoryFeature::CloudSave: return TEXT("CloudSave");
+	default: return TEXT("Unknown");
+	}
+}
+
+static FAutoConsoleCommand AccelByteMemoryReportCommand(
+	TEXT("AccelByte.Sample.Memory.Report"),
+	TEXT("Log the memory held by each AccelByte feature with its high-water mark and budget"),
+	FConsoleCommandDelegate::CreateStatic(&FAccelByteMemoryReport::LogReport));
+
+static FAutoConsoleCommand AccelByteMemoryDumpCsvCommand(
+	TEXT("AccelByte.Sample.Memory.DumpCsv"),
+	TEXT("Write the memory held by each AccelByte feature to a CSV file. Usage: AccelByte.Sample.Memory.DumpCsv [Path]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](TArray<FString> const& Args)
+	{
+		FAccelByteMemoryReport::DumpCsv(Args.Num() > 0 ? Args[0] : TEXT(""));
+	}));
+
+static FAutoConsoleCommand AccelByteMemoryResetPeaksCommand(
+	TEXT("AccelByte.Sample.Memory.ResetPeaks"),
+	TEXT("Clear the high-water marks of the AccelByte features"),
+	FConsoleCommandDelegate::CreateStatic(&FAccelByteMemoryReport::ResetPeaks));
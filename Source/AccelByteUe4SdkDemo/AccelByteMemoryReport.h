@@ -0,0 +1,93 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+enum class EAccelByteMemoryFeature : uint8
+{
+	// Item cache, bulk item queries and the paged store catalog
+	Items,
+	// Receipt parsing, the purchase journal, purchase syncs and restores
+	Receipts,
+	// Lobby state and chat history
+	Lobby,
+	// Store item image downloads, decoding and the texture cache
+	Images,
+	// Entitlement and wallet mirror
+	Entitlements,
+	// Logins, the session cache, the warm-up and the async Blueprint nodes
+	Session,
+	// Stat and game profile write buffer
+	Statistics,
+	// Cloud save chunking, transfers and save containers
+	CloudSave,
+	Count
+};
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+// Attributes the allocations made until the end of the enclosing scope on this thread to a feature, SDK calls
+// made in the scope included, when the game runs with -llm
+#define ACCELBYTE_LLM_SCOPE(Feature) LLM_SCOPE(FAccelByteMemoryReport::GetLLMTag(Feature))
+#else
+#define ACCELBYTE_LLM_SCOPE(Feature)
+#endif
+
+/**
+ * Memory held by each online feature of the module, its high-water mark and its budget.
+ *
+ * With the low level memory tracker running (-llm), the allocations of the functions that open an
+ * ACCELBYTE_LLM_SCOPE are counted under a project tag per feature, which also shows them in stat LLMFULL and the
+ * LLM CSV. Without it, the features that account for what they keep (the item cache, the chat history and the image
+ * cache) report their own estimate through a size provider. The features are sampled on an interval, every sample
+ * updates the high-water marks and a feature going over its budget logs a warning once until it is back under.
+ * Response buffers the HTTP thread allocates before a handler runs are not attributed. Only meant to be used from
+ * the game thread.
+ */
+class FAccelByteMemoryReport
+{
+public:
+	struct FFeatureSummary
+	{
+		FString Feature;
+		// Bytes counted by the tracker, -1 while it is not running
+		int64 TrackedBytes = -1;
+		// Bytes reported by the size provider, -1 for features without one
+		int64 EstimatedBytes = -1;
+		// Tracked when available, estimated otherwise
+		int64 CurrentBytes = 0;
+		int64 PeakBytes = 0;
+		// Zero for no budget
+		int64 BudgetBytes = 0;
+		// Samples that found the feature over its budget after being under it
+		int32 OverBudgetCount = 0;
+	};
+
+	using FSizeProvider = TFunction<int64()>;
+
+	static void SetBudget(EAccelByteMemoryFeature Feature, int64 BudgetBytes);
+	static void SetSizeProvider(EAccelByteMemoryFeature Feature, FSizeProvider&& SizeProvider);
+
+	// Zero stops sampling, the report still samples when it is read
+	static void SetSampleInterval(float Seconds);
+
+	static void Sample();
+	static TArray<FFeatureSummary> Summarize();
+	static void ResetPeaks();
+
+	// Also run by AccelByte.Sample.Memory.Report
+	static void LogReport();
+
+	// Writes one row per feature, an empty path writes under Saved/AccelByte, returns the path or an empty string
+	static FString DumpCsv(FString const& Path = TEXT(""));
+
+	static TCHAR const* GetFeatureName(EAccelByteMemoryFeature Feature);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	// Registers the project tags on first use
+	static ELLMTag GetLLMTag(EAccelByteMemoryFeature Feature);
+#endif
+};
@@ -0,0 +1,156 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteOnlineContext.h"
+
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "Interfaces/OnlinePurchaseInterface.h"
+
+FAccelByteOnlineContext& FAccelByteOnlineContext::Get()
+{
+	static FAccelByteOnlineContext Instance;
+	return Instance;
+}
+
+FAccelByteOnlineContext::~FAccelByteOnlineContext()
+{
+	Invalidate();
+}
+
+void FAccelByteOnlineContext::Initialize(FString const& DefaultSubsystemName, FString const& NativeSubsystemName)
+{
+	Invalidate();
+
+	FSubsystemEntry& DefaultEntry = Entries[static_cast<uint8>(ESubsystem::Default)];
+	DefaultEntry.Name = FName(*DefaultSubsystemName);
+	DefaultEntry.PlatformType = GetPlatformTypeFromName(DefaultEntry.Name);
+
+	FSubsystemEntry& NativeEntry = Entries[static_cast<uint8>(ESubsystem::Native)];
+	NativeEntry.Name = FName(*NativeSubsystemName);
+	NativeEntry.PlatformType = GetPlatformTypeFromName(NativeEntry.Name);
+}
+
+void FAccelByteOnlineContext::Invalidate()
+{
+	for (FSubsystemEntry& Entry : Entries)
+	{
+		Release(Entry);
+	}
+}
+
+void FAccelByteOnlineContext::Release(FSubsystemEntry& Entry)
+{
+	if (const IOnlineIdentityPtr Identity = Entry.Identity.Pin())
+	{
+		for (TPair<int32, FDelegateHandle> const& Handle : Entry.LoginStatusHandles)
+		{
+			Identity->ClearOnLoginStatusChangedDelegate_Handle(Handle.Key, Handle.Value);
+		}
+	}
+
+	Entry.Subsystem = nullptr;
+	Entry.Identity.Reset();
+	Entry.Purchase.Reset();
+	Entry.UniqueIds.Reset();
+	Entry.LoginStatusHandles.Reset();
+}
+
+FAccelByteOnlineContext::FSubsystemEntry& FAccelByteOnlineContext::Resolve(ESubsystem Subsystem)
+{
+	FSubsystemEntry& Entry = Entries[static_cast<uint8>(Subsystem)];
+	if (Entry.Subsystem != nullptr && Entry.Identity.IsValid())
+	{
+		return Entry;
+	}
+
+	// Either never resolved or the subsystem has been shut down since and released its interfaces
+	Release(Entry);
+	Entry.Subsystem = IOnlineSubsystem::Get(Entry.Name);
+	if (Entry.Subsystem != nullptr)
+	{
+		Entry.Identity = Entry.Subsystem->GetIdentityInterface();
+		Entry.Purchase = Entry.Subsystem->GetPurchaseInterface();
+		// An empty name resolves to the default subsystem, its real name decides the platform type
+		Entry.PlatformType = GetPlatformTypeFromName(Entry.Subsystem->GetSubsystemName());
+	}
+	return Entry;
+}
+
+FName FAccelByteOnlineContext::GetSubsystemName(ESubsystem Subsystem) const
+{
+	return Entries[static_cast<uint8>(Subsystem)].Name;
+}
+
+EAccelBytePlatformType FAccelByteOnlineContext::GetPlatformType(ESubsystem Subsystem) const
+{
+	return Entries[static_cast<uint8>(Subsystem)].PlatformType;
+}
+
+IOnlineSubsystem* FAccelByteOnlineContext::GetSubsystem(ESubsystem Subsystem)
+{
+	return Resolve(Subsystem).Subsystem;
+}
+
+IOnlineIdentityPtr FAccelByteOnlineContext::GetIdentity(ESubsystem Subsystem)
+{
+	return Resolve(Subsystem).Identity.Pin();
+}
+
+IOnlinePurchasePtr FAccelByteOnlineContext::GetPurchase(ESubsystem Subsystem)
+{
+	return Resolve(Subsystem).Purchase.Pin();
+}
+
+TSharedPtr<const FUniqueNetId> FAccelByteOnlineContext::GetUniquePlayerId(ESubsystem Subsystem, int32 LocalUserNum)
+{
+	FSubsystemEntry& Entry = Resolve(Subsystem);
+	if (const TSharedPtr<const FUniqueNetId>* Cached = Entry.UniqueIds.Find(LocalUserNum))
+	{
+		return *Cached;
+	}
+
+	const IOnlineIdentityPtr Identity = Entry.Identity.Pin();
+	if (!Identity.IsValid())
+	{
+		return nullptr;
+	}
+
+	const TSharedPtr<const FUniqueNetId> UniqueId = Identity->GetUniquePlayerId(LocalUserNum);
+	if (!UniqueId.IsValid())
+	{
+		// Not logged in yet, nothing worth caching
+		return nullptr;
+	}
+
+	Entry.UniqueIds.Add(LocalUserNum, UniqueId);
+	if (!Entry.LoginStatusHandles.Contains(LocalUserNum))
+	{
+		const FDelegateHandle Handle = Identity->AddOnLoginStatusChangedDelegate_Handle(LocalUserNum, FOnLoginStatusChangedDelegate::CreateLambda([this, Subsystem](int32 ChangedUserNum, ELoginStatus::Type, ELoginStatus::Type, FUniqueNetId const&)
+		{
+			Entries[static_cast<uint8>(Subsystem)].UniqueIds.Remove(ChangedUserNum);
+		}));
+		Entry.LoginStatusHandles.Add(LocalUserNum, Handle);
+	}
+	return UniqueId;
+}
+
+EAccelBytePlatformType FAccelByteOnlineContext::GetPlatformTypeFromName(FName SubsystemName)
+{
+	// FName comparison ignores case, so the map replaces a chain of case insensitive string compares
+	static const TMap<FName, EAccelBytePlatformType> PlatformTypes =
+	{
+		{ FName(TEXT("GDK")), EAccelBytePlatformType::Live },
+		{ FName(TEXT("Live")), EAccelBytePlatformType::Live },
+		{ FName(TEXT("PS4")), EAccelBytePlatformType::PS4CrossGen },
+		{ FName(TEXT("PS5")), EAccelBytePlatformType::PS5 },
+		{ FName(TEXT("STEAM")), EAccelBytePlatformType::Steam },
+		{ FName(TEXT("GOOGLEPLAY")), EAccelBytePlatformType::Google },
+		{ FName(TEXT("GOOGLE")), EAccelBytePlatformType::Google },
+		{ FName(TEXT("IOS")), EAccelBytePlatformType::Apple },
+		{ FName(TEXT("APPLE")), EAccelBytePlatformType::Apple },
+	};
+
+	const EAccelBytePlatformType* PlatformType = PlatformTypes.Find(SubsystemName);
+	return PlatformType != nullptr ? *PlatformType : EAccelBytePlatformType::Device;
+}
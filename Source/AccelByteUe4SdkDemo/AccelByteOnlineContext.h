@@ -0,0 +1,68 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystem.h"
+#include "Models/AccelByteUserModels.h"
+
+/**
+ * Online subsystems and interfaces resolved once from the names in DefaultEngine.ini.
+ *
+ * The interfaces are held through weak pointers, a subsystem that has been shut down releases them and the next
+ * call resolves the subsystem again instead of touching a dangling pointer. Unique net ids are cached per local
+ * user and dropped when the login status of that user changes. Only meant to be used from the game thread.
+ */
+class FAccelByteOnlineContext
+{
+public:
+	enum class ESubsystem : uint8
+	{
+		// DefaultPlatformService, used for purchases
+		Default,
+		// NativePlatformService, used for login
+		Native
+	};
+
+	static FAccelByteOnlineContext& Get();
+
+	~FAccelByteOnlineContext();
+
+	void Initialize(FString const& DefaultSubsystemName, FString const& NativeSubsystemName);
+
+	// Drops every resolved subsystem, interface and unique net id
+	void Invalidate();
+
+	FName GetSubsystemName(ESubsystem Subsystem) const;
+
+	// Looked up once per resolve instead of on every call
+	EAccelBytePlatformType GetPlatformType(ESubsystem Subsystem) const;
+
+	IOnlineSubsystem* GetSubsystem(ESubsystem Subsystem);
+	IOnlineIdentityPtr GetIdentity(ESubsystem Subsystem);
+	IOnlinePurchasePtr GetPurchase(ESubsystem Subsystem);
+	TSharedPtr<const FUniqueNetId> GetUniquePlayerId(ESubsystem Subsystem, int32 LocalUserNum);
+
+	// Case insensitive like FName, unknown names map to EAccelBytePlatformType::Device
+	static EAccelBytePlatformType GetPlatformTypeFromName(FName SubsystemName);
+
+private:
+	struct FSubsystemEntry
+	{
+		FName Name;
+		EAccelBytePlatformType PlatformType = EAccelBytePlatformType::Device;
+		// Only dereferenced while Identity is still alive
+		IOnlineSubsystem* Subsystem = nullptr;
+		TWeakPtr<IOnlineIdentity, ESPMode::ThreadSafe> Identity;
+		TWeakPtr<IOnlinePurchase, ESPMode::ThreadSafe> Purchase;
+		TMap<int32, TSharedPtr<const FUniqueNetId>> UniqueIds;
+		TMap<int32, FDelegateHandle> LoginStatusHandles;
+	};
+
+	FSubsystemEntry& Resolve(ESubsystem Subsystem);
+	static void Release(FSubsystemEntry& Entry);
+
+	FSubsystemEntry Entries[2];
+};
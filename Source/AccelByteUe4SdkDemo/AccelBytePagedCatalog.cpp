@@ -0,0 +1,287 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelBytePagedCatalog.h"
+#include "AccelByteItemCache.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteItemApi.h"
+
+// Scroll notifications further apart than this mean the list stopped
+#define PAGED_CATALOG_SCROLL_IDLE_SECONDS 0.25
+#define PAGED_CATALOG_FAILURE_RETRY_SECONDS 2.0
+#define PAGED_CATALOG_FRAME_SAMPLES 1024
+
+using namespace AccelByte;
+
+namespace AccelBytePagedCatalog
+{
+	static UAccelBytePagedCatalog::FSettings DefaultSettings;
+
+	static float GetPercentile(TArray<float> Samples, float Percentile)
+	{
+		if (Samples.Num() == 0)
+		{
+			return 0.0f;
+		}
+		Samples.Sort();
+		return Samples[FMath::Clamp(FMath::CeilToInt(Percentile * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+	}
+}
+
+using namespace AccelBytePagedCatalog;
+
+void UAccelBytePagedCatalog::SetDefaultSettings(FSettings const& InSettings)
+{
+	DefaultSettings = InSettings;
+}
+
+UAccelBytePagedCatalog* UAccelBytePagedCatalog::CreatePagedCatalog(FString const& Language, FString const& Region)
+{
+	FAccelByteModelsItemCriteria Criteria;
+	Criteria.Language = Language;
+	Criteria.Region = Region;
+
+	return CreatePagedCatalogFromSource([Criteria](int32 Offset, int32 Limit, FOnPage&& OnPage, FOnError&& OnError)
+	{
+		const FAccelByteTelemetry::FRequest Request = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::GetItemsByCriteria);
+		FRegistry::Item.GetItemsByCriteria(Criteria, Offset, Limit
+			, FAccelByteTelemetry::WrapSuccess(Request, THandler<FAccelByteModelsItemPagingSlicedResult>::CreateLambda([Limit, OnPage = MoveTemp(OnPage)](FAccelByteModelsItemPagingSlicedResult const& Result)
+			{
+				OnPage(Result.Data, Result.Data.Num() == Limit && !Result.Paging.Next.IsEmpty());
+			}))
+			, FAccelByteTelemetry::WrapError(Request, FErrorHandler::CreateLambda([OnError = MoveTemp(OnError)](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				OnError(ErrorCode, ErrorMessage);
+			})));
+	}, DefaultSettings);
+}
+
+UAccelBytePagedCatalog* UAccelBytePagedCatalog::CreatePagedCatalogFromSource(FFetchPage&& InFetchPage, FSettings const& InSettings)
+{
+	UAccelBytePagedCatalog* Catalog = NewObject<UAccelBytePagedCatalog>();
+	Catalog->FetchPage = MoveTemp(InFetchPage);
+	Catalog->Settings = InSettings;
+	Catalog->Settings.PageSize = FMath::Max(1, Catalog->Settings.PageSize);
+	Catalog->Settings.PrefetchSeconds = FMath::Max(0.0f, Catalog->Settings.PrefetchSeconds);
+	Catalog->Settings.MaxPagesInFlight = FMath::Max(1, Catalog->Settings.MaxPagesInFlight);
+	return Catalog;
+}
+
+void UAccelBytePagedCatalog::Open()
+{
+	Generation++;
+	Entries.Reset();
+	ArrivedPages.Reset();
+	PagesInFlight.Reset();
+	NextPageToRequest = 0;
+	NextPageToAppend = 0;
+	bHasMore = true;
+	RetryTime = 0.0;
+	ItemOffset = 0.0f;
+	Velocity = 0.0f;
+	LastScrollTime = 0.0;
+	Metrics = FAccelByteCatalogMetrics();
+	ScrollFrameMs.Reset();
+	OpenTime = FPlatformTime::Seconds();
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAccelBytePagedCatalog::Tick));
+	}
+
+	RequestPagesUpTo(FMath::Max(0, VisibleRows - 1));
+}
+
+void UAccelBytePagedCatalog::NotifyScrolled(float InItemOffset, int32 InVisibleRows)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double Elapsed = Now - LastScrollTime;
+	if (LastScrollTime > 0.0 && Elapsed > 0.0 && Elapsed < PAGED_CATALOG_SCROLL_IDLE_SECONDS)
+	{
+		const float Instant = static_cast<float>((InItemOffset - ItemOffset) / Elapsed);
+		Velocity = FMath::Lerp(Velocity, Instant, 0.5f);
+	}
+	else
+	{
+		Velocity = 0.0f;
+	}
+
+	ItemOffset = InItemOffset;
+	VisibleRows = FMath::Max(0, InVisibleRows);
+	LastScrollTime = Now;
+	// A scroll is a user action, it may retry right away after a failure
+	RetryTime = 0.0;
+
+	RequestPagesUpTo(GetPredictedIndex());
+}
+
+int32 UAccelBytePagedCatalog::GetPredictedIndex() const
+{
+	const float Ahead = FMath::Max(0.0f, Velocity) * Settings.PrefetchSeconds;
+	return FMath::CeilToInt(ItemOffset + VisibleRows + Ahead);
+}
+
+void UAccelBytePagedCatalog::RequestPagesUpTo(int32 Index)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	if (!FetchPage || FPlatformTime::Seconds() < RetryTime)
+	{
+		return;
+	}
+
+	const int32 FirstInvisible = FMath::CeilToInt(ItemOffset) + VisibleRows;
+	while (bHasMore && PagesInFlight.Num() < Settings.MaxPagesInFlight && NextPageToRequest * Settings.PageSize <= Index)
+	{
+		const int32 Page = NextPageToRequest++;
+		if (Page < NextPageToAppend || PagesInFlight.Contains(Page) || ArrivedPages.Contains(Page))
+		{
+			continue;
+		}
+
+		PagesInFlight.Add(Page);
+		if (Page > 0 && Page * Settings.PageSize >= FirstInvisible)
+		{
+			Metrics.PagesPrefetched++;
+		}
+
+		TWeakObjectPtr<UAccelBytePagedCatalog> WeakThis(this);
+		const int32 RequestGeneration = Generation;
+		FetchPage(Page * Settings.PageSize, Settings.PageSize
+			, [WeakThis, RequestGeneration, Page](TArray<FAccelByteModelsItemInfo> const& Items, bool bInHasMore)
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->OnPageFetched(RequestGeneration, Page, Items, bInHasMore);
+				}
+			}
+			, [WeakThis, RequestGeneration, Page](int32 ErrorCode, FString const& ErrorMessage)
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->OnPageFailed(RequestGeneration, Page, ErrorCode, ErrorMessage);
+				}
+			});
+	}
+}
+
+void UAccelBytePagedCatalog::OnPageFetched(int32 InGeneration, int32 Page, TArray<FAccelByteModelsItemInfo> const& Items, bool bInHasMore)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	if (InGeneration != Generation)
+	{
+		return;
+	}
+
+	PagesInFlight.Remove(Page);
+	FArrivedPage& Arrived = ArrivedPages.Add(Page);
+	Arrived.Items = Items;
+	Arrived.bHasMore = bInHasMore;
+
+	TArray<UAccelByteCatalogEntry*> NewEntries;
+	while (bHasMore)
+	{
+		FArrivedPage* Next = ArrivedPages.Find(NextPageToAppend);
+		if (Next == nullptr)
+		{
+			break;
+		}
+
+		for (FAccelByteModelsItemInfo const& Item : Next->Items)
+		{
+			UAccelByteCatalogEntry* Entry = NewObject<UAccelByteCatalogEntry>(this);
+			Entry->Index = Entries.Num();
+			Entry->Item = Item;
+			Entries.Add(Entry);
+			NewEntries.Add(Entry);
+			FAccelByteItemCache::Get().AddItem(Item);
+		}
+		bHasMore = Next->bHasMore;
+		ArrivedPages.Remove(NextPageToAppend);
+		NextPageToAppend++;
+		Metrics.PagesLoaded++;
+	}
+	if (!bHasMore)
+	{
+		// Pages requested past the end are empty, nothing to wait for
+		ArrivedPages.Reset();
+		PagesInFlight.Reset();
+	}
+
+	Metrics.ItemsLoaded = Entries.Num();
+	if (NewEntries.Num() == 0)
+	{
+		return;
+	}
+	if (Metrics.OpenToFirstRowMs < 0.0f)
+	{
+		Metrics.OpenToFirstRowMs = static_cast<float>((FPlatformTime::Seconds() - OpenTime) * 1000.0);
+	}
+
+	OnPageLoaded.Broadcast(NewEntries);
+	RequestPagesUpTo(GetPredictedIndex());
+}
+
+void UAccelBytePagedCatalog::OnPageFailed(int32 InGeneration, int32 Page, int32 ErrorCode, FString const& ErrorMessage)
+{
+	if (InGeneration != Generation)
+	{
+		return;
+	}
+
+	PagesInFlight.Remove(Page);
+	NextPageToRequest = FMath::Min(NextPageToRequest, Page);
+	RetryTime = FPlatformTime::Seconds() + PAGED_CATALOG_FAILURE_RETRY_SECONDS;
+	OnFailed.Broadcast(ErrorCode, ErrorMessage);
+}
+
+bool UAccelBytePagedCatalog::Tick(float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+	if (LastScrollTime > 0.0 && Now - LastScrollTime < PAGED_CATALOG_SCROLL_IDLE_SECONDS)
+	{
+		const float FrameMs = DeltaSeconds * 1000.0f;
+		if (ScrollFrameMs.Num() < PAGED_CATALOG_FRAME_SAMPLES)
+		{
+			ScrollFrameMs.Add(FrameMs);
+		}
+		else
+		{
+			ScrollFrameMs[Metrics.ScrollFrames % PAGED_CATALOG_FRAME_SAMPLES] = FrameMs;
+		}
+		Metrics.ScrollFrames++;
+		Metrics.ScrollFrameMaxMs = FMath::Max(Metrics.ScrollFrameMaxMs, FrameMs);
+		if (bHasMore && FMath::CeilToInt(ItemOffset) + VisibleRows > Entries.Num())
+		{
+			Metrics.StarvedFrames++;
+		}
+	}
+
+	// Requests held back by the in flight cap or a failure go out as soon as they can
+	RequestPagesUpTo(GetPredictedIndex());
+	return true;
+}
+
+FAccelByteCatalogMetrics UAccelBytePagedCatalog::GetMetrics() const
+{
+	FAccelByteCatalogMetrics Result = Metrics;
+	Result.ScrollFrameP50Ms = GetPercentile(ScrollFrameMs, 0.5f);
+	Result.ScrollFrameP95Ms = GetPercentile(ScrollFrameMs, 0.95f);
+	return Result;
+}
+
+void UAccelBytePagedCatalog::BeginDestroy()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
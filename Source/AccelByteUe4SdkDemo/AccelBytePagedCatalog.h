@@ -0,0 +1,166 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelBytePagedCatalog.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteCatalogMetrics
+{
+	GENERATED_BODY()
+
+	// Wall time from Open to the first page being appended, negative until then
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	float OpenToFirstRowMs = -1.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 PagesLoaded = 0;
+
+	// Pages requested ahead of the visible rows because of the scroll velocity
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 PagesPrefetched = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 ItemsLoaded = 0;
+
+	// Frames ticked while the list was being scrolled
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 ScrollFrames = 0;
+
+	// Scroll frames where visible rows were past the loaded items
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 StarvedFrames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	float ScrollFrameP50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	float ScrollFrameP95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	float ScrollFrameMaxMs = 0.0f;
+};
+
+/** One catalog row, the list item of the store list views. */
+UCLASS(BlueprintType)
+class UAccelByteCatalogEntry : public UObject
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	int32 Index = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Catalog")
+	FAccelByteModelsItemInfo Item;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAccelByteCatalogPageLoaded, TArray<UAccelByteCatalogEntry*> const&, Entries);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAccelByteCatalogFailed, int32, ErrorCode, FString const&, ErrorMessage);
+
+/**
+ * Catalog data source for the Store, Marketplace and Item list views, fetched a page at a time.
+ *
+ * Only rows are created here, the entry widgets are left to a UListView which builds them for the visible rows
+ * only. The list view reports its scroll position through NotifyScrolled, the catalog keeps a smoothed scroll
+ * velocity and keeps the pages that the list will reach within PrefetchSeconds requested, with at most
+ * MaxPagesInFlight requests at once. Pages are appended in order even when their responses are not. Fetched
+ * items also seed the SKU item cache.
+ */
+UCLASS(BlueprintType)
+class UAccelBytePagedCatalog : public UObject
+{
+	GENERATED_BODY()
+public:
+	struct FSettings
+	{
+		int32 PageSize = 20;
+		float PrefetchSeconds = 1.0f;
+		int32 MaxPagesInFlight = 2;
+	};
+
+	using FOnPage = TFunction<void(TArray<FAccelByteModelsItemInfo> const& Items, bool bHasMore)>;
+	using FOnError = TFunction<void(int32 ErrorCode, FString const& ErrorMessage)>;
+	using FFetchPage = TFunction<void(int32 Offset, int32 Limit, FOnPage&& OnPage, FOnError&& OnError)>;
+
+	// Used by the catalogs created afterwards
+	static void SetDefaultSettings(FSettings const& InSettings);
+
+	// Pages of the published store through the Item API
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	static UAccelBytePagedCatalog* CreatePagedCatalog(FString const& Language, FString const& Region);
+
+	// Pages from another source, benchmarks and offline runs
+	static UAccelBytePagedCatalog* CreatePagedCatalogFromSource(FFetchPage&& InFetchPage, FSettings const& InSettings);
+
+	// The new rows, add them to the list view
+	UPROPERTY(BlueprintAssignable)
+	FAccelByteCatalogPageLoaded OnPageLoaded;
+
+	UPROPERTY(BlueprintAssignable)
+	FAccelByteCatalogFailed OnFailed;
+
+	// Drops the loaded rows and fetches the first page, call it again to refresh
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	void Open();
+
+	// Call from OnListViewScrolled with the item offset and the number of rows that fit in the list
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	void NotifyScrolled(float ItemOffset, int32 VisibleRows);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	TArray<UAccelByteCatalogEntry*> GetEntries() const { return Entries; }
+
+	int32 Num() const { return Entries.Num(); }
+
+	// False once a page came back as the last one
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	bool HasMore() const { return bHasMore; }
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Catalog")
+	FAccelByteCatalogMetrics GetMetrics() const;
+
+	virtual void BeginDestroy() override;
+
+private:
+	struct FArrivedPage
+	{
+		TArray<FAccelByteModelsItemInfo> Items;
+		bool bHasMore = false;
+	};
+
+	void RequestPagesUpTo(int32 Index);
+	void OnPageFetched(int32 InGeneration, int32 Page, TArray<FAccelByteModelsItemInfo> const& Items, bool bInHasMore);
+	void OnPageFailed(int32 InGeneration, int32 Page, int32 ErrorCode, FString const& ErrorMessage);
+	bool Tick(float DeltaSeconds);
+	int32 GetPredictedIndex() const;
+
+	FFetchPage FetchPage;
+	FSettings Settings;
+
+	UPROPERTY()
+	TArray<UAccelByteCatalogEntry*> Entries;
+
+	TMap<int32, FArrivedPage> ArrivedPages;
+	TSet<int32> PagesInFlight;
+	int32 NextPageToRequest = 0;
+	int32 NextPageToAppend = 0;
+	bool bHasMore = true;
+	int32 Generation = 0;
+	double OpenTime = 0.0;
+	double RetryTime = 0.0;
+
+	float ItemOffset = 0.0f;
+	int32 VisibleRows = 0;
+	float Velocity = 0.0f;
+	double LastScrollTime = 0.0;
+
+	FAccelByteCatalogMetrics Metrics;
+	// Most recent scroll frame times, a ring
+	TArray<float> ScrollFrameMs;
+	FDelegateHandle TickerHandle;
+};
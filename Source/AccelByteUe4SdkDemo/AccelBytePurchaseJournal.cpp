@@ -0,0 +1,495 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelBytePurchaseJournal.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteSampleBlueprints.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "Misc/Paths.h"
+#include "JsonObjectConverter.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteEntitlementApi.h"
+
+#define JOURNAL_OP_PENDING TEXT('P')
+#define JOURNAL_OP_ACKNOWLEDGED TEXT('A')
+
+FAccelBytePurchaseJournal& FAccelBytePurchaseJournal::Get()
+{
+	static FAccelBytePurchaseJournal Instance(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("PurchaseJournal.log"));
+	return Instance;
+}
+
+FAccelBytePurchaseJournal::FAccelBytePurchaseJournal(FString const& InPath)
+	: Path(InPath)
+	, DeadLetterPath(FPaths::ChangeExtension(InPath, TEXT("deadletter")))
+	, AliveToken(MakeShared<bool, ESPMode::ThreadSafe>(true))
+{
+}
+
+FAccelBytePurchaseJournal::~FAccelBytePurchaseJournal()
+{
+	if (BackoffTickerHandle.IsValid())
+	{
+		FTicker::GetCoreTicker().RemoveTicker(BackoffTickerHandle);
+	}
+	CloseWriter();
+}
+
+void FAccelBytePurchaseJournal::Configure
+	( int32 InReplayBatchSize
+	, float InInitialBackoffSeconds
+	, float InMaxBackoffSeconds
+	, int32 InMaxReplayAttempts
+	, int32 InCompactThreshold )
+{
+	ReplayBatchSize = FMath::Max(1, InReplayBatchSize);
+	InitialBackoffSeconds = FMath::Max(0.1f, InInitialBackoffSeconds);
+	MaxBackoffSeconds = FMath::Max(InitialBackoffSeconds, InMaxBackoffSeconds);
+	MaxReplayAttempts = FMath::Max(1, InMaxReplayAttempts);
+	CompactThreshold = FMath::Max(1, InCompactThreshold);
+}
+
+FString FAccelBytePurchaseJournal::RecordGoogle(FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest, int32 LocalUserNum)
+{
+	FString Payload;
+	FJsonObjectConverter::UStructToJsonObjectString(SyncRequest, Payload);
+	const FString& Key = SyncRequest.OrderId.IsEmpty() ? SyncRequest.PurchaseToken : SyncRequest.OrderId;
+	return Record(EPlatform::Google, TEXT("google:") + Key, LocalUserNum, Payload);
+}
+
+FString FAccelBytePurchaseJournal::RecordApple(FAccelByteModelsPlatformSyncMobileApple const& SyncRequest, int32 LocalUserNum)
+{
+	FString Payload;
+	FJsonObjectConverter::UStructToJsonObjectString(SyncRequest, Payload);
+	return Record(EPlatform::Apple, TEXT("apple:") + SyncRequest.TransactionId, LocalUserNum, Payload);
+}
+
+FString FAccelBytePurchaseJournal::Record(EPlatform Platform, FString const& Id, int32 LocalUserNum, FString const& Payload)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	if (FEntry* Existing = Pending.Find(Id))
+	{
+		Existing->bSentThisSession = true;
+		return Id;
+	}
+
+	FEntry& Entry = Pending.Add(Id);
+	Entry.Id = Id;
+	Entry.Platform = Platform;
+	Entry.LocalUserNum = LocalUserNum;
+	Entry.bSentThisSession = true;
+	// Pretty printed JSON only has line breaks and tabs between tokens, strings carry them escaped
+	Entry.Payload = Payload.Replace(TEXT("\r"), TEXT("")).Replace(TEXT("\n"), TEXT("")).Replace(TEXT("\t"), TEXT(""));
+	AppendLine(JOURNAL_OP_PENDING, Entry);
+	return Id;
+}
+
+void FAccelBytePurchaseJournal::Acknowledge(FString const& EntryId)
+{
+	FEntry Entry;
+	if (!Pending.RemoveAndCopyValue(EntryId, Entry))
+	{
+		return;
+	}
+
+	AppendLine(JOURNAL_OP_ACKNOWLEDGED, Entry);
+	AcknowledgedSinceCompact++;
+	if (bLoading)
+	{
+		AcknowledgedWhileLoading.Add(EntryId);
+	}
+	// Compacting before the file has been loaded would drop the records that are only on disk. Waiting for at least as
+	// many acknowledgements as there are pending records keeps the cost of rewriting the file linear in the journal size.
+	if (bLoaded && AcknowledgedSinceCompact >= FMath::Max(CompactThreshold, Pending.Num()))
+	{
+		Compact();
+	}
+}
+
+void FAccelBytePurchaseJournal::AppendLine(TCHAR Op, FEntry const& Entry)
+{
+	if (Writer == nullptr)
+	{
+		Writer = IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead);
+		if (Writer == nullptr)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot open purchase journal %s, the purchase is only tracked in memory"), *Path);
+			return;
+		}
+	}
+
+	FTCHARToUTF8 Utf8Line(*SerializeLine(Op, Entry));
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+	Writer->Flush();
+}
+
+void FAccelBytePurchaseJournal::Compact()
+{
+	CloseWriter();
+
+	// Acknowledgements only matter until the record they cancel is gone, so the compacted file holds pending records only
+	FString Content;
+	for (const TPair<FString, FEntry>& Pair : Pending)
+	{
+		Content += SerializeLine(JOURNAL_OP_PENDING, Pair.Value);
+	}
+
+	const FString TempPath = Path + TEXT(".tmp");
+	if (FFileHelper::SaveStringToFile(Content, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		&& IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		AcknowledgedSinceCompact = 0;
+	}
+	else
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to compact purchase journal %s"), *Path);
+	}
+}
+
+void FAccelBytePurchaseJournal::CloseWriter()
+{
+	if (Writer != nullptr)
+	{
+		Writer->Close();
+		delete Writer;
+		Writer = nullptr;
+	}
+}
+
+void FAccelBytePurchaseJournal::LoadAsync(FSimpleDelegate const& OnLoaded)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	if (bLoaded || bLoading)
+	{
+		return;
+	}
+	bLoading = true;
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	Async(EAsyncExecution::ThreadPool, [this, WeakAlive, OnLoaded, FilePath = Path]()
+	{
+		ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *FilePath);
+
+		TMap<FString, FEntry> Loaded;
+		int32 NumAcknowledged = 0;
+		int32 NumCorrupted = 0;
+		for (FString const& Line : Lines)
+		{
+			TCHAR Op;
+			FEntry Entry;
+			if (!ParseLine(Line, Op, Entry))
+			{
+				NumCorrupted++;
+				continue;
+			}
+
+			if (Op == JOURNAL_OP_PENDING)
+			{
+				Loaded.Add(Entry.Id, MoveTemp(Entry));
+			}
+			else
+			{
+				Loaded.Remove(Entry.Id);
+				NumAcknowledged++;
+			}
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [this, WeakAlive, OnLoaded, Loaded = MoveTemp(Loaded), NumAcknowledged, NumCorrupted]() mutable
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+			if (!WeakAlive.IsValid())
+			{
+				return;
+			}
+
+			for (TPair<FString, FEntry>& Pair : Loaded)
+			{
+				// Entries recorded or acknowledged while the file was being read are newer than their copy on disk
+				if (!Pending.Contains(Pair.Key) && !AcknowledgedWhileLoading.Contains(Pair.Key))
+				{
+					Pending.Add(Pair.Key, MoveTemp(Pair.Value));
+				}
+			}
+			AcknowledgedWhileLoading.Empty();
+			AcknowledgedSinceCompact += NumAcknowledged;
+			bLoading = false;
+			bLoaded = true;
+
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("Purchase journal loaded, %d pending syncs, %d corrupted lines skipped"), Pending.Num(), NumCorrupted);
+
+			if (AcknowledgedSinceCompact >= CompactThreshold || NumCorrupted > 0)
+			{
+				Compact();
+			}
+
+			OnLoaded.ExecuteIfBound();
+			if (bReplayRequested)
+			{
+				Replay();
+			}
+		});
+	});
+}
+
+void FAccelBytePurchaseJournal::SetReplayHandler(FReplayHandler&& InReplayHandler)
+{
+	ReplayHandler = MoveTemp(InReplayHandler);
+}
+
+void FAccelBytePurchaseJournal::Replay()
+{
+	bReplayRequested = true;
+	if (!bLoaded || bReplaying || Pending.Num() == 0)
+	{
+		return;
+	}
+
+	bReplayRequested = false;
+	bReplaying = true;
+	CurrentBackoffSeconds = 0.0f;
+	FailedThisPass.Reset();
+	ReplayNextBatch();
+}
+
+void FAccelBytePurchaseJournal::ReplayNextBatch()
+{
+	// Batches that finish synchronously would otherwise recurse once per batch
+	if (bStartingBatch)
+	{
+		bBatchFinishedWhileStarting = true;
+		return;
+	}
+
+	do
+	{
+		bBatchFinishedWhileStarting = false;
+		bStartingBatch = true;
+		StartBatch();
+		bStartingBatch = false;
+	}
+	while (bBatchFinishedWhileStarting);
+}
+
+void FAccelBytePurchaseJournal::StartBatch()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	TArray<FEntry> Batch;
+	for (int32 Pass = 0; Pass < 2 && Batch.Num() == 0; Pass++)
+	{
+		// Every sync left has failed in this pass, the next one starts over
+		if (Pass == 1)
+		{
+			if (FailedThisPass.Num() == 0)
+			{
+				break;
+			}
+			FailedThisPass.Reset();
+		}
+
+		for (const TPair<FString, FEntry>& Pair : Pending)
+		{
+			if (Pair.Value.bSentThisSession || FailedThisPass.Contains(Pair.Key))
+			{
+				continue;
+			}
+
+			Batch.Add(Pair.Value);
+			if (Batch.Num() >= ReplayBatchSize)
+			{
+				break;
+			}
+		}
+	}
+
+	if (Batch.Num() == 0)
+	{
+		bReplaying = false;
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Purchase journal replay finished"));
+		return;
+	}
+
+	struct FBatchState
+	{
+		int32 NumRetryableFailures = 0;
+	};
+	TSharedRef<FBatchState> BatchState = MakeShared<FBatchState>();
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+
+	TArray<FAccelByteTaskPipeline::FTask> Tasks;
+	for (FEntry const& Entry : Batch)
+	{
+		Tasks.Add([this, WeakAlive, BatchState, Entry](FSimpleDelegate const& OnDone)
+		{
+			ReplayEntry(Entry, [this, WeakAlive, BatchState, EntryId = Entry.Id, OnDone](bool bSuccess, bool bRetryable)
+			{
+				if (WeakAlive.IsValid())
+				{
+					FEntry* Stored = Pending.Find(EntryId);
+					if (bSuccess)
+					{
+						Acknowledge(EntryId);
+					}
+					else if (Stored != nullptr && (!bRetryable || ++Stored->ReplayAttempts >= MaxReplayAttempts))
+					{
+						UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Giving up on journaled purchase sync %s, moved to %s"), *EntryId, *DeadLetterPath);
+						DeadLetter(*Stored);
+						Acknowledge(EntryId);
+					}
+					else
+					{
+						FailedThisPass.Add(EntryId);
+						BatchState->NumRetryableFailures++;
+					}
+				}
+				OnDone.ExecuteIfBound();
+			});
+		});
+	}
+
+	TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Batch.Num());
+	Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([this, WeakAlive, BatchState]()
+	{
+		if (WeakAlive.IsValid())
+		{
+			OnBatchFinished(BatchState->NumRetryableFailures);
+		}
+	}));
+	Pipeline->EnqueueAll(MoveTemp(Tasks));
+}
+
+void FAccelBytePurchaseJournal::OnBatchFinished(int32 NumRetryableFailures)
+{
+	if (NumRetryableFailures == 0)
+	{
+		CurrentBackoffSeconds = 0.0f;
+		ReplayNextBatch();
+		return;
+	}
+
+	CurrentBackoffSeconds = CurrentBackoffSeconds <= 0.0f ? InitialBackoffSeconds : FMath::Min(CurrentBackoffSeconds * 2.0f, MaxBackoffSeconds);
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("%d journaled purchase syncs failed, retrying in %.1f seconds"), NumRetryableFailures, CurrentBackoffSeconds);
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	BackoffTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this, WeakAlive](float)
+	{
+		if (WeakAlive.IsValid())
+		{
+			BackoffTickerHandle.Reset();
+			ReplayNextBatch();
+		}
+		return false;
+	}), CurrentBackoffSeconds);
+}
+
+void FAccelBytePurchaseJournal::ReplayEntry(FEntry const& Entry, FReplayResult const& OnResult)
+{
+	if (ReplayHandler)
+	{
+		ReplayHandler(Entry, OnResult);
+		return;
+	}
+
+	// A rejected receipt would be rejected again, only network and server failures are retried
+	const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([OnResult, Id = Entry.Id](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Journaled purchase sync %s failed! code: %d - message: %s"), *Id, ErrorCode, *ErrorMessage);
+		OnResult(false, IsAccelByteErrorRetryable(ErrorCode));
+	});
+
+	if (Entry.Platform == EPlatform::Google)
+	{
+		FAccelByteModelsPlatformSyncMobileGoogle SyncRequest;
+		if (!FJsonObjectConverter::JsonObjectStringToUStruct(Entry.Payload, &SyncRequest, 0, 0))
+		{
+			OnResult(false, false);
+			return;
+		}
+
+		const AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse> OnSuccess = AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse>::CreateLambda(
+			[OnResult, LocalUserNum = Entry.LocalUserNum, ReceiptId = SyncRequest.OrderId](FAccelByteModelsPlatformSyncMobileGoogleResponse const& Response)
+			{
+				if (Response.NeedConsume)
+				{
+					FString FinalizeError;
+					UAccelByteBluePrintsSample::FinalizePurchaseForLocalUser(LocalUserNum, ReceiptId, FinalizeError);
+				}
+				OnResult(true, false);
+			});
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseGoogle);
+		FRegistry::Entitlement.SyncMobilePlatformPurchaseGooglePlay(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+	}
+	else
+	{
+		FAccelByteModelsPlatformSyncMobileApple SyncRequest;
+		if (!FJsonObjectConverter::JsonObjectStringToUStruct(Entry.Payload, &SyncRequest, 0, 0))
+		{
+			OnResult(false, false);
+			return;
+		}
+
+		const FSimpleDelegate OnSuccess = FSimpleDelegate::CreateLambda([OnResult]()
+		{
+			OnResult(true, false);
+		});
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseApple);
+		FRegistry::Entitlement.SyncMobilePlatformPurchaseApple(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+	}
+}
+
+void FAccelBytePurchaseJournal::DeadLetter(FEntry const& Entry)
+{
+	// Kept for support to sync by hand, the journal itself never reads it back
+	if (!FFileHelper::SaveStringToFile(SerializeLine(JOURNAL_OP_PENDING, Entry), *DeadLetterPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot write journaled purchase sync %s to %s"), *Entry.Id, *DeadLetterPath);
+	}
+}
+
+FString FAccelBytePurchaseJournal::SerializeLine(TCHAR Op, FEntry const& Entry)
+{
+	const FString Body = FString::Printf(TEXT("%c\t%s\t%d\t%d\t%s"), Op, *Entry.Id, static_cast<int32>(Entry.Platform), Entry.LocalUserNum, *Entry.Payload);
+	FTCHARToUTF8 Utf8Body(*Body);
+	const uint32 Crc = FCrc::MemCrc32(Utf8Body.Get(), Utf8Body.Length());
+	return FString::Printf(TEXT("%08x\t%s\n"), Crc, *Body);
+}
+
+bool FAccelBytePurchaseJournal::ParseLine(FString const& Line, TCHAR& OutOp, FEntry& OutEntry)
+{
+	if (Line.Len() < 10 || Line[8] != TEXT('\t'))
+	{
+		return false;
+	}
+
+	const FString Body = Line.Mid(9);
+	FTCHARToUTF8 Utf8Body(*Body);
+	const uint32 Crc = FCString::Strtoui64(*Line.Left(8), nullptr, 16);
+	if (Crc != FCrc::MemCrc32(Utf8Body.Get(), Utf8Body.Length()))
+	{
+		return false;
+	}
+
+	TArray<FString> Fields;
+	Body.ParseIntoArray(Fields, TEXT("\t"), false);
+	if (Fields.Num() != 5 || Fields[0].Len() != 1)
+	{
+		return false;
+	}
+
+	OutOp = Fields[0][0];
+	OutEntry.Id = Fields[1];
+	OutEntry.Platform = FCString::Atoi(*Fields[2]) == static_cast<int32>(EPlatform::Apple) ? EPlatform::Apple : EPlatform::Google;
+	OutEntry.LocalUserNum = FCString::Atoi(*Fields[3]);
+	OutEntry.Payload = Fields[4];
+	return OutOp == JOURNAL_OP_PENDING || OutOp == JOURNAL_OP_ACKNOWLEDGED;
+}
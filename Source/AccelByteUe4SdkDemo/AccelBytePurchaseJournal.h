@@ -0,0 +1,121 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Models/AccelByteEcommerceModels.h"
+
+/**
+ * Append only journal of purchase syncs that have not been acknowledged by the backend yet.
+ *
+ * A record is written before a sync request is sent and an acknowledgement after it succeeds, so a purchase
+ * whose sync was cut short by a crash or a kill is still in the journal on the next launch. Each line carries a
+ * CRC of its content, a line torn by a crash fails the check and is ignored. The file is rewritten with only
+ * the pending records once enough acknowledgements have accumulated.
+ *
+ * Loading parses the file on a worker thread. Replay sends the pending syncs in batches once a user is logged
+ * in and backs off exponentially while the backend keeps failing. A sync that failed waits behind the ones not
+ * tried yet, so a few failing receipts cannot hold back the rest. A sync the backend rejected, or one that kept
+ * failing, is acknowledged and copied to a dead letter file next to the journal.
+ */
+class FAccelBytePurchaseJournal
+{
+public:
+	enum class EPlatform : uint8
+	{
+		Google,
+		Apple
+	};
+
+	struct FEntry
+	{
+		FString Id;
+		EPlatform Platform = EPlatform::Google;
+		// Local player the purchase was made by, a replayed purchase that needs consuming is finalized for them
+		int32 LocalUserNum = 0;
+		// Sync request serialized as JSON
+		FString Payload;
+		int32 ReplayAttempts = 0;
+		// Recorded by a sync of the current session, which is still in charge of it and is not replayed
+		bool bSentThisSession = false;
+	};
+
+	// Reports the outcome of one replayed sync, a failure is retried with backoff unless it is not retryable
+	using FReplayResult = TFunction<void(bool bSuccess, bool bRetryable)>;
+	using FReplayHandler = TFunction<void(FEntry const& Entry, FReplayResult const& OnResult)>;
+
+	static FAccelBytePurchaseJournal& Get();
+
+	explicit FAccelBytePurchaseJournal(FString const& InPath);
+	~FAccelBytePurchaseJournal();
+
+	void Configure(int32 InReplayBatchSize, float InInitialBackoffSeconds, float InMaxBackoffSeconds, int32 InMaxReplayAttempts, int32 InCompactThreshold);
+
+	// Records a sync before it is sent and returns the id to acknowledge it with, the id is stable for the same purchase
+	FString RecordGoogle(FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest, int32 LocalUserNum = 0);
+	FString RecordApple(FAccelByteModelsPlatformSyncMobileApple const& SyncRequest, int32 LocalUserNum = 0);
+
+	void Acknowledge(FString const& EntryId);
+
+	// Reads the journal file on a worker thread, OnLoaded is called on the game thread
+	void LoadAsync(FSimpleDelegate const& OnLoaded = FSimpleDelegate());
+
+	// Starts sending the pending syncs, deferred until loading has finished
+	void Replay();
+
+	// Replaces the backend calls used by Replay, used to measure the journal without a backend
+	void SetReplayHandler(FReplayHandler&& InReplayHandler);
+
+	int32 NumPending() const { return Pending.Num(); }
+	bool IsLoaded() const { return bLoaded; }
+	bool IsReplaying() const { return bReplaying; }
+
+private:
+	FString Record(EPlatform Platform, FString const& Id, int32 LocalUserNum, FString const& Payload);
+	void AppendLine(TCHAR Op, FEntry const& Entry);
+	void Compact();
+	void CloseWriter();
+
+	void ReplayNextBatch();
+	void StartBatch();
+	void ReplayEntry(FEntry const& Entry, FReplayResult const& OnResult);
+	void DeadLetter(FEntry const& Entry);
+	void OnBatchFinished(int32 NumRetryableFailures);
+
+	static FString SerializeLine(TCHAR Op, FEntry const& Entry);
+	static bool ParseLine(FString const& Line, TCHAR& OutOp, FEntry& OutEntry);
+
+	FString Path;
+	FString DeadLetterPath;
+	FArchive* Writer = nullptr;
+
+	TMap<FString, FEntry> Pending;
+	int32 AcknowledgedSinceCompact = 0;
+	// Acknowledged while the file was being read, their record on disk is older than the acknowledgement
+	TSet<FString> AcknowledgedWhileLoading;
+
+	bool bLoaded = false;
+	bool bLoading = false;
+	bool bReplayRequested = false;
+	bool bReplaying = false;
+	bool bStartingBatch = false;
+	bool bBatchFinishedWhileStarting = false;
+	// Failed during the current pass over the pending syncs, they are only retried once the others were tried
+	TSet<FString> FailedThisPass;
+
+	int32 ReplayBatchSize = 16;
+	float InitialBackoffSeconds = 2.0f;
+	float MaxBackoffSeconds = 300.0f;
+	float CurrentBackoffSeconds = 0.0f;
+	int32 MaxReplayAttempts = 8;
+	int32 CompactThreshold = 64;
+
+	FReplayHandler ReplayHandler;
+	FDelegateHandle BackoffTickerHandle;
+
+	// Shared with worker and ticker callbacks so they can detect that the journal has been destroyed
+	TSharedRef<bool, ESPMode::ThreadSafe> AliveToken;
+};
@@ -0,0 +1,213 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelBytePurchaseRestore.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteReceiptParser.h"
+#include "AccelByteSampleBlueprints.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteEntitlementApi.h"
+
+// Receipts parsed by one worker before it picks up the next chunk, large enough to amortize the task overhead
+#define RESTORE_PARSE_CHUNK_SIZE 8
+
+int32 FAccelBytePurchaseRestore::DefaultMaxConcurrency = 4;
+
+void FAccelBytePurchaseRestore::SetDefaultMaxConcurrency(int32 InMaxConcurrency)
+{
+	DefaultMaxConcurrency = FMath::Max(1, InMaxConcurrency);
+}
+
+namespace AccelBytePurchaseRestore
+{
+	struct FRestoreState
+	{
+		TArray<FAccelByteRestoreReceiptResult> Results;
+		TArray<FAccelByteModelsPlatformSyncMobileGoogle> GoogleRequests;
+		TArray<FAccelByteModelsPlatformSyncMobileApple> AppleRequests;
+		int32 LocalUserNum = 0;
+		int32 MaxConcurrency = 1;
+		FAccelBytePurchaseRestore::FOnComplete OnComplete;
+	};
+
+	static void SyncGoogle(TSharedRef<FRestoreState> State, int32 ResultIndex, FSimpleDelegate const& OnDone)
+	{
+		FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest = State->GoogleRequests[ResultIndex];
+
+		const AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse> OnSyncSuccess = AccelByte::THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse>::CreateLambda(
+			[State, ResultIndex, OnDone](FAccelByteModelsPlatformSyncMobileGoogleResponse const& Response)
+			{
+				FAccelByteRestoreReceiptResult& Result = State->Results[ResultIndex];
+				Result.Status = EAccelByteRestoreReceiptStatus::Synced;
+				if (Response.NeedConsume)
+				{
+					FString FinalizeError;
+					if (UAccelByteBluePrintsSample::FinalizePurchaseForLocalUser(State->LocalUserNum, State->GoogleRequests[ResultIndex].OrderId, FinalizeError))
+					{
+						Result.Status = EAccelByteRestoreReceiptStatus::SyncedAndFinalized;
+					}
+					else
+					{
+						Result.Status = EAccelByteRestoreReceiptStatus::FinalizeFailed;
+						Result.ErrorCode = static_cast<int32>(AccelByte::ErrorCodes::UnknownError);
+						Result.ErrorMessage = FinalizeError;
+					}
+				}
+				OnDone.ExecuteIfBound();
+			});
+
+		const AccelByte::FErrorHandler OnSyncError = AccelByte::FErrorHandler::CreateLambda([State, ResultIndex, OnDone](int32 ErrorCode, FString const& ErrorMessage)
+		{
+			FAccelByteRestoreReceiptResult& Result = State->Results[ResultIndex];
+			Result.Status = EAccelByteRestoreReceiptStatus::SyncFailed;
+			Result.ErrorCode = ErrorCode;
+			Result.ErrorMessage = ErrorMessage;
+			OnDone.ExecuteIfBound();
+		});
+
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseGoogle);
+		FRegistry::Entitlement.SyncMobilePlatformPurchaseGooglePlay(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSyncSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnSyncError));
+	}
+
+	static void SyncApple(TSharedRef<FRestoreState> State, int32 ResultIndex, FSimpleDelegate const& OnDone)
+	{
+		FAccelByteModelsPlatformSyncMobileApple const& SyncRequest = State->AppleRequests[ResultIndex - State->GoogleRequests.Num()];
+
+		const FSimpleDelegate OnSyncSuccess = FSimpleDelegate::CreateLambda([State, ResultIndex, OnDone]()
+		{
+			State->Results[ResultIndex].Status = EAccelByteRestoreReceiptStatus::Synced;
+			OnDone.ExecuteIfBound();
+		});
+
+		const AccelByte::FErrorHandler OnSyncError = AccelByte::FErrorHandler::CreateLambda([State, ResultIndex, OnDone](int32 ErrorCode, FString const& ErrorMessage)
+		{
+			FAccelByteRestoreReceiptResult& Result = State->Results[ResultIndex];
+			Result.Status = EAccelByteRestoreReceiptStatus::SyncFailed;
+			Result.ErrorCode = ErrorCode;
+			Result.ErrorMessage = ErrorMessage;
+			OnDone.ExecuteIfBound();
+		});
+
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseApple);
+		FRegistry::Entitlement.SyncMobilePlatformPurchaseApple(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSyncSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnSyncError));
+	}
+
+	// Runs on the game thread once every Google receipt has been parsed
+	static void DedupeAndSync(TSharedRef<FRestoreState> State)
+	{
+		TSet<FString> SeenKeys;
+		TArray<FAccelByteTaskPipeline::FTask> Tasks;
+		for (int32 ResultIndex = 0; ResultIndex < State->Results.Num(); ResultIndex++)
+		{
+			FAccelByteRestoreReceiptResult& Result = State->Results[ResultIndex];
+			if (Result.Status == EAccelByteRestoreReceiptStatus::ParseFailed)
+			{
+				continue;
+			}
+
+			// A receipt without an order or transaction id cannot be told apart from another one, it is always sent
+			bool bAlreadySeen = false;
+			if (!Result.ReceiptKey.IsEmpty())
+			{
+				SeenKeys.Add((Result.bApple ? TEXT("apple:") : TEXT("google:")) + Result.ReceiptKey, &bAlreadySeen);
+			}
+			if (bAlreadySeen)
+			{
+				Result.Status = EAccelByteRestoreReceiptStatus::Duplicate;
+				continue;
+			}
+
+			if (Result.bApple)
+			{
+				Tasks.Add([State, ResultIndex](FSimpleDelegate const& OnDone) { SyncApple(State, ResultIndex, OnDone); });
+			}
+			else
+			{
+				Tasks.Add([State, ResultIndex](FSimpleDelegate const& OnDone) { SyncGoogle(State, ResultIndex, OnDone); });
+			}
+		}
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Restoring %d purchases, %d skipped as duplicate or unparsable"), Tasks.Num(), State->Results.Num() - Tasks.Num());
+
+		auto Complete = [State]()
+		{
+			State->OnComplete(MoveTemp(State->Results));
+		};
+
+		if (Tasks.Num() == 0)
+		{
+			Complete();
+			return;
+		}
+
+		TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(State->MaxConcurrency);
+		Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda(Complete));
+		Pipeline->EnqueueAll(MoveTemp(Tasks));
+	}
+}
+
+using namespace AccelBytePurchaseRestore;
+
+void FAccelBytePurchaseRestore::Run
+	( TArray<FString> const& GoogleReceipts
+	, TArray<FAccelByteModelsPlatformSyncMobileApple> const& AppleRequests
+	, int32 LocalUserNum
+	, int32 MaxConcurrency
+	, FOnComplete&& OnComplete )
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	TSharedRef<FRestoreState> State = MakeShared<FRestoreState>();
+	State->LocalUserNum = LocalUserNum;
+	State->MaxConcurrency = MaxConcurrency > 0 ? MaxConcurrency : DefaultMaxConcurrency;
+	State->OnComplete = MoveTemp(OnComplete);
+	State->AppleRequests = AppleRequests;
+	State->GoogleRequests.SetNum(GoogleReceipts.Num());
+	State->Results.SetNum(GoogleReceipts.Num() + AppleRequests.Num());
+
+	for (int32 Index = 0; Index < AppleRequests.Num(); Index++)
+	{
+		FAccelByteRestoreReceiptResult& Result = State->Results[GoogleReceipts.Num() + Index];
+		Result.ReceiptKey = AppleRequests[Index].TransactionId;
+		Result.SourceIndex = Index;
+		Result.bApple = true;
+	}
+
+	// Parsing only touches the receipt strings and the state slots of its own chunk, so it is safe off the game thread
+	Async(EAsyncExecution::TaskGraph, [State, GoogleReceipts]()
+	{
+		const int32 NumChunks = FMath::DivideAndRoundUp(GoogleReceipts.Num(), RESTORE_PARSE_CHUNK_SIZE);
+		ParallelFor(NumChunks, [&State, &GoogleReceipts](int32 Chunk)
+		{
+			ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+			FAccelByteReceiptParser Parser;
+			const int32 End = FMath::Min(GoogleReceipts.Num(), (Chunk + 1) * RESTORE_PARSE_CHUNK_SIZE);
+			for (int32 Index = Chunk * RESTORE_PARSE_CHUNK_SIZE; Index < End; Index++)
+			{
+				FAccelByteRestoreReceiptResult& Result = State->Results[Index];
+				FAccelByteModelsPlatformSyncMobileGoogle& SyncRequest = State->GoogleRequests[Index];
+				Result.SourceIndex = Index;
+				if (!Parser.Parse(GoogleReceipts[Index], SyncRequest))
+				{
+					Result.Status = EAccelByteRestoreReceiptStatus::ParseFailed;
+					Result.ErrorCode = static_cast<int32>(AccelByte::ErrorCodes::UnknownError);
+					Result.ErrorMessage = Parser.GetErrorMessage();
+					continue;
+				}
+				Result.ReceiptKey = SyncRequest.OrderId.IsEmpty() ? SyncRequest.PurchaseToken : SyncRequest.OrderId;
+			}
+		});
+
+		AsyncTask(ENamedThreads::GameThread, [State]()
+		{
+			DedupeAndSync(State);
+		});
+	});
+}
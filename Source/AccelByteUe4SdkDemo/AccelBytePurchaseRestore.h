@@ -0,0 +1,76 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelBytePurchaseRestore.generated.h"
+
+UENUM(BlueprintType)
+enum class EAccelByteRestoreReceiptStatus : uint8
+{
+	Synced,
+	// Synced and consumed on the native store because the backend asked for it
+	SyncedAndFinalized,
+	// Another receipt in the same batch has the same OrderId / TransactionId
+	Duplicate,
+	ParseFailed,
+	SyncFailed,
+	// Synced, but consuming the purchase on the native store failed
+	FinalizeFailed
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteRestoreReceiptResult
+{
+	GENERATED_BODY()
+
+	// OrderId for Google Play (purchase token for test purchases without one), TransactionId for Apple
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	FString ReceiptKey;
+
+	// Index of the receipt in the array it was passed in
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 SourceIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	bool bApple = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	EAccelByteRestoreReceiptStatus Status = EAccelByteRestoreReceiptStatus::Synced;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	int32 ErrorCode = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | IAP")
+	FString ErrorMessage;
+};
+
+/**
+ * Restores a batch of store purchases on the AccelByte backend.
+ *
+ * Google Play receipts are parsed in parallel on task graph workers, receipts that share an OrderId or
+ * TransactionId are synced only once, and the syncs run through a bounded concurrency pipeline. Consumables
+ * are finalized on the native store only for the Google Play entries whose sync response sets NeedConsume.
+ */
+class FAccelBytePurchaseRestore
+{
+public:
+	using FOnComplete = TFunction<void(TArray<FAccelByteRestoreReceiptResult>&& Results)>;
+
+	/**
+	 * @param GoogleReceipts Raw receipts from the Google Play purchase interface.
+	 * @param AppleRequests Sync requests for Apple purchases.
+	 * @param LocalUserNum Local user whose native purchases are finalized.
+	 * @param MaxConcurrency Maximum number of syncs in flight, zero or less uses the configured default.
+	 * @param OnComplete Called on the game thread with the Google results followed by the Apple results.
+	 */
+	static void Run(TArray<FString> const& GoogleReceipts, TArray<FAccelByteModelsPlatformSyncMobileApple> const& AppleRequests, int32 LocalUserNum, int32 MaxConcurrency, FOnComplete&& OnComplete);
+
+	static void SetDefaultMaxConcurrency(int32 InMaxConcurrency);
+
+private:
+	static int32 DefaultMaxConcurrency;
+};
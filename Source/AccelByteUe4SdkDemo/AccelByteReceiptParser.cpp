@@ -0,0 +1,554 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteReceiptParser.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Containers/StringConv.h"
+
+namespace AccelByteReceiptParser
+{
+	template <typename CharType>
+	static bool IsJsonWhitespace(CharType C)
+	{
+		return C == ' ' || C == '\t' || C == '\n' || C == '\r';
+	}
+
+	template <typename CharType>
+	static bool KeyEquals(const CharType* Key, int32 KeyLen, const ANSICHAR* Expected)
+	{
+		int32 Index = 0;
+		for (; Index < KeyLen; Index++)
+		{
+			if (Expected[Index] == '\0' || static_cast<uint32>(Key[Index]) != static_cast<uint32>(Expected[Index]))
+			{
+				return false;
+			}
+		}
+		return Expected[Index] == '\0';
+	}
+
+	/** Forward only JSON tokenizer over a character range, values are returned as ranges into the source. */
+	template <typename CharType>
+	struct TJsonScanner
+	{
+		const CharType* Begin;
+		const CharType* Cur;
+		const CharType* End;
+
+		TJsonScanner(const CharType* InBegin, int32 InLen)
+			: Begin(InBegin)
+			, Cur(InBegin)
+			, End(InBegin + InLen)
+		{
+		}
+
+		int32 Offset() const
+		{
+			return static_cast<int32>(Cur - Begin);
+		}
+
+		void SkipWhitespace()
+		{
+			while (Cur < End && IsJsonWhitespace(*Cur))
+			{
+				++Cur;
+			}
+		}
+
+		bool Consume(CharType Expected)
+		{
+			SkipWhitespace();
+			if (Cur < End && *Cur == Expected)
+			{
+				++Cur;
+				return true;
+			}
+			return false;
+		}
+
+		bool PeekString()
+		{
+			SkipWhitespace();
+			return Cur < End && *Cur == '"';
+		}
+
+		// Reads a string token, the returned range excludes the quotes and still holds any escape sequences
+		bool ReadString(const CharType*& OutStart, int32& OutLen, bool& bOutEscaped)
+		{
+			if (!PeekString())
+			{
+				return false;
+			}
+
+			++Cur;
+			OutStart = Cur;
+			bOutEscaped = false;
+			while (Cur < End)
+			{
+				if (*Cur == '"')
+				{
+					OutLen = static_cast<int32>(Cur - OutStart);
+					++Cur;
+					return true;
+				}
+				if (*Cur == '\\')
+				{
+					bOutEscaped = true;
+					++Cur;
+				}
+				++Cur;
+			}
+			return false;
+		}
+
+		// Reads a number or literal token
+		bool ReadScalar(const CharType*& OutStart, int32& OutLen)
+		{
+			SkipWhitespace();
+			OutStart = Cur;
+			while (Cur < End && !IsJsonWhitespace(*Cur) && *Cur != ',' && *Cur != '}' && *Cur != ']')
+			{
+				++Cur;
+			}
+			OutLen = static_cast<int32>(Cur - OutStart);
+			return OutLen > 0;
+		}
+
+		bool SkipValue()
+		{
+			SkipWhitespace();
+			if (Cur >= End)
+			{
+				return false;
+			}
+
+			const CharType* Start;
+			int32 Len;
+			bool bEscaped;
+			if (*Cur == '"')
+			{
+				return ReadString(Start, Len, bEscaped);
+			}
+
+			if (*Cur != '{' && *Cur != '[')
+			{
+				return ReadScalar(Start, Len);
+			}
+
+			int32 Nesting = 0;
+			while (Cur < End)
+			{
+				if (*Cur == '"')
+				{
+					if (!ReadString(Start, Len, bEscaped))
+					{
+						return false;
+					}
+					continue;
+				}
+
+				if (*Cur == '{' || *Cur == '[')
+				{
+					Nesting++;
+				}
+				else if (*Cur == '}' || *Cur == ']')
+				{
+					Nesting--;
+					if (Nesting == 0)
+					{
+						++Cur;
+						return true;
+					}
+				}
+				++Cur;
+			}
+			return false;
+		}
+
+		/**
+		 * Walks the members of an object, Visitor(Key, KeyLen) is called with the scanner positioned on the
+		 * member value and must consume it, returning false aborts the scan.
+		 */
+		template <typename FVisitor>
+		bool ScanObject(FVisitor&& Visitor)
+		{
+			if (!Consume('{'))
+			{
+				return false;
+			}
+			if (Consume('}'))
+			{
+				return true;
+			}
+
+			do
+			{
+				const CharType* Key;
+				int32 KeyLen;
+				bool bKeyEscaped;
+				if (!ReadString(Key, KeyLen, bKeyEscaped) || !Consume(':') || !Visitor(Key, KeyLen))
+				{
+					return false;
+				}
+			}
+			while (Consume(','));
+
+			return Consume('}');
+		}
+	};
+
+	static void AppendUtf8(TArray<ANSICHAR>& Out, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Out.Add(static_cast<ANSICHAR>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xC0 | (CodePoint >> 6)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Out.Add(static_cast<ANSICHAR>(0xE0 | (CodePoint >> 12)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Out.Add(static_cast<ANSICHAR>(0xF0 | (CodePoint >> 18)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Out.Add(static_cast<ANSICHAR>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	template <typename CharType>
+	static bool ReadHex4(const CharType* Src, uint32& OutValue)
+	{
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; Index++)
+		{
+			const uint32 C = static_cast<uint32>(Src[Index]);
+			OutValue <<= 4;
+			if (C >= '0' && C <= '9') { OutValue |= C - '0'; }
+			else if (C >= 'a' && C <= 'f') { OutValue |= C - 'a' + 10; }
+			else if (C >= 'A' && C <= 'F') { OutValue |= C - 'A' + 10; }
+			else { return false; }
+		}
+		return true;
+	}
+
+	// Resolves the escape sequences of a JSON string range into UTF-8
+	template <typename CharType>
+	static bool UnescapeToUtf8(const CharType* Src, int32 Len, TArray<ANSICHAR>& Out)
+	{
+		Out.Reset(Len);
+		for (int32 Index = 0; Index < Len; Index++)
+		{
+			const uint32 C = static_cast<uint32>(Src[Index]);
+			if (C != '\\')
+			{
+				if (sizeof(CharType) == 1)
+				{
+					// UTF-8 input is copied byte for byte
+					Out.Add(static_cast<ANSICHAR>(C));
+				}
+				else
+				{
+					AppendUtf8(Out, C);
+				}
+				continue;
+			}
+
+			if (++Index >= Len)
+			{
+				return false;
+			}
+
+			switch (static_cast<uint32>(Src[Index]))
+			{
+			case '"': Out.Add('"'); break;
+			case '\\': Out.Add('\\'); break;
+			case '/': Out.Add('/'); break;
+			case 'b': Out.Add('\b'); break;
+			case 'f': Out.Add('\f'); break;
+			case 'n': Out.Add('\n'); break;
+			case 'r': Out.Add('\r'); break;
+			case 't': Out.Add('\t'); break;
+			case 'u':
+			{
+				uint32 CodePoint;
+				if (Index + 4 >= Len || !ReadHex4(Src + Index + 1, CodePoint))
+				{
+					return false;
+				}
+				Index += 4;
+
+				uint32 LowSurrogate;
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Index + 6 < Len && Src[Index + 1] == '\\' && Src[Index + 2] == 'u' && ReadHex4(Src + Index + 3, LowSurrogate))
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+					Index += 6;
+				}
+				AppendUtf8(Out, CodePoint);
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static const int8* GetBase64DecodeTable()
+	{
+		static int8 Table[256];
+		static bool bInitialized = [&]()
+		{
+			FMemory::Memset(Table, -1, sizeof(Table));
+			const ANSICHAR* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (int32 Index = 0; Index < 64; Index++)
+			{
+				Table[static_cast<uint8>(Alphabet[Index])] = static_cast<int8>(Index);
+			}
+			return true;
+		}();
+		(void)bInitialized;
+		return Table;
+	}
+
+	/**
+	 * Decodes standard Base64 (padding optional) into Out, reusing its allocation.
+	 * @return false with OutErrorIndex set to the offending character on invalid input.
+	 */
+	template <typename CharType>
+	static bool DecodeBase64(const CharType* Src, int32 Len, TArray<uint8>& Out, int32& OutErrorIndex)
+	{
+		while (Len > 0 && Src[Len - 1] == '=')
+		{
+			Len--;
+		}
+		if (Len % 4 == 1)
+		{
+			OutErrorIndex = Len - 1;
+			return false;
+		}
+
+		const int8* Table = GetBase64DecodeTable();
+		Out.SetNumUninitialized(Len / 4 * 3 + 2, false);
+		uint8* Dest = Out.GetData();
+
+		uint32 Accumulator = 0;
+		int32 Bits = 0;
+		for (int32 Index = 0; Index < Len; Index++)
+		{
+			const uint32 C = static_cast<uint32>(Src[Index]);
+			const int8 Value = C < 256 ? Table[C] : -1;
+			if (Value < 0)
+			{
+				OutErrorIndex = Index;
+				return false;
+			}
+
+			Accumulator = (Accumulator << 6) | static_cast<uint32>(Value);
+			Bits += 6;
+			if (Bits >= 8)
+			{
+				Bits -= 8;
+				*Dest++ = static_cast<uint8>(Accumulator >> Bits);
+			}
+		}
+
+		Out.SetNum(static_cast<int32>(Dest - Out.GetData()), false);
+		return true;
+	}
+
+	static FString Utf8ToString(const ANSICHAR* Utf8, int32 Len)
+	{
+		const FUTF8ToTCHAR Converter(Utf8, Len);
+		return FString(Converter.Length(), Converter.Get());
+	}
+}
+
+using namespace AccelByteReceiptParser;
+
+bool FAccelByteReceiptParser::DecodeReceiptData(FString const& Receipt)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	Error = EAccelByteReceiptParseError::None;
+	ErrorOffset = INDEX_NONE;
+	DecodedBuffer.Reset();
+
+	TJsonScanner<TCHAR> Scanner(*Receipt, Receipt.Len());
+	const TCHAR* EncodedStart = nullptr;
+	int32 EncodedLen = 0;
+	bool bEncodedEscaped = false;
+	int32 EncodedOffset = INDEX_NONE;
+
+	const bool bOuterParsed = Scanner.ScanObject([&](const TCHAR* Key, int32 KeyLen)
+	{
+		if (EncodedStart == nullptr && KeyEquals(Key, KeyLen, "receiptData") && Scanner.PeekString())
+		{
+			EncodedOffset = Scanner.Offset();
+			return Scanner.ReadString(EncodedStart, EncodedLen, bEncodedEscaped);
+		}
+		return Scanner.SkipValue();
+	});
+
+	if (!bOuterParsed)
+	{
+		return Fail(EAccelByteReceiptParseError::MalformedReceipt, Scanner.Offset());
+	}
+	if (EncodedStart == nullptr)
+	{
+		return Fail(EAccelByteReceiptParseError::MissingReceiptData, INDEX_NONE);
+	}
+
+	int32 InvalidIndex = INDEX_NONE;
+	bool bDecoded;
+	if (bEncodedEscaped)
+	{
+		// JSON encoders may write '/' as "\/", which is the only escape valid Base64 can contain
+		if (!UnescapeToUtf8(EncodedStart, EncodedLen, UnescapeBuffer))
+		{
+			return Fail(EAccelByteReceiptParseError::MalformedReceipt, EncodedOffset);
+		}
+		bDecoded = DecodeBase64(UnescapeBuffer.GetData(), UnescapeBuffer.Num(), DecodedBuffer, InvalidIndex);
+	}
+	else
+	{
+		bDecoded = DecodeBase64(EncodedStart, EncodedLen, DecodedBuffer, InvalidIndex);
+	}
+
+	if (!bDecoded)
+	{
+		return Fail(EAccelByteReceiptParseError::InvalidBase64, InvalidIndex);
+	}
+	return true;
+}
+
+bool FAccelByteReceiptParser::Parse(FString const& Receipt, FAccelByteModelsPlatformSyncMobileGoogle& OutSyncRequest)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	if (!DecodeReceiptData(Receipt))
+	{
+		return false;
+	}
+
+	const ANSICHAR* Data = reinterpret_cast<const ANSICHAR*>(DecodedBuffer.GetData());
+	TJsonScanner<ANSICHAR> Scanner(Data, DecodedBuffer.Num());
+
+	bool bHasPackageName = false;
+	bool bHasProductId = false;
+	bool bHasPurchaseToken = false;
+
+	auto ReadStringField = [&](FString& OutValue) -> bool
+	{
+		const ANSICHAR* Start;
+		int32 Len;
+		bool bEscaped;
+		if (!Scanner.ReadString(Start, Len, bEscaped))
+		{
+			return false;
+		}
+		if (!bEscaped)
+		{
+			OutValue = Utf8ToString(Start, Len);
+			return true;
+		}
+		if (!UnescapeToUtf8(Start, Len, UnescapeBuffer))
+		{
+			return false;
+		}
+		OutValue = Utf8ToString(UnescapeBuffer.GetData(), UnescapeBuffer.Num());
+		return true;
+	};
+
+	const bool bParsed = Scanner.ScanObject([&](const ANSICHAR* Key, int32 KeyLen)
+	{
+		if (KeyEquals(Key, KeyLen, "orderId"))
+		{
+			return ReadStringField(OutSyncRequest.OrderId);
+		}
+		if (KeyEquals(Key, KeyLen, "packageName"))
+		{
+			bHasPackageName = true;
+			return ReadStringField(OutSyncRequest.PackageName);
+		}
+		if (KeyEquals(Key, KeyLen, "productId"))
+		{
+			bHasProductId = true;
+			return ReadStringField(OutSyncRequest.ProductId);
+		}
+		if (KeyEquals(Key, KeyLen, "purchaseToken"))
+		{
+			bHasPurchaseToken = true;
+			return ReadStringField(OutSyncRequest.PurchaseToken);
+		}
+		if (KeyEquals(Key, KeyLen, "purchaseTime"))
+		{
+			// Google writes purchaseTime as a number, older receipts wrap it in a string
+			const ANSICHAR* Start;
+			int32 Len;
+			bool bEscaped;
+			const bool bRead = Scanner.PeekString() ? Scanner.ReadString(Start, Len, bEscaped) : Scanner.ReadScalar(Start, Len);
+			if (!bRead)
+			{
+				return false;
+			}
+
+			int64 PurchaseTime = 0;
+			for (int32 Index = 0; Index < Len && Start[Index] >= '0' && Start[Index] <= '9'; Index++)
+			{
+				PurchaseTime = PurchaseTime * 10 + (Start[Index] - '0');
+			}
+			OutSyncRequest.PurchaseTime = PurchaseTime;
+			return true;
+		}
+		return Scanner.SkipValue();
+	});
+
+	if (!bParsed)
+	{
+		return Fail(EAccelByteReceiptParseError::MalformedReceiptData, Scanner.Offset());
+	}
+	if (!bHasPackageName || !bHasProductId || !bHasPurchaseToken)
+	{
+		return Fail(EAccelByteReceiptParseError::MissingField, INDEX_NONE);
+	}
+
+	OutSyncRequest.AutoAck = false;
+	OutSyncRequest.Language = "en";
+	OutSyncRequest.Region = "US";
+	return true;
+}
+
+FString FAccelByteReceiptParser::GetErrorMessage() const
+{
+	FString Message;
+	switch (Error)
+	{
+	case EAccelByteReceiptParseError::None: return FString();
+	case EAccelByteReceiptParseError::MalformedReceipt: Message = TEXT("receipt-malformed"); break;
+	case EAccelByteReceiptParseError::MissingReceiptData: Message = TEXT("receipt-data-missing"); break;
+	case EAccelByteReceiptParseError::InvalidBase64: Message = TEXT("receipt-data-invalid-base64"); break;
+	case EAccelByteReceiptParseError::MalformedReceiptData: Message = TEXT("receipt-data-malformed"); break;
+	case EAccelByteReceiptParseError::MissingField: Message = TEXT("receipt-data-missing-field"); break;
+	}
+
+	if (ErrorOffset != INDEX_NONE)
+	{
+		Message += FString::Printf(TEXT(" at offset %d"), ErrorOffset);
+	}
+	return Message;
+}
+
+bool FAccelByteReceiptParser::Fail(EAccelByteReceiptParseError InError, int32 InOffset)
+{
+	Error = InError;
+	ErrorOffset = InOffset;
+	return false;
+}
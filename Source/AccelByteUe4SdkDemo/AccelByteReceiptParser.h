@@ -0,0 +1,60 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteReceiptParser.generated.h"
+
+UENUM(BlueprintType)
+enum class EAccelByteReceiptParseError : uint8
+{
+	None,
+	// The outer receipt is not a JSON object
+	MalformedReceipt,
+	// The outer receipt has no receiptData string
+	MissingReceiptData,
+	// receiptData is not valid Base64
+	InvalidBase64,
+	// The decoded receiptData is not a JSON object
+	MalformedReceiptData,
+	// A field required to sync the purchase is missing from the decoded receiptData
+	MissingField
+};
+
+/**
+ * Single pass parser for Google Play receipts as handed out by the purchase interface.
+ *
+ * The outer receipt and the Base64 decoded receiptData are scanned in place without building a JSON DOM.
+ * The decode buffer is kept between calls, so reuse one parser per thread when processing many receipts.
+ */
+class FAccelByteReceiptParser
+{
+public:
+	/**
+	 * Extracts the fields needed by SyncMobilePlatformPurchaseGooglePlay from a receipt.
+	 *
+	 * productId, packageName and purchaseToken are required, orderId is optional because test purchases do not carry one.
+	 * @return false when the receipt is malformed, see GetError and GetErrorMessage.
+	 */
+	bool Parse(FString const& Receipt, FAccelByteModelsPlatformSyncMobileGoogle& OutSyncRequest);
+
+	// Locates and decodes receiptData only, the UTF-8 result is available through GetDecodedReceiptData
+	bool DecodeReceiptData(FString const& Receipt);
+
+	TArray<uint8> const& GetDecodedReceiptData() const { return DecodedBuffer; }
+
+	EAccelByteReceiptParseError GetError() const { return Error; }
+
+	FString GetErrorMessage() const;
+
+private:
+	bool Fail(EAccelByteReceiptParseError InError, int32 InOffset);
+
+	TArray<uint8> DecodedBuffer;
+	TArray<ANSICHAR> UnescapeBuffer;
+	EAccelByteReceiptParseError Error = EAccelByteReceiptParseError::None;
+	int32 ErrorOffset = INDEX_NONE;
+};
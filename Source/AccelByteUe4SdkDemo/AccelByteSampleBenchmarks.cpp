@@ -0,0 +1,1492 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+// Console commands that time the sample app code paths against their previous implementation.
+// Point the SDK at a local mock backend (e.g. with -url=) to get numbers that do not depend on a live environment.
+
+#include "AccelByteUe4SdkDemo.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Base64.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "HttpPath.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "JsonObjectConverter.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteItemApi.h"
+
+#include "AccelByteItemCache.h"
+#include "AccelByteBulkItemQuery.h"
+#include "AccelByteReceiptParser.h"
+#include "AccelBytePurchaseJournal.h"
+#include "AccelByteByteConversion.h"
+#include "AccelByteCloudSave.h"
+#include "AccelByteSaveContainer.h"
+#include "AccelByteUtilitiesBlueprints.h"
+#include "AccelByteLobbyState.h"
+#include "AccelByteChatHistory.h"
+#include "AccelBytePagedCatalog.h"
+#include "AccelByteImageCache.h"
+#include "AccelByteEntitlementMirror.h"
+#include "AccelByteAsyncAction.h"
+#include "AccelByteSampleBlueprints.h"
+#include "AccelByteStatWriteBuffer.h"
+#include "AccelByteTrustStorePrototype.h"
+
+#if WITH_ACCELBYTE_OPENSSL
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include "openssl/err.h"
+#include "openssl/pem.h"
+#include "openssl/x509.h"
+#include "openssl/x509_vfy.h"
+THIRD_PARTY_INCLUDES_END
+#undef UI
+#endif
+
+namespace AccelByteSampleBenchmarks
+{
+	// Splits the console arguments into -key=value options and positional values
+	static TArray<FString> ParseArgs(TArray<FString> const& Args, TMap<FString, FString>& OutOptions)
+	{
+		TArray<FString> Positional;
+		for (FString const& Arg : Args)
+		{
+			FString Key;
+			FString Value;
+			if (Arg.StartsWith(TEXT("-")) && Arg.Split(TEXT("="), &Key, &Value))
+			{
+				OutOptions.Add(Key.RightChop(1).ToLower(), Value);
+			}
+			else
+			{
+				Positional.Add(Arg);
+			}
+		}
+		return Positional;
+	}
+
+	static void GetItemsSequentially(TSharedRef<TArray<FString>> Skus, int32 Index, double StartTime, TFunction<void(double)> OnComplete)
+	{
+		if (Index >= Skus->Num())
+		{
+			OnComplete(FPlatformTime::Seconds() - StartTime);
+			return;
+		}
+
+		auto Next = [Skus, Index, StartTime, OnComplete]()
+		{
+			GetItemsSequentially(Skus, Index + 1, StartTime, OnComplete);
+		};
+
+		FRegistry::Item.GetItemBySku((*Skus)[Index], "", "",
+			AccelByte::THandler<FAccelByteModelsItemInfo>::CreateLambda([Next](FAccelByteModelsItemInfo const&) { Next(); }),
+			AccelByte::FErrorHandler::CreateLambda([Next](int32, FString const&) { Next(); }));
+	}
+
+	struct FItemsBench
+	{
+		TSharedPtr<IHttpRouter> Router;
+		FHttpRouteHandle RouteHandle;
+		// The platform URL of the settings, put back once the bench is done
+		FString PreviousPlatformServerUrl;
+		float LatencySeconds = 0.0f;
+		int32 Served = 0;
+	};
+
+	static void FinishItemsBench(TSharedRef<FItemsBench> const& Bench)
+	{
+		if (Bench->Router.IsValid())
+		{
+			Bench->Router->UnbindRoute(Bench->RouteHandle);
+		}
+		FRegistry::Settings.PlatformServerUrl = Bench->PreviousPlatformServerUrl;
+	}
+
+	// AccelByte.Sample.Bench.ItemsBySkus [-url=<platform url>] [-port=N] [-latencyms=N] [-concurrency=N] Sku1 Sku2 ...
+	static void BenchItemsBySkus(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		TSharedRef<TArray<FString>> Skus = MakeShared<TArray<FString>>(ParseArgs(Args, Options));
+		if (Skus->Num() == 0)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Usage: AccelByte.Sample.Bench.ItemsBySkus [-url=<platform url>] [-port=N] [-latencyms=N] [-concurrency=N] Sku1 Sku2 ..."));
+			return;
+		}
+
+		TSharedRef<FItemsBench> Bench = MakeShared<FItemsBench>();
+		Bench->PreviousPlatformServerUrl = FRegistry::Settings.PlatformServerUrl;
+		if (const FString* Url = Options.Find(TEXT("url")))
+		{
+			FRegistry::Settings.PlatformServerUrl = *Url;
+		}
+		else
+		{
+			const int32 Port = Options.Contains(TEXT("port")) ? FCString::Atoi(*Options[TEXT("port")]) : 18082;
+			Bench->Router = FHttpServerModule::Get().GetHttpRouter(Port);
+			if (!Bench->Router.IsValid())
+			{
+				UE_LOG(LogAccelByteSampleApp, Warning, TEXT("ItemsBySkus: cannot listen on port %d"), Port);
+				return;
+			}
+
+			// Stand-in for the platform service, answers items/bySku after the given round trip time
+			Bench->LatencySeconds = (Options.Contains(TEXT("latencyms")) ? FCString::Atoi(*Options[TEXT("latencyms")]) : 50) / 1000.0f;
+			TWeakPtr<FItemsBench> WeakBench = Bench;
+			Bench->RouteHandle = Bench->Router->BindRoute(FHttpPath(TEXT("/bench-platform")), EHttpServerRequestVerbs::VERB_GET, [WeakBench](FHttpServerRequest const& Request, FHttpResultCallback const& OnComplete)
+			{
+				TSharedPtr<FItemsBench> Bench = WeakBench.Pin();
+				FString const* Sku = Request.QueryParams.Find(TEXT("sku"));
+				if (!Bench.IsValid() || Sku == nullptr || !Request.RelativePath.GetPath().EndsWith(TEXT("/items/bySku")))
+				{
+					TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+					Response->Code = EHttpServerResponseCodes::NotFound;
+					OnComplete(MoveTemp(Response));
+					return true;
+				}
+
+				FAccelByteModelsItemInfo Item;
+				Item.ItemId = FMD5::HashAnsiString(**Sku);
+				Item.Sku = *Sku;
+				Item.Title = FString::Printf(TEXT("Bench item %s"), **Sku);
+				FString Body;
+				FJsonObjectConverter::UStructToJsonObjectString(Item, Body);
+				Bench->Served++;
+
+				FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([OnComplete, Body](float)
+				{
+					TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(Body, TEXT("application/json"));
+					OnComplete(MoveTemp(Response));
+					return false;
+				}), Bench->LatencySeconds);
+				return true;
+			});
+			FHttpServerModule::Get().StartAllListeners();
+			FRegistry::Settings.PlatformServerUrl = FString::Printf(TEXT("http://localhost:%d/bench-platform"), Port);
+		}
+		const int32 Concurrency = Options.Contains(TEXT("concurrency")) ? FCString::Atoi(*Options[TEXT("concurrency")]) : 0;
+
+		FAccelByteItemCache::Get().Reset();
+		GetItemsSequentially(Skus, 0, FPlatformTime::Seconds(), [Bench, Skus, Concurrency](double SequentialSeconds)
+		{
+			FAccelByteItemCache::Get().Reset();
+			const double BulkStart = FPlatformTime::Seconds();
+			FAccelByteBulkItemQuery::Run(*Skus, Concurrency, [Bench, Skus, SequentialSeconds, BulkStart](TArray<FAccelByteItemBySkuResult>&& Results)
+			{
+				const double BulkSeconds = FPlatformTime::Seconds() - BulkStart;
+				const int32 Failed = Results.FilterByPredicate([](FAccelByteItemBySkuResult const& Result) { return !Result.bSuccess; }).Num();
+				const FAccelByteItemCacheStats Stats = FAccelByteItemCache::Get().GetStats();
+				UE_LOG(LogAccelByteSampleApp, Display, TEXT("ItemsBySkus: %d SKUs - sequential %.1f ms - bulk %.1f ms (%.1fx) - backend requests %d - failed %d - %d served by the stand-in"),
+					Skus->Num(), SequentialSeconds * 1000.0, BulkSeconds * 1000.0, BulkSeconds > 0.0 ? SequentialSeconds / BulkSeconds : 0.0, Stats.Misses, Failed, Bench->Served);
+				FinishItemsBench(Bench);
+			});
+		});
+	}
+
+	static FAutoConsoleCommand BenchItemsBySkusCommand(
+		TEXT("AccelByte.Sample.Bench.ItemsBySkus"),
+		TEXT("Compares sequential GetItemBySku round trips against GetItemsBySkus for the given SKUs, against a local stand-in unless -url is given."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchItemsBySkus));
+
+	// The DOM based ParseReceiptString that FAccelByteReceiptParser replaced, kept as the baseline
+	static FAccelByteModelsPlatformSyncMobileGoogle LegacyParseReceiptString(FString const& ReceiptData)
+	{
+		FAccelByteModelsPlatformSyncMobileGoogle ReceiptStruct;
+
+		FString OutReceiptEncStr;
+		TSharedPtr<FJsonObject> JsonParsed;
+		TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ReceiptData);
+		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
+		{
+			OutReceiptEncStr = JsonParsed->GetStringField("receiptData");
+		}
+
+		FString ReceiptDecodedStr;
+		FBase64::Decode(OutReceiptEncStr, ReceiptDecodedStr);
+
+		JsonParsed = nullptr;
+		JsonReader = TJsonReaderFactory<TCHAR>::Create(ReceiptDecodedStr);
+		if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
+		{
+			ReceiptStruct.OrderId = JsonParsed->GetStringField("orderId");
+			ReceiptStruct.PackageName = JsonParsed->GetStringField("packageName");
+			ReceiptStruct.ProductId = JsonParsed->GetStringField("productId");
+			ReceiptStruct.PurchaseTime = FCString::Atoi64(*JsonParsed->GetStringField("purchaseTime"));
+			ReceiptStruct.PurchaseToken = JsonParsed->GetStringField("purchaseToken");
+		}
+		return ReceiptStruct;
+	}
+
+	static FString MakeSampleReceipt(int32 Seed)
+	{
+		const FString ReceiptJson = FString::Printf(
+			TEXT("{\"orderId\":\"GPA.3300-0000-0000-%05d\",\"packageName\":\"net.accelbyte.sample\",\"productId\":\"sample_gem_pack_%d\",")
+			TEXT("\"purchaseTime\":16500000%05d,\"purchaseState\":0,\"purchaseToken\":\"%s\",\"acknowledged\":false}"),
+			Seed, Seed % 10, Seed, *FString::ChrN(160, static_cast<TCHAR>(TEXT('a') + Seed % 26)));
+		return FString::Printf(TEXT("{\"receiptData\":\"%s\",\"signature\":\"%s\"}"), *FBase64::Encode(ReceiptJson), *FString::ChrN(344, TEXT('s')));
+	}
+
+	// AccelByte.Sample.Bench.ParseReceipt [Iterations]
+	static void BenchParseReceipt(TArray<FString> const& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+
+		TArray<FString> Receipts;
+		for (int32 Index = 0; Index < 64; Index++)
+		{
+			Receipts.Add(MakeSampleReceipt(Index));
+		}
+
+		int64 Checksum = 0;
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Checksum += LegacyParseReceiptString(Receipts[Iteration % Receipts.Num()]).PurchaseTime;
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - Start;
+
+		FAccelByteReceiptParser Parser;
+		int32 Failures = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteModelsPlatformSyncMobileGoogle SyncRequest;
+			if (Parser.Parse(Receipts[Iteration % Receipts.Num()], SyncRequest))
+			{
+				Checksum -= SyncRequest.PurchaseTime;
+			}
+			else
+			{
+				Failures++;
+			}
+		}
+		const double StreamingSeconds = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ParseReceipt: %d iterations - DOM %.2f us/receipt - streaming %.2f us/receipt (%.1fx) - failures %d - checksum %lld"),
+			Iterations, LegacySeconds * 1e6 / Iterations, StreamingSeconds * 1e6 / Iterations, StreamingSeconds > 0.0 ? LegacySeconds / StreamingSeconds : 0.0, Failures, Checksum);
+	}
+
+	static FAutoConsoleCommand BenchParseReceiptCommand(
+		TEXT("AccelByte.Sample.Bench.ParseReceipt"),
+		TEXT("Compares the DOM based receipt parsing against FAccelByteReceiptParser on synthetic Google Play receipts."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchParseReceipt));
+
+	// AccelByte.Sample.Bench.JournalReplay [Entries]
+	static void BenchJournalReplay(TArray<FString> const& Args)
+	{
+		const int32 NumEntries = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10000;
+		const FString JournalPath = FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("BenchPurchaseJournal.log");
+		IFileManager::Get().Delete(*JournalPath);
+
+		double Start = FPlatformTime::Seconds();
+		{
+			FAccelBytePurchaseJournal Writer(JournalPath);
+			for (int32 Index = 0; Index < NumEntries; Index++)
+			{
+				FAccelByteModelsPlatformSyncMobileGoogle SyncRequest;
+				SyncRequest.OrderId = FString::Printf(TEXT("GPA.3300-0000-0000-%08d"), Index);
+				SyncRequest.PackageName = TEXT("net.accelbyte.sample");
+				SyncRequest.ProductId = TEXT("sample_gem_pack");
+				SyncRequest.PurchaseToken = FString::ChrN(160, TEXT('t'));
+				Writer.RecordGoogle(SyncRequest);
+			}
+		}
+		const double RecordSeconds = FPlatformTime::Seconds() - Start;
+
+		// The journal has to outlive the asynchronous load, the handler acknowledges every entry without a backend
+		TSharedRef<FAccelBytePurchaseJournal> Journal = MakeShared<FAccelBytePurchaseJournal>(JournalPath);
+		Journal->SetReplayHandler([](FAccelBytePurchaseJournal::FEntry const&, FAccelBytePurchaseJournal::FReplayResult const& OnResult)
+		{
+			OnResult(true, false);
+		});
+
+		Start = FPlatformTime::Seconds();
+		Journal->LoadAsync(FSimpleDelegate::CreateLambda([Journal, NumEntries, RecordSeconds, Start]()
+		{
+			const double LoadSeconds = FPlatformTime::Seconds() - Start;
+			const int32 Loaded = Journal->NumPending();
+
+			const double ReplayStart = FPlatformTime::Seconds();
+			Journal->Replay();
+			const double ReplaySeconds = FPlatformTime::Seconds() - ReplayStart;
+
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("JournalReplay: %d entries - record %.1f ms - load %.1f ms (%d pending) - replay %.1f ms (%d left)"),
+				NumEntries, RecordSeconds * 1000.0, LoadSeconds * 1000.0, Loaded, ReplaySeconds * 1000.0, Journal->NumPending());
+		}));
+	}
+
+	static FAutoConsoleCommand BenchJournalReplayCommand(
+		TEXT("AccelByte.Sample.Bench.JournalReplay"),
+		TEXT("Measures recording, loading and replaying a purchase journal of the given size with a backend stand-in."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchJournalReplay));
+
+	// AccelByte.Sample.Bench.ByteConversion [Megabytes] [Iterations]
+	static void BenchByteConversion(TArray<FString> const& Args)
+	{
+		const int32 Megabytes = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 4;
+		const int32 Iterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 8;
+
+		// Mostly ASCII JSON with some accented, CJK and astral characters, like a typical save payload
+		FString Payload;
+		Payload.Reserve(Megabytes * 1024 * 1024);
+		for (int32 Index = 0; Payload.Len() < Megabytes * 1024 * 1024; Index++)
+		{
+			Payload += FString::Printf(TEXT("{\"slot\":%d,\"name\":\"player_%d\",\"gold\":%d},"), Index, Index, Index * 7);
+			if (Index % 16 == 0)
+			{
+				Payload += TEXT("\"caf\u00e9 \u4e2d\u6587 \U0001F600\",");
+			}
+		}
+		const double PayloadMB = Payload.Len() / (1024.0 * 1024.0);
+
+		TArray<uint8> Bytes;
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FTCHARToUTF8 Converted(*Payload);
+			Bytes = TArray<uint8>(reinterpret_cast<uint8 const*>(Converted.Get()), Converted.Length());
+		}
+		const double EngineEncodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		FString Text;
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FUTF8ToTCHAR Converted(reinterpret_cast<ANSICHAR const*>(Bytes.GetData()), Bytes.Num());
+			Text = FString(Converted.Length(), Converted.Get());
+		}
+		const double EngineDecodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		// The outputs are reused across iterations, only the first one allocates
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteByteConversion::StringToUtf8(Payload, Bytes);
+		}
+		const double EncodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteByteConversion::Utf8ToString(Bytes.GetData(), Bytes.Num(), Text);
+		}
+		const double DecodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+		const bool bUtf8RoundTrip = Text.Equals(Payload, ESearchCase::CaseSensitive);
+
+		TArray<uint8> Raw;
+		Raw.SetNumUninitialized(Megabytes * 1024 * 1024);
+		for (int32 Index = 0; Index < Raw.Num(); Index++)
+		{
+			Raw[Index] = static_cast<uint8>(Index * 131);
+		}
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			Text = ::BytesToString(Raw.GetData(), Raw.Num());
+			Bytes.SetNumUninitialized(Text.Len());
+			::StringToBytes(Text, Bytes.GetData(), Bytes.Num());
+		}
+		const double EngineRawSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteByteConversion::BytesToString(Raw.GetData(), Raw.Num(), Text);
+			FAccelByteByteConversion::StringToBytes(Text, Bytes);
+		}
+		const double RawSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+		const bool bRawRoundTrip = Bytes == Raw;
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ByteConversion: %.1f MB - UTF-8 encode engine %.2f ms / kernel %.2f ms - decode engine %.2f ms / kernel %.2f ms - round trip %s"),
+			PayloadMB, EngineEncodeSeconds * 1000.0, EncodeSeconds * 1000.0, EngineDecodeSeconds * 1000.0, DecodeSeconds * 1000.0, bUtf8RoundTrip ? TEXT("ok") : TEXT("MISMATCH"));
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ByteConversion: %d MB raw bytes to string and back - engine %.2f ms / kernel %.2f ms - round trip %s"),
+			Megabytes, EngineRawSeconds * 1000.0, RawSeconds * 1000.0, bRawRoundTrip ? TEXT("ok") : TEXT("MISMATCH"));
+	}
+
+	static FAutoConsoleCommand BenchByteConversionCommand(
+		TEXT("AccelByte.Sample.Bench.ByteConversion"),
+		TEXT("Compares the engine UTF-8 and byte string conversions against FAccelByteByteConversion on a multi megabyte payload."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchByteConversion));
+
+	// AccelByte.Sample.Bench.CloudSave [Megabytes] [-latency=<ms per request>]
+	static void BenchCloudSave(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 Megabytes = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 8;
+		const float LatencySeconds = Options.Contains(TEXT("latency")) ? FCString::Atof(*Options[TEXT("latency")]) / 1000.0f : 0.05f;
+
+		const FString BenchDir = FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("BenchCloudSave");
+		IFileManager::Get().DeleteDirectory(*BenchDir, false, true);
+		const FString PayloadPath = BenchDir / TEXT("Payload.bin");
+		const FString DownloadPath = BenchDir / TEXT("Download.bin");
+
+		TSharedRef<TArray<uint8>> Payload = MakeShared<TArray<uint8>>();
+		Payload->SetNumUninitialized(Megabytes * 1024 * 1024);
+		FRandomStream Random(1234);
+		for (uint8& Byte : *Payload)
+		{
+			Byte = static_cast<uint8>(Random.RandHelper(256));
+		}
+		FFileHelper::SaveArrayToFile(*Payload, *PayloadPath);
+
+		TSharedRef<FAccelByteCloudSave> CloudSave = MakeShared<FAccelByteCloudSave>(IAccelByteCloudChunkStore::CreateLocalStore(BenchDir / TEXT("Store"), LatencySeconds));
+		const double FullStart = FPlatformTime::Seconds();
+		CloudSave->UploadFile(TEXT("bench"), PayloadPath, [CloudSave, Payload, PayloadPath, DownloadPath, Megabytes, FullStart](FAccelByteCloudSaveResult const& Full)
+		{
+			const double FullSeconds = FPlatformTime::Seconds() - FullStart;
+
+			// A typical save edit: a few bytes inserted in the middle and a small region rewritten further on
+			TArray<uint8> Inserted;
+			Inserted.Init(0xAB, 100);
+			Payload->Insert(Inserted, Payload->Num() / 2);
+			for (int32 Index = Payload->Num() * 3 / 4; Index < Payload->Num() * 3 / 4 + 4096; Index++)
+			{
+				(*Payload)[Index] ^= 0x5A;
+			}
+			FFileHelper::SaveArrayToFile(*Payload, *PayloadPath);
+
+			const double DeltaStart = FPlatformTime::Seconds();
+			CloudSave->UploadFile(TEXT("bench"), PayloadPath, [CloudSave, Payload, DownloadPath, Megabytes, Full, FullSeconds, DeltaStart](FAccelByteCloudSaveResult const& Delta)
+			{
+				const double DeltaSeconds = FPlatformTime::Seconds() - DeltaStart;
+
+				const double DownloadStart = FPlatformTime::Seconds();
+				CloudSave->DownloadFile(TEXT("bench"), DownloadPath, [Payload, DownloadPath, Megabytes, Full, FullSeconds, Delta, DeltaSeconds, DownloadStart](FAccelByteCloudSaveResult const& Download)
+				{
+					const double DownloadSeconds = FPlatformTime::Seconds() - DownloadStart;
+					TArray<uint8> Downloaded;
+					FFileHelper::LoadFileToArray(Downloaded, *DownloadPath);
+
+					UE_LOG(LogAccelByteSampleApp, Display, TEXT("CloudSave: %d MB - full upload %d chunks %.1f ms - edited upload %d of %d chunks, %lld bytes %.1f ms - download %.1f ms - %s"),
+						Megabytes, Full.ChunksTransferred, FullSeconds * 1000.0, Delta.ChunksTransferred, Delta.NumChunks, Delta.BytesTransferred, DeltaSeconds * 1000.0,
+						DownloadSeconds * 1000.0, Full.bSuccess && Delta.bSuccess && Download.bSuccess && Downloaded == *Payload ? TEXT("round trip ok") : TEXT("FAILED"));
+				});
+			});
+		});
+	}
+
+	static FAutoConsoleCommand BenchCloudSaveCommand(
+		TEXT("AccelByte.Sample.Bench.CloudSave"),
+		TEXT("Uploads a payload, edits it, uploads it again and downloads it through the chunked cloud save against a local stand-in store."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchCloudSave));
+
+	struct FBenchSaveRecord
+	{
+		int32 Id = 0;
+		FString Name;
+		int32 Count = 0;
+		float Durability = 0.0f;
+
+		friend FArchive& operator<<(FArchive& Ar, FBenchSaveRecord& Record)
+		{
+			return Ar << Record.Id << Record.Name << Record.Count << Record.Durability;
+		}
+	};
+
+	// The slot widgets store JSON text through ConvertToBytes and read it back through ConvertToString
+	static double TimeStringSave(TArray<FBenchSaveRecord> const& Records, int32 Iterations, TArray<uint8>& OutBytes, double& OutDecodeSeconds)
+	{
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FString Json = TEXT("{\"items\":[");
+			for (FBenchSaveRecord const& Record : Records)
+			{
+				Json += FString::Printf(TEXT("{\"id\":%d,\"name\":\"%s\",\"count\":%d,\"durability\":%.3f},"), Record.Id, *Record.Name, Record.Count, Record.Durability);
+			}
+			Json.RemoveFromEnd(TEXT(","));
+			Json += TEXT("]}");
+			OutBytes = UAccelByteUtilitiesBlueprints::ConvertToBytes(Json);
+		}
+		const double EncodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		int32 Decoded = 0;
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			const FString Json = UAccelByteUtilitiesBlueprints::ConvertToString(OutBytes);
+			TSharedPtr<FJsonObject> Root;
+			if (FJsonSerializer::Deserialize(TJsonReaderFactory<TCHAR>::Create(Json), Root) && Root.IsValid())
+			{
+				TArray<FBenchSaveRecord> Loaded;
+				for (TSharedPtr<FJsonValue> const& Value : Root->GetArrayField(TEXT("items")))
+				{
+					TSharedPtr<FJsonObject> const& Item = Value->AsObject();
+					FBenchSaveRecord& Record = Loaded.AddDefaulted_GetRef();
+					Record.Id = Item->GetIntegerField(TEXT("id"));
+					Record.Name = Item->GetStringField(TEXT("name"));
+					Record.Count = Item->GetIntegerField(TEXT("count"));
+					Record.Durability = static_cast<float>(Item->GetNumberField(TEXT("durability")));
+				}
+				Decoded = Loaded.Num();
+			}
+		}
+		OutDecodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+		check(Decoded == Records.Num());
+		return EncodeSeconds;
+	}
+
+	static double TimeContainerSave(TArray<FBenchSaveRecord>& Records, EAccelByteSaveCompression Compression, int32 Iterations, TArray<uint8>& OutBytes, double& OutDecodeSeconds, bool& bOutRoundTrip)
+	{
+		double Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteSaveWriter Writer(Compression);
+			Writer.BeginSection(TEXT("Inventory"), 1) << Records;
+			Writer.Finish(OutBytes);
+		}
+		const double EncodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		TArray<uint8> Section;
+		TArray<FBenchSaveRecord> Loaded;
+		Start = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			FAccelByteSaveReader Reader;
+			if (Reader.Open(OutBytes) && Reader.ReadSection(TEXT("Inventory"), Section))
+			{
+				FMemoryReader SectionReader(Section);
+				SectionReader << Loaded;
+			}
+		}
+		OutDecodeSeconds = (FPlatformTime::Seconds() - Start) / Iterations;
+
+		bOutRoundTrip = Loaded.Num() == Records.Num();
+		for (int32 Index = 0; bOutRoundTrip && Index < Records.Num(); Index++)
+		{
+			bOutRoundTrip = Loaded[Index].Id == Records[Index].Id && Loaded[Index].Name == Records[Index].Name
+				&& Loaded[Index].Count == Records[Index].Count && Loaded[Index].Durability == Records[Index].Durability;
+		}
+		return EncodeSeconds;
+	}
+
+	// AccelByte.Sample.Bench.SaveFormat [Iterations]
+	static void BenchSaveFormat(TArray<FString> const& Args)
+	{
+		const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 4;
+		const int32 SaveSizesKB[] = { 10, 100, 1024, 10 * 1024 };
+
+		TArray<EAccelByteSaveCompression> Compressions = { EAccelByteSaveCompression::None, EAccelByteSaveCompression::LZ4, EAccelByteSaveCompression::Zlib };
+		if (FAccelByteSaveWriter::ResolveCompression(EAccelByteSaveCompression::Oodle) == EAccelByteSaveCompression::Oodle)
+		{
+			Compressions.Add(EAccelByteSaveCompression::Oodle);
+		}
+
+		FRandomStream Random(42);
+		for (const int32 SizeKB : SaveSizesKB)
+		{
+			// About 60 bytes of JSON per record
+			TArray<FBenchSaveRecord> Records;
+			Records.SetNum(SizeKB * 1024 / 60);
+			for (int32 Index = 0; Index < Records.Num(); Index++)
+			{
+				Records[Index].Id = Index;
+				Records[Index].Name = FString::Printf(TEXT("item_%d"), Random.RandRange(0, 500));
+				Records[Index].Count = Random.RandRange(1, 99);
+				Records[Index].Durability = FMath::RoundToFloat(Random.FRand() * 1000.0f) / 1000.0f;
+			}
+
+			TArray<uint8> Bytes;
+			double DecodeSeconds = 0.0;
+			const double EncodeSeconds = TimeStringSave(Records, Iterations, Bytes, DecodeSeconds);
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("SaveFormat: %5d KB %-6s - %9d bytes (%d bytes as FString) - encode %8.2f ms - decode %8.2f ms"),
+				SizeKB, TEXT("string"), Bytes.Num(), Bytes.Num() * static_cast<int32>(sizeof(TCHAR)), EncodeSeconds * 1000.0, DecodeSeconds * 1000.0);
+
+			for (EAccelByteSaveCompression Compression : Compressions)
+			{
+				bool bRoundTrip = false;
+				const double ContainerEncodeSeconds = TimeContainerSave(Records, Compression, Iterations, Bytes, DecodeSeconds, bRoundTrip);
+				UE_LOG(LogAccelByteSampleApp, Display, TEXT("SaveFormat: %5d KB %-6s - %9d bytes - encode %8.2f ms - decode %8.2f ms - %s"),
+					SizeKB, *StaticEnum<EAccelByteSaveCompression>()->GetNameStringByValue(static_cast<int64>(Compression)), Bytes.Num(),
+					ContainerEncodeSeconds * 1000.0, DecodeSeconds * 1000.0, bRoundTrip ? TEXT("round trip ok") : TEXT("MISMATCH"));
+			}
+		}
+	}
+
+	static FAutoConsoleCommand BenchSaveFormatCommand(
+		TEXT("AccelByte.Sample.Bench.SaveFormat"),
+		TEXT("Compares size and encode/decode time of the JSON string slot path against the binary save container, for 10 KB to 10 MB saves."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchSaveFormat));
+
+	// AccelByte.Sample.Bench.LobbyPresence [Updates] [-friends=N] [-perframe=N]
+	static void BenchLobbyPresence(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumUpdates = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 10000;
+		const int32 NumFriends = Options.Contains(TEXT("friends")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("friends")])) : 1000;
+		const int32 UpdatesPerFrame = Options.Contains(TEXT("perframe")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("perframe")])) : 100;
+
+		TArray<FString> FriendIds;
+		for (int32 Index = 0; Index < NumFriends; Index++)
+		{
+			FriendIds.Add(FString::Printf(TEXT("%032x"), Index));
+		}
+
+		// Presence bursts land on a small set of active friends, like a party finishing a match
+		struct FUpdate
+		{
+			int32 Friend;
+			FString Availability;
+			FString Activity;
+		};
+		const TCHAR* Availabilities[] = { TEXT("online"), TEXT("busy"), TEXT("invisible"), TEXT("offline") };
+		FRandomStream Random(7);
+		TArray<FUpdate> Updates;
+		Updates.Reserve(NumUpdates);
+		for (int32 Index = 0; Index < NumUpdates; Index++)
+		{
+			const int32 Friend = Random.FRand() < 0.8f ? Random.RandRange(0, FMath::Min(NumFriends, 50) - 1) : Random.RandRange(0, NumFriends - 1);
+			Updates.Add({ Friend, Availabilities[Random.RandRange(0, 3)], FString::Printf(TEXT("match_%d"), Random.RandRange(0, 3)) });
+		}
+
+		// Previous widget behaviour: apply the notification, then rebuild and sort the whole visible list
+		int64 RebuiltRows = 0;
+		double Start = FPlatformTime::Seconds();
+		{
+			TMap<FString, FAccelByteLobbyUser> Rows;
+			for (FString const& FriendId : FriendIds)
+			{
+				FAccelByteLobbyUser& Row = Rows.Add(FriendId);
+				Row.UserId = FriendId;
+				Row.bFriend = true;
+			}
+			for (FUpdate const& Update : Updates)
+			{
+				FAccelByteLobbyUser& Row = Rows.FindChecked(FriendIds[Update.Friend]);
+				Row.Availability = Update.Availability;
+				Row.Activity = Update.Activity;
+
+				TArray<FAccelByteLobbyUser> Visible;
+				Rows.GenerateValueArray(Visible);
+				Visible.Sort([](FAccelByteLobbyUser const& A, FAccelByteLobbyUser const& B)
+				{
+					return A.Availability != B.Availability ? A.Availability < B.Availability : A.UserId < B.UserId;
+				});
+				RebuiltRows += Visible.Num();
+			}
+		}
+		const double RebuildSeconds = FPlatformTime::Seconds() - Start;
+
+		int64 ChangedRows = 0;
+		int32 Frames = 0;
+		Start = FPlatformTime::Seconds();
+		{
+			FAccelByteLobbyState State;
+			State.SetRelationList(FAccelByteLobbyState::ERelation::Friend, FriendIds);
+			State.Flush();
+			State.OnChanged().AddLambda([&ChangedRows](TArray<FAccelByteLobbyRowChange> const& Changes)
+			{
+				ChangedRows += Changes.Num();
+			});
+
+			for (int32 Index = 0; Index < Updates.Num(); Index++)
+			{
+				FUpdate const& Update = Updates[Index];
+				State.QueuePresence(FriendIds[Update.Friend], Update.Availability, Update.Activity, FString());
+				if ((Index + 1) % UpdatesPerFrame == 0 || Index + 1 == Updates.Num())
+				{
+					State.Flush();
+					Frames++;
+				}
+			}
+		}
+		const double StoreSeconds = FPlatformTime::Seconds() - Start;
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("LobbyPresence: %d updates, %d friends, %d updates per frame"), NumUpdates, NumFriends, UpdatesPerFrame);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("LobbyPresence: list rebuild - %8.2f ms - %lld rows rebuilt"), RebuildSeconds * 1000.0, RebuiltRows);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("LobbyPresence: lobby state  - %8.2f ms - %lld rows changed over %d frames"), StoreSeconds * 1000.0, ChangedRows, Frames);
+	}
+
+	static FAutoConsoleCommand BenchLobbyPresenceCommand(
+		TEXT("AccelByte.Sample.Bench.LobbyPresence"),
+		TEXT("Replays presence notifications through a full list rebuild per notification and through the lobby state store."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchLobbyPresence));
+
+	// AccelByte.Sample.Bench.ChatHistory [Messages] [-capacity=N] [-budgetkb=N]
+	static void BenchChatHistory(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumMessages = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 200000;
+
+		FAccelByteChatHistory::FSettings Settings;
+		if (const FString* Capacity = Options.Find(TEXT("capacity")))
+		{
+			Settings.MessagesPerChannel = FCString::Atoi(**Capacity);
+		}
+		if (const FString* BudgetKB = Options.Find(TEXT("budgetkb")))
+		{
+			Settings.BudgetBytes = FCString::Atoi64(**BudgetKB) * 1024;
+		}
+
+		const FString Sender = TEXT("6f0c3a8e9b2d4c1f8a7e5d3b2c1a0f9e");
+		FRandomStream Random(99);
+		TArray<FString> Texts;
+		for (int32 Index = 0; Index < 256; Index++)
+		{
+			FString Text = FString::Printf(TEXT("gg %d "), Index);
+			const int32 Words = Random.RandRange(1, 24);
+			for (int32 Word = 0; Word < Words; Word++)
+			{
+				Text += TEXT("lorem ");
+			}
+			Texts.Add(MoveTemp(Text));
+		}
+		const int32 PageSize = 50;
+		const int32 ScrollReads = 10000;
+
+		// Previous widget behaviour: one allocated message per notification, kept for the whole session
+		struct FLegacyMessage
+		{
+			FString From;
+			FString Text;
+			FDateTime ReceivedAt;
+		};
+		int64 LegacyBytes = 0;
+		double LegacyReadSeconds = 0.0;
+		double Start = FPlatformTime::Seconds();
+		{
+			TArray<FLegacyMessage> Legacy;
+			for (int32 Index = 0; Index < NumMessages; Index++)
+			{
+				Legacy.Add({ Sender, Texts[Index % Texts.Num()], FDateTime::UtcNow() });
+			}
+			for (FLegacyMessage const& Message : Legacy)
+			{
+				LegacyBytes += Message.From.GetAllocatedSize() + Message.Text.GetAllocatedSize();
+			}
+			LegacyBytes += Legacy.GetAllocatedSize();
+
+			const double ReadStart = FPlatformTime::Seconds();
+			for (int32 Read = 0; Read < ScrollReads; Read++)
+			{
+				const int32 FromNewest = Random.RandRange(0, FMath::Min(Legacy.Num(), FMath::Max(1, Settings.MessagesPerChannel)) - 1);
+				TArray<FLegacyMessage> Page;
+				for (int32 Index = FromNewest; Index < FMath::Min(Legacy.Num(), FromNewest + PageSize); Index++)
+				{
+					Page.Add(Legacy[Legacy.Num() - 1 - Index]);
+				}
+			}
+			LegacyReadSeconds = FPlatformTime::Seconds() - ReadStart;
+		}
+		const double LegacySeconds = FPlatformTime::Seconds() - Start - LegacyReadSeconds;
+
+		FAccelByteChatHistory History;
+		History.Configure(Settings);
+		const FString Channel = FAccelByteChatHistory::GetLobbyChannel(TEXT("global"));
+		Start = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumMessages; Index++)
+		{
+			History.Add(Channel, Sender, Texts[Index % Texts.Num()]);
+		}
+		const double HistorySeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		TArray<FAccelByteChatHistory::FMessageView> Page;
+		for (int32 Read = 0; Read < ScrollReads; Read++)
+		{
+			Page.Reset();
+			History.Read(Channel, Random.RandRange(0, FMath::Max(0, History.Num(Channel) - 1)), PageSize, Page);
+		}
+		const double HistoryReadSeconds = FPlatformTime::Seconds() - Start;
+
+		const FAccelByteChatHistoryStats Stats = History.GetStats();
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ChatHistory: %d messages on one channel, %d reads of %d messages"), NumMessages, ScrollReads, PageSize);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ChatHistory: unbounded array - %8.2f ms (%.0f msg/s) - %lld bytes - reads %8.2f ms"),
+			LegacySeconds * 1000.0, NumMessages / FMath::Max(LegacySeconds, 1e-9), LegacyBytes, LegacyReadSeconds * 1000.0);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ChatHistory: ring + arenas  - %8.2f ms (%.0f msg/s) - %lld bytes allocated, %lld in use - %d kept, %lld evicted - reads %8.2f ms"),
+			HistorySeconds * 1000.0, NumMessages / FMath::Max(HistorySeconds, 1e-9), Stats.AllocatedBytes, Stats.TextBytes, Stats.Messages, Stats.EvictedMessages, HistoryReadSeconds * 1000.0);
+	}
+
+	static FAutoConsoleCommand BenchChatHistoryCommand(
+		TEXT("AccelByte.Sample.Bench.ChatHistory"),
+		TEXT("Pushes a high volume chat channel through an unbounded message array and through the chat history, then pages through the scrollback."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchChatHistory));
+
+	struct FCatalogBench
+	{
+		int32 TotalItems = 0;
+		int32 VisibleRows = 0;
+		float RowsPerSecond = 0.0f;
+		float LatencySeconds = 0.0f;
+		UAccelBytePagedCatalog::FSettings Settings;
+	};
+
+	// Mode 0 loads every page before showing anything like the old widgets, 1 fetches on demand, 2 prefetches
+	static void RunCatalogBenchMode(TSharedRef<FCatalogBench> const& Bench, int32 Mode)
+	{
+		if (Mode > 2)
+		{
+			return;
+		}
+
+		UAccelBytePagedCatalog::FSettings Settings = Bench->Settings;
+		if (Mode == 0)
+		{
+			Settings.MaxPagesInFlight = 1;
+		}
+		else if (Mode == 1)
+		{
+			Settings.PrefetchSeconds = 0.0f;
+		}
+
+		const int32 TotalItems = Bench->TotalItems;
+		const float LatencySeconds = Bench->LatencySeconds;
+		UAccelBytePagedCatalog* Catalog = UAccelBytePagedCatalog::CreatePagedCatalogFromSource([TotalItems, LatencySeconds](int32 Offset, int32 Limit, UAccelBytePagedCatalog::FOnPage&& OnPage, UAccelBytePagedCatalog::FOnError&&)
+		{
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([TotalItems, Offset, Limit, OnPage = MoveTemp(OnPage)](float)
+			{
+				TArray<FAccelByteModelsItemInfo> Items;
+				for (int32 Index = Offset; Index < FMath::Min(TotalItems, Offset + Limit); Index++)
+				{
+					FAccelByteModelsItemInfo& Item = Items.AddDefaulted_GetRef();
+					Item.ItemId = FString::Printf(TEXT("%032x"), Index);
+					Item.Sku = FString::Printf(TEXT("bench-sku-%d"), Index);
+					Item.Title = FString::Printf(TEXT("Bench item %d"), Index);
+				}
+				OnPage(Items, Offset + Limit < TotalItems);
+				return false;
+			}), LatencySeconds);
+		}, Settings);
+		Catalog->AddToRoot();
+
+		const double Start = FPlatformTime::Seconds();
+		TSharedRef<float> ItemOffset = MakeShared<float>(0.0f);
+		Catalog->Open();
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Bench, Mode, Catalog, Start, ItemOffset](float DeltaSeconds)
+		{
+			const int32 ScrollEnd = FMath::Max(0, Bench->TotalItems - Bench->VisibleRows);
+			bool bDone = false;
+			if (Mode == 0)
+			{
+				// Keep asking for the row after the last one until the catalog is complete
+				Catalog->NotifyScrolled(static_cast<float>(Catalog->Num()), Bench->VisibleRows);
+				bDone = !Catalog->HasMore();
+			}
+			else if (Catalog->Num() > 0)
+			{
+				*ItemOffset = FMath::Min(*ItemOffset + Bench->RowsPerSecond * DeltaSeconds, static_cast<float>(ScrollEnd));
+				Catalog->NotifyScrolled(*ItemOffset, Bench->VisibleRows);
+				bDone = *ItemOffset >= ScrollEnd;
+			}
+			if (!bDone)
+			{
+				return true;
+			}
+
+			static const TCHAR* ModeNames[] = { TEXT("load all"), TEXT("on demand"), TEXT("prefetch") };
+			const FAccelByteCatalogMetrics Metrics = Catalog->GetMetrics();
+			const float FirstRowMs = Mode == 0 ? static_cast<float>((FPlatformTime::Seconds() - Start) * 1000.0) : Metrics.OpenToFirstRowMs;
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("PagedCatalog: %-9s - first row %8.1f ms - %d pages, %d prefetched - %d entry widgets - %d scroll frames, %d starved - frame p50 %.2f ms p95 %.2f ms max %.2f ms"),
+				ModeNames[Mode], FirstRowMs, Metrics.PagesLoaded, Metrics.PagesPrefetched, Mode == 0 ? Metrics.ItemsLoaded : Bench->VisibleRows,
+				Metrics.ScrollFrames, Metrics.StarvedFrames, Metrics.ScrollFrameP50Ms, Metrics.ScrollFrameP95Ms, Metrics.ScrollFrameMaxMs);
+
+			Catalog->RemoveFromRoot();
+			RunCatalogBenchMode(Bench, Mode + 1);
+			return false;
+		}));
+	}
+
+	// AccelByte.Sample.Bench.PagedCatalog [Items] [-latency=<ms per page>] [-speed=<rows per second>] [-visible=N]
+	static void BenchPagedCatalog(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+
+		TSharedRef<FCatalogBench> Bench = MakeShared<FCatalogBench>();
+		Bench->TotalItems = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 2000;
+		Bench->LatencySeconds = Options.Contains(TEXT("latency")) ? FCString::Atof(*Options[TEXT("latency")]) / 1000.0f : 0.15f;
+		Bench->RowsPerSecond = Options.Contains(TEXT("speed")) ? FCString::Atof(*Options[TEXT("speed")]) : 40.0f;
+		Bench->VisibleRows = Options.Contains(TEXT("visible")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("visible")])) : 8;
+		Bench->Settings.PageSize = 20;
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("PagedCatalog: %d items, %.0f ms per page, scrolling %.0f rows per second with %d visible rows"),
+			Bench->TotalItems, Bench->LatencySeconds * 1000.0f, Bench->RowsPerSecond, Bench->VisibleRows);
+		RunCatalogBenchMode(Bench, 0);
+	}
+
+	static FAutoConsoleCommand BenchPagedCatalogCommand(
+		TEXT("AccelByte.Sample.Bench.PagedCatalog"),
+		TEXT("Opens and scrolls a synthetic catalog loaded all at once, page by page on demand and with scroll velocity prefetch."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchPagedCatalog));
+
+	struct FImageBench
+	{
+		TSharedPtr<FAccelByteImageCache> Cache;
+		TSharedPtr<IHttpRouter> Router;
+		FHttpRouteHandle RouteHandle;
+		TArray<TArray<uint8>> Images;
+		TArray<FString> Urls;
+		int32 Served = 0;
+		int32 ServedNotModified = 0;
+		int64 ServedBytes = 0;
+	};
+
+	static TArray<uint8> MakeBenchImage(IImageWrapperModule& Module, int32 Index, int32 Size)
+	{
+		TArray<uint8> Bgra;
+		Bgra.SetNumUninitialized(Size * Size * 4);
+		for (int32 Y = 0; Y < Size; Y++)
+		{
+			for (int32 X = 0; X < Size; X++)
+			{
+				uint8* Pixel = &Bgra[(Y * Size + X) * 4];
+				Pixel[0] = static_cast<uint8>(X * 255 / Size);
+				Pixel[1] = static_cast<uint8>(Y * 255 / Size);
+				Pixel[2] = static_cast<uint8>(Index * 37);
+				Pixel[3] = 255;
+			}
+		}
+
+		TSharedPtr<IImageWrapper> Wrapper = Module.CreateImageWrapper(EImageFormat::PNG);
+		Wrapper->SetRaw(Bgra.GetData(), Bgra.Num(), Size, Size, ERGBFormat::BGRA, 8);
+		return Wrapper->GetCompressed();
+	}
+
+	// Pass 0 is cold with every URL requested twice, 1 is served from memory, 2 from disk, 3 revalidates the disk entries
+	static void RunImageBenchPass(TSharedRef<FImageBench> const& Bench, int32 Pass)
+	{
+		if (Pass > 3)
+		{
+			Bench->Router->UnbindRoute(Bench->RouteHandle);
+			Bench->Cache->ClearDisk();
+			return;
+		}
+
+		if (Pass == 2)
+		{
+			Bench->Cache->ClearMemory();
+		}
+		else if (Pass == 3)
+		{
+			FAccelByteImageCache::FSettings Settings;
+			Settings.RevalidateSeconds = 0.0;
+			Bench->Cache->Configure(Settings);
+			Bench->Cache->ClearMemory();
+		}
+
+		const FAccelByteImageCacheStats Before = Bench->Cache->GetStats();
+		const int32 ServedBefore = Bench->Served;
+		const int32 RequestsPerUrl = Pass == 0 ? 2 : 1;
+		TSharedRef<int32> Remaining = MakeShared<int32>(Bench->Urls.Num() * RequestsPerUrl);
+		TSharedRef<int32> Failed = MakeShared<int32>(0);
+		const double Start = FPlatformTime::Seconds();
+		for (FString const& Url : Bench->Urls)
+		{
+			for (int32 Request = 0; Request < RequestsPerUrl; Request++)
+			{
+				Bench->Cache->Load(Url, [Bench, Pass, Remaining, Failed, Before, ServedBefore, Start](UTexture2D* Texture, FString const&)
+				{
+					*Failed += Texture == nullptr ? 1 : 0;
+					if (--*Remaining > 0)
+					{
+						return;
+					}
+
+					static const TCHAR* PassNames[] = { TEXT("cold"), TEXT("memory"), TEXT("disk"), TEXT("revalidate") };
+					const FAccelByteImageCacheStats Stats = Bench->Cache->GetStats();
+					UE_LOG(LogAccelByteSampleApp, Display, TEXT("ImageCache: %-10s - %8.2f ms - %d memory hits, %d disk hits, %d not modified, %d downloads, %d coalesced, %d failed - %d served by the stand-in - %lld KB in memory, %lld KB on disk"),
+						PassNames[Pass], (FPlatformTime::Seconds() - Start) * 1000.0,
+						Stats.MemoryHits - Before.MemoryHits, Stats.DiskHits - Before.DiskHits, Stats.NotModified - Before.NotModified,
+						Stats.Downloads - Before.Downloads, Stats.Coalesced - Before.Coalesced, *Failed, Bench->Served - ServedBefore,
+						Stats.MemoryBytes / 1024, Stats.DiskBytes / 1024);
+
+					// The next pass starts outside of the cache callback
+					FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Bench, Pass](float)
+					{
+						RunImageBenchPass(Bench, Pass + 1);
+						return false;
+					}));
+				});
+			}
+		}
+	}
+
+	// AccelByte.Sample.Bench.ImageCache [Images] [-size=<pixels>] [-port=N] [-memorymb=N]
+	static void BenchImageCache(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumImages = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 64;
+		const int32 Size = Options.Contains(TEXT("size")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("size")])) : 256;
+		const int32 Port = Options.Contains(TEXT("port")) ? FCString::Atoi(*Options[TEXT("port")]) : 18081;
+
+		TSharedRef<FImageBench> Bench = MakeShared<FImageBench>();
+		Bench->Router = FHttpServerModule::Get().GetHttpRouter(Port);
+		if (!Bench->Router.IsValid())
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("ImageCache: cannot listen on port %d"), Port);
+			return;
+		}
+
+		IImageWrapperModule& ImageWrapper = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+		int64 EncodedBytes = 0;
+		for (int32 Index = 0; Index < NumImages; Index++)
+		{
+			Bench->Images.Add(MakeBenchImage(ImageWrapper, Index, Size));
+			Bench->Urls.Add(FString::Printf(TEXT("http://localhost:%d/bench-images?id=%d"), Port, Index));
+			EncodedBytes += Bench->Images.Last().Num();
+		}
+
+		// Stand-in for the CDN, one ETag per image
+		TWeakPtr<FImageBench> WeakBench = Bench;
+		Bench->RouteHandle = Bench->Router->BindRoute(FHttpPath(TEXT("/bench-images")), EHttpServerRequestVerbs::VERB_GET, [WeakBench](FHttpServerRequest const& Request, FHttpResultCallback const& OnComplete)
+		{
+			TSharedPtr<FImageBench> Bench = WeakBench.Pin();
+			FString const* Id = Request.QueryParams.Find(TEXT("id"));
+			const int32 Index = Id != nullptr ? FCString::Atoi(**Id) : -1;
+			TUniquePtr<FHttpServerResponse> Response = MakeUnique<FHttpServerResponse>();
+			if (!Bench.IsValid() || !Bench->Images.IsValidIndex(Index))
+			{
+				Response->Code = EHttpServerResponseCodes::NotFound;
+				OnComplete(MoveTemp(Response));
+				return true;
+			}
+
+			const FString ETag = FString::Printf(TEXT("\"bench-%d\""), Index);
+			Bench->Served++;
+			Response->Headers.Add(TEXT("etag"), { ETag });
+			for (TPair<FString, TArray<FString>> const& Header : Request.Headers)
+			{
+				if (Header.Key.Equals(TEXT("if-none-match"), ESearchCase::IgnoreCase) && Header.Value.Contains(ETag))
+				{
+					Bench->ServedNotModified++;
+					Response->Code = EHttpServerResponseCodes::NotModified;
+					OnComplete(MoveTemp(Response));
+					return true;
+				}
+			}
+
+			Bench->ServedBytes += Bench->Images[Index].Num();
+			Response->Code = EHttpServerResponseCodes::Ok;
+			Response->Headers.Add(TEXT("content-type"), { TEXT("image/png") });
+			Response->Body = Bench->Images[Index];
+			OnComplete(MoveTemp(Response));
+			return true;
+		});
+		FHttpServerModule::Get().StartAllListeners();
+
+		FAccelByteImageCache::FSettings Settings;
+		if (Options.Contains(TEXT("memorymb")))
+		{
+			Settings.MemoryBudgetBytes = static_cast<int64>(FCString::Atoi(*Options[TEXT("memorymb")])) * 1024 * 1024;
+		}
+		Bench->Cache = MakeShared<FAccelByteImageCache>(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("BenchImageCache"));
+		Bench->Cache->Configure(Settings);
+		Bench->Cache->ClearDisk();
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("ImageCache: %d images of %dx%d, %lld KB encoded, %lld KB decoded, memory budget %lld MB"),
+			NumImages, Size, Size, EncodedBytes / 1024, static_cast<int64>(NumImages) * Size * Size * 4 / 1024, Settings.MemoryBudgetBytes / (1024 * 1024));
+		RunImageBenchPass(Bench, 0);
+	}
+
+	static FAutoConsoleCommand BenchImageCacheCommand(
+		TEXT("AccelByte.Sample.Bench.ImageCache"),
+		TEXT("Loads generated images from a local HTTP stand-in cold, from memory, from disk and revalidated with If-None-Match."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchImageCache));
+
+	static FAccelByteModelsEntitlementInfo MakeBenchEntitlement(int32 Index)
+	{
+		FAccelByteModelsEntitlementInfo Entitlement;
+		Entitlement.Id = FString::Printf(TEXT("%032x"), Index);
+		Entitlement.ItemId = FString::Printf(TEXT("item-%08x"), Index);
+		Entitlement.Sku = FString::Printf(TEXT("bench-sku-%d"), Index);
+		Entitlement.Name = FString::Printf(TEXT("Bench entitlement %d"), Index);
+		Entitlement.Status = EAccelByteEntitlementStatus::ACTIVE;
+		Entitlement.UpdatedAt = FDateTime(2022, 1, 1) + FTimespan::FromSeconds(Index);
+		return Entitlement;
+	}
+
+	// AccelByte.Sample.Bench.EntitlementMirror [Entitlements] [-purchases=N] [-checks=<ownership checks per refresh>]
+	static void BenchEntitlementMirror(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumEntitlements = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 2000;
+		const int32 NumPurchases = Options.Contains(TEXT("purchases")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("purchases")])) : 100;
+		const int32 NumChecks = Options.Contains(TEXT("checks")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("checks")])) : 200;
+
+		TArray<FAccelByteModelsEntitlementInfo> Listing;
+		for (int32 Index = 0; Index < NumEntitlements; Index++)
+		{
+			Listing.Add(MakeBenchEntitlement(Index));
+		}
+
+		// What the widgets did: reload the whole list after every purchase and scan it for ownership
+		int32 Owned = 0;
+		const double ReloadStart = FPlatformTime::Seconds();
+		for (int32 Purchase = 0; Purchase < NumPurchases; Purchase++)
+		{
+			Listing.Add(MakeBenchEntitlement(NumEntitlements + Purchase));
+			const TArray<FAccelByteModelsEntitlementInfo> Reloaded = Listing;
+			for (int32 Check = 0; Check < NumChecks; Check++)
+			{
+				const FString ItemId = FString::Printf(TEXT("item-%08x"), (Check * 7919) % Listing.Num());
+				Owned += Reloaded.ContainsByPredicate([&ItemId](FAccelByteModelsEntitlementInfo const& Entitlement)
+				{
+					return Entitlement.ItemId == ItemId && Entitlement.Status == EAccelByteEntitlementStatus::ACTIVE;
+				}) ? 1 : 0;
+			}
+		}
+		const double ReloadSeconds = FPlatformTime::Seconds() - ReloadStart;
+		const int64 ReloadRows = static_cast<int64>(NumPurchases) * NumEntitlements + static_cast<int64>(NumPurchases) * (NumPurchases + 1) / 2;
+
+		// The mirror gets the newest page, which only holds the purchase as a change
+		FAccelByteEntitlementMirror Mirror;
+		Listing.SetNum(NumEntitlements);
+		Mirror.ApplyEntitlements(Listing, true);
+		int32 ChangedRows = 0;
+		Mirror.OnChanged().AddLambda([&ChangedRows](FAccelByteEntitlementDelta const& Delta)
+		{
+			ChangedRows += Delta.Changed.Num() + Delta.RemovedIds.Num();
+		});
+
+		int32 MirrorOwned = 0;
+		const double MirrorStart = FPlatformTime::Seconds();
+		for (int32 Purchase = 0; Purchase < NumPurchases; Purchase++)
+		{
+			Listing.Add(MakeBenchEntitlement(NumEntitlements + Purchase));
+			const int32 PageStart = FMath::Max(0, Listing.Num() - 50);
+			Mirror.ApplyEntitlements(TArray<FAccelByteModelsEntitlementInfo>(Listing.GetData() + PageStart, Listing.Num() - PageStart), false);
+			for (int32 Check = 0; Check < NumChecks; Check++)
+			{
+				MirrorOwned += Mirror.IsItemOwned(FString::Printf(TEXT("item-%08x"), (Check * 7919) % Listing.Num())) ? 1 : 0;
+			}
+		}
+		const double MirrorSeconds = FPlatformTime::Seconds() - MirrorStart;
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("EntitlementMirror: %d entitlements, %d purchases, %d ownership checks each"), NumEntitlements, NumPurchases, NumChecks);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("EntitlementMirror: full reload - %8.2f ms - %lld rows copied - %d owned"), ReloadSeconds * 1000.0, ReloadRows, Owned);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("EntitlementMirror: mirror      - %8.2f ms - %d rows changed - %d owned"), MirrorSeconds * 1000.0, ChangedRows, MirrorOwned);
+	}
+
+	static FAutoConsoleCommand BenchEntitlementMirrorCommand(
+		TEXT("AccelByte.Sample.Bench.EntitlementMirror"),
+		TEXT("Compares reloading and scanning the full entitlement list after each purchase with applying the newest page to the mirror."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchEntitlementMirror));
+
+	// AccelByte.Sample.Bench.AsyncActions [Actions] [-rounds=N] [-inflight=<nodes running at once>]
+	static void BenchAsyncActions(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumActions = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 2000;
+		const int32 NumRounds = Options.Contains(TEXT("rounds")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("rounds")])) : 10;
+		// Nodes running at the same time, each of them holds its own proxy
+		const int32 InFlight = Options.Contains(TEXT("inflight")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("inflight")])) : 4;
+
+		// What the nodes did: a new proxy per call, left to the garbage collector once done
+		double AllocateSeconds = 0.0;
+		double AllocateGcSeconds = 0.0;
+		for (int32 Round = 0; Round < NumRounds; Round++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumActions; Index++)
+			{
+				NewObject<UAccelByteGetItemsBySkus>(GetTransientPackage());
+			}
+			const double GcStart = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			AllocateSeconds += GcStart - Start;
+			AllocateGcSeconds += FPlatformTime::Seconds() - GcStart;
+		}
+
+		// Pooled proxies, an empty SKU list completes on Activate and sends the proxy back to the pool
+		const FAccelByteAsyncActionStats Before = UAccelByteAsyncAction::GetStats();
+		// Released proxies go back into the pool on the next tick of the pool ticker, this one runs nothing else
+		FTicker PoolTicker;
+		UAccelByteAsyncAction::SetPoolTicker(&PoolTicker);
+		double PooledSeconds = 0.0;
+		double PooledGcSeconds = 0.0;
+		TArray<UAccelByteGetItemsBySkus*> Running;
+		for (int32 Round = 0; Round < NumRounds; Round++)
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < NumActions; Index += InFlight)
+			{
+				for (int32 Slot = 0; Slot < InFlight; Slot++)
+				{
+					Running.Add(UAccelByteGetItemsBySkus::GetItemsBySkusAsync(nullptr, TArray<FString>()));
+				}
+				for (UAccelByteGetItemsBySkus* Proxy : Running)
+				{
+					Proxy->Activate();
+				}
+				Running.Reset();
+				PoolTicker.Tick(0.0f);
+			}
+			const double GcStart = FPlatformTime::Seconds();
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+			PooledSeconds += GcStart - Start;
+			PooledGcSeconds += FPlatformTime::Seconds() - GcStart;
+		}
+		UAccelByteAsyncAction::SetPoolTicker(nullptr);
+		const FAccelByteAsyncActionStats After = UAccelByteAsyncAction::GetStats();
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("AsyncActions: %d actions per round, %d rounds, %d in flight"), NumActions, NumRounds, InFlight);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("AsyncActions: per call - %8.2f ms - GC %8.2f ms per round - %d proxies created"), AllocateSeconds * 1000.0, AllocateGcSeconds * 1000.0 / NumRounds, NumActions * NumRounds);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("AsyncActions: pooled   - %8.2f ms - GC %8.2f ms per round - %d proxies created, %d reused"), PooledSeconds * 1000.0, PooledGcSeconds * 1000.0 / NumRounds, After.Created - Before.Created, After.Reused - Before.Reused);
+	}
+
+	static FAutoConsoleCommand BenchAsyncActionsCommand(
+		TEXT("AccelByte.Sample.Bench.AsyncActions"),
+		TEXT("Compares allocation and garbage collection time of per call async proxies against pooled ones."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchAsyncActions));
+
+	// AccelByte.Sample.Bench.StatWrites [Writes] [-codes=N] [-rate=<writes per second>] [-latency=<ms per request>] [-interval=<seconds>]
+	static void BenchStatWrites(TArray<FString> const& Args)
+	{
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 NumWrites = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 2000;
+		const int32 NumCodes = Options.Contains(TEXT("codes")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("codes")])) : 20;
+		const float WritesPerSecond = Options.Contains(TEXT("rate")) ? FMath::Max(1.0f, FCString::Atof(*Options[TEXT("rate")])) : 200.0f;
+		const float LatencySeconds = Options.Contains(TEXT("latency")) ? FMath::Max(0.0f, FCString::Atof(*Options[TEXT("latency")]) / 1000.0f) : 0.15f;
+
+		FAccelByteStatWriteBuffer::FSettings Settings;
+		Settings.FlushIntervalSeconds = Options.Contains(TEXT("interval")) ? FCString::Atof(*Options[TEXT("interval")]) : 2.0f;
+
+		const FString BufferPath = FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("BenchStatWriteBuffer.log");
+		IFileManager::Get().Delete(*BufferPath);
+
+		// The handler answers every request after the latency without a backend
+		TSharedRef<FAccelByteStatWriteBuffer> Buffer = MakeShared<FAccelByteStatWriteBuffer>(BufferPath);
+		Buffer->Configure(Settings);
+		Buffer->SetRequestHandler([LatencySeconds](FAccelByteStatWriteBuffer::FRequest const&, FAccelByteStatWriteBuffer::FRequestResult const& OnResult)
+		{
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([OnResult](float)
+			{
+				OnResult(true, false);
+				return false;
+			}), LatencySeconds);
+		});
+		Buffer->BeginSession(TEXT("bench-user"));
+
+		// Kills, assists and the like are increments, a best score is a set and a loadout is a profile attribute
+		TSharedRef<int32> Written = MakeShared<int32>(0);
+		TSharedRef<bool> bMatchEnded = MakeShared<bool>(false);
+		const double Start = FPlatformTime::Seconds();
+		FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Buffer, Written, bMatchEnded, Start, NumWrites, NumCodes, WritesPerSecond, BufferPath](float)
+		{
+			const int32 Due = FMath::Min(NumWrites, static_cast<int32>((FPlatformTime::Seconds() - Start) * WritesPerSecond));
+			for (; *Written < Due; (*Written)++)
+			{
+				const int32 Index = *Written;
+				if (Index % 10 == 9)
+				{
+					Buffer->SetProfileAttribute(TEXT("bench-profile"), FString::Printf(TEXT("loadout-%d"), Index % 4), FString::Printf(TEXT("weapon-%d"), Index));
+				}
+				else if (Index % 10 == 8)
+				{
+					Buffer->SetStat(FString::Printf(TEXT("bench-best-%d"), Index % 3), static_cast<float>(Index));
+				}
+				else
+				{
+					Buffer->IncrementStat(FString::Printf(TEXT("bench-stat-%d"), Index % NumCodes), 1.0f);
+				}
+			}
+			if (*Written < NumWrites)
+			{
+				return true;
+			}
+
+			if (!*bMatchEnded)
+			{
+				*bMatchEnded = true;
+				Buffer->Flush();
+			}
+			if (Buffer->IsFlushing() || Buffer->NumPending() > 0)
+			{
+				return true;
+			}
+
+			const FAccelByteStatWriteStats Stats = Buffer->GetStats();
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("StatWrites: %d writes in %.1f s, %d merged - %d requests instead of %d (%.1fx fewer) - %d flushes"),
+				Stats.Writes, FPlatformTime::Seconds() - Start, Stats.Merged, Stats.Requests, Stats.Writes, Stats.Requests > 0 ? static_cast<float>(Stats.Writes) / Stats.Requests : 0.0f, Stats.Flushes);
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("StatWrites: flush avg %.1f ms max %.1f ms - oldest write waited up to %.1f ms"), Stats.AverageFlushMs, Stats.MaxFlushMs, Stats.MaxWriteAgeMs);
+
+			// A run cut short before its flush, the next buffer reads the writes back from the file
+			IFileManager::Get().Delete(*BufferPath);
+			const int32 NumCrashWrites = 100;
+			{
+				FAccelByteStatWriteBuffer::FSettings CrashSettings;
+				CrashSettings.FlushThreshold = NumCrashWrites + 1;
+				FAccelByteStatWriteBuffer Crashed(BufferPath);
+				Crashed.Configure(CrashSettings);
+				Crashed.BeginSession(TEXT("bench-user"));
+				for (int32 Index = 0; Index < NumCrashWrites; Index++)
+				{
+					Crashed.IncrementStat(FString::Printf(TEXT("bench-stat-%d"), Index % NumCodes), 1.0f);
+				}
+			}
+			const double LoadStart = FPlatformTime::Seconds();
+			FAccelByteStatWriteBuffer Recovered(BufferPath);
+			Recovered.Load();
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("StatWrites: recovery - %d of %d writes read back as %d pending stat codes in %.2f ms"),
+				Recovered.GetStats().Recovered, NumCrashWrites, Recovered.NumPending(), (FPlatformTime::Seconds() - LoadStart) * 1000.0);
+			IFileManager::Get().Delete(*BufferPath);
+			return false;
+		}));
+	}
+
+	static FAutoConsoleCommand BenchStatWritesCommand(
+		TEXT("AccelByte.Sample.Bench.StatWrites"),
+		TEXT("Simulates a match of stat and profile writes through the write buffer with a backend stand-in and reports requests, flush latency and crash recovery."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchStatWrites));
+
+#if WITH_ACCELBYTE_OPENSSL && OPENSSL_VERSION_NUMBER >= 0x10100000L
+	// Looks each subject up the way a chain verification asks for an issuer, returns how many were found
+	static int32 ResolveSubjects(X509_STORE* Store, TArray<X509_NAME*> const& Subjects)
+	{
+		int32 Found = 0;
+		X509_STORE_CTX* Context = X509_STORE_CTX_new();
+		if (Context != nullptr && X509_STORE_CTX_init(Context, Store, nullptr, nullptr) == 1)
+		{
+			for (X509_NAME* Subject : Subjects)
+			{
+				X509_OBJECT* Object = X509_OBJECT_new();
+				if (X509_STORE_CTX_get_by_subject(Context, X509_LU_X509, Subject, Object) == 1)
+				{
+					Found++;
+				}
+				X509_OBJECT_free(Object);
+			}
+		}
+		X509_STORE_CTX_free(Context);
+		return Found;
+	}
+#endif
+
+	// AccelByte.Sample.Bench.TrustStore [Iterations] [-lookups=<roots a connection needs>]
+	static void BenchTrustStore(TArray<FString> const& Args)
+	{
+#if WITH_ACCELBYTE_OPENSSL && OPENSSL_VERSION_NUMBER >= 0x10100000L
+		TMap<FString, FString> Options;
+		const TArray<FString> Positional = ParseArgs(Args, Options);
+		const int32 Iterations = Positional.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Positional[0])) : 20;
+		const int32 NumLookups = Options.Contains(TEXT("lookups")) ? FMath::Max(1, FCString::Atoi(*Options[TEXT("lookups")])) : 3;
+
+		// Nothing stages a cache, the prototype reads one built from the bundle for this run
+		const FString PemPath = FAccelByteTrustStorePrototype::GetDefaultPemPath();
+		const FString CachePath = FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("BenchTrustStore.abts");
+		int32 NumCertificates = 0;
+		FString Error;
+		if (!FAccelByteTrustStorePrototype::BuildCache(PemPath, CachePath, NumCertificates, Error))
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store benchmark cannot build its cache: %s"), *Error);
+			return;
+		}
+
+		TArray<uint8> Pem;
+		FFileHelper::LoadFileToArray(Pem, *PemPath);
+
+		// Subjects spread over the bundle stand for the roots of the hosts the game connects to
+		TArray<X509_NAME*> Subjects;
+		{
+			BIO* Bio = BIO_new_mem_buf(Pem.GetData(), Pem.Num());
+			const int32 Stride = FMath::Max(1, NumCertificates / NumLookups);
+			int32 Index = 0;
+			while (X509* Certificate = PEM_read_bio_X509(Bio, nullptr, nullptr, nullptr))
+			{
+				if (Index++ % Stride == 0 && Subjects.Num() < NumLookups)
+				{
+					Subjects.Add(X509_NAME_dup(X509_get_subject_name(Certificate)));
+				}
+				X509_free(Certificate);
+			}
+			BIO_free(Bio);
+			ERR_clear_error();
+		}
+
+		double PemMs = 0.0;
+		double CacheMs = 0.0;
+		int32 PemFound = 0;
+		int32 CacheFound = 0;
+		int32 Decoded = 0;
+		bool bMapped = false;
+		for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+		{
+			// What the engine does for every context: parse the whole bundle and add every certificate
+			double Start = FPlatformTime::Seconds();
+			{
+				TArray<uint8> Bytes;
+				FFileHelper::LoadFileToArray(Bytes, *PemPath);
+				X509_STORE* Store = X509_STORE_new();
+				BIO* Bio = BIO_new_mem_buf(Bytes.GetData(), Bytes.Num());
+				while (X509* Certificate = PEM_read_bio_X509(Bio, nullptr, nullptr, nullptr))
+				{
+					X509_STORE_add_cert(Store, Certificate);
+					X509_free(Certificate);
+				}
+				BIO_free(Bio);
+				ERR_clear_error();
+				PemFound += ResolveSubjects(Store, Subjects);
+				X509_STORE_free(Store);
+			}
+			PemMs += (FPlatformTime::Seconds() - Start) * 1000.0;
+
+			// The store goes before the trust store, its lookup points at it
+			Start = FPlatformTime::Seconds();
+			{
+				FAccelByteTrustStorePrototype TrustStore(PemPath, CachePath);
+				X509_STORE* Store = X509_STORE_new();
+				TrustStore.AddToStore(Store);
+				CacheFound += ResolveSubjects(Store, Subjects);
+				X509_STORE_free(Store);
+				Decoded += TrustStore.NumInstalled();
+				bMapped = TrustStore.GetStats().bMapped;
+			}
+			CacheMs += (FPlatformTime::Seconds() - Start) * 1000.0;
+		}
+
+		for (X509_NAME* Subject : Subjects)
+		{
+			X509_NAME_free(Subject);
+		}
+		const int64 CacheSize = IFileManager::Get().FileSize(*CachePath);
+		IFileManager::Get().Delete(*CachePath);
+
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Trust store: %d certificates - PEM %lld bytes - cache %lld bytes%s - %d lookups x %d iterations"),
+			NumCertificates, static_cast<int64>(Pem.Num()), CacheSize, bMapped ? TEXT(" mapped") : TEXT(""), Subjects.Num(), Iterations);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("  PEM parse + add all:   %.3f ms per context - %d/%d found"),
+			PemMs / Iterations, PemFound, Subjects.Num() * Iterations);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("  Cache open + lookups:  %.3f ms per context - %d/%d found - %.1f certificates decoded per context"),
+			CacheMs / Iterations, CacheFound, Subjects.Num() * Iterations, static_cast<float>(Decoded) / Iterations);
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("  Speedup x%.1f"), CacheMs > 0.0 ? PemMs / CacheMs : 0.0);
+#else
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store benchmark needs OpenSSL 1.1 or later on this platform"));
+#endif
+	}
+
+	static FAutoConsoleCommand BenchTrustStoreCommand(
+		TEXT("AccelByte.Sample.Bench.TrustStore"),
+		TEXT("Compares parsing cacert.pem into a TLS certificate store against opening the binary trust store cache and resolving a few roots lazily."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&BenchTrustStore));
+}
+
+#endif // !UE_BUILD_SHIPPING
+
+
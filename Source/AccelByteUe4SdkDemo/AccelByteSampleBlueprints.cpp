@@ -1,7 +1,25 @@
 ﻿#include "AccelByteSampleBlueprints.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteItemCache.h"
+#include "AccelByteReceiptParser.h"
+#include "AccelBytePurchaseJournal.h"
+#include "AccelByteSteamAuthReadiness.h"
+#include "AccelByteSessionWarmup.h"
+#include "AccelByteSessionCache.h"
+#include "AccelByteOnlineContext.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteHttpFixture.h"
+#include "AccelByteLobbyState.h"
+#include "AccelByteChatHistory.h"
+#include "AccelBytePagedCatalog.h"
+#include "AccelByteStatWriteBuffer.h"
+#include "AccelByteMemoryReport.h"
+#include "AccelByteServerValidation.h"
 
-#include "Misc/DateTime.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
 #include "Misc/ConfigCacheIni.h"
+#include "Misc/DateTime.h"
 
 #include "OnlineSubsystem.h"
 #include "Interfaces/OnlineIdentityInterface.h"
@@ -12,17 +30,48 @@
 #include "Api/AccelByteEntitlementApi.h"
 #include "Api/AccelByteItemApi.h"
 
-#define STEAM_LOGIN_DELAY 2 // seconds
-
-DECLARE_LOG_CATEGORY_EXTERN(LogAccelByteSampleApp, Log, All);
-DEFINE_LOG_CATEGORY(LogAccelByteSampleApp);
 
 #define DEFAULT_SUBSYSTEM_NAME TEXT("DefaultPlatformService")
 #define NATIVE_SUBSYSTEM_NAME TEXT("NativePlatformService")
+#define SAMPLE_APP_CONFIG_SECTION TEXT("AccelByteSampleApp")
 
 static FString DefaultSubsystemName;
 static FString NativeSubsystemName;
 
+// Work that needs a logged in user, shared by the full login and a resumed session
+static void OnAccelByteSessionStarted()
+{
+	// Sent before the login result is broadcast so the queries are in flight while the next screen is being built
+	FAccelByteSessionWarmup::Get().Start();
+	FAccelByteLobbyState::Get().Reset();
+	FAccelByteChatHistory::Get().Reset();
+	FAccelByteEntitlementMirror::Get().Reset();
+	FAccelByteSessionWarmup::Get().WhenReady([](FAccelByteSessionSnapshot const& Snapshot)
+	{
+		FAccelByteEntitlementMirror::Get().Seed(Snapshot);
+	});
+	FAccelByteStatWriteBuffer::Get().BeginSession(FRegistry::Credentials.GetUserId());
+}
+
+static void OnAccelByteSessionBroadcast()
+{
+	// Purchases whose sync was interrupted in a previous session can only be sent once a user is logged in
+	FAccelBytePurchaseJournal::Get().Replay();
+}
+
+// IAM codes of a refresh token grant whose token is invalid or expired, and of one that was revoked
+#define IAM_REFRESH_TOKEN_INVALID_ERROR 10196
+#define IAM_REFRESH_TOKEN_REVOKED_ERROR 10197
+
+// IAM refused the refresh token itself, as opposed to the request not reaching it, IAM failing to answer or any other
+// bad request. OAuth answers an expired or revoked refresh token with invalid_grant.
+static bool IsRefreshTokenRejected(int32 ErrorCode, FString const& ErrorMessage)
+{
+	return ErrorMessage.Contains(TEXT("invalid_grant"))
+		|| ErrorCode == IAM_REFRESH_TOKEN_INVALID_ERROR
+		|| ErrorCode == IAM_REFRESH_TOKEN_REVOKED_ERROR;
+}
+
 UAccelByteLoginNativePlatform::UAccelByteLoginNativePlatform(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 	, WorldContextObject(nullptr)
@@ -33,35 +82,41 @@ UAccelByteLoginNativePlatform* UAccelByteLoginNativePlatform::LoginWithNativePla
 	( UObject* WorldContextObject
 	, APlayerController* InPlayerController )
 {
-	UAccelByteLoginNativePlatform* Proxy = NewObject<UAccelByteLoginNativePlatform>();
+	UAccelByteLoginNativePlatform* Proxy = Acquire<UAccelByteLoginNativePlatform>();
 	Proxy->PlayerControllerWeakPtr = InPlayerController;
 	Proxy->WorldContextObject = WorldContextObject;
+	// The platform login UI waits on the user, there is no sensible time to give up after
+	Proxy->TimeoutSeconds = 0.0f;
 	return Proxy;
 }
 
-void UAccelByteLoginNativePlatform::Activate()
+void UAccelByteLoginNativePlatform::Start()
 {
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	FAccelByteSessionCache::Get().MarkFullLoginStarted();
+
 	APlayerController* MyPlayerController = PlayerControllerWeakPtr.Get();
 	if (!MyPlayerController)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("A player controller must be provided in order to do login with native platform."));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("player-controller-not-provided"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("player-controller-not-provided"));
 		return;
 	}
 	
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(FName(NativeSubsystemName));
+	FAccelByteOnlineContext& OnlineContext = FAccelByteOnlineContext::Get();
+	const IOnlineSubsystem* OnlineSubsystem = OnlineContext.GetSubsystem(FAccelByteOnlineContext::ESubsystem::Native);
 	if (OnlineSubsystem == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot login with no online subsystem set!"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
 		return;
 	}
 
-	const IOnlineIdentityPtr OnlineIdentity = OnlineSubsystem->GetIdentityInterface();
+	const IOnlineIdentityPtr OnlineIdentity = OnlineContext.GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
 	if (!OnlineIdentity.IsValid())
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Could not retrieve identity interface from native subsystem."));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
 		return;
 	}
 
@@ -69,25 +124,28 @@ void UAccelByteLoginNativePlatform::Activate()
 	if (LocalPlayer == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Can only login with native platform for local players"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
 		return;
 	}
 
 	const ELoginStatus::Type LoginStatus = OnlineIdentity->GetLoginStatus(LocalPlayer->GetControllerId());
 	if (LoginStatus == ELoginStatus::LoggedIn)
 	{
-		OnSuccess.Broadcast(MyPlayerController, 0, TEXT(""));
+		Succeed();
 		return;
 	}
 	
-	const FOnLoginCompleteDelegate NativeLoginComplete = FOnLoginCompleteDelegate::CreateUObject(this, &UAccelByteLoginNativePlatform::OnLoginNativePlatformCompleted);
-	OnlineIdentity->AddOnLoginCompleteDelegate_Handle(LocalPlayer->GetControllerId(), NativeLoginComplete);
-	const bool bWaitForDelegate = OnlineIdentity->Login(LocalPlayer->GetControllerId(), FOnlineAccountCredentials());
+	// Bound to this object so ClearOnLoginCompleteDelegates can find it, and to this use of the proxy
+	const FOnLoginCompleteDelegate NativeLoginComplete = FOnLoginCompleteDelegate::CreateWeakLambda(this, Bind(&UAccelByteLoginNativePlatform::OnLoginNativePlatformCompleted));
+	LoginLocalUserNum = LocalPlayer->GetControllerId();
+	OnlineIdentity->AddOnLoginCompleteDelegate_Handle(LoginLocalUserNum, NativeLoginComplete);
+	const bool bWaitForDelegate = OnlineIdentity->Login(LoginLocalUserNum, FOnlineAccountCredentials());
 
 	if (!bWaitForDelegate)
 	{
 		UE_LOG(LogAccelByteSampleApp, Display, TEXT("The online subsystem couldn't login"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT(""));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT(""));
+		return;
 	}
 
 	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Sending login request to native subsystem!"));
@@ -116,55 +174,73 @@ void UAccelByteLoginNativePlatform::OnLoginNativePlatformCompleted
 		}
 	}
 
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(FName(NativeSubsystemName));
+	FAccelByteOnlineContext& OnlineContext = FAccelByteOnlineContext::Get();
+	const IOnlineSubsystem* OnlineSubsystem = OnlineContext.GetSubsystem(FAccelByteOnlineContext::ESubsystem::Native);
 	if (OnlineSubsystem == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot login with native subsystem as none was set!"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
 		return;
 	}
 
-	const IOnlineIdentityPtr OnlineIdentity = OnlineSubsystem->GetIdentityInterface();
+	const IOnlineIdentityPtr OnlineIdentity = OnlineContext.GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
 	if (!OnlineIdentity.IsValid())
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Could not retrieve identity interface from native subsystem."));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
 		return;
 	}
 	
 	// Clear the delegate for our login as it will be invalid once this task ends
 	OnlineIdentity->ClearOnLoginCompleteDelegates(NativeLocalUserNum, this);
 
-	// Set the login type for this request to be the login type corresponding to the native subsystem
-	const EAccelBytePlatformType PlatformType = UAccelByteBluePrintsSample::GetPlatformTypeFromSubsystem(OnlineSubsystem->GetSubsystemName().ToString());
-
 	if (bWasNativeLoginSuccessful)
 	{
-		if (PlatformType == EAccelBytePlatformType::Steam)
-		{
-			int64 TriggerTime = FDateTime::UtcNow().ToUnixTimestamp() + STEAM_LOGIN_DELAY;
-			FTicker::GetCoreTicker().AddTicker(
-				FTickerDelegate::CreateLambda([TriggerTime, MyPlayerController, this](float Time)
-				{
-					if (TriggerTime > FDateTime::UtcNow().ToUnixTimestamp())
-					{
-						return true;
-					}
-					OnSuccess.Broadcast(MyPlayerController, 0, TEXT(""));
-
-					return false;
-				}),
-				0.2f);
-		}
-		else
-		{
-			OnSuccess.Broadcast(MyPlayerController, 0, TEXT(""));
-		}
+		// A Steam ticket is waited for by the AccelByte login that sends it
+		Succeed();
 	}
 	else
 	{
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), NativeError);
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), NativeError);
+	}
+}
+
+void UAccelByteLoginNativePlatform::Succeed()
+{
+	Finish([this]()
+	{
+		OnSuccess.Broadcast(PlayerControllerWeakPtr.Get(), 0, TEXT(""));
+	});
+}
+
+void UAccelByteLoginNativePlatform::Fail(int32 ErrorCode, FString const& ErrorMessage)
+{
+	Finish([this, ErrorCode, &ErrorMessage]()
+	{
+		OnAborted(ErrorCode, ErrorMessage);
+	});
+}
+
+void UAccelByteLoginNativePlatform::OnAborted(int32 ErrorCode, FString const& ErrorMessage)
+{
+	OnFailure.Broadcast(PlayerControllerWeakPtr.Get(), ErrorCode, ErrorMessage);
+}
+
+void UAccelByteLoginNativePlatform::ResetState()
+{
+	if (LoginLocalUserNum != INDEX_NONE)
+	{
+		// A cancelled or timed out login must not leave its delegate behind for the next use of the proxy
+		const IOnlineIdentityPtr OnlineIdentity = FAccelByteOnlineContext::Get().GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
+		if (OnlineIdentity.IsValid())
+		{
+			OnlineIdentity->ClearOnLoginCompleteDelegates(LoginLocalUserNum, this);
+		}
 	}
+
+	PlayerControllerWeakPtr.Reset();
+	WorldContextObject = nullptr;
+	LoginLocalUserNum = INDEX_NONE;
 }
 
 UAccelByteLogin::UAccelByteLogin(const FObjectInitializer& ObjectInitializer)
@@ -177,35 +253,40 @@ UAccelByteLogin* UAccelByteLogin::LoginWithAccelByte
 	( UObject* WorldContextObject
 	, APlayerController* InPlayerController )
 {
-	UAccelByteLogin* Proxy = NewObject<UAccelByteLogin>();
+	UAccelByteLogin* Proxy = Acquire<UAccelByteLogin>();
 	Proxy->PlayerControllerWeakPtr = InPlayerController;
 	Proxy->WorldContextObject = WorldContextObject;
+	// A login answered after a timeout would leave the SDK logged in with no session set up, the SDK's own HTTP
+	// timeout and retries bound the wait instead
+	Proxy->TimeoutSeconds = 0.0f;
 	return Proxy;
 }
 
-void UAccelByteLogin::Activate()
+void UAccelByteLogin::Start()
 {
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
 	APlayerController* MyPlayerController = PlayerControllerWeakPtr.Get();
 	if (!MyPlayerController)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("A player controller must be provided in order to do login with nataccelbyte."));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("player-controller-not-provided"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("player-controller-not-provided"));
 		return;
 	}
 	
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(FName(NativeSubsystemName));
+	FAccelByteOnlineContext& OnlineContext = FAccelByteOnlineContext::Get();
+	const IOnlineSubsystem* OnlineSubsystem = OnlineContext.GetSubsystem(FAccelByteOnlineContext::ESubsystem::Native);
 	if (OnlineSubsystem == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot login with no online subsystem set!"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
 		return;
 	}
 
-	const IOnlineIdentityPtr OnlineIdentity = OnlineSubsystem->GetIdentityInterface();
+	const IOnlineIdentityPtr OnlineIdentity = OnlineContext.GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
 	if (!OnlineIdentity.IsValid())
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Could not retrieve identity interface from native subsystem."));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
 		return;
 	}
 
@@ -213,35 +294,274 @@ void UAccelByteLogin::Activate()
 	if (LocalPlayer == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Can only login with native platform for local players"));
-		OnFailure.Broadcast(MyPlayerController, static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
+		return;
+	}
+
+	ControllerId = LocalPlayer->GetControllerId();
+	const TSharedPtr<const FUniqueNetId> NativeUniqueId = OnlineContext.GetUniquePlayerId(FAccelByteOnlineContext::ESubsystem::Native, ControllerId);
+	NativeUserId = NativeUniqueId.IsValid() ? NativeUniqueId->ToString() : TEXT("");
+
+	if (OnlineContext.GetPlatformType(FAccelByteOnlineContext::ESubsystem::Native) == EAccelBytePlatformType::Steam)
+	{
+		FAccelByteSteamAuthReadiness::RequestTicket(Bind(&UAccelByteLogin::OnSteamTicketReady));
 		return;
 	}
 
+	LoginWithPlatformToken(OnlineIdentity->GetAuthToken(ControllerId));
+}
+
+void UAccelByteLogin::OnSteamTicketReady(bool bTicketReady, FString const& Ticket)
+{
+	if (!Ticket.IsEmpty())
+	{
+		LoginWithPlatformToken(Ticket);
+		return;
+	}
+
+	// No ticket could be requested directly, the online subsystem may still have one
+	const IOnlineIdentityPtr OnlineIdentity = FAccelByteOnlineContext::Get().GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
+	if (!OnlineIdentity.IsValid())
+	{
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
+		return;
+	}
+	LoginWithPlatformToken(OnlineIdentity->GetAuthToken(ControllerId));
+}
+
+void UAccelByteLogin::LoginWithPlatformToken(FString const& PlatformToken)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
 	// Set the login type for this request to be the login type corresponding to the native subsystem
-	const EAccelBytePlatformType PlatformType = UAccelByteBluePrintsSample::GetPlatformTypeFromSubsystem(OnlineSubsystem->GetSubsystemName().ToString());
-	const FString PlatformToken = OnlineIdentity->GetAuthToken(LocalPlayer->GetControllerId());
-	
-	FSimpleDelegate OnLoginSuccessDelegate = FSimpleDelegate::CreateUObject(this, &UAccelByteLogin::OnLoginAccelByteCompleted);
-	AccelByte::FErrorHandler OnLoginErrorDelegate = AccelByte::FErrorHandler::CreateUObject(this, &UAccelByteLogin::OnLoginAccelByteFailed);
-	FRegistry::User.LoginWithOtherPlatform(PlatformType, PlatformToken, OnLoginSuccessDelegate, OnLoginErrorDelegate);
+	const EAccelBytePlatformType PlatformType = FAccelByteOnlineContext::Get().GetPlatformType(FAccelByteOnlineContext::ESubsystem::Native);
+
+	FSimpleDelegate OnLoginSuccessDelegate = FSimpleDelegate::CreateWeakLambda(this, Bind(&UAccelByteLogin::OnLoginAccelByteCompleted));
+	AccelByte::FErrorHandler OnLoginErrorDelegate = AccelByte::FErrorHandler::CreateWeakLambda(this, Bind(&UAccelByteLogin::OnLoginAccelByteFailed));
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::LoginWithOtherPlatform);
+	FRegistry::User.LoginWithOtherPlatform(PlatformType, PlatformToken, FAccelByteTelemetry::WrapSuccess(Telemetry, OnLoginSuccessDelegate), FAccelByteTelemetry::WrapError(Telemetry, OnLoginErrorDelegate));
 
 	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Sending login request to AccelByte service!"));
 }
 
 void UAccelByteLogin::OnLoginAccelByteCompleted()
 {
-	APlayerController* MyPlayerController = PlayerControllerWeakPtr.Get();
-	
 	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Successfully Login to AccelByte service!"));
-	OnSuccess.Broadcast(MyPlayerController, 0, TEXT(""));
+
+	FAccelByteSessionCache& SessionCache = FAccelByteSessionCache::Get();
+	FAccelByteSessionCache::FSession Session;
+	Session.RefreshToken = FRegistry::Credentials.GetRefreshToken();
+	Session.UserId = FRegistry::Credentials.GetUserId();
+	Session.NativeSubsystemName = NativeSubsystemName;
+	Session.NativeUserId = NativeUserId;
+	Session.SavedAt = FDateTime::UtcNow();
+	Session.FullLoginMs = SessionCache.GetFullLoginMs();
+	SessionCache.Save(Session);
+	SessionCache.RecordSessionReady(false, Session.FullLoginMs, Session.FullLoginMs);
+
+	OnAccelByteSessionStarted();
+	Succeed();
+	OnAccelByteSessionBroadcast();
 }
 
 void UAccelByteLogin::OnLoginAccelByteFailed(int32 ErrorCode, FString const& ErrorMessage)
 {
-	APlayerController* MyPlayerController = PlayerControllerWeakPtr.Get();
-	
 	UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed Login to AccelByte service! code: %d - message: %s"), ErrorCode, *ErrorMessage);
-	OnFailure.Broadcast(MyPlayerController, ErrorCode, ErrorMessage);
+	Fail(ErrorCode, ErrorMessage);
+}
+
+void UAccelByteLogin::Succeed()
+{
+	Finish([this]()
+	{
+		OnSuccess.Broadcast(PlayerControllerWeakPtr.Get(), 0, TEXT(""));
+	});
+}
+
+void UAccelByteLogin::Fail(int32 ErrorCode, FString const& ErrorMessage)
+{
+	Finish([this, ErrorCode, &ErrorMessage]()
+	{
+		OnAborted(ErrorCode, ErrorMessage);
+	});
+}
+
+void UAccelByteLogin::OnAborted(int32 ErrorCode, FString const& ErrorMessage)
+{
+	OnFailure.Broadcast(PlayerControllerWeakPtr.Get(), ErrorCode, ErrorMessage);
+}
+
+void UAccelByteLogin::ResetState()
+{
+	PlayerControllerWeakPtr.Reset();
+	WorldContextObject = nullptr;
+	NativeUserId.Empty();
+	ControllerId = INDEX_NONE;
+}
+
+UAccelByteResumeSession::UAccelByteResumeSession(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, WorldContextObject(nullptr)
+{
+}
+
+UAccelByteResumeSession* UAccelByteResumeSession::ResumeSession
+	( UObject* WorldContextObject
+	, APlayerController* InPlayerController )
+{
+	UAccelByteResumeSession* Proxy = Acquire<UAccelByteResumeSession>();
+	Proxy->PlayerControllerWeakPtr = InPlayerController;
+	Proxy->WorldContextObject = WorldContextObject;
+	// A refresh answered after a timeout would rotate the refresh token without it being cached, as for the login
+	Proxy->TimeoutSeconds = 0.0f;
+	return Proxy;
+}
+
+void UAccelByteResumeSession::Start()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	APlayerController* MyPlayerController = PlayerControllerWeakPtr.Get();
+	StartTime = FPlatformTime::Seconds();
+
+	FAccelByteSessionCache& SessionCache = FAccelByteSessionCache::Get();
+	if (!SessionCache.Load(CachedSession))
+	{
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("session-cache-miss"));
+		return;
+	}
+
+	if (CachedSession.NativeSubsystemName != NativeSubsystemName)
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Cached session belongs to native subsystem %s, a full login is needed"), *CachedSession.NativeSubsystemName);
+		SessionCache.Clear();
+		Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("session-cache-native-mismatch"));
+		return;
+	}
+
+	// A native platform that already has a user logged in must still have the one the session was issued for
+	const ULocalPlayer* LocalPlayer = MyPlayerController != nullptr ? Cast<ULocalPlayer>(MyPlayerController->Player) : nullptr;
+	FAccelByteOnlineContext& OnlineContext = FAccelByteOnlineContext::Get();
+	const IOnlineIdentityPtr OnlineIdentity = OnlineContext.GetIdentity(FAccelByteOnlineContext::ESubsystem::Native);
+	if (LocalPlayer != nullptr && OnlineIdentity.IsValid() && OnlineIdentity->GetLoginStatus(LocalPlayer->GetControllerId()) == ELoginStatus::LoggedIn)
+	{
+		const TSharedPtr<const FUniqueNetId> NativeUniqueId = OnlineContext.GetUniquePlayerId(FAccelByteOnlineContext::ESubsystem::Native, LocalPlayer->GetControllerId());
+		if (NativeUniqueId.IsValid() && NativeUniqueId->ToString() != CachedSession.NativeUserId)
+		{
+			UE_LOG(LogAccelByteSampleApp, Display, TEXT("Native user changed since the session was cached, a full login is needed"));
+			SessionCache.Clear();
+			Fail(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("session-cache-native-mismatch"));
+			return;
+		}
+	}
+
+	FSimpleDelegate OnResumeSuccessDelegate = FSimpleDelegate::CreateWeakLambda(this, Bind(&UAccelByteResumeSession::OnResumeCompleted));
+	AccelByte::FErrorHandler OnResumeErrorDelegate = AccelByte::FErrorHandler::CreateWeakLambda(this, Bind(&UAccelByteResumeSession::OnResumeFailed));
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::LoginWithRefreshToken);
+	FRegistry::User.LoginWithRefreshToken(CachedSession.RefreshToken, FAccelByteTelemetry::WrapSuccess(Telemetry, OnResumeSuccessDelegate), FAccelByteTelemetry::WrapError(Telemetry, OnResumeErrorDelegate));
+
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Sending refresh token login request to AccelByte service!"));
+}
+
+void UAccelByteResumeSession::OnResumeCompleted()
+{
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Successfully resumed the AccelByte session!"));
+
+	// The refresh token is rotated by every refresh, the cached one is no longer valid
+	FAccelByteSessionCache& SessionCache = FAccelByteSessionCache::Get();
+	CachedSession.RefreshToken = FRegistry::Credentials.GetRefreshToken();
+	CachedSession.SavedAt = FDateTime::UtcNow();
+	SessionCache.Save(CachedSession);
+	SessionCache.RecordSessionReady(true, static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0), CachedSession.FullLoginMs);
+
+	OnAccelByteSessionStarted();
+	Succeed();
+	OnAccelByteSessionBroadcast();
+}
+
+void UAccelByteResumeSession::OnResumeFailed(int32 ErrorCode, FString const& ErrorMessage)
+{
+	// Expired or revoked, the token will not work on a retry either. A network or server failure keeps it for the next try.
+	const bool bRejected = IsRefreshTokenRejected(ErrorCode, ErrorMessage);
+	UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to resume the AccelByte session%s. code: %d - message: %s"), bRejected ? TEXT(", a full login is needed") : TEXT(""), ErrorCode, *ErrorMessage);
+	if (bRejected)
+	{
+		FAccelByteSessionCache::Get().Clear();
+	}
+	Fail(ErrorCode, ErrorMessage);
+}
+
+void UAccelByteResumeSession::Succeed()
+{
+	Finish([this]()
+	{
+		OnSuccess.Broadcast(PlayerControllerWeakPtr.Get(), 0, TEXT(""));
+	});
+}
+
+void UAccelByteResumeSession::Fail(int32 ErrorCode, FString const& ErrorMessage)
+{
+	Finish([this, ErrorCode, &ErrorMessage]()
+	{
+		OnAborted(ErrorCode, ErrorMessage);
+	});
+}
+
+void UAccelByteResumeSession::OnAborted(int32 ErrorCode, FString const& ErrorMessage)
+{
+	OnFailure.Broadcast(PlayerControllerWeakPtr.Get(), ErrorCode, ErrorMessage);
+}
+
+void UAccelByteResumeSession::ResetState()
+{
+	PlayerControllerWeakPtr.Reset();
+	WorldContextObject = nullptr;
+	CachedSession = FAccelByteSessionCache::FSession();
+	StartTime = 0.0;
+}
+
+UAccelByteGetItemsBySkus* UAccelByteGetItemsBySkus::GetItemsBySkusAsync
+	( UObject* WorldContextObject
+	, TArray<FString> const& Skus
+	, int32 MaxConcurrency )
+{
+	UAccelByteGetItemsBySkus* Proxy = Acquire<UAccelByteGetItemsBySkus>();
+	Proxy->Skus = Skus;
+	Proxy->MaxConcurrency = MaxConcurrency;
+	return Proxy;
+}
+
+void UAccelByteGetItemsBySkus::Start()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Items);
+	FAccelByteBulkItemQuery::Run(Skus, MaxConcurrency, Bind(&UAccelByteGetItemsBySkus::OnResults));
+}
+
+void UAccelByteGetItemsBySkus::OnResults(TArray<FAccelByteItemBySkuResult>&& Results)
+{
+	Finish([this, &Results]()
+	{
+		OnCompleted.Broadcast(Results);
+	});
+}
+
+void UAccelByteGetItemsBySkus::OnAborted(int32 ErrorCode, FString const& ErrorMessage)
+{
+	// The node has a single output, every SKU is reported as failed with the reason
+	TArray<FAccelByteItemBySkuResult> Results;
+	Results.Reserve(Skus.Num());
+	for (FString const& Sku : Skus)
+	{
+		FAccelByteItemBySkuResult& Result = Results.AddDefaulted_GetRef();
+		Result.Sku = Sku;
+		Result.ErrorCode = ErrorCode;
+		Result.ErrorMessage = ErrorMessage;
+	}
+	OnCompleted.Broadcast(Results);
+}
+
+void UAccelByteGetItemsBySkus::ResetState()
+{
+	Skus.Empty();
+	MaxConcurrency = 0;
 }
 
 void UAccelByteBluePrintsSample::LoadConfig()
@@ -264,40 +584,286 @@ void UAccelByteBluePrintsSample::LoadConfig()
 	{
 		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Retrieved NativePlatformService = %s in [%s] of DefaultEngine.ini"), *NativeSubsystemName, *ConfigSection);
 	}
+	FAccelByteOnlineContext::Get().Initialize(DefaultSubsystemName, NativeSubsystemName);
+	FAccelByteHttpFixture::Get().StartFromCommandLine(FCommandLine::Get());
+
+	float ItemCacheTtlSeconds = 300.0f;
+	int32 ItemCacheBudgetKB = 2048;
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("ItemCacheTtlSeconds"), ItemCacheTtlSeconds, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ItemCacheBudgetKB"), ItemCacheBudgetKB, GGameIni);
+	FAccelByteItemCache::Get().Configure(ItemCacheTtlSeconds, static_cast<int64>(ItemCacheBudgetKB) * 1024);
+
+	int32 BulkItemMaxConcurrency = 8;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("BulkItemMaxConcurrency"), BulkItemMaxConcurrency, GGameIni);
+	FAccelByteBulkItemQuery::SetDefaultMaxConcurrency(BulkItemMaxConcurrency);
+
+	int32 RestoreMaxConcurrency = 4;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("RestoreMaxConcurrency"), RestoreMaxConcurrency, GGameIni);
+	FAccelBytePurchaseRestore::SetDefaultMaxConcurrency(RestoreMaxConcurrency);
+
+	int32 JournalReplayBatchSize = 16;
+	float JournalInitialBackoffSeconds = 2.0f;
+	float JournalMaxBackoffSeconds = 300.0f;
+	int32 JournalMaxReplayAttempts = 8;
+	int32 JournalCompactThreshold = 64;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("JournalReplayBatchSize"), JournalReplayBatchSize, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("JournalInitialBackoffSeconds"), JournalInitialBackoffSeconds, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("JournalMaxBackoffSeconds"), JournalMaxBackoffSeconds, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("JournalMaxReplayAttempts"), JournalMaxReplayAttempts, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("JournalCompactThreshold"), JournalCompactThreshold, GGameIni);
+	FAccelBytePurchaseJournal::Get().Configure(JournalReplayBatchSize, JournalInitialBackoffSeconds, JournalMaxBackoffSeconds, JournalMaxReplayAttempts, JournalCompactThreshold);
+	FAccelBytePurchaseJournal::Get().LoadAsync();
+
+	float SteamTicketFallbackSeconds = 2.0f;
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("SteamTicketFallbackSeconds"), SteamTicketFallbackSeconds, GGameIni);
+	FAccelByteSteamAuthReadiness::SetFallbackSeconds(SteamTicketFallbackSeconds);
+
+	FAccelByteSessionWarmup::FSettings WarmupSettings;
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bWarmupEnabled"), WarmupSettings.bEnabled, GGameIni);
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bWarmupProfile"), WarmupSettings.bProfile, GGameIni);
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bWarmupWallet"), WarmupSettings.bWallet, GGameIni);
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bWarmupEntitlements"), WarmupSettings.bEntitlements, GGameIni);
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bWarmupCatalog"), WarmupSettings.bCatalog, GGameIni);
+	GConfig->GetString(SAMPLE_APP_CONFIG_SECTION, TEXT("WarmupWalletCurrencyCode"), WarmupSettings.WalletCurrencyCode, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("WarmupEntitlementLimit"), WarmupSettings.EntitlementLimit, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("WarmupCatalogLimit"), WarmupSettings.CatalogLimit, GGameIni);
+	GConfig->GetString(SAMPLE_APP_CONFIG_SECTION, TEXT("WarmupCatalogLanguage"), WarmupSettings.CatalogLanguage, GGameIni);
+	GConfig->GetString(SAMPLE_APP_CONFIG_SECTION, TEXT("WarmupCatalogRegion"), WarmupSettings.CatalogRegion, GGameIni);
+	FAccelByteSessionWarmup::Get().Configure(WarmupSettings);
+
+	bool bSessionCacheEnabled = true;
+	float SessionCacheMaxAgeSeconds = 86400.0f;
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bSessionCacheEnabled"), bSessionCacheEnabled, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("SessionCacheMaxAgeSeconds"), SessionCacheMaxAgeSeconds, GGameIni);
+	FAccelByteSessionCache::Get().Configure(bSessionCacheEnabled, SessionCacheMaxAgeSeconds);
+
+	bool bTelemetryEnabled = true;
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bTelemetryEnabled"), bTelemetryEnabled, GGameIni);
+	FAccelByteTelemetry::SetEnabled(bTelemetryEnabled);
+
+	FAccelByteCloudSave::FSettings CloudSaveSettings;
+	int32 CloudSaveAverageChunkKB = CloudSaveSettings.AverageChunkSize / 1024;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("CloudSaveAverageChunkKB"), CloudSaveAverageChunkKB, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("CloudSaveMaxConcurrency"), CloudSaveSettings.MaxConcurrency, GGameIni);
+	GConfig->GetBool(SAMPLE_APP_CONFIG_SECTION, TEXT("bCloudSaveLocalStore"), CloudSaveSettings.bLocalStore, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("CloudSaveListingCacheSeconds"), CloudSaveSettings.ListingCacheSeconds, GGameIni);
+	CloudSaveSettings.AverageChunkSize = CloudSaveAverageChunkKB * 1024;
+	FAccelByteCloudSave::Get().Configure(CloudSaveSettings);
+
+	FAccelByteChatHistory::FSettings ChatHistorySettings;
+	int32 ChatHistoryBudgetKB = static_cast<int32>(ChatHistorySettings.BudgetBytes / 1024);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ChatHistoryMessagesPerChannel"), ChatHistorySettings.MessagesPerChannel, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ChatHistoryBudgetKB"), ChatHistoryBudgetKB, GGameIni);
+	ChatHistorySettings.BudgetBytes = static_cast<int64>(ChatHistoryBudgetKB) * 1024;
+	FAccelByteChatHistory::Get().Configure(ChatHistorySettings);
+
+	UAccelBytePagedCatalog::FSettings CatalogSettings;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("CatalogPageSize"), CatalogSettings.PageSize, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("CatalogPrefetchSeconds"), CatalogSettings.PrefetchSeconds, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("CatalogMaxPagesInFlight"), CatalogSettings.MaxPagesInFlight, GGameIni);
+	UAccelBytePagedCatalog::SetDefaultSettings(CatalogSettings);
+
+	FAccelByteImageCache::FSettings ImageCacheSettings;
+	int32 ImageCacheMemoryBudgetMB = static_cast<int32>(ImageCacheSettings.MemoryBudgetBytes / (1024 * 1024));
+	int32 ImageCacheDiskBudgetMB = static_cast<int32>(ImageCacheSettings.DiskBudgetBytes / (1024 * 1024));
+	float ImageCacheRevalidateSeconds = static_cast<float>(ImageCacheSettings.RevalidateSeconds);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ImageCacheMemoryBudgetMB"), ImageCacheMemoryBudgetMB, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ImageCacheDiskBudgetMB"), ImageCacheDiskBudgetMB, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("ImageCacheRevalidateSeconds"), ImageCacheRevalidateSeconds, GGameIni);
+	ImageCacheSettings.MemoryBudgetBytes = static_cast<int64>(ImageCacheMemoryBudgetMB) * 1024 * 1024;
+	ImageCacheSettings.DiskBudgetBytes = static_cast<int64>(ImageCacheDiskBudgetMB) * 1024 * 1024;
+	ImageCacheSettings.RevalidateSeconds = ImageCacheRevalidateSeconds;
+	FAccelByteImageCache::Get().Configure(ImageCacheSettings);
+
+	FAccelByteEntitlementMirror::FSettings EntitlementMirrorSettings;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("EntitlementMirrorPageSize"), EntitlementMirrorSettings.PageSize, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("EntitlementMirrorFullRefreshSeconds"), EntitlementMirrorSettings.FullRefreshSeconds, GGameIni);
+	EntitlementMirrorSettings.WalletCurrencyCodes.Add(WarmupSettings.WalletCurrencyCode);
+	FAccelByteEntitlementMirror::Get().Configure(EntitlementMirrorSettings);
+
+	float AsyncActionTimeoutSeconds = 30.0f;
+	int32 AsyncActionPoolSize = 8;
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("AsyncActionTimeoutSeconds"), AsyncActionTimeoutSeconds, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("AsyncActionPoolSize"), AsyncActionPoolSize, GGameIni);
+	UAccelByteAsyncAction::SetDefaultTimeoutSeconds(AsyncActionTimeoutSeconds);
+	UAccelByteAsyncAction::SetMaxPooledPerClass(AsyncActionPoolSize);
+
+	FAccelByteStatWriteBuffer::FSettings StatWriteSettings;
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("StatWriteFlushIntervalSeconds"), StatWriteSettings.FlushIntervalSeconds, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("StatWriteFlushThreshold"), StatWriteSettings.FlushThreshold, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("StatWriteMaxStatsPerRequest"), StatWriteSettings.MaxStatsPerRequest, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("StatWriteMaxConcurrency"), StatWriteSettings.MaxConcurrency, GGameIni);
+	FAccelByteStatWriteBuffer::Get().Configure(StatWriteSettings);
+	FAccelByteStatWriteBuffer::Get().Load();
+
+	for (int32 Index = 0; Index < static_cast<int32>(EAccelByteMemoryFeature::Count); Index++)
+	{
+		const EAccelByteMemoryFeature Feature = static_cast<EAccelByteMemoryFeature>(Index);
+		int32 MemoryBudgetKB = 0;
+		GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, *FString::Printf(TEXT("MemoryBudget%sKB"), FAccelByteMemoryReport::GetFeatureName(Feature)), MemoryBudgetKB, GGameIni);
+		FAccelByteMemoryReport::SetBudget(Feature, static_cast<int64>(MemoryBudgetKB) * 1024);
+	}
+	// Used while the game runs without -llm
+	FAccelByteMemoryReport::SetSizeProvider(EAccelByteMemoryFeature::Items, []() { return FAccelByteItemCache::Get().GetStats().CachedBytes; });
+	FAccelByteMemoryReport::SetSizeProvider(EAccelByteMemoryFeature::Lobby, []() { return FAccelByteChatHistory::Get().GetStats().AllocatedBytes; });
+	FAccelByteMemoryReport::SetSizeProvider(EAccelByteMemoryFeature::Images, []() { return FAccelByteImageCache::Get().GetStats().MemoryBytes; });
+	float MemoryReportSampleSeconds = 5.0f;
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("MemoryReportSampleSeconds"), MemoryReportSampleSeconds, GGameIni);
+	FAccelByteMemoryReport::SetSampleInterval(MemoryReportSampleSeconds);
+
+	FAccelByteServerValidation::FSettings ServerValidationSettings;
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ServerValidationMaxConcurrency"), ServerValidationSettings.MaxConcurrency, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ServerValidationMaxQueued"), ServerValidationSettings.MaxQueued, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("ServerValidationRateLimitPerMinute"), ServerValidationSettings.RateLimitPerMinute, GGameIni);
+	GConfig->GetInt(SAMPLE_APP_CONFIG_SECTION, TEXT("ServerValidationRateLimitBurst"), ServerValidationSettings.RateLimitBurst, GGameIni);
+	GConfig->GetFloat(SAMPLE_APP_CONFIG_SECTION, TEXT("ServerValidationDedupeWindowSeconds"), ServerValidationSettings.DedupeWindowSeconds, GGameIni);
+	FAccelByteServerValidation::Get().Configure(ServerValidationSettings);
 }
 EAccelBytePlatformType UAccelByteBluePrintsSample::GetPlatformTypeFromSubsystem(FString const& SubsystemName)
 {
-	if (SubsystemName.Equals(TEXT("GDK"), ESearchCase::IgnoreCase) || SubsystemName.Equals(TEXT("Live"), ESearchCase::IgnoreCase))
+	return FAccelByteOnlineContext::GetPlatformTypeFromName(FName(*SubsystemName));
+}
+
+EAccelBytePlatformType UAccelByteBluePrintsSample::GetNativePlatformType()
+{
+	return FAccelByteOnlineContext::Get().GetPlatformType(FAccelByteOnlineContext::ESubsystem::Native);
+}
+
+FAccelByteSteamTicketStats UAccelByteBluePrintsSample::GetSteamTicketStats()
+{
+	return FAccelByteSteamAuthReadiness::GetStats();
+}
+
+FAccelByteStartupTiming UAccelByteBluePrintsSample::GetStartupTiming()
+{
+	return FAccelByteSessionCache::Get().GetStartupTiming();
+}
+
+void UAccelByteBluePrintsSample::ClearSessionCache()
+{
+	FAccelByteSessionCache::Get().Clear();
+}
+
+FString UAccelByteBluePrintsSample::DumpTelemetryCsv(FString const& Path)
+{
+	return FAccelByteTelemetry::DumpCsv(Path);
+}
+
+bool UAccelByteBluePrintsSample::GetSessionSnapshot(FAccelByteSessionSnapshot& OutSnapshot)
+{
+	OutSnapshot = FAccelByteSessionWarmup::Get().GetSnapshot();
+	return FAccelByteSessionWarmup::Get().IsReady();
+}
+
+void UAccelByteBluePrintsSample::WaitForSessionWarmup(FDAccelByteSessionSnapshot const& OnReady)
+{
+	FAccelByteSessionWarmup::Get().WhenReady([OnReady](FAccelByteSessionSnapshot const& Snapshot)
 	{
-		return EAccelBytePlatformType::Live;
-	}
-	else if (SubsystemName.Equals(TEXT("PS4"), ESearchCase::IgnoreCase))
+		OnReady.ExecuteIfBound(Snapshot);
+	});
+}
+
+void UAccelByteBluePrintsSample::UploadCloudSave(FString const& SlotName, TArray<uint8> const& Payload, FDAccelByteCloudSaveResult const& OnComplete)
+{
+	FAccelByteCloudSave::Get().UploadBytes(SlotName, Payload, [OnComplete](FAccelByteCloudSaveResult const& Result)
 	{
-		return EAccelBytePlatformType::PS4CrossGen;
-	}
-	else if (SubsystemName.Equals(TEXT("PS5"), ESearchCase::IgnoreCase))
+		OnComplete.ExecuteIfBound(Result);
+	});
+}
+
+void UAccelByteBluePrintsSample::DownloadCloudSave(FString const& SlotName, FString const& FilePath, FDAccelByteCloudSaveResult const& OnComplete)
+{
+	FAccelByteCloudSave::Get().DownloadFile(SlotName, FilePath, [OnComplete](FAccelByteCloudSaveResult const& Result)
 	{
-		return EAccelBytePlatformType::PS5;
-	}
-	else if (SubsystemName.Equals(TEXT("STEAM"), ESearchCase::IgnoreCase))
+		OnComplete.ExecuteIfBound(Result);
+	});
+}
+
+void UAccelByteBluePrintsSample::SyncLobbyState()
+{
+	FAccelByteLobbyState::Get().SyncLobby();
+}
+
+void UAccelByteBluePrintsSample::BindLobbyChanges(FDAccelByteLobbyChanges const& OnChanged)
+{
+	UObject* Listener = OnChanged.GetUObject();
+	if (Listener == nullptr)
 	{
-		return EAccelBytePlatformType::Steam;
+		return;
 	}
-	else if (SubsystemName.Equals(TEXT("GOOGLEPLAY"), ESearchCase::IgnoreCase) || SubsystemName.Equals(TEXT("GOOGLE"), ESearchCase::IgnoreCase))
+
+	FAccelByteLobbyState::Get().OnChanged().AddWeakLambda(Listener, [OnChanged](TArray<FAccelByteLobbyRowChange> const& Changes)
 	{
-		return EAccelBytePlatformType::Google;
+		OnChanged.ExecuteIfBound(Changes);
+	});
+}
+
+void UAccelByteBluePrintsSample::UnbindLobbyChanges(UObject* Listener)
+{
+	FAccelByteLobbyState::Get().OnChanged().RemoveAll(Listener);
+}
+
+TArray<FAccelByteLobbyUser> UAccelByteBluePrintsSample::GetLobbyUsers()
+{
+	return FAccelByteLobbyState::Get().GetUsers();
+}
+
+bool UAccelByteBluePrintsSample::FindLobbyUser(FString const& UserId, FAccelByteLobbyUser& OutUser)
+{
+	FAccelByteLobbyUser const* User = FAccelByteLobbyState::Get().FindUser(UserId);
+	if (User == nullptr)
+	{
+		return false;
 	}
-	else if (SubsystemName.Equals(TEXT("IOS"), ESearchCase::IgnoreCase) || SubsystemName.Equals(TEXT("APPLE"), ESearchCase::IgnoreCase))
+	OutUser = *User;
+	return true;
+}
+
+void UAccelByteBluePrintsSample::MarkLobbyMessagesRead(FString const& UserId)
+{
+	FAccelByteLobbyState::Get().ClearUnreadMessages(UserId);
+}
+
+TArray<FAccelByteChatMessage> UAccelByteBluePrintsSample::GetChatHistory(FString const& Channel, int32 FromNewest, int32 Count)
+{
+	TArray<FAccelByteChatHistory::FMessageView> Views;
+	FAccelByteChatHistory::Get().Read(Channel, FromNewest, Count, Views);
+
+	TArray<FAccelByteChatMessage> Messages;
+	Messages.Reserve(Views.Num());
+	for (FAccelByteChatHistory::FMessageView const& View : Views)
 	{
-		return EAccelBytePlatformType::Apple;
+		FAccelByteChatMessage& Message = Messages.AddDefaulted_GetRef();
+		Message.From = FString(View.From);
+		Message.Text = FString(View.Text);
+		Message.ReceivedAt = View.ReceivedAt;
 	}
-	
-	return EAccelBytePlatformType::Device;
+	return Messages;
 }
 
-EAccelBytePlatformType UAccelByteBluePrintsSample::GetNativePlatformType()
+void UAccelByteBluePrintsSample::AddChatHistoryMessage(FString const& Channel, FString const& From, FString const& Text)
+{
+	FAccelByteChatHistory::Get().Add(Channel, From, Text);
+}
+
+FAccelByteChatHistoryStats UAccelByteBluePrintsSample::GetChatHistoryStats()
+{
+	return FAccelByteChatHistory::Get().GetStats();
+}
+
+FString UAccelByteBluePrintsSample::GetPartyChatChannel()
+{
+	return FAccelByteChatHistory::GetPartyChannel();
+}
+
+FString UAccelByteBluePrintsSample::GetPrivateChatChannel(FString const& UserId)
 {
-	return GetPlatformTypeFromSubsystem(NativeSubsystemName);
+	return FAccelByteChatHistory::GetPrivateChannel(UserId);
+}
+
+FString UAccelByteBluePrintsSample::GetLobbyChatChannel(FString const& ChannelSlug)
+{
+	return FAccelByteChatHistory::GetLobbyChannel(ChannelSlug);
 }
 
 void UAccelByteBluePrintsSample::GetItemBySku
@@ -307,7 +873,6 @@ void UAccelByteBluePrintsSample::GetItemBySku
 {
 	const THandler<FAccelByteModelsItemInfo> OnGetItemBySkuSuccessDelegate = THandler<FAccelByteModelsItemInfo>::CreateLambda([OnSuccess](const FAccelByteModelsItemInfo& Respose)
 	{
-		UE_LOG(LogAccelByteSampleApp, Display, TEXT("AccelByte get item by SKU succeed!"));
 		OnSuccess.ExecuteIfBound(Respose);
 	});
 
@@ -315,11 +880,167 @@ void UAccelByteBluePrintsSample::GetItemBySku
 		( int32 ErrorCode
 		, FString const& ErrorMessage )
 		{
-			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("AccelByte Get Item by SKU failed! code: %d - message: %s"), ErrorCode, *ErrorMessage);
 			OnError.ExecuteIfBound(ErrorCode, ErrorMessage);
 		});
-	
-	FRegistry::Item.GetItemBySku(Sku, "", "", OnGetItemBySkuSuccessDelegate, OnSynErrorDelegate);
+
+	FAccelByteItemCache::Get().GetItemBySku(Sku, OnGetItemBySkuSuccessDelegate, OnSynErrorDelegate);
+}
+
+FAccelByteItemCacheStats UAccelByteBluePrintsSample::GetItemCacheStats()
+{
+	return FAccelByteItemCache::Get().GetStats();
+}
+
+void UAccelByteBluePrintsSample::GetItemsBySkus
+	( TArray<FString> const& Skus
+	, int32 MaxConcurrency
+	, FDAccelByteItemBySkuResults const& OnComplete )
+{
+	FAccelByteBulkItemQuery::Run(Skus, MaxConcurrency, [OnComplete](TArray<FAccelByteItemBySkuResult>&& Results)
+	{
+		OnComplete.ExecuteIfBound(Results);
+	});
+}
+
+void UAccelByteBluePrintsSample::ResetItemCache()
+{
+	FAccelByteItemCache::Get().Reset();
+}
+
+void UAccelByteBluePrintsSample::LoadImageFromUrl(FString const& Url, FDAccelByteImageLoaded const& OnLoaded)
+{
+	FAccelByteImageCache::Get().Load(Url, [OnLoaded](UTexture2D* Texture, FString const& ErrorMessage)
+	{
+		OnLoaded.ExecuteIfBound(Texture, ErrorMessage);
+	});
+}
+
+void UAccelByteBluePrintsSample::LoadItemImage(FAccelByteModelsItemInfo const& Item, bool bSmall, FDAccelByteImageLoaded const& OnLoaded)
+{
+	FString Url;
+	if (Item.Images.Num() > 0)
+	{
+		Url = bSmall ? Item.Images[0].SmallImageUrl : Item.Images[0].ImageUrl;
+	}
+	if (Url.IsEmpty())
+	{
+		Url = Item.ThumbnailUrl;
+	}
+	LoadImageFromUrl(Url, OnLoaded);
+}
+
+FAccelByteImageCacheStats UAccelByteBluePrintsSample::GetImageCacheStats()
+{
+	return FAccelByteImageCache::Get().GetStats();
+}
+
+void UAccelByteBluePrintsSample::ClearImageCache(bool bDisk)
+{
+	FAccelByteImageCache::Get().ClearMemory();
+	if (bDisk)
+	{
+		FAccelByteImageCache::Get().ClearDisk();
+	}
+}
+
+void UAccelByteBluePrintsSample::BindEntitlementChanges(FDAccelByteEntitlementDelta const& OnChanged)
+{
+	UObject* Listener = OnChanged.GetUObject();
+	if (Listener == nullptr)
+	{
+		return;
+	}
+
+	FAccelByteEntitlementMirror::Get().OnChanged().AddWeakLambda(Listener, [OnChanged](FAccelByteEntitlementDelta const& Delta)
+	{
+		OnChanged.ExecuteIfBound(Delta);
+	});
+}
+
+void UAccelByteBluePrintsSample::UnbindEntitlementChanges(UObject* Listener)
+{
+	FAccelByteEntitlementMirror::Get().OnChanged().RemoveAll(Listener);
+}
+
+void UAccelByteBluePrintsSample::RefreshEntitlements(bool bFull, FDHandler const& OnSuccess, FDErrorHandler const& OnError)
+{
+	FAccelByteEntitlementMirror::Get().Refresh(bFull, [OnSuccess, OnError](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		if (ErrorCode != 0)
+		{
+			OnError.ExecuteIfBound(ErrorCode, ErrorMessage);
+		}
+		else
+		{
+			OnSuccess.ExecuteIfBound();
+		}
+	});
+}
+
+TArray<FAccelByteModelsEntitlementInfo> UAccelByteBluePrintsSample::GetMirroredEntitlements()
+{
+	return FAccelByteEntitlementMirror::Get().GetEntitlements();
+}
+
+bool UAccelByteBluePrintsSample::FindMirroredWallet(FString const& CurrencyCode, FAccelByteModelsWalletInfo& OutWallet)
+{
+	FAccelByteModelsWalletInfo const* Wallet = FAccelByteEntitlementMirror::Get().FindWallet(CurrencyCode);
+	if (Wallet == nullptr)
+	{
+		return false;
+	}
+	OutWallet = *Wallet;
+	return true;
+}
+
+bool UAccelByteBluePrintsSample::IsItemOwned(FString const& ItemId)
+{
+	return FAccelByteEntitlementMirror::Get().IsItemOwned(ItemId);
+}
+
+bool UAccelByteBluePrintsSample::IsSkuOwned(FString const& Sku)
+{
+	return FAccelByteEntitlementMirror::Get().IsSkuOwned(Sku);
+}
+
+FAccelByteEntitlementMirrorStats UAccelByteBluePrintsSample::GetEntitlementMirrorStats()
+{
+	return FAccelByteEntitlementMirror::Get().GetStats();
+}
+
+FAccelByteAsyncActionStats UAccelByteBluePrintsSample::GetAsyncActionStats()
+{
+	return UAccelByteAsyncAction::GetStats();
+}
+
+void UAccelByteBluePrintsSample::IncrementUserStat(FString const& StatCode, float Delta)
+{
+	FAccelByteStatWriteBuffer::Get().IncrementStat(StatCode, Delta);
+}
+
+void UAccelByteBluePrintsSample::SetUserStat(FString const& StatCode, float Value)
+{
+	FAccelByteStatWriteBuffer::Get().SetStat(StatCode, Value);
+}
+
+void UAccelByteBluePrintsSample::SetGameProfileAttribute(FString const& ProfileId, FString const& Key, FString const& Value)
+{
+	FAccelByteStatWriteBuffer::Get().SetProfileAttribute(ProfileId, Key, Value);
+}
+
+void UAccelByteBluePrintsSample::FlushStatWrites()
+{
+	FAccelByteStatWriteBuffer::Get().Flush();
+}
+
+FAccelByteStatWriteStats UAccelByteBluePrintsSample::GetStatWriteStats()
+{
+	return FAccelByteStatWriteBuffer::Get().GetStats();
+}
+
+FAccelByteServerValidationStats UAccelByteBluePrintsSample::GetServerValidationStats()
+{
+	return FAccelByteServerValidation::Get().GetStats();
 }
 
 void UAccelByteBluePrintsSample::FinalizePurchase
@@ -335,44 +1056,91 @@ void UAccelByteBluePrintsSample::FinalizePurchase
 		return;
 	}
 
-	const IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(FName(DefaultSubsystemName));
+	const ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(InPlayerController->Player);
+	if (LocalPlayer == nullptr)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Need local player to finalize purchase"));
+		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
+		return;
+	}
+
+	FString ErrorMessage;
+	if (!FinalizePurchaseForLocalUser(LocalPlayer->GetControllerId(), ReceiptId, ErrorMessage))
+	{
+		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), ErrorMessage);
+		return;
+	}
+
+	OnSuccess.ExecuteIfBound();
+}
+
+bool UAccelByteBluePrintsSample::FinalizePurchaseForLocalUser
+	( int32 LocalUserNum
+	, FString const& ReceiptId
+	, FString& OutErrorMessage )
+{
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::FinalizePurchase);
+
+	FAccelByteOnlineContext& OnlineContext = FAccelByteOnlineContext::Get();
+	const IOnlineSubsystem* OnlineSubsystem = OnlineContext.GetSubsystem(FAccelByteOnlineContext::ESubsystem::Default);
 	if (OnlineSubsystem == nullptr)
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot finalize purchase with no online subsystem set!"));
-		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-subsystem-null"));
-		return;
+		OutErrorMessage = TEXT("login-failed-native-subsystem-null");
+		FAccelByteTelemetry::End(Telemetry, static_cast<int32>(AccelByte::ErrorCodes::UnknownError));
+		return false;
 	}
 
-	const IOnlineIdentityPtr OnlineIdentity = OnlineSubsystem->GetIdentityInterface();
+	const IOnlineIdentityPtr OnlineIdentity = OnlineContext.GetIdentity(FAccelByteOnlineContext::ESubsystem::Default);
 	if (!OnlineIdentity.IsValid())
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Could not retrieve identity interface from the subsystem."));
-		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-identity-null"));
-		return;
+		OutErrorMessage = TEXT("login-failed-native-identity-null");
+		FAccelByteTelemetry::End(Telemetry, static_cast<int32>(AccelByte::ErrorCodes::UnknownError));
+		return false;
 	}
 	
-	const IOnlinePurchasePtr OnlinePurchase = OnlineSubsystem->GetPurchaseInterface();
+	const IOnlinePurchasePtr OnlinePurchase = OnlineContext.GetPurchase(FAccelByteOnlineContext::ESubsystem::Default);
 	if (!OnlinePurchase.IsValid())
 	{
 		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Could not retrieve purchase interface from the subsystem."));
-		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("login-failed-native-purchase-null"));
-		return;
+		OutErrorMessage = TEXT("login-failed-native-purchase-null");
+		FAccelByteTelemetry::End(Telemetry, static_cast<int32>(AccelByte::ErrorCodes::UnknownError));
+		return false;
 	}
 
-	const ULocalPlayer* LocalPlayer = Cast<ULocalPlayer>(InPlayerController->Player);
-	if (LocalPlayer == nullptr)
+	const auto UserIdPtr = OnlineContext.GetUniquePlayerId(FAccelByteOnlineContext::ESubsystem::Default, LocalUserNum);
+	if (!UserIdPtr.IsValid())
 	{
-		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Need local player to finalize purchase"));
-		OnError.ExecuteIfBound(static_cast<int32>(AccelByte::ErrorCodes::UnknownError), TEXT("local-player-not-found"));
-		return;
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Need a logged in native user to finalize purchase"));
+		OutErrorMessage = TEXT("native-user-not-found");
+		FAccelByteTelemetry::End(Telemetry, static_cast<int32>(AccelByte::ErrorCodes::UnknownError));
+		return false;
 	}
 
-	const auto UserIdPtr = OnlineIdentity->GetUniquePlayerId(LocalPlayer->GetControllerId());
 	OnlinePurchase->FinalizePurchase(*UserIdPtr.Get(), ReceiptId);
-
-	OnSuccess.ExecuteIfBound();
+	FAccelByteTelemetry::End(Telemetry);
 	
 	UE_LOG(LogAccelByteSampleApp, Display, TEXT("IAP Purchase finalized!"));
+	return true;
+}
+
+void UAccelByteBluePrintsSample::RestorePurchases
+	( APlayerController* InPlayerController
+	, TArray<FString> const& GoogleReceipts
+	, TArray<FAccelByteModelsPlatformSyncMobileApple> const& AppleRequests
+	, int32 MaxConcurrency
+	, FDAccelByteRestoreReceiptResults const& OnComplete )
+{
+	const ULocalPlayer* LocalPlayer = InPlayerController != nullptr ? Cast<ULocalPlayer>(InPlayerController->Player) : nullptr;
+	const int32 LocalUserNum = LocalPlayer != nullptr ? LocalPlayer->GetControllerId() : 0;
+
+	FAccelBytePurchaseRestore::Run(GoogleReceipts, AppleRequests, LocalUserNum, MaxConcurrency, [OnComplete](TArray<FAccelByteRestoreReceiptResult>&& Results)
+	{
+		// A single refresh for the whole batch, restores only add entitlements so a delta is enough
+		FAccelByteEntitlementMirror::Get().Refresh(false);
+		OnComplete.ExecuteIfBound(Results);
+	});
 }
 
 void UAccelByteBluePrintsSample::SyncPurchaseGooglePlay
@@ -381,13 +1149,21 @@ void UAccelByteBluePrintsSample::SyncPurchaseGooglePlay
 	, FDHandler const& OnSuccess
 	, FDErrorHandler const& OnError)
 {
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	const ULocalPlayer* LocalPlayer = InPlayerController != nullptr ? Cast<ULocalPlayer>(InPlayerController->Player) : nullptr;
+	const FString JournalId = FAccelBytePurchaseJournal::Get().RecordGoogle(SyncRequest, LocalPlayer != nullptr ? LocalPlayer->GetControllerId() : 0);
+
 	const THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse> OnSyncSuccessDelegate = THandler<FAccelByteModelsPlatformSyncMobileGoogleResponse>::CreateLambda(
-		[&OnSuccess, &OnError, InPlayerController, ReceiptId = SyncRequest.OrderId](FAccelByteModelsPlatformSyncMobileGoogleResponse const& Response)
+		[OnSuccess, OnError, PlayerController = TWeakObjectPtr<APlayerController>(InPlayerController), ReceiptId = SyncRequest.OrderId, JournalId](FAccelByteModelsPlatformSyncMobileGoogleResponse const& Response)
 		{
 			UE_LOG(LogAccelByteSampleApp, Display, TEXT("AccelByte sync purchase Google succeeded!"));
+			FAccelBytePurchaseJournal::Get().Acknowledge(JournalId);
+			// The granted entitlement reaches the widgets as a delta, they do not need to reload the lists. A delta only
+			// finds new grants, anything else changed since is picked up by the periodic full refresh
+			FAccelByteEntitlementMirror::Get().Refresh(false);
 			if (Response.NeedConsume)
 			{
-				FinalizePurchase(InPlayerController, ReceiptId, OnSuccess, OnError);
+				FinalizePurchase(PlayerController.Get(), ReceiptId, OnSuccess, OnError);
 			}
 			else
 			{
@@ -395,7 +1171,7 @@ void UAccelByteBluePrintsSample::SyncPurchaseGooglePlay
 			}
 		});
 
-	AccelByte::FErrorHandler OnSynErrorDelegate = AccelByte::FErrorHandler::CreateLambda([&OnError]
+	AccelByte::FErrorHandler OnSynErrorDelegate = AccelByte::FErrorHandler::CreateLambda([OnError]
 		( int32 ErrorCode
 		, FString const& ErrorMessage )
 		{
@@ -403,7 +1179,8 @@ void UAccelByteBluePrintsSample::SyncPurchaseGooglePlay
 			OnError.ExecuteIfBound(ErrorCode, ErrorMessage);
 		});
 	
-	FRegistry::Entitlement.SyncMobilePlatformPurchaseGooglePlay(SyncRequest, OnSyncSuccessDelegate, OnSynErrorDelegate);
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseGoogle);
+	FRegistry::Entitlement.SyncMobilePlatformPurchaseGooglePlay(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSyncSuccessDelegate), FAccelByteTelemetry::WrapError(Telemetry, OnSynErrorDelegate));
 }
 
 void UAccelByteBluePrintsSample::SyncPurchaseApple
@@ -412,13 +1189,20 @@ void UAccelByteBluePrintsSample::SyncPurchaseApple
 	, FDHandler const& OnSuccess
 	, FDErrorHandler const& OnError )
 {
-	FSimpleDelegate OnSyncPurchaseSuccessDelegate = FSimpleDelegate::CreateLambda([&OnSuccess]()
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	const ULocalPlayer* LocalPlayer = InPlayerController != nullptr ? Cast<ULocalPlayer>(InPlayerController->Player) : nullptr;
+	const FString JournalId = FAccelBytePurchaseJournal::Get().RecordApple(SyncRequest, LocalPlayer != nullptr ? LocalPlayer->GetControllerId() : 0);
+
+	FSimpleDelegate OnSyncPurchaseSuccessDelegate = FSimpleDelegate::CreateLambda([OnSuccess, JournalId]()
 		{
 			UE_LOG(LogAccelByteSampleApp, Display, TEXT("AccelByte sync purchase Apple succeeded!"));
+			FAccelBytePurchaseJournal::Get().Acknowledge(JournalId);
+			// Nothing is consumed here, the new grant is all a delta has to find
+			FAccelByteEntitlementMirror::Get().Refresh(false);
 			OnSuccess.ExecuteIfBound();
 		});
 
-	AccelByte::FErrorHandler OnSyncPurchaseErrorDelegate = AccelByte::FErrorHandler::CreateLambda([&OnError]
+	AccelByte::FErrorHandler OnSyncPurchaseErrorDelegate = AccelByte::FErrorHandler::CreateLambda([OnError]
 		( int32 ErrorCode
 		, FString const& ErrorMessage)
 		{
@@ -427,59 +1211,53 @@ void UAccelByteBluePrintsSample::SyncPurchaseApple
 		});
 
 	UE_LOG(LogAccelByteSampleApp, Warning, TEXT("AccelByte sync request ProductId: %s - TransactionId: %s - ReceiptData: %s"), *SyncRequest.ProductId, *SyncRequest.TransactionId, *SyncRequest.ReceiptData);
-	FRegistry::Entitlement.SyncMobilePlatformPurchaseApple(SyncRequest, OnSyncPurchaseSuccessDelegate, OnSyncPurchaseErrorDelegate);
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::SyncPurchaseApple);
+	FRegistry::Entitlement.SyncMobilePlatformPurchaseApple(SyncRequest, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSyncPurchaseSuccessDelegate), FAccelByteTelemetry::WrapError(Telemetry, OnSyncPurchaseErrorDelegate));
 }
 
 FAccelByteModelsPlatformSyncMobileGoogle UAccelByteBluePrintsSample::ParseReceiptString(const FString& ReceiptData)
 {
 	FAccelByteModelsPlatformSyncMobileGoogle ReceiptStruct;
+	EAccelByteReceiptParseError Error;
+	FString ErrorMessage;
+	TryParseReceiptString(ReceiptData, ReceiptStruct, Error, ErrorMessage);
 
-	//deserialize to pick receiptData encoded string
-	FString OutReceiptEncStr;
-	TSharedPtr<FJsonObject> JsonParsed;
-	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ReceiptData);
-	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
-	{
-		OutReceiptEncStr = JsonParsed->GetStringField("receiptData");
-	}
+	return ReceiptStruct;
+}
 
-	//decode to json string
-	FString ReceiptDecodedStr;
-	FBase64::Decode(OutReceiptEncStr, ReceiptDecodedStr);
+bool UAccelByteBluePrintsSample::TryParseReceiptString
+	( FString const& ReceiptData
+	, FAccelByteModelsPlatformSyncMobileGoogle& OutSyncRequest
+	, EAccelByteReceiptParseError& OutError
+	, FString& OutErrorMessage )
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	// Keeps its decode buffers between calls, Blueprints parsing a list of receipts do not allocate per receipt
+	static thread_local FAccelByteReceiptParser Parser;
+	OutSyncRequest = FAccelByteModelsPlatformSyncMobileGoogle();
+	const bool bParsed = Parser.Parse(ReceiptData, OutSyncRequest);
+	OutError = Parser.GetError();
+	OutErrorMessage = Parser.GetErrorMessage();
 
-	//deserialize to pick receiptData json string and assign data to FAccelByteModelsPlatformSyncMobileGoogle
-	JsonParsed = nullptr;
-	JsonReader = TJsonReaderFactory<TCHAR>::Create(ReceiptDecodedStr);
-	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
+	if (!bParsed)
 	{
-		ReceiptStruct.OrderId = JsonParsed->GetStringField("orderId");
-		ReceiptStruct.PackageName = JsonParsed->GetStringField("packageName");
-		ReceiptStruct.ProductId = JsonParsed->GetStringField("productId");
-		ReceiptStruct.PurchaseTime = FCString::Atoi64(*JsonParsed->GetStringField("purchaseTime"));
-		ReceiptStruct.PurchaseToken = JsonParsed->GetStringField("purchaseToken");
-		ReceiptStruct.AutoAck = false;
-		ReceiptStruct.Language = "en";
-		ReceiptStruct.Region = "US";
-		
-		return ReceiptStruct;
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to parse receipt! message: %s"), *OutErrorMessage);
+		OutSyncRequest = FAccelByteModelsPlatformSyncMobileGoogle();
 	}
-	
-	return ReceiptStruct;		
+	return bParsed;
 }
 
 FString UAccelByteBluePrintsSample::ParseReceiptToStringDisplay(const FString& ReceiptData)
 {
-	FString OutReceiptEncStr;
-	TSharedPtr<FJsonObject> JsonParsed;
-	TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(ReceiptData);
-	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed))
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	static thread_local FAccelByteReceiptParser Parser;
+	if (!Parser.DecodeReceiptData(ReceiptData))
 	{
-		OutReceiptEncStr = JsonParsed->GetStringField("receiptData");
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to decode receipt! message: %s"), *Parser.GetErrorMessage());
+		return FString();
 	}
 
-	//decode to json string
-	FString ReceiptDecodedStr;
-	FBase64::Decode(OutReceiptEncStr, ReceiptDecodedStr);
-
-	return ReceiptDecodedStr;
+	TArray<uint8> const& Decoded = Parser.GetDecodedReceiptData();
+	const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Decoded.GetData()), Decoded.Num());
+	return FString(Converter.Length(), Converter.Get());
 }
\ No newline at end of file
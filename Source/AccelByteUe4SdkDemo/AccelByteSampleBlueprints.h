@@ -6,17 +6,39 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
-#include "Kismet/BlueprintAsyncActionBase.h"
+#include "AccelByteAsyncAction.h"
 #include "Core/AccelByteError.h"
 #include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteItemCache.h"
+#include "AccelByteBulkItemQuery.h"
+#include "AccelByteReceiptParser.h"
+#include "AccelBytePurchaseRestore.h"
+#include "AccelByteSteamAuthReadiness.h"
+#include "AccelByteSessionWarmup.h"
+#include "AccelByteSessionCache.h"
+#include "AccelByteCloudSave.h"
+#include "AccelByteLobbyState.h"
+#include "AccelByteChatHistory.h"
+#include "AccelByteImageCache.h"
+#include "AccelByteEntitlementMirror.h"
+#include "AccelByteStatWriteBuffer.h"
+#include "AccelByteServerValidation.h"
 #include "AccelByteSampleBlueprints.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FAccelByteLoginResult, APlayerController*, PlayerController, int32, ErrorCode, FString const&, ErrorMessage);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteModelsPlatformSyncMobileGoogleResponse, FAccelByteModelsPlatformSyncMobileGoogleResponse, Response);
 DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteModelsItemInfo, FAccelByteModelsItemInfo, Response);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteItemBySkuResults, TArray<FAccelByteItemBySkuResult> const&, Results);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAccelByteItemBySkuResults, TArray<FAccelByteItemBySkuResult> const&, Results);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteRestoreReceiptResults, TArray<FAccelByteRestoreReceiptResult> const&, Results);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteSessionSnapshot, FAccelByteSessionSnapshot const&, Snapshot);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteCloudSaveResult, FAccelByteCloudSaveResult const&, Result);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteLobbyChanges, TArray<FAccelByteLobbyRowChange> const&, Changes);
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FDAccelByteImageLoaded, UTexture2D*, Texture, FString const&, ErrorMessage);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDAccelByteEntitlementDelta, FAccelByteEntitlementDelta const&, Delta);
 
 UCLASS(MinimalAPI)
-class UAccelByteLoginNativePlatform : public UBlueprintAsyncActionBase
+class UAccelByteLoginNativePlatform : public UAccelByteAsyncAction
 {
 	GENERATED_BODY()
 public:
@@ -34,11 +56,17 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "AccelByte | SampleApp")
 	static UAccelByteLoginNativePlatform* LoginWithNativePlatform(UObject* WorldContextObject, APlayerController* InPlayerController);
 
-	// UBlueprintAsyncActionBase interface
-	virtual void Activate() override;
-	// End of UBlueprintAsyncActionBase interface
+protected:
+	// UAccelByteAsyncAction interface
+	virtual void Start() override;
+	virtual void OnAborted(int32 ErrorCode, FString const& ErrorMessage) override;
+	virtual void ResetState() override;
+	// End of UAccelByteAsyncAction interface
 
 private:
+	void Succeed();
+	void Fail(int32 ErrorCode, FString const& ErrorMessage);
+
 	// Internal callback when the login UI closes, calls out to the public success/failure callbacks
 	void OnLoginNativePlatformCompleted(int32 NativeLocalUserNum, bool bWasNativeLoginSuccessful, FUniqueNetId const& NativeUserId, FString const& NativeError);
 
@@ -47,10 +75,13 @@ private:
 
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
+
+	// Local user the login complete delegate was added for
+	int32 LoginLocalUserNum = INDEX_NONE;
 };
 
 UCLASS(MinimalAPI)
-class UAccelByteLogin : public UBlueprintAsyncActionBase
+class UAccelByteLogin : public UAccelByteAsyncAction
 {
 	GENERATED_BODY()
 public:
@@ -68,21 +99,110 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "AccelByte | SampleApp")
 	static UAccelByteLogin* LoginWithAccelByte(UObject* WorldContextObject, APlayerController* InPlayerController);
 
-	// UBlueprintAsyncActionBase interface
-	virtual void Activate() override;
-	// End of UBlueprintAsyncActionBase interface
+protected:
+	// UAccelByteAsyncAction interface
+	virtual void Start() override;
+	virtual void OnAborted(int32 ErrorCode, FString const& ErrorMessage) override;
+	virtual void ResetState() override;
+	// End of UAccelByteAsyncAction interface
 
 private:
+	void Succeed();
+	void Fail(int32 ErrorCode, FString const& ErrorMessage);
+
 	// Internal callback when the login UI closes, calls out to the public success/failure callbacks
 	void OnLoginAccelByteCompleted();
 
 	void OnLoginAccelByteFailed(int32 ErrorCode, FString const& ErrorMessage);
 
+	// Steam rejects a ticket until it has registered it, the login waits for the ticket it sends
+	void OnSteamTicketReady(bool bTicketReady, FString const& Ticket);
+
+	void LoginWithPlatformToken(FString const& PlatformToken);
+
 	// The player controller triggering things
 	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
 
 	// The world context object in which this call is taking place
 	UObject* WorldContextObject;
+
+	// Native identity the platform token was issued for, saved with the session
+	FString NativeUserId;
+
+	// Local player the platform token is requested for
+	int32 ControllerId = INDEX_NONE;
+};
+
+UCLASS(MinimalAPI)
+class UAccelByteResumeSession : public UAccelByteAsyncAction
+{
+	GENERATED_BODY()
+public:
+	UAccelByteResumeSession(const FObjectInitializer& ObjectInitializer);
+
+	// Called when the cached session has been refreshed and the user is logged in
+	UPROPERTY(BlueprintAssignable)
+	FAccelByteLoginResult OnSuccess;
+	
+	// Called when there is no usable cached session, continue with the native platform login
+	UPROPERTY(BlueprintAssignable)
+	FAccelByteLoginResult OnFailure;
+
+	// Restore the session saved by the last login with a single refresh token request
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "AccelByte | SampleApp")
+	static UAccelByteResumeSession* ResumeSession(UObject* WorldContextObject, APlayerController* InPlayerController);
+
+protected:
+	// UAccelByteAsyncAction interface
+	virtual void Start() override;
+	virtual void OnAborted(int32 ErrorCode, FString const& ErrorMessage) override;
+	virtual void ResetState() override;
+	// End of UAccelByteAsyncAction interface
+
+private:
+	void Succeed();
+	void Fail(int32 ErrorCode, FString const& ErrorMessage);
+
+	void OnResumeCompleted();
+
+	void OnResumeFailed(int32 ErrorCode, FString const& ErrorMessage);
+
+	// The player controller triggering things
+	TWeakObjectPtr<APlayerController> PlayerControllerWeakPtr;
+
+	// The world context object in which this call is taking place
+	UObject* WorldContextObject;
+
+	FAccelByteSessionCache::FSession CachedSession;
+	double StartTime = 0.0;
+};
+
+UCLASS(MinimalAPI)
+class UAccelByteGetItemsBySkus : public UAccelByteAsyncAction
+{
+	GENERATED_BODY()
+public:
+	// Called once every SKU has resolved or failed, results are in the order of the requested SKUs
+	UPROPERTY(BlueprintAssignable)
+	FAccelByteItemBySkuResults OnCompleted;
+
+	// Resolve many SKUs with a bounded number of item requests in flight, zero MaxConcurrency uses the configured default
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext="WorldContextObject"), Category = "AccelByte | SampleApp | IAP")
+	static UAccelByteGetItemsBySkus* GetItemsBySkusAsync(UObject* WorldContextObject, TArray<FString> const& Skus, int32 MaxConcurrency = 0);
+
+protected:
+	// UAccelByteAsyncAction interface
+	virtual void Start() override;
+	virtual void OnAborted(int32 ErrorCode, FString const& ErrorMessage) override;
+	virtual void ResetState() override;
+	// End of UAccelByteAsyncAction interface
+
+private:
+	void OnResults(TArray<FAccelByteItemBySkuResult>&& Results);
+
+	TArray<FString> Skus;
+
+	int32 MaxConcurrency = 0;
 };
 
 UCLASS(Blueprintable, BlueprintType)
@@ -98,13 +218,174 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
 	static EAccelBytePlatformType GetNativePlatformType();
+
+	// How long native Steam logins waited for an auth ticket the backend accepts
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static FAccelByteSteamTicketStats GetSteamTicketStats();
+
+	// Whether the current session was resumed from the session cache and how long its login took
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static FAccelByteStartupTiming GetStartupTiming();
+
+	// Forget the cached session so the next launch runs the full login, call it on logout
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static void ClearSessionCache();
+
+	// Write the latency percentiles and error counts of the AccelByte calls to a CSV file, returns the file path
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static FString DumpTelemetryCsv(FString const& Path);
+
+	// Data prefetched right after login, returns false while the warm-up has not finished
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Session")
+	static bool GetSessionSnapshot(FAccelByteSessionSnapshot& OutSnapshot);
+
+	// Calls OnReady with the snapshot once the post login warm-up has finished
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Session")
+	static void WaitForSessionWarmup(FDAccelByteSessionSnapshot const& OnReady);
 	
+	// Upload a slot payload, only the chunks the cloud does not hold yet are sent
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | CloudSave")
+	static void UploadCloudSave(FString const& SlotName, TArray<uint8> const& Payload, FDAccelByteCloudSaveResult const& OnComplete);
+
+	// Download a slot payload into FilePath, an interrupted download continues from what it already wrote
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | CloudSave")
+	static void DownloadCloudSave(FString const& SlotName, FString const& FilePath, FDAccelByteCloudSaveResult const& OnComplete);
+
+	// Route the lobby friend, party, presence and chat notifications to the lobby state and fetch the lists, call it once the lobby is connected
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static void SyncLobbyState();
+
+	// Called at most once per frame with the rows that changed, the binding goes away with the object it is bound to
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static void BindLobbyChanges(FDAccelByteLobbyChanges const& OnChanged);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static void UnbindLobbyChanges(UObject* Listener);
+
+	// Every row to build the lists from once, later updates come through BindLobbyChanges
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static TArray<FAccelByteLobbyUser> GetLobbyUsers();
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static bool FindLobbyUser(FString const& UserId, FAccelByteLobbyUser& OutUser);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static void MarkLobbyMessagesRead(FString const& UserId);
+
+	// Up to Count messages of a chat channel, newest first, skipping the FromNewest most recent ones
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static TArray<FAccelByteChatMessage> GetChatHistory(FString const& Channel, int32 FromNewest, int32 Count);
+
+	// Received messages are added by the lobby state, this is for the messages the local user sends
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static void AddChatHistoryMessage(FString const& Channel, FString const& From, FString const& Text);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static FAccelByteChatHistoryStats GetChatHistoryStats();
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static FString GetPartyChatChannel();
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static FString GetPrivateChatChannel(FString const& UserId);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Lobby")
+	static FString GetLobbyChatChannel(FString const& ChannelSlug);
+
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
 	static void GetItemBySku(FString const& Sku, FDAccelByteModelsItemInfo const& OnSuccess, FDErrorHandler const& OnError);
 
+	// Hit, miss and coalesce counters of the item cache behind GetItemBySku
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
+	static FAccelByteItemCacheStats GetItemCacheStats();
+
+	// Resolve many SKUs with a bounded number of item requests in flight, zero MaxConcurrency uses the configured default
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
+	static void GetItemsBySkus(TArray<FString> const& Skus, int32 MaxConcurrency, FDAccelByteItemBySkuResults const& OnComplete);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
+	static void ResetItemCache();
+
+	// Texture of an image URL through the memory and disk image cache, Texture is null on failure
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Images")
+	static void LoadImageFromUrl(FString const& Url, FDAccelByteImageLoaded const& OnLoaded);
+
+	// The first image of a store item, its small version when bSmall is set, the thumbnail when the item has no image
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Images")
+	static void LoadItemImage(FAccelByteModelsItemInfo const& Item, bool bSmall, FDAccelByteImageLoaded const& OnLoaded);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Images")
+	static FAccelByteImageCacheStats GetImageCacheStats();
+
+	// Drops the cached textures, and the cached files when bDisk is set
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Images")
+	static void ClearImageCache(bool bDisk);
+
+	// Called with what changed whenever the entitlement mirror is updated, the binding goes away with the object it is bound to
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static void BindEntitlementChanges(FDAccelByteEntitlementDelta const& OnChanged);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static void UnbindEntitlementChanges(UObject* Listener);
+
+	// Purchase syncs refresh the mirror by themselves, a full refresh also drops the entitlements that are gone
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static void RefreshEntitlements(bool bFull, FDHandler const& OnSuccess, FDErrorHandler const& OnError);
+
+	// Every mirrored entitlement to build the lists from once, later updates come through BindEntitlementChanges
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static TArray<FAccelByteModelsEntitlementInfo> GetMirroredEntitlements();
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static bool FindMirroredWallet(FString const& CurrencyCode, FAccelByteModelsWalletInfo& OutWallet);
+
+	// True when the user has an active entitlement of the item
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static bool IsItemOwned(FString const& ItemId);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static bool IsSkuOwned(FString const& Sku);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Entitlements")
+	static FAccelByteEntitlementMirrorStats GetEntitlementMirrorStats();
+
+	// Allocations, reuse, cancels and timeouts of the pooled async nodes
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Utilities")
+	static FAccelByteAsyncActionStats GetAsyncActionStats();
+
+	// Buffered, increments of the same stat code are summed and sent with the next flush
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Statistics")
+	static void IncrementUserStat(FString const& StatCode, float Delta);
+
+	// Buffered, replaces the increments pending for the stat code
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Statistics")
+	static void SetUserStat(FString const& StatCode, float Value);
+
+	// Buffered, only the last value of the attribute is sent
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Statistics")
+	static void SetGameProfileAttribute(FString const& ProfileId, FString const& Key, FString const& Value);
+
+	// Sends the buffered writes now, call it at the end of a match
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Statistics")
+	static void FlushStatWrites();
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Statistics")
+	static FAccelByteStatWriteStats GetStatWriteStats();
+
+	// Receipts and grants the dedicated server validated for its players
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Server")
+	static FAccelByteServerValidationStats GetServerValidationStats();
+
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
 	static void FinalizePurchase(APlayerController* InPlayerController, FString const& ReceiptId, FDHandler const& OnSuccess, FDErrorHandler const& OnError);
 
+	// Finalizes a native store purchase for a local user, returns false with the reason if it could not be done
+	static bool FinalizePurchaseForLocalUser(int32 LocalUserNum, FString const& ReceiptId, FString& OutErrorMessage);
+
+	// Sync a batch of restored purchases, receipts are parsed in parallel and deduped, zero MaxConcurrency uses the configured default
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
+	static void RestorePurchases(APlayerController* InPlayerController, TArray<FString> const& GoogleReceipts, TArray<FAccelByteModelsPlatformSyncMobileApple> const& AppleRequests, int32 MaxConcurrency, FDAccelByteRestoreReceiptResults const& OnComplete);
+
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
 	static void SyncPurchaseGooglePlay(APlayerController* InPlayerController, FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest, FDHandler const& OnSuccess, FDErrorHandler const& OnError);
 	
@@ -114,6 +395,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
 	static FAccelByteModelsPlatformSyncMobileGoogle ParseReceiptString(FString const& ReceiptData);
 
+	// Same as ParseReceiptString but reports why a malformed receipt could not be parsed
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
+	static bool TryParseReceiptString(FString const& ReceiptData, FAccelByteModelsPlatformSyncMobileGoogle& OutSyncRequest, EAccelByteReceiptParseError& OutError, FString& OutErrorMessage);
+
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | IAP")
 	static FString ParseReceiptToStringDisplay(FString const& ReceiptData);
 };
\ No newline at end of file
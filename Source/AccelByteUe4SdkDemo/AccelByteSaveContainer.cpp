@@ -0,0 +1,233 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteSaveContainer.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Misc/Compression.h"
+#include "Misc/Crc.h"
+#include "Serialization/LargeMemoryReader.h"
+
+#define SAVE_CONTAINER_MAGIC 0x56534241 // "ABSV"
+#define SAVE_CONTAINER_VERSION 1
+// Magic, format version, section count, table size and table CRC
+#define SAVE_CONTAINER_HEADER_SIZE 16
+
+namespace AccelByteSaveContainer
+{
+	static FName GetFormatName(EAccelByteSaveCompression Compression)
+	{
+		switch (Compression)
+		{
+		case EAccelByteSaveCompression::LZ4: return NAME_LZ4;
+		case EAccelByteSaveCompression::Zlib: return NAME_Zlib;
+		case EAccelByteSaveCompression::Oodle: return FName(TEXT("Oodle"));
+		default: return NAME_None;
+		}
+	}
+}
+
+using namespace AccelByteSaveContainer;
+
+FAccelByteSaveWriter::FAccelByteSaveWriter(EAccelByteSaveCompression InCompression)
+	: Compression(ResolveCompression(InCompression))
+{
+}
+
+EAccelByteSaveCompression FAccelByteSaveWriter::ResolveCompression(EAccelByteSaveCompression InCompression)
+{
+	if (InCompression == EAccelByteSaveCompression::Default)
+	{
+		InCompression = FCompression::IsFormatValid(GetFormatName(EAccelByteSaveCompression::Oodle)) ? EAccelByteSaveCompression::Oodle : EAccelByteSaveCompression::LZ4;
+	}
+	if (InCompression != EAccelByteSaveCompression::None && !FCompression::IsFormatValid(GetFormatName(InCompression)))
+	{
+		return EAccelByteSaveCompression::Zlib;
+	}
+	return InCompression;
+}
+
+FArchive& FAccelByteSaveWriter::BeginSection(FName Tag, int32 SchemaVersion)
+{
+	TUniquePtr<FSection>& Section = Sections.Add_GetRef(MakeUnique<FSection>());
+	Section->Tag = Tag;
+	Section->SchemaVersion = SchemaVersion;
+	return Section->Writer;
+}
+
+void FAccelByteSaveWriter::AddSection(FName Tag, int32 SchemaVersion, TArrayView<uint8 const> Data)
+{
+	BeginSection(Tag, SchemaVersion).Serialize(const_cast<uint8*>(Data.GetData()), Data.Num());
+}
+
+void FAccelByteSaveWriter::Finish(TArray<uint8>& Out)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+	const FName FormatName = GetFormatName(Compression);
+
+	// Sections are compressed straight into the payload buffer, a section that does not shrink overwrites its attempt with the raw bytes
+	TArray<uint8> Payloads;
+	TArray<uint8> Table;
+	FMemoryWriter TableWriter(Table);
+	for (TUniquePtr<FSection> const& Section : Sections)
+	{
+		const int32 RawSize = Section->Data.Num();
+		uint32 RawCrc = FCrc::MemCrc32(Section->Data.GetData(), RawSize);
+		uint8 StoredCompression = static_cast<uint8>(EAccelByteSaveCompression::None);
+		int32 StoredSize = RawSize;
+
+		const int32 PayloadOffset = Payloads.Num();
+		if (Compression != EAccelByteSaveCompression::None && RawSize > 0)
+		{
+			int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, RawSize);
+			Payloads.AddUninitialized(CompressedSize);
+			if (FCompression::CompressMemory(FormatName, Payloads.GetData() + PayloadOffset, CompressedSize, Section->Data.GetData(), RawSize)
+				&& CompressedSize < RawSize)
+			{
+				StoredCompression = static_cast<uint8>(Compression);
+				StoredSize = CompressedSize;
+			}
+			Payloads.SetNum(PayloadOffset + (StoredCompression == static_cast<uint8>(EAccelByteSaveCompression::None) ? 0 : StoredSize), false);
+		}
+		if (StoredCompression == static_cast<uint8>(EAccelByteSaveCompression::None))
+		{
+			Payloads.Append(Section->Data);
+		}
+
+		FName Tag = Section->Tag;
+		int32 SchemaVersion = Section->SchemaVersion;
+		TableWriter << Tag << SchemaVersion << StoredCompression << RawSize << StoredSize << RawCrc;
+	}
+
+	uint32 Magic = SAVE_CONTAINER_MAGIC;
+	uint16 Version = SAVE_CONTAINER_VERSION;
+	uint16 NumSections = static_cast<uint16>(Sections.Num());
+	int32 TableSize = Table.Num();
+	uint32 TableCrc = FCrc::MemCrc32(Table.GetData(), Table.Num());
+
+	Out.Reset(SAVE_CONTAINER_HEADER_SIZE + Table.Num() + Payloads.Num());
+	FMemoryWriter Writer(Out);
+	Writer << Magic << Version << NumSections << TableSize << TableCrc;
+	Writer.Serialize(Table.GetData(), Table.Num());
+	Writer.Serialize(Payloads.GetData(), Payloads.Num());
+
+	Sections.Reset();
+}
+
+bool FAccelByteSaveReader::Open(TArrayView<uint8 const> InData)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::CloudSave);
+	Data = InData;
+	Sections.Reset();
+	ErrorMessage.Reset();
+
+	if (Data.Num() < SAVE_CONTAINER_HEADER_SIZE)
+	{
+		ErrorMessage = TEXT("Too short for a save container");
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint16 NumSections = 0;
+	int32 TableSize = 0;
+	uint32 TableCrc = 0;
+	FLargeMemoryReader HeaderReader(Data.GetData(), SAVE_CONTAINER_HEADER_SIZE);
+	HeaderReader << Magic << Version << NumSections << TableSize << TableCrc;
+	if (Magic != SAVE_CONTAINER_MAGIC)
+	{
+		ErrorMessage = TEXT("Not a save container");
+		return false;
+	}
+	if (Version != SAVE_CONTAINER_VERSION)
+	{
+		ErrorMessage = FString::Printf(TEXT("Unsupported save container version %u"), Version);
+		return false;
+	}
+	if (TableSize < 0 || TableSize > Data.Num() - SAVE_CONTAINER_HEADER_SIZE
+		|| FCrc::MemCrc32(Data.GetData() + SAVE_CONTAINER_HEADER_SIZE, TableSize) != TableCrc)
+	{
+		ErrorMessage = TEXT("The section table is corrupted");
+		return false;
+	}
+
+	FLargeMemoryReader TableReader(Data.GetData() + SAVE_CONTAINER_HEADER_SIZE, TableSize);
+	int64 Offset = SAVE_CONTAINER_HEADER_SIZE + TableSize;
+	for (int32 Index = 0; Index < NumSections; Index++)
+	{
+		FSectionInfo& Section = Sections.AddDefaulted_GetRef();
+		uint8 StoredCompression = 0;
+		TableReader << Section.Tag << Section.SchemaVersion << StoredCompression << Section.RawSize << Section.StoredSize << Section.RawCrc;
+		Section.Compression = static_cast<EAccelByteSaveCompression>(StoredCompression);
+		Section.Offset = Offset;
+		Offset += Section.StoredSize;
+		if (TableReader.IsError() || Section.RawSize < 0 || Section.StoredSize < 0 || Offset > Data.Num())
+		{
+			ErrorMessage = TEXT("The section table does not match the data");
+			Sections.Reset();
+			return false;
+		}
+	}
+	return true;
+}
+
+FAccelByteSaveReader::FSectionInfo const* FAccelByteSaveReader::FindSection(FName Tag) const
+{
+	return Sections.FindByPredicate([Tag](FSectionInfo const& Section) { return Section.Tag == Tag; });
+}
+
+bool FAccelByteSaveReader::HasSection(FName Tag) const
+{
+	return FindSection(Tag) != nullptr;
+}
+
+int32 FAccelByteSaveReader::GetSchemaVersion(FName Tag) const
+{
+	FSectionInfo const* Section = FindSection(Tag);
+	return Section != nullptr ? Section->SchemaVersion : INDEX_NONE;
+}
+
+TArray<FName> FAccelByteSaveReader::GetTags() const
+{
+	TArray<FName> Tags;
+	for (FSectionInfo const& Section : Sections)
+	{
+		Tags.Add(Section.Tag);
+	}
+	return Tags;
+}
+
+bool FAccelByteSaveReader::ReadSection(FName Tag, TArray<uint8>& OutData) const
+{
+	FSectionInfo const* Section = FindSection(Tag);
+	if (Section == nullptr)
+	{
+		ErrorMessage = FString::Printf(TEXT("No section %s"), *Tag.ToString());
+		return false;
+	}
+
+	uint8 const* Stored = Data.GetData() + Section->Offset;
+	OutData.SetNumUninitialized(Section->RawSize, false);
+	if (Section->Compression == EAccelByteSaveCompression::None)
+	{
+		if (Section->StoredSize != Section->RawSize)
+		{
+			ErrorMessage = FString::Printf(TEXT("Section %s has an inconsistent size"), *Tag.ToString());
+			return false;
+		}
+		FMemory::Memcpy(OutData.GetData(), Stored, Section->RawSize);
+	}
+	else if (!FCompression::UncompressMemory(GetFormatName(Section->Compression), OutData.GetData(), Section->RawSize, Stored, Section->StoredSize))
+	{
+		ErrorMessage = FString::Printf(TEXT("Section %s failed to decompress"), *Tag.ToString());
+		return false;
+	}
+
+	if (FCrc::MemCrc32(OutData.GetData(), OutData.Num()) != Section->RawCrc)
+	{
+		ErrorMessage = FString::Printf(TEXT("Section %s fails its checksum"), *Tag.ToString());
+		return false;
+	}
+	return true;
+}
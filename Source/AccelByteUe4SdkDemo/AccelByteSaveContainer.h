@@ -0,0 +1,139 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "AccelByteSaveContainer.generated.h"
+
+UENUM(BlueprintType)
+enum class EAccelByteSaveCompression : uint8
+{
+	None,
+	LZ4,
+	Zlib,
+	Oodle,
+	// Oodle when the engine has it, LZ4 otherwise
+	Default
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteSaveSection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "AccelByte | SampleApp | CloudSave")
+	FName Tag;
+
+	// Version of the layout of Data, readers use it to migrate old sections
+	UPROPERTY(BlueprintReadWrite, Category = "AccelByte | SampleApp | CloudSave")
+	int32 SchemaVersion = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category = "AccelByte | SampleApp | CloudSave")
+	TArray<uint8> Data;
+};
+
+/**
+ * Writes a versioned save container: a section table followed by the section payloads.
+ *
+ * Each section has a tag, a schema version and its own compression, a section that does not shrink is stored
+ * as is. The table carries a CRC32 of itself and of every uncompressed section. Sections are written through an
+ * FArchive, so structs and arrays serialize straight into the section buffer without going through a string.
+ *
+ *   uint32 Magic, uint16 FormatVersion, uint16 NumSections, int32 TableSize, uint32 TableCrc
+ *   table: per section FName Tag, int32 SchemaVersion, uint8 Compression, int32 RawSize, int32 StoredSize, uint32 RawCrc
+ *   payloads in table order
+ */
+class FAccelByteSaveWriter
+{
+public:
+	explicit FAccelByteSaveWriter(EAccelByteSaveCompression InCompression = EAccelByteSaveCompression::Default);
+
+	// The archive stays valid until the next section is started or the container is finished
+	FArchive& BeginSection(FName Tag, int32 SchemaVersion);
+
+	void AddSection(FName Tag, int32 SchemaVersion, TArrayView<uint8 const> Data);
+
+	// Tagged property serialization, fields added or removed later still load
+	template <typename TStruct>
+	void AddStruct(FName Tag, int32 SchemaVersion, TStruct& Value)
+	{
+		TStruct::StaticStruct()->SerializeItem(BeginSection(Tag, SchemaVersion), &Value, nullptr);
+	}
+
+	// Replaces the content of Out and keeps its allocation
+	void Finish(TArray<uint8>& Out);
+
+	static EAccelByteSaveCompression ResolveCompression(EAccelByteSaveCompression Compression);
+
+private:
+	struct FSection
+	{
+		FName Tag;
+		int32 SchemaVersion = 0;
+		TArray<uint8> Data;
+		FMemoryWriter Writer;
+
+		FSection()
+			: Writer(Data)
+		{
+		}
+	};
+
+	EAccelByteSaveCompression Compression;
+	TArray<TUniquePtr<FSection>> Sections;
+};
+
+/** Reads a container written by FAccelByteSaveWriter, the data passed to Open must outlive the reader. */
+class FAccelByteSaveReader
+{
+public:
+	// Checks the header and the section table, sections are only decompressed and checked when read
+	bool Open(TArrayView<uint8 const> InData);
+
+	bool HasSection(FName Tag) const;
+
+	// INDEX_NONE when there is no such section
+	int32 GetSchemaVersion(FName Tag) const;
+
+	TArray<FName> GetTags() const;
+
+	// Replaces the content of OutData and keeps its allocation, false when missing or corrupted
+	bool ReadSection(FName Tag, TArray<uint8>& OutData) const;
+
+	template <typename TStruct>
+	bool ReadStruct(FName Tag, TStruct& OutValue) const
+	{
+		TArray<uint8> Data;
+		if (!ReadSection(Tag, Data))
+		{
+			return false;
+		}
+		FMemoryReader Reader(Data);
+		TStruct::StaticStruct()->SerializeItem(Reader, &OutValue, nullptr);
+		return !Reader.IsError();
+	}
+
+	FString const& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+	struct FSectionInfo
+	{
+		FName Tag;
+		int32 SchemaVersion = 0;
+		EAccelByteSaveCompression Compression = EAccelByteSaveCompression::None;
+		int32 RawSize = 0;
+		int32 StoredSize = 0;
+		uint32 RawCrc = 0;
+		int64 Offset = 0;
+	};
+
+	FSectionInfo const* FindSection(FName Tag) const;
+
+	TArrayView<uint8 const> Data;
+	TArray<FSectionInfo> Sections;
+	mutable FString ErrorMessage;
+};
@@ -0,0 +1,520 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteServerValidation.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "JsonObjectConverter.h"
+#include "Misc/Guid.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Core/AccelByteServerCredentials.h"
+#include "GameServerApi/AccelByteServerOauth2Api.h"
+#include "GameServerApi/AccelByteServerEcommerceApi.h"
+
+namespace AccelByteServerValidation
+{
+	// IAM answers a client token that expired or was revoked with this code
+	constexpr int32 UnauthorizedAccessCode = 20001;
+
+	// How often the expired results of the dedupe window and the full buckets of idle users are dropped
+	constexpr float PruneIntervalSeconds = 10.0f;
+
+	static void ParseError(FHttpResponsePtr const& Response, int32& OutErrorCode, FString& OutErrorMessage)
+	{
+		OutErrorCode = Response.IsValid() ? Response->GetResponseCode() : static_cast<int32>(AccelByte::ErrorCodes::UnknownError);
+		OutErrorMessage = Response.IsValid() ? Response->GetContentAsString() : TEXT("server-validation-no-response");
+		if (!Response.IsValid())
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> Json;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(OutErrorMessage);
+		if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid())
+		{
+			double Code = 0.0;
+			if (Json->TryGetNumberField(TEXT("errorCode"), Code))
+			{
+				OutErrorCode = static_cast<int32>(Code);
+			}
+			Json->TryGetStringField(TEXT("errorMessage"), OutErrorMessage);
+		}
+	}
+}
+
+using namespace AccelByteServerValidation;
+
+FAccelByteServerValidation& FAccelByteServerValidation::Get()
+{
+	static FAccelByteServerValidation Instance;
+	return Instance;
+}
+
+FAccelByteServerValidation::FAccelByteServerValidation()
+	: Pipeline(FAccelByteTaskPipeline::Create(FSettings().MaxConcurrency))
+	, AliveToken(MakeShared<bool, ESPMode::ThreadSafe>(true))
+{
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAccelByteServerValidation::Tick), PruneIntervalSeconds);
+}
+
+FAccelByteServerValidation::~FAccelByteServerValidation()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+void FAccelByteServerValidation::Configure(FSettings const& InSettings)
+{
+	const int32 PreviousConcurrency = Settings.MaxConcurrency;
+	Settings = InSettings;
+	Settings.MaxConcurrency = FMath::Max(1, Settings.MaxConcurrency);
+	Settings.MaxQueued = FMath::Max(0, Settings.MaxQueued);
+	Settings.RateLimitPerMinute = FMath::Max(0.0f, Settings.RateLimitPerMinute);
+	Settings.RateLimitBurst = FMath::Max(1, Settings.RateLimitBurst);
+	Settings.DedupeWindowSeconds = FMath::Max(0.0f, Settings.DedupeWindowSeconds);
+
+	// The pipeline in use keeps itself alive until its tasks are done
+	if (Settings.MaxConcurrency != PreviousConcurrency)
+	{
+		Pipeline = FAccelByteTaskPipeline::Create(Settings.MaxConcurrency);
+	}
+}
+
+void FAccelByteServerValidation::Submit(FRequest const& Request, FOnComplete&& OnComplete)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	Stats.Submitted++;
+	const double Now = FPlatformTime::Seconds();
+
+	FString Key = GetDedupeKey(Request);
+	if (!Key.IsEmpty())
+	{
+		if (FPending* InFlight = Pending.Find(Key))
+		{
+			Stats.Deduplicated++;
+			InFlight->Callbacks.Add(MoveTemp(OnComplete));
+			InFlight->SubmitTimes.Add(Now);
+			return;
+		}
+
+		if (FRecent const* Done = Recent.Find(Key))
+		{
+			if (Now - Done->CompletedTime <= Settings.DedupeWindowSeconds)
+			{
+				Stats.Deduplicated++;
+				FResult Result = Done->Result;
+				Result.bDeduplicated = true;
+				OnComplete(Result);
+				return;
+			}
+			Recent.Remove(Key);
+		}
+	}
+	else
+	{
+		Key = FString::Printf(TEXT("once:%s"), *FGuid::NewGuid().ToString());
+	}
+
+	// Grants are decided by the server, only what the players send is limited
+	if (Request.Kind != EKind::GrantEntitlements && !TakeToken(Request.UserId, Now))
+	{
+		Stats.RateLimited++;
+		UE_LOG(LogAccelByteSampleApp, Verbose, TEXT("Server validation rate limited user %s"), *Request.UserId);
+		FResult Result;
+		Result.ErrorCode = EHttpResponseCodes::TooManyRequests;
+		Result.ErrorMessage = TEXT("server-validation-rate-limited");
+		OnComplete(Result);
+		return;
+	}
+
+	if (Pipeline->NumQueued() >= Settings.MaxQueued)
+	{
+		Stats.Rejected++;
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server validation queue is full, refusing a request of user %s"), *Request.UserId);
+		FResult Result;
+		Result.ErrorCode = EHttpResponseCodes::ServiceUnavail;
+		Result.ErrorMessage = TEXT("server-validation-queue-full");
+		OnComplete(Result);
+		return;
+	}
+
+	FPending& Entry = Pending.Add(Key);
+	Entry.Callbacks.Add(MoveTemp(OnComplete));
+	Entry.SubmitTimes.Add(Now);
+	Dispatch(Key, Request);
+}
+
+void FAccelByteServerValidation::VerifyUser(FString const& AccessToken, FOnUserVerified&& OnVerified)
+{
+	if (AccessToken.IsEmpty())
+	{
+		FResult Result;
+		Result.ErrorCode = EHttpResponseCodes::Denied;
+		Result.ErrorMessage = TEXT("server-validation-no-access-token");
+		OnVerified(Result, TEXT(""));
+		return;
+	}
+
+	// IAM only answers with the user the token was issued to, a token of another user or a forged one gets a 401
+	auto HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetURL(FString::Printf(TEXT("%s/v3/public/users/me"), *FRegistry::ServerSettings.IamServerUrl));
+	HttpRequest->SetVerb(TEXT("GET"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *AccessToken));
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::ServerVerifyUser);
+	HttpRequest->OnProcessRequestComplete().BindLambda([OnVerified = MoveTemp(OnVerified), Telemetry](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+	{
+		const int32 ResponseCode = bSucceeded && Response.IsValid() ? Response->GetResponseCode() : 0;
+		FResult Result;
+		FString UserId;
+		if (EHttpResponseCodes::IsOk(ResponseCode))
+		{
+			TSharedPtr<FJsonObject> Json;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+			if (FJsonSerializer::Deserialize(Reader, Json) && Json.IsValid() && Json->TryGetStringField(TEXT("userId"), UserId) && !UserId.IsEmpty())
+			{
+				FAccelByteTelemetry::End(Telemetry);
+				Result.bSuccess = true;
+				OnVerified(Result, UserId);
+				return;
+			}
+			Result.ErrorCode = static_cast<int32>(AccelByte::ErrorCodes::UnknownError);
+			Result.ErrorMessage = TEXT("server-validation-unexpected-user-response");
+		}
+		else
+		{
+			ParseError(bSucceeded ? Response : FHttpResponsePtr(), Result.ErrorCode, Result.ErrorMessage);
+		}
+
+		FAccelByteTelemetry::End(Telemetry, Result.ErrorCode);
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server could not verify a player's access token! code: %d - message: %s"), Result.ErrorCode, *Result.ErrorMessage);
+		OnVerified(Result, TEXT(""));
+	});
+	HttpRequest->ProcessRequest();
+}
+
+void FAccelByteServerValidation::SetRequestHandler(FRequestHandler&& InRequestHandler)
+{
+	RequestHandler = MoveTemp(InRequestHandler);
+}
+
+FAccelByteServerValidationStats FAccelByteServerValidation::GetStats() const
+{
+	FAccelByteServerValidationStats Result = Stats;
+	Result.Queued = Pipeline->NumQueued();
+	Result.InFlight = Pipeline->NumInFlight();
+	Result.AverageLatencyMs = NumCompleted > 0 ? static_cast<float>(TotalLatencyMs / NumCompleted) : 0.0f;
+	return Result;
+}
+
+FString FAccelByteServerValidation::GetDedupeKey(FRequest const& Request)
+{
+	switch (Request.Kind)
+	{
+	case EKind::GooglePurchase:
+		return Request.GoogleReceipt.OrderId.IsEmpty() ? TEXT("") : FString::Printf(TEXT("google:%s:%s"), *Request.UserId, *Request.GoogleReceipt.OrderId);
+	case EKind::ApplePurchase:
+		return Request.AppleReceipt.TransactionId.IsEmpty() ? TEXT("") : FString::Printf(TEXT("apple:%s:%s"), *Request.UserId, *Request.AppleReceipt.TransactionId);
+	case EKind::GrantEntitlements:
+		return Request.IdempotencyKey.IsEmpty() ? TEXT("") : FString::Printf(TEXT("grant:%s:%s"), *Request.UserId, *Request.IdempotencyKey);
+	default:
+		return TEXT("");
+	}
+}
+
+bool FAccelByteServerValidation::TakeToken(FString const& UserId, double Now)
+{
+	if (Settings.RateLimitPerMinute <= 0.0f)
+	{
+		return true;
+	}
+
+	FBucket* Bucket = Buckets.Find(UserId);
+	if (Bucket == nullptr)
+	{
+		Bucket = &Buckets.Add(UserId);
+		Bucket->Tokens = static_cast<float>(Settings.RateLimitBurst);
+		Bucket->LastRefillTime = Now;
+	}
+
+	const float Refill = static_cast<float>((Now - Bucket->LastRefillTime) * Settings.RateLimitPerMinute / 60.0);
+	Bucket->Tokens = FMath::Min(static_cast<float>(Settings.RateLimitBurst), Bucket->Tokens + Refill);
+	Bucket->LastRefillTime = Now;
+
+	if (Bucket->Tokens < 1.0f)
+	{
+		return false;
+	}
+	Bucket->Tokens -= 1.0f;
+	return true;
+}
+
+void FAccelByteServerValidation::Dispatch(FString const& Key, FRequest const& Request)
+{
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	Pipeline->Enqueue([this, WeakAlive, Key, Request](FSimpleDelegate const& OnDone)
+	{
+		if (!WeakAlive.IsValid())
+		{
+			OnDone.ExecuteIfBound();
+			return;
+		}
+
+		Send(Request, [this, WeakAlive, Key, OnDone](FResult const& Result)
+		{
+			if (WeakAlive.IsValid())
+			{
+				Complete(Key, Result);
+			}
+			OnDone.ExecuteIfBound();
+		}, false);
+	});
+}
+
+void FAccelByteServerValidation::Send(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried)
+{
+	if (RequestHandler)
+	{
+		RequestHandler(Request, OnResult);
+		return;
+	}
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	EnsureLoggedIn([this, WeakAlive, Request, OnResult, bLoginRetried](FResult const& Login)
+	{
+		if (!WeakAlive.IsValid() || !Login.bSuccess)
+		{
+			OnResult(Login);
+			return;
+		}
+
+		if (Request.Kind == EKind::GrantEntitlements)
+		{
+			SendGrant(Request, OnResult, bLoginRetried);
+		}
+		else
+		{
+			SendReceipt(Request, OnResult, bLoginRetried);
+		}
+	});
+}
+
+void FAccelByteServerValidation::SendReceipt(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Receipts);
+	const bool bGoogle = Request.Kind == EKind::GooglePurchase;
+	FString Content;
+	if (bGoogle)
+	{
+		FJsonObjectConverter::UStructToJsonObjectString(Request.GoogleReceipt, Content);
+	}
+	else
+	{
+		FJsonObjectConverter::UStructToJsonObjectString(Request.AppleReceipt, Content);
+	}
+
+	// The same endpoint a client syncs its purchases with, the client token needs the user's IAP update permission
+	auto HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetURL(FString::Printf(TEXT("%s/public/namespaces/%s/users/%s/iap/%s/receipt"),
+		*FRegistry::ServerSettings.PlatformServerUrl, *FRegistry::ServerSettings.Namespace, *Request.UserId, bGoogle ? TEXT("google") : TEXT("apple")));
+	HttpRequest->SetVerb(TEXT("PUT"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *FRegistry::ServerCredentials.GetClientAccessToken()));
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Accept"), TEXT("application/json"));
+	HttpRequest->SetContentAsString(Content);
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(bGoogle ? EAccelByteTelemetryOp::ServerSyncPurchaseGoogle : EAccelByteTelemetryOp::ServerSyncPurchaseApple);
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	HttpRequest->OnProcessRequestComplete().BindLambda([this, WeakAlive, Request, OnResult, bLoginRetried, Telemetry](FHttpRequestPtr, FHttpResponsePtr Response, bool bSucceeded)
+	{
+		const int32 ResponseCode = bSucceeded && Response.IsValid() ? Response->GetResponseCode() : 0;
+		FResult Result;
+		if (EHttpResponseCodes::IsOk(ResponseCode))
+		{
+			FAccelByteTelemetry::End(Telemetry);
+			Result.bSuccess = true;
+			OnResult(Result);
+			return;
+		}
+
+		ParseError(bSucceeded ? Response : FHttpResponsePtr(), Result.ErrorCode, Result.ErrorMessage);
+		FAccelByteTelemetry::End(Telemetry, Result.ErrorCode);
+		if (WeakAlive.IsValid() && !bLoginRetried && (IsUnauthorized(ResponseCode) || IsUnauthorized(Result.ErrorCode)))
+		{
+			bLoggedIn = false;
+			Send(Request, OnResult, true);
+			return;
+		}
+
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server receipt validation for user %s failed! code: %d - message: %s"), *Request.UserId, Result.ErrorCode, *Result.ErrorMessage);
+		OnResult(Result);
+	});
+	HttpRequest->ProcessRequest();
+}
+
+void FAccelByteServerValidation::SendGrant(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Entitlements);
+	const AccelByte::THandler<TArray<FAccelByteModelsStackableEntitlementInfo>> OnSuccess = AccelByte::THandler<TArray<FAccelByteModelsStackableEntitlementInfo>>::CreateLambda(
+		[OnResult](TArray<FAccelByteModelsStackableEntitlementInfo> const&)
+		{
+			FResult Result;
+			Result.bSuccess = true;
+			OnResult(Result);
+		});
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([this, WeakAlive, Request, OnResult, bLoginRetried](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		if (WeakAlive.IsValid() && !bLoginRetried && IsUnauthorized(ErrorCode))
+		{
+			bLoggedIn = false;
+			Send(Request, OnResult, true);
+			return;
+		}
+
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server entitlement grant for user %s failed! code: %d - message: %s"), *Request.UserId, ErrorCode, *ErrorMessage);
+		FResult Result;
+		Result.ErrorCode = ErrorCode;
+		Result.ErrorMessage = ErrorMessage;
+		OnResult(Result);
+	});
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::ServerGrantEntitlements);
+	FRegistry::ServerEcommerce.GrantUserEntitlements(Request.UserId, Request.Grants, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+}
+
+void FAccelByteServerValidation::EnsureLoggedIn(FOnLoggedIn&& OnLoggedIn)
+{
+	if (bLoggedIn)
+	{
+		FResult Result;
+		Result.bSuccess = true;
+		OnLoggedIn(Result);
+		return;
+	}
+
+	// Requests arriving during a login wait for it rather than starting their own
+	LoginWaiters.Add(MoveTemp(OnLoggedIn));
+	if (bLoggingIn)
+	{
+		return;
+	}
+	bLoggingIn = true;
+	Stats.Logins++;
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	const FSimpleDelegate OnSuccess = FSimpleDelegate::CreateLambda([this, WeakAlive]()
+	{
+		if (WeakAlive.IsValid())
+		{
+			FResult Result;
+			Result.bSuccess = true;
+			FinishLogin(Result);
+		}
+	});
+	const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([this, WeakAlive](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		if (WeakAlive.IsValid())
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server client credentials login failed! code: %d - message: %s"), ErrorCode, *ErrorMessage);
+			FResult Result;
+			Result.ErrorCode = ErrorCode;
+			Result.ErrorMessage = ErrorMessage;
+			FinishLogin(Result);
+		}
+	});
+
+	const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::ServerLoginWithClientCredentials);
+	FRegistry::ServerOauth2.LoginWithClientCredentials(FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+}
+
+void FAccelByteServerValidation::FinishLogin(FResult const& Result)
+{
+	bLoggingIn = false;
+	bLoggedIn = Result.bSuccess;
+
+	TArray<FOnLoggedIn> Waiters = MoveTemp(LoginWaiters);
+	LoginWaiters.Reset();
+	for (FOnLoggedIn const& Waiter : Waiters)
+	{
+		Waiter(Result);
+	}
+}
+
+void FAccelByteServerValidation::Complete(FString const& Key, FResult const& Result)
+{
+	FPending Entry;
+	if (!Pending.RemoveAndCopyValue(Key, Entry))
+	{
+		return;
+	}
+
+	if (Result.bSuccess)
+	{
+		Stats.Succeeded += Entry.Callbacks.Num();
+		// Failures are not kept, a client may retry once the backend or the store recovers
+		if (!Key.StartsWith(TEXT("once:")) && Settings.DedupeWindowSeconds > 0.0f)
+		{
+			FRecent& Done = Recent.Add(Key);
+			Done.Result = Result;
+			Done.CompletedTime = FPlatformTime::Seconds();
+		}
+	}
+	else
+	{
+		Stats.Failed += Entry.Callbacks.Num();
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Entry.Callbacks.Num(); Index++)
+	{
+		const double LatencyMs = (Now - Entry.SubmitTimes[Index]) * 1000.0;
+		TotalLatencyMs += LatencyMs;
+		NumCompleted++;
+		Stats.MaxLatencyMs = FMath::Max(Stats.MaxLatencyMs, static_cast<float>(LatencyMs));
+
+		FResult Shared = Result;
+		Shared.bDeduplicated = Index > 0;
+		Entry.Callbacks[Index](Shared);
+	}
+}
+
+bool FAccelByteServerValidation::Tick(float DeltaSeconds)
+{
+	const double Now = FPlatformTime::Seconds();
+	for (auto It = Recent.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().CompletedTime > Settings.DedupeWindowSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// A bucket that refilled completely holds nothing a new bucket would not
+	const double FullRefillSeconds = Settings.RateLimitPerMinute > 0.0f ? Settings.RateLimitBurst * 60.0 / Settings.RateLimitPerMinute : 0.0;
+	for (auto It = Buckets.CreateIterator(); It; ++It)
+	{
+		if (Now - It.Value().LastRefillTime > FullRefillSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return true;
+}
+
+bool FAccelByteServerValidation::IsUnauthorized(int32 ErrorCode)
+{
+	return ErrorCode == EHttpResponseCodes::Denied || ErrorCode == UnauthorizedAccessCode;
+}
@@ -0,0 +1,197 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteServerValidation.generated.h"
+
+class FAccelByteTaskPipeline;
+
+USTRUCT(BlueprintType)
+struct FAccelByteServerValidationStats
+{
+	GENERATED_BODY()
+
+	// Receipts and grants handed to the service by the players' components or the game
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Submitted = 0;
+
+	// Answered by a request already in flight or by a result of the dedupe window instead of a backend call
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Deduplicated = 0;
+
+	// Refused because the user ran out of tokens
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 RateLimited = 0;
+
+	// Refused because the queue was full
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Rejected = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Succeeded = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Failed = 0;
+
+	// Client credentials logins, the first one and those after the token was refused
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Logins = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 Queued = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	int32 InFlight = 0;
+
+	// From Submit until the result, queueing included
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	float AverageLatencyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Server")
+	float MaxLatencyMs = 0.0f;
+};
+
+/**
+ * Validates purchase receipts and grants entitlements for the players connected to a dedicated server.
+ *
+ * The server logs in once with its client credentials and makes the calls on behalf of the players, instead of
+ * every game client syncing its own purchases. At most MaxConcurrency calls are in flight, the rest wait in a queue
+ * of MaxQueued requests and anything past that is refused, so a burst of players can neither exhaust the HTTP
+ * connections nor grow the server's memory. All the calls go through the engine's HTTP module and reuse its
+ * keep-alive connections to the backend; keep MaxConcurrency at or under [HTTP] HttpMaxConnectionsPerServer of the
+ * engine ini so no call waits for a connection to be opened.
+ *
+ * Each user gets a token bucket for the receipts they send, a receipt arriving with the bucket empty is refused;
+ * grants are decided by the server and are not limited. A request for a receipt or a grant that is already in
+ * flight joins it, and a receipt or grant that succeeded within the dedupe window is answered with the same result,
+ * so a client retrying or two clients of the same account do not sync twice. Receipts are keyed on their order or
+ * transaction id, grants on the idempotency key given by the game. Only meant to be used from the game thread.
+ */
+class FAccelByteServerValidation
+{
+public:
+	enum class EKind : uint8
+	{
+		GooglePurchase,
+		ApplePurchase,
+		GrantEntitlements,
+	};
+
+	struct FSettings
+	{
+		int32 MaxConcurrency = 16;
+		int32 MaxQueued = 1024;
+		// Tokens a user gets back per minute, and the most they can hold, zero turns the limit off
+		float RateLimitPerMinute = 30.0f;
+		int32 RateLimitBurst = 10;
+		float DedupeWindowSeconds = 300.0f;
+	};
+
+	struct FRequest
+	{
+		EKind Kind = EKind::GooglePurchase;
+		FString UserId;
+		FAccelByteModelsPlatformSyncMobileGoogle GoogleReceipt;
+		FAccelByteModelsPlatformSyncMobileApple AppleReceipt;
+		TArray<FAccelByteModelsEntitlementGrant> Grants;
+		// Grants without one are never deduplicated
+		FString IdempotencyKey;
+	};
+
+	struct FResult
+	{
+		bool bSuccess = false;
+		int32 ErrorCode = 0;
+		FString ErrorMessage;
+		// Set when the result was shared with another request instead of coming from a call of its own
+		bool bDeduplicated = false;
+	};
+
+	using FOnComplete = TFunction<void(FResult const& Result)>;
+	using FOnUserVerified = TFunction<void(FResult const& Result, FString const& UserId)>;
+	using FRequestHandler = TFunction<void(FRequest const& Request, FOnComplete const& OnResult)>;
+
+	static FAccelByteServerValidation& Get();
+
+	FAccelByteServerValidation();
+	~FAccelByteServerValidation();
+
+	// Requests submitted before keep the pool they were queued in
+	void Configure(FSettings const& InSettings);
+
+	// OnComplete is called once, right away when the request is refused
+	void Submit(FRequest const& Request, FOnComplete&& OnComplete);
+
+	/**
+	 * Asks IAM which user an access token sent by a player belongs to. The user id it answers with is the only one
+	 * the server should validate or grant for, a user id sent by a client is not proof of anything.
+	 */
+	void VerifyUser(FString const& AccessToken, FOnUserVerified&& OnVerified);
+
+	// Replaces the backend calls, used to load test the service without a backend
+	void SetRequestHandler(FRequestHandler&& InRequestHandler);
+
+	FAccelByteServerValidationStats GetStats() const;
+
+	static FString GetDedupeKey(FRequest const& Request);
+
+private:
+	struct FPending
+	{
+		TArray<FOnComplete> Callbacks;
+		TArray<double> SubmitTimes;
+	};
+
+	struct FBucket
+	{
+		float Tokens = 0.0f;
+		double LastRefillTime = 0.0;
+	};
+
+	struct FRecent
+	{
+		FResult Result;
+		double CompletedTime = 0.0;
+	};
+
+	using FOnLoggedIn = TFunction<void(FResult const& Result)>;
+
+	bool TakeToken(FString const& UserId, double Now);
+	void Dispatch(FString const& Key, FRequest const& Request);
+	void Send(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried);
+	void SendReceipt(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried);
+	void SendGrant(FRequest const& Request, FOnComplete const& OnResult, bool bLoginRetried);
+	void EnsureLoggedIn(FOnLoggedIn&& OnLoggedIn);
+	void FinishLogin(FResult const& Result);
+	void Complete(FString const& Key, FResult const& Result);
+	bool Tick(float DeltaSeconds);
+
+	static bool IsUnauthorized(int32 ErrorCode);
+
+	FSettings Settings;
+	TSharedRef<FAccelByteTaskPipeline> Pipeline;
+
+	// Requests queued or in flight, by dedupe key
+	TMap<FString, FPending> Pending;
+	TMap<FString, FRecent> Recent;
+	TMap<FString, FBucket> Buckets;
+
+	bool bLoggedIn = false;
+	bool bLoggingIn = false;
+	TArray<FOnLoggedIn> LoginWaiters;
+
+	FRequestHandler RequestHandler;
+	FDelegateHandle TickerHandle;
+
+	FAccelByteServerValidationStats Stats;
+	double TotalLatencyMs = 0.0;
+	int32 NumCompleted = 0;
+
+	// Shared with request callbacks so they can detect that the service has been destroyed
+	TSharedRef<bool, ESPMode::ThreadSafe> AliveToken;
+};
@@ -0,0 +1,161 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteServerValidationComponent.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Guid.h"
+
+#include "Core/AccelByteRegistry.h"
+
+UAccelByteServerValidationComponent::UAccelByteServerValidationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+FString UAccelByteServerValidationComponent::SyncPurchaseGooglePlay(FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest)
+{
+	const FString RequestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	SendAccessToken();
+	ServerSyncPurchaseGooglePlay(RequestId, SyncRequest);
+	return RequestId;
+}
+
+FString UAccelByteServerValidationComponent::SyncPurchaseApple(FAccelByteModelsPlatformSyncMobileApple const& SyncRequest)
+{
+	const FString RequestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+	SendAccessToken();
+	ServerSyncPurchaseApple(RequestId, SyncRequest);
+	return RequestId;
+}
+
+FString UAccelByteServerValidationComponent::GrantEntitlement(FString const& ItemId, int32 Quantity, FString const& IdempotencyKey)
+{
+	const FString RequestId = FGuid::NewGuid().ToString(EGuidFormats::Digits);
+
+	FAccelByteModelsEntitlementGrant Grant;
+	Grant.ItemId = ItemId;
+	Grant.ItemNamespace = FRegistry::ServerSettings.Namespace;
+	Grant.Quantity = Quantity;
+
+	FAccelByteServerValidation::FRequest Request;
+	Request.Kind = FAccelByteServerValidation::EKind::GrantEntitlements;
+	Request.Grants.Add(Grant);
+	Request.IdempotencyKey = IdempotencyKey;
+	Validate(RequestId, Request);
+	return RequestId;
+}
+
+void UAccelByteServerValidationComponent::ServerAuthenticate_Implementation(FString const& AccessToken)
+{
+	UserId.Empty();
+	bVerifying = true;
+	const int32 Generation = ++VerifyGeneration;
+
+	TWeakObjectPtr<UAccelByteServerValidationComponent> WeakThis = this;
+	FAccelByteServerValidation::Get().VerifyUser(AccessToken, [WeakThis, Generation](FAccelByteServerValidation::FResult const& Result, FString const& VerifiedUserId)
+	{
+		if (!WeakThis.IsValid() || WeakThis->VerifyGeneration != Generation)
+		{
+			return;
+		}
+
+		WeakThis->bVerifying = false;
+		WeakThis->UserId = Result.bSuccess ? VerifiedUserId : FString();
+
+		TArray<TPair<FString, FAccelByteServerValidation::FRequest>> Waiting = MoveTemp(WeakThis->WaitingForUser);
+		WeakThis->WaitingForUser.Reset();
+		for (TPair<FString, FAccelByteServerValidation::FRequest> const& Entry : Waiting)
+		{
+			WeakThis->Validate(Entry.Key, Entry.Value);
+		}
+	});
+}
+
+void UAccelByteServerValidationComponent::ServerSyncPurchaseGooglePlay_Implementation(FString const& RequestId, FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest)
+{
+	FAccelByteServerValidation::FRequest Request;
+	Request.Kind = FAccelByteServerValidation::EKind::GooglePurchase;
+	Request.GoogleReceipt = SyncRequest;
+	Validate(RequestId, Request);
+}
+
+void UAccelByteServerValidationComponent::ServerSyncPurchaseApple_Implementation(FString const& RequestId, FAccelByteModelsPlatformSyncMobileApple const& SyncRequest)
+{
+	FAccelByteServerValidation::FRequest Request;
+	Request.Kind = FAccelByteServerValidation::EKind::ApplePurchase;
+	Request.AppleReceipt = SyncRequest;
+	Validate(RequestId, Request);
+}
+
+void UAccelByteServerValidationComponent::ClientValidationResult_Implementation(FString const& RequestId, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage)
+{
+	OnValidationResult.Broadcast(RequestId, bSuccess, ErrorCode, ErrorMessage);
+}
+
+void UAccelByteServerValidationComponent::Validate(FString const& RequestId, FAccelByteServerValidation::FRequest const& Request)
+{
+	if (GetOwner() == nullptr || !GetOwner()->HasAuthority())
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Server validation requested away from the server, request %s ignored"), *RequestId);
+		return;
+	}
+
+	if (bVerifying)
+	{
+		WaitingForUser.Emplace(RequestId, Request);
+		return;
+	}
+
+	// No token was sent or IAM did not accept it, nothing is done without a verified user
+	if (UserId.IsEmpty())
+	{
+		ReportResult(RequestId, false, EHttpResponseCodes::Denied, TEXT("server-validation-user-unverified"));
+		return;
+	}
+
+	FAccelByteServerValidation::FRequest UserRequest = Request;
+	UserRequest.UserId = UserId;
+
+	// The player may leave before the backend answers
+	TWeakObjectPtr<UAccelByteServerValidationComponent> WeakThis = this;
+	FAccelByteServerValidation::Get().Submit(UserRequest, [WeakThis, RequestId](FAccelByteServerValidation::FResult const& Result)
+	{
+		if (WeakThis.IsValid())
+		{
+			WeakThis->ReportResult(RequestId, Result.bSuccess, Result.ErrorCode, Result.ErrorMessage);
+		}
+	});
+}
+
+void UAccelByteServerValidationComponent::ReportResult(FString const& RequestId, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage)
+{
+	OnValidationResult.Broadcast(RequestId, bSuccess, ErrorCode, ErrorMessage);
+
+	// A listen server's own player already got the broadcast
+	if (!IsLocallyOwned())
+	{
+		ClientValidationResult(RequestId, bSuccess, ErrorCode, ErrorMessage);
+	}
+}
+
+bool UAccelByteServerValidationComponent::IsLocallyOwned() const
+{
+	APlayerController const* PlayerController = Cast<APlayerController>(GetOwner());
+	return PlayerController != nullptr && PlayerController->IsLocalController();
+}
+
+void UAccelByteServerValidationComponent::SendAccessToken()
+{
+	// Reliable RPCs of an actor arrive in order, the receipt that follows the token waits for its verification
+	const FString CurrentUserId = FRegistry::Credentials.GetUserId();
+	if (CurrentUserId != SentUserId)
+	{
+		SentUserId = CurrentUserId;
+		ServerAuthenticate(FRegistry::Credentials.GetAccessToken());
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "AccelByteServerValidation.h"
+#include "AccelByteServerValidationComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FAccelByteServerValidationResult, FString const&, RequestId, bool, bSuccess, int32, ErrorCode, FString const&, ErrorMessage);
+
+/**
+ * Sends the purchases of a player to the dedicated server, which validates them with FAccelByteServerValidation.
+ *
+ * Add it to the player controller. The owning client sends its receipts through server RPCs; the server answers
+ * each of them with the request id the client got back and fires OnValidationResult on both sides. Entitlement
+ * grants are made by the server only, a client cannot ask for one.
+ *
+ * The client never tells the server who it is: it sends its AccelByte access token ahead of its first receipt and
+ * the server asks IAM which user the token belongs to. Receipts and grants wait for the answer and are refused when
+ * the token was not accepted, so a modified client can neither sync into nor receive grants for another account.
+ */
+UCLASS(ClassGroup = (AccelByte), meta = (BlueprintSpawnableComponent))
+class UAccelByteServerValidationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UAccelByteServerValidationComponent();
+
+	// Called on the owning client, returns the id the result is reported with
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Server")
+	FString SyncPurchaseGooglePlay(FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest);
+
+	// Called on the owning client, returns the id the result is reported with
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | SampleApp | Server")
+	FString SyncPurchaseApple(FAccelByteModelsPlatformSyncMobileApple const& SyncRequest);
+
+	// Grants to the player owning the component, a grant with the same idempotency key is only made once
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "AccelByte | SampleApp | Server")
+	FString GrantEntitlement(FString const& ItemId, int32 Quantity, FString const& IdempotencyKey);
+
+	// The user IAM verified the player's token for, empty on clients and until the token was checked
+	UFUNCTION(BlueprintPure, Category = "AccelByte | SampleApp | Server")
+	FString GetUserId() const { return UserId; }
+
+	UPROPERTY(BlueprintAssignable, Category = "AccelByte | SampleApp | Server")
+	FAccelByteServerValidationResult OnValidationResult;
+
+protected:
+	UFUNCTION(Server, Reliable)
+	void ServerAuthenticate(FString const& AccessToken);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSyncPurchaseGooglePlay(FString const& RequestId, FAccelByteModelsPlatformSyncMobileGoogle const& SyncRequest);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSyncPurchaseApple(FString const& RequestId, FAccelByteModelsPlatformSyncMobileApple const& SyncRequest);
+
+	UFUNCTION(Client, Reliable)
+	void ClientValidationResult(FString const& RequestId, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage);
+
+private:
+	// Runs on the server
+	void Validate(FString const& RequestId, FAccelByteServerValidation::FRequest const& Request);
+	void ReportResult(FString const& RequestId, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage);
+	bool IsLocallyOwned() const;
+
+	// Runs on the owning client, before a receipt whenever the player logged in as someone else
+	void SendAccessToken();
+
+	// Server side, set from the verified token only
+	FString UserId;
+	bool bVerifying = false;
+	// Tells apart the answers of a token that was replaced while IAM was checking it
+	int32 VerifyGeneration = 0;
+	TArray<TPair<FString, FAccelByteServerValidation::FRequest>> WaitingForUser;
+
+	// Client side, the user the last token sent was issued to
+	FString SentUserId;
+};
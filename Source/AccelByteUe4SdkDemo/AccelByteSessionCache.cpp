@@ -0,0 +1,296 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteSessionCache.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteMemoryReport.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AES.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <dpapi.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#endif
+
+#if WITH_ACCELBYTE_OPENSSL
+THIRD_PARTY_INCLUDES_START
+#include "openssl/rand.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+#define SESSION_CACHE_MAGIC 0x43534241 // "ABSC"
+#define SESSION_CACHE_VERSION 1
+#define SESSION_CACHE_KEY_SIZE 32
+
+namespace AccelByteSessionCache
+{
+	static void MakeRandomKey(TArray<uint8>& OutKey)
+	{
+		OutKey.SetNumUninitialized(SESSION_CACHE_KEY_SIZE);
+#if WITH_ACCELBYTE_OPENSSL
+		if (RAND_bytes(OutKey.GetData(), OutKey.Num()) == 1)
+		{
+			return;
+		}
+#endif
+		// Random version 4 GUIDs where OpenSSL is not linked
+		for (int32 Offset = 0; Offset < OutKey.Num(); Offset += sizeof(FGuid))
+		{
+			const FGuid Guid = FGuid::NewGuid();
+			FMemory::Memcpy(OutKey.GetData() + Offset, &Guid, FMath::Min<int32>(sizeof(FGuid), OutKey.Num() - Offset));
+		}
+	}
+
+	// Ties the key to the OS account where the platform offers a store for it
+	static bool SealKey(TArray<uint8> const& Key, TArray<uint8>& OutSealed)
+	{
+#if PLATFORM_WINDOWS
+		DATA_BLOB Input = { static_cast<DWORD>(Key.Num()), const_cast<BYTE*>(Key.GetData()) };
+		DATA_BLOB Output = { 0, nullptr };
+		if (!CryptProtectData(&Input, nullptr, nullptr, nullptr, nullptr, CRYPTPROTECT_UI_FORBIDDEN, &Output))
+		{
+			return false;
+		}
+		OutSealed = TArray<uint8>(Output.pbData, Output.cbData);
+		LocalFree(Output.pbData);
+		return true;
+#else
+		OutSealed = Key;
+		return true;
+#endif
+	}
+
+	static bool UnsealKey(TArray<uint8> const& Sealed, TArray<uint8>& OutKey)
+	{
+#if PLATFORM_WINDOWS
+		DATA_BLOB Input = { static_cast<DWORD>(Sealed.Num()), const_cast<BYTE*>(Sealed.GetData()) };
+		DATA_BLOB Output = { 0, nullptr };
+		if (!CryptUnprotectData(&Input, nullptr, nullptr, nullptr, nullptr, CRYPTPROTECT_UI_FORBIDDEN, &Output))
+		{
+			return false;
+		}
+		OutKey = TArray<uint8>(Output.pbData, Output.cbData);
+		SecureZeroMemory(Output.pbData, Output.cbData);
+		LocalFree(Output.pbData);
+#else
+		OutKey = Sealed;
+#endif
+		return OutKey.Num() == SESSION_CACHE_KEY_SIZE;
+	}
+}
+
+using namespace AccelByteSessionCache;
+
+FAccelByteSessionCache& FAccelByteSessionCache::Get()
+{
+	static FAccelByteSessionCache Instance(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("Session.bin"));
+	return Instance;
+}
+
+FAccelByteSessionCache::FAccelByteSessionCache(FString const& InPath)
+	: Path(InPath)
+	, KeyPath(FPaths::Combine(FPlatformProcess::UserSettingsDir(), FApp::GetProjectName(), TEXT("AccelByteSessionKey.bin")))
+{
+}
+
+void FAccelByteSessionCache::Configure(bool bInEnabled, double InMaxAgeSeconds)
+{
+	bEnabled = bInEnabled;
+	MaxAgeSeconds = FMath::Max(0.0, InMaxAgeSeconds);
+}
+
+bool FAccelByteSessionCache::GetKey(uint8 (&OutKey)[32], bool bCreate)
+{
+	static_assert(sizeof(OutKey) == SESSION_CACHE_KEY_SIZE, "The session cache key is an AES-256 key");
+
+	if (CachedKey.Num() != SESSION_CACHE_KEY_SIZE)
+	{
+		TArray<uint8> Sealed;
+		if (!FFileHelper::LoadFileToArray(Sealed, *KeyPath, FILEREAD_Silent) || !UnsealKey(Sealed, CachedKey))
+		{
+			CachedKey.Reset();
+			if (!bCreate)
+			{
+				return false;
+			}
+
+			// Whatever the cache holds was encrypted with a key that is gone
+			TArray<uint8> NewKey;
+			MakeRandomKey(NewKey);
+			if (!SealKey(NewKey, Sealed) || !FFileHelper::SaveArrayToFile(Sealed, *KeyPath))
+			{
+				UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Cannot store the session cache key in %s"), *KeyPath);
+				return false;
+			}
+			CachedKey = MoveTemp(NewKey);
+		}
+	}
+
+	FMemory::Memcpy(OutKey, CachedKey.GetData(), SESSION_CACHE_KEY_SIZE);
+	return true;
+}
+
+bool FAccelByteSessionCache::Load(FSession& OutSession)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	if (!bEnabled)
+	{
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader HeaderReader(FileData);
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	uint32 PlainSize = 0;
+	HeaderReader << Magic << Version << PlainSize;
+	const int64 HeaderSize = HeaderReader.Tell();
+	const int64 CipherSize = FileData.Num() - HeaderSize;
+
+	if (HeaderReader.IsError()
+		|| Magic != SESSION_CACHE_MAGIC
+		|| Version != SESSION_CACHE_VERSION
+		|| CipherSize <= 0
+		|| CipherSize % FAES::AESBlockSize != 0
+		|| PlainSize < sizeof(FSHAHash::Hash)
+		|| PlainSize > CipherSize)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Session cache %s is not readable, deleting it"), *Path);
+		Clear();
+		return false;
+	}
+
+	FAES::FAESKey Key;
+	if (!GetKey(Key.Key, false))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Session cache %s has no key, deleting it"), *Path);
+		Clear();
+		return false;
+	}
+	uint8* CipherData = FileData.GetData() + HeaderSize;
+	FAES::DecryptData(CipherData, CipherSize, Key);
+
+	FSHAHash Digest;
+	FSHA1::HashBuffer(CipherData + sizeof(Digest.Hash), PlainSize - sizeof(Digest.Hash), Digest.Hash);
+	if (FMemory::Memcmp(Digest.Hash, CipherData, sizeof(Digest.Hash)) != 0)
+	{
+		// Also what a file whose key was replaced looks like
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Session cache %s failed its integrity check, deleting it"), *Path);
+		Clear();
+		return false;
+	}
+
+	TArray<uint8> Body(CipherData + sizeof(Digest.Hash), PlainSize - sizeof(Digest.Hash));
+	FMemoryReader BodyReader(Body);
+	FSession Session;
+	BodyReader << Session.RefreshToken << Session.UserId << Session.NativeSubsystemName << Session.NativeUserId << Session.SavedAt << Session.FullLoginMs;
+	if (BodyReader.IsError() || Session.RefreshToken.IsEmpty())
+	{
+		Clear();
+		return false;
+	}
+
+	const double AgeSeconds = (FDateTime::UtcNow() - Session.SavedAt).GetTotalSeconds();
+	if (AgeSeconds < 0.0 || AgeSeconds > MaxAgeSeconds)
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Cached session is %.0f seconds old, a full login is needed"), AgeSeconds);
+		Clear();
+		return false;
+	}
+
+	OutSession = MoveTemp(Session);
+	return true;
+}
+
+void FAccelByteSessionCache::Save(FSession const& Session)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	if (!bEnabled || Session.RefreshToken.IsEmpty())
+	{
+		return;
+	}
+
+	TArray<uint8> Body;
+	FMemoryWriter BodyWriter(Body);
+	FSession Copy = Session;
+	BodyWriter << Copy.RefreshToken << Copy.UserId << Copy.NativeSubsystemName << Copy.NativeUserId << Copy.SavedAt << Copy.FullLoginMs;
+
+	FSHAHash Digest;
+	FSHA1::HashBuffer(Body.GetData(), Body.Num(), Digest.Hash);
+
+	uint32 Magic = SESSION_CACHE_MAGIC;
+	uint32 Version = SESSION_CACHE_VERSION;
+	uint32 PlainSize = sizeof(Digest.Hash) + Body.Num();
+
+	TArray<uint8> FileData;
+	FMemoryWriter FileWriter(FileData);
+	FileWriter << Magic << Version << PlainSize;
+	const int32 HeaderSize = FileData.Num();
+	FileWriter.Serialize(Digest.Hash, sizeof(Digest.Hash));
+	FileWriter.Serialize(Body.GetData(), Body.Num());
+	FileData.AddZeroed(Align(PlainSize, FAES::AESBlockSize) - PlainSize);
+
+	FAES::FAESKey Key;
+	if (!GetKey(Key.Key, true))
+	{
+		return;
+	}
+	FAES::EncryptData(FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize, Key);
+
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileData, *TempPath) || !IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to write session cache %s"), *Path);
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+	}
+}
+
+void FAccelByteSessionCache::Clear()
+{
+	IFileManager::Get().Delete(*Path, false, false, true);
+}
+
+void FAccelByteSessionCache::MarkFullLoginStarted()
+{
+	FullLoginStartTime = FPlatformTime::Seconds();
+}
+
+float FAccelByteSessionCache::GetFullLoginMs() const
+{
+	return FullLoginStartTime > 0.0 ? static_cast<float>((FPlatformTime::Seconds() - FullLoginStartTime) * 1000.0) : 0.0f;
+}
+
+void FAccelByteSessionCache::RecordSessionReady(bool bResumed, float LoginMs, float LastFullLoginMs)
+{
+	StartupTiming.bResumed = bResumed;
+	StartupTiming.LoginMs = LoginMs;
+	StartupTiming.SinceLaunchMs = static_cast<float>((FPlatformTime::Seconds() - GStartTime) * 1000.0);
+	StartupTiming.LastFullLoginMs = LastFullLoginMs;
+
+	if (bResumed)
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Session resumed in %.0f ms, %.0f ms after launch, the last full login took %.0f ms"), StartupTiming.LoginMs, StartupTiming.SinceLaunchMs, LastFullLoginMs);
+	}
+	else
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Full login took %.0f ms, %.0f ms after launch"), StartupTiming.LoginMs, StartupTiming.SinceLaunchMs);
+	}
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteSessionCache.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteStartupTiming
+{
+	GENERATED_BODY()
+
+	// Set when the session was restored from the cache instead of the full native and AccelByte login
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	bool bResumed = false;
+
+	// Wall time of the login that produced the current session
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float LoginMs = 0.0f;
+
+	// Wall time from the process start to the session being ready
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float SinceLaunchMs = 0.0f;
+
+	// Wall time of the last full login, kept in the cache so a resumed session can report what it saved
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float LastFullLoginMs = 0.0f;
+};
+
+/**
+ * Encrypted on-disk cache of the AccelByte refresh token and the native identity it was issued for.
+ *
+ * The file is AES encrypted with a random key made by the first save of the install. The key is kept apart from the
+ * cache, in the user settings directory, and on Windows it is sealed with DPAPI so only the same OS account can
+ * open it. On the other platforms the key file is as protected as the user's own files: a copy of the Saved folder
+ * is unreadable without it, but code running as the same user can read both. A SHA1 of the content is stored inside
+ * the encrypted payload and a file that fails the check, or whose key is gone, is treated as missing.
+ */
+class FAccelByteSessionCache
+{
+public:
+	struct FSession
+	{
+		FString RefreshToken;
+		FString UserId;
+		FString NativeSubsystemName;
+		FString NativeUserId;
+		FDateTime SavedAt;
+		float FullLoginMs = 0.0f;
+	};
+
+	static FAccelByteSessionCache& Get();
+
+	explicit FAccelByteSessionCache(FString const& InPath);
+
+	/**
+	 * @param bInEnabled Disabled caches never load and never write, the file is left untouched.
+	 * @param InMaxAgeSeconds Sessions older than this are not resumed, keep it below the refresh token lifetime.
+	 */
+	void Configure(bool bInEnabled, double InMaxAgeSeconds);
+
+	// Returns false when there is no usable session, corrupted and expired files are deleted
+	bool Load(FSession& OutSession);
+
+	void Save(FSession const& Session);
+
+	void Clear();
+
+	// Marks the start of a full login, its duration is stored with the next saved session
+	void MarkFullLoginStarted();
+
+	// Records the timing of the login that made the current session ready, LastFullLoginMs comes from the cached session when resumed
+	void RecordSessionReady(bool bResumed, float LoginMs, float LastFullLoginMs);
+
+	// Milliseconds since MarkFullLoginStarted, zero when no full login was started
+	float GetFullLoginMs() const;
+
+	FAccelByteStartupTiming const& GetStartupTiming() const { return StartupTiming; }
+	bool IsEnabled() const { return bEnabled; }
+
+private:
+	// Reads the install key, or makes and stores one when bCreate is set
+	bool GetKey(uint8 (&OutKey)[32], bool bCreate);
+
+	FString Path;
+	FString KeyPath;
+	TArray<uint8> CachedKey;
+	bool bEnabled = true;
+	double MaxAgeSeconds = 86400.0;
+	double FullLoginStartTime = 0.0;
+	FAccelByteStartupTiming StartupTiming;
+};
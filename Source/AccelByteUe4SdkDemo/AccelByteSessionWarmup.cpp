@@ -0,0 +1,221 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteSessionWarmup.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteItemCache.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteMemoryReport.h"
+
+#include "HAL/PlatformTime.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteUserProfileApi.h"
+#include "Api/AccelByteWalletApi.h"
+#include "Api/AccelByteEntitlementApi.h"
+#include "Api/AccelByteItemApi.h"
+
+using namespace AccelByte;
+
+FAccelByteSessionWarmup& FAccelByteSessionWarmup::Get()
+{
+	static FAccelByteSessionWarmup Instance;
+	return Instance;
+}
+
+void FAccelByteSessionWarmup::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.EntitlementLimit = FMath::Max(1, Settings.EntitlementLimit);
+	Settings.CatalogLimit = FMath::Max(1, Settings.CatalogLimit);
+}
+
+void FAccelByteSessionWarmup::Start()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	Reset();
+	if (!Settings.bEnabled)
+	{
+		return;
+	}
+
+	TArray<EAccelByteWarmupStage> Stages;
+	if (Settings.bProfile)
+	{
+		Stages.Add(EAccelByteWarmupStage::Profile);
+	}
+	// The wallet query is per currency, there is nothing to fetch without one
+	if (Settings.bWallet && !Settings.WalletCurrencyCode.IsEmpty())
+	{
+		Stages.Add(EAccelByteWarmupStage::Wallet);
+	}
+	if (Settings.bEntitlements)
+	{
+		Stages.Add(EAccelByteWarmupStage::Entitlements);
+	}
+	if (Settings.bCatalog)
+	{
+		Stages.Add(EAccelByteWarmupStage::Catalog);
+	}
+
+	if (Stages.Num() == 0)
+	{
+		return;
+	}
+
+	bRunning = true;
+	StartTime = FPlatformTime::Seconds();
+	const int32 StartedGeneration = Generation;
+
+	// One slot per stage, every query is sent right away
+	TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Stages.Num());
+	Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([this, StartedGeneration]()
+	{
+		Finish(StartedGeneration);
+	}));
+
+	TArray<FAccelByteTaskPipeline::FTask> Tasks;
+	Tasks.Reserve(Stages.Num());
+	for (const EAccelByteWarmupStage Stage : Stages)
+	{
+		Tasks.Add([this, Stage, StartedGeneration](FSimpleDelegate const& OnDone)
+		{
+			RunStage(Stage, StartedGeneration, OnDone);
+		});
+	}
+	Pipeline->EnqueueAll(MoveTemp(Tasks));
+}
+
+void FAccelByteSessionWarmup::RunStage(EAccelByteWarmupStage Stage, int32 InGeneration, FSimpleDelegate const& OnDone)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Session);
+	// Responses of a warm-up that has been superseded still complete the pipeline but leave the snapshot alone
+	const FErrorHandler OnError = FErrorHandler::CreateLambda([this, Stage, InGeneration, OnDone](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		if (InGeneration == Generation)
+		{
+			RecordStage(Stage, false, ErrorCode, ErrorMessage);
+		}
+		OnDone.ExecuteIfBound();
+	});
+
+	switch (Stage)
+	{
+	case EAccelByteWarmupStage::Profile:
+		FRegistry::UserProfile.GetUserProfile(THandler<FAccelByteModelsUserProfileInfo>::CreateLambda([this, Stage, InGeneration, OnDone](FAccelByteModelsUserProfileInfo const& Result)
+		{
+			if (InGeneration == Generation)
+			{
+				Snapshot.Profile = Result;
+				RecordStage(Stage, true, 0, TEXT(""));
+			}
+			OnDone.ExecuteIfBound();
+		}), OnError);
+		break;
+
+	case EAccelByteWarmupStage::Wallet:
+		FRegistry::Wallet.GetWalletInfoByCurrencyCode(Settings.WalletCurrencyCode, THandler<FAccelByteModelsWalletInfo>::CreateLambda([this, Stage, InGeneration, OnDone](FAccelByteModelsWalletInfo const& Result)
+		{
+			if (InGeneration == Generation)
+			{
+				Snapshot.Wallet = Result;
+				RecordStage(Stage, true, 0, TEXT(""));
+			}
+			OnDone.ExecuteIfBound();
+		}), OnError);
+		break;
+
+	case EAccelByteWarmupStage::Entitlements:
+		FRegistry::Entitlement.QueryUserEntitlements(TEXT(""), TEXT(""), 0, Settings.EntitlementLimit, THandler<FAccelByteModelsEntitlementPagingSlicedResult>::CreateLambda([this, Stage, InGeneration, OnDone](FAccelByteModelsEntitlementPagingSlicedResult const& Result)
+		{
+			if (InGeneration == Generation)
+			{
+				Snapshot.Entitlements = Result;
+				RecordStage(Stage, true, 0, TEXT(""));
+			}
+			OnDone.ExecuteIfBound();
+		}), OnError, EAccelByteEntitlementClass::NONE, EAccelByteAppType::NONE);
+		break;
+
+	case EAccelByteWarmupStage::Catalog:
+	{
+		FAccelByteModelsItemCriteria Criteria;
+		Criteria.Language = Settings.CatalogLanguage;
+		Criteria.Region = Settings.CatalogRegion;
+		FRegistry::Item.GetItemsByCriteria(Criteria, 0, Settings.CatalogLimit, THandler<FAccelByteModelsItemPagingSlicedResult>::CreateLambda([this, Stage, InGeneration, OnDone](FAccelByteModelsItemPagingSlicedResult const& Result)
+		{
+			if (InGeneration == Generation)
+			{
+				Snapshot.Catalog = Result;
+				RecordStage(Stage, true, 0, TEXT(""));
+				for (FAccelByteModelsItemInfo const& Item : Result.Data)
+				{
+					FAccelByteItemCache::Get().AddItem(Item);
+				}
+			}
+			OnDone.ExecuteIfBound();
+		}), OnError);
+		break;
+	}
+	}
+}
+
+void FAccelByteSessionWarmup::RecordStage(EAccelByteWarmupStage Stage, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage)
+{
+	FAccelByteWarmupStageTiming& Timing = Snapshot.StageTimings.AddDefaulted_GetRef();
+	Timing.Stage = Stage;
+	Timing.bSuccess = bSuccess;
+	Timing.ErrorCode = ErrorCode;
+	Timing.ErrorMessage = ErrorMessage;
+	Timing.DurationMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Session warm-up stage %s failed after %.0f ms, code: %d - message: %s"), *UEnum::GetValueAsString(Stage), Timing.DurationMs, ErrorCode, *ErrorMessage);
+	}
+}
+
+void FAccelByteSessionWarmup::Finish(int32 InGeneration)
+{
+	if (InGeneration != Generation)
+	{
+		return;
+	}
+
+	bRunning = false;
+	bReady = true;
+	Snapshot.TotalMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Session warm-up finished in %.0f ms"), Snapshot.TotalMs);
+
+	TArray<FOnReady> Callbacks = MoveTemp(PendingReady);
+	for (FOnReady const& Callback : Callbacks)
+	{
+		Callback(Snapshot);
+	}
+}
+
+void FAccelByteSessionWarmup::WhenReady(FOnReady&& OnReady)
+{
+	if (bRunning)
+	{
+		PendingReady.Add(MoveTemp(OnReady));
+		return;
+	}
+	OnReady(Snapshot);
+}
+
+void FAccelByteSessionWarmup::Reset()
+{
+	Generation++;
+	bRunning = false;
+	bReady = false;
+	Snapshot = FAccelByteSessionSnapshot();
+
+	// Nothing will complete the callers still waiting on the dropped warm-up
+	TArray<FOnReady> Callbacks = MoveTemp(PendingReady);
+	for (FOnReady const& Callback : Callbacks)
+	{
+		Callback(Snapshot);
+	}
+}
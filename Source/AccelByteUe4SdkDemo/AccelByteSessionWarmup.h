@@ -0,0 +1,128 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Models/AccelByteEcommerceModels.h"
+#include "Models/AccelByteUserProfileModels.h"
+#include "AccelByteSessionWarmup.generated.h"
+
+UENUM(BlueprintType)
+enum class EAccelByteWarmupStage : uint8
+{
+	Profile,
+	Wallet,
+	Entitlements,
+	Catalog
+};
+
+USTRUCT(BlueprintType)
+struct FAccelByteWarmupStageTiming
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	EAccelByteWarmupStage Stage = EAccelByteWarmupStage::Profile;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	bool bSuccess = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	int32 ErrorCode = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	FString ErrorMessage;
+
+	// Wall time from the warm-up start to the response of this stage
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	float DurationMs = 0.0f;
+};
+
+/** Data fetched right after login so the first screens can render without waiting for the backend. */
+USTRUCT(BlueprintType)
+struct FAccelByteSessionSnapshot
+{
+	GENERATED_BODY()
+
+	// Only the stages listed in StageTimings with bSuccess set hold data
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	FAccelByteModelsUserProfileInfo Profile;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	FAccelByteModelsWalletInfo Wallet;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	FAccelByteModelsEntitlementPagingSlicedResult Entitlements;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	FAccelByteModelsItemPagingSlicedResult Catalog;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	TArray<FAccelByteWarmupStageTiming> StageTimings;
+
+	// Wall time until the slowest stage responded
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Session")
+	float TotalMs = 0.0f;
+};
+
+/**
+ * Post login warm-up that fetches the profile, wallet, entitlements and the first catalog page at once.
+ *
+ * The queries do not depend on each other, so they are all sent as soon as the login succeeds and the result
+ * is published as a snapshot once the last one has responded. A failed stage does not fail the warm-up, its
+ * timing carries the error and widgets can fall back to their own request. Catalog items also seed the SKU
+ * item cache. Handlers run on the game thread.
+ */
+class FAccelByteSessionWarmup
+{
+public:
+	struct FSettings
+	{
+		bool bEnabled = true;
+		bool bProfile = true;
+		bool bWallet = true;
+		bool bEntitlements = true;
+		bool bCatalog = true;
+		FString WalletCurrencyCode;
+		int32 EntitlementLimit = 20;
+		int32 CatalogLimit = 20;
+		FString CatalogLanguage;
+		FString CatalogRegion;
+	};
+
+	using FOnReady = TFunction<void(FAccelByteSessionSnapshot const& Snapshot)>;
+
+	static FAccelByteSessionWarmup& Get();
+
+	void Configure(FSettings const& InSettings);
+
+	// Discards the previous snapshot and sends the queries of every enabled stage
+	void Start();
+
+	// Called once the running warm-up finishes, immediately with the current snapshot when none is running
+	void WhenReady(FOnReady&& OnReady);
+
+	// Drops the snapshot, the responses of a warm-up still running are ignored
+	void Reset();
+
+	bool IsReady() const { return bReady; }
+	bool IsRunning() const { return bRunning; }
+	FAccelByteSessionSnapshot const& GetSnapshot() const { return Snapshot; }
+
+private:
+	void RunStage(EAccelByteWarmupStage Stage, int32 InGeneration, FSimpleDelegate const& OnDone);
+	void RecordStage(EAccelByteWarmupStage Stage, bool bSuccess, int32 ErrorCode, FString const& ErrorMessage);
+	void Finish(int32 InGeneration);
+
+	FSettings Settings;
+	FAccelByteSessionSnapshot Snapshot;
+	TArray<FOnReady> PendingReady;
+
+	// Bumped by every Start and Reset, responses tagged with an older generation are dropped
+	int32 Generation = 0;
+	double StartTime = 0.0;
+	bool bReady = false;
+	bool bRunning = false;
+};
@@ -0,0 +1,620 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteStatWriteBuffer.h"
+#include "AccelByteUe4SdkDemo.h"
+#include "AccelByteTaskPipeline.h"
+#include "AccelByteTelemetry.h"
+#include "AccelByteMemoryReport.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "Core/AccelByteRegistry.h"
+#include "Api/AccelByteStatisticApi.h"
+#include "Api/AccelByteGameProfileApi.h"
+
+#define STAT_BUFFER_OP_USER TEXT('U')
+#define STAT_BUFFER_OP_INCREMENT TEXT('I')
+#define STAT_BUFFER_OP_SET TEXT('S')
+#define STAT_BUFFER_OP_ATTRIBUTE TEXT('A')
+
+namespace AccelByteStatWriteBuffer
+{
+	static FString FormatFloat(float Value)
+	{
+		// Enough digits for the value to read back unchanged
+		return FString::Printf(TEXT("%.9g"), Value);
+	}
+}
+
+using namespace AccelByteStatWriteBuffer;
+
+FAccelByteStatWriteBuffer& FAccelByteStatWriteBuffer::Get()
+{
+	static FAccelByteStatWriteBuffer Instance(FPaths::ProjectSavedDir() / TEXT("AccelByte") / TEXT("StatWriteBuffer.log"));
+	return Instance;
+}
+
+FAccelByteStatWriteBuffer::FAccelByteStatWriteBuffer(FString const& InPath)
+	: Path(InPath)
+	, AliveToken(MakeShared<bool, ESPMode::ThreadSafe>(true))
+{
+	TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAccelByteStatWriteBuffer::Tick));
+	// The requests may not make it out, the buffer file is flushed either way
+	PreExitHandle = FCoreDelegates::OnPreExit.AddRaw(this, &FAccelByteStatWriteBuffer::Flush);
+	BackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddRaw(this, &FAccelByteStatWriteBuffer::Flush);
+}
+
+FAccelByteStatWriteBuffer::~FAccelByteStatWriteBuffer()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FCoreDelegates::OnPreExit.Remove(PreExitHandle);
+	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(BackgroundHandle);
+	CloseWriter();
+}
+
+void FAccelByteStatWriteBuffer::Configure(FSettings const& InSettings)
+{
+	Settings = InSettings;
+	Settings.FlushIntervalSeconds = FMath::Max(0.1f, Settings.FlushIntervalSeconds);
+	Settings.FlushThreshold = FMath::Max(1, Settings.FlushThreshold);
+	Settings.MaxStatsPerRequest = FMath::Max(1, Settings.MaxStatsPerRequest);
+	Settings.MaxConcurrency = FMath::Max(1, Settings.MaxConcurrency);
+}
+
+void FAccelByteStatWriteBuffer::Load()
+{
+	// LoadConfig runs again whenever the map is reloaded
+	if (bLoaded)
+	{
+		return;
+	}
+	bLoaded = true;
+
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Statistics);
+	// The file is rewritten after every flush, it only holds what a few flush intervals wrote
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *Path);
+
+	int32 NumCorrupted = 0;
+	for (FString const& Line : Lines)
+	{
+		TCHAR Op;
+		FString Key;
+		FString SubKey;
+		FString Value;
+		if (!ParseLine(Line, Op, Key, SubKey, Value))
+		{
+			NumCorrupted++;
+			continue;
+		}
+
+		switch (Op)
+		{
+		case STAT_BUFFER_OP_USER:
+			UserId = Key;
+			break;
+		case STAT_BUFFER_OP_INCREMENT:
+			ApplyStat(Key, false, FCString::Atof(*Value));
+			Stats.Recovered++;
+			break;
+		case STAT_BUFFER_OP_SET:
+			ApplyStat(Key, true, FCString::Atof(*Value));
+			Stats.Recovered++;
+			break;
+		case STAT_BUFFER_OP_ATTRIBUTE:
+			ApplyAttribute(Key, SubKey, Value);
+			Stats.Recovered++;
+			break;
+		}
+	}
+
+	if (NumPending() > 0)
+	{
+		OldestWriteTime = FPlatformTime::Seconds();
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("Recovered %d unsent stat and profile writes, %d corrupted lines skipped"), Stats.Recovered, NumCorrupted);
+	}
+
+	if (Stats.Recovered > 0 || NumCorrupted > 0)
+	{
+		Compact();
+	}
+}
+
+void FAccelByteStatWriteBuffer::BeginSession(FString const& InUserId)
+{
+	if (!UserId.IsEmpty() && UserId != InUserId && NumPending() > 0)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Dropping %d unsent stat and profile writes of another user"), NumPending());
+		Stats.Dropped += NumPending();
+		PendingStats.Reset();
+		PendingAttributes.Reset();
+		NumPendingAttributes = 0;
+		OldestWriteTime = 0.0;
+	}
+
+	UserId = InUserId;
+	bSessionActive = true;
+	RetryAfterTime = 0.0;
+	Compact();
+
+	// Writes recovered from a previous run go out right away
+	if (NumPending() > 0)
+	{
+		Flush();
+	}
+}
+
+void FAccelByteStatWriteBuffer::IncrementStat(FString const& StatCode, float Delta)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Statistics);
+	if (StatCode.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bMerged = ApplyStat(StatCode, false, Delta);
+	AppendLine(STAT_BUFFER_OP_INCREMENT, StatCode, TEXT(""), FormatFloat(Delta));
+	OnWrite(bMerged);
+}
+
+void FAccelByteStatWriteBuffer::SetStat(FString const& StatCode, float Value)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Statistics);
+	if (StatCode.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bMerged = ApplyStat(StatCode, true, Value);
+	AppendLine(STAT_BUFFER_OP_SET, StatCode, TEXT(""), FormatFloat(Value));
+	OnWrite(bMerged);
+}
+
+void FAccelByteStatWriteBuffer::SetProfileAttribute(FString const& ProfileId, FString const& Key, FString const& Value)
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Statistics);
+	if (ProfileId.IsEmpty() || Key.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bMerged = ApplyAttribute(ProfileId, Key, Value);
+	AppendLine(STAT_BUFFER_OP_ATTRIBUTE, ProfileId, Key, Value);
+	OnWrite(bMerged);
+}
+
+bool FAccelByteStatWriteBuffer::ApplyStat(FString const& StatCode, bool bOverride, float Value)
+{
+	if (OldestWriteTime <= 0.0)
+	{
+		OldestWriteTime = FPlatformTime::Seconds();
+	}
+
+	FStatWrite Write;
+	Write.bOverride = bOverride;
+	Write.Value = bOverride ? Value : 0.0f;
+	Write.Increment = bOverride ? 0.0f : Value;
+
+	FStatWrite* Existing = PendingStats.Find(StatCode);
+	if (Existing == nullptr)
+	{
+		PendingStats.Add(StatCode, Write);
+		return false;
+	}
+
+	MergeStat(*Existing, Write);
+	return true;
+}
+
+bool FAccelByteStatWriteBuffer::ApplyAttribute(FString const& ProfileId, FString const& Key, FString const& Value)
+{
+	if (OldestWriteTime <= 0.0)
+	{
+		OldestWriteTime = FPlatformTime::Seconds();
+	}
+
+	FAttributes& Attributes = PendingAttributes.FindOrAdd(ProfileId);
+	if (FString* Existing = Attributes.Find(Key))
+	{
+		*Existing = Value;
+		return true;
+	}
+
+	Attributes.Add(Key, Value);
+	NumPendingAttributes++;
+	return false;
+}
+
+void FAccelByteStatWriteBuffer::MergeStat(FStatWrite& Into, FStatWrite const& Newer)
+{
+	if (Newer.bOverride)
+	{
+		Into = Newer;
+	}
+	else if (Into.bOverride)
+	{
+		Into.Value += Newer.Increment;
+	}
+	else
+	{
+		Into.Increment += Newer.Increment;
+	}
+}
+
+void FAccelByteStatWriteBuffer::OnWrite(bool bMerged)
+{
+	Stats.Writes++;
+	if (bMerged)
+	{
+		Stats.Merged++;
+	}
+
+	if (NumPending() >= Settings.FlushThreshold)
+	{
+		Flush();
+	}
+}
+
+bool FAccelByteStatWriteBuffer::Tick(float DeltaSeconds)
+{
+	if (bWriterDirty && Writer != nullptr)
+	{
+		// Once per frame rather than once per write, a crash loses at most the writes of the frame
+		Writer->Flush();
+		bWriterDirty = false;
+	}
+
+	if (OldestWriteTime > 0.0 && FPlatformTime::Seconds() - OldestWriteTime >= Settings.FlushIntervalSeconds)
+	{
+		Flush();
+	}
+	return true;
+}
+
+void FAccelByteStatWriteBuffer::Flush()
+{
+	ACCELBYTE_LLM_SCOPE(EAccelByteMemoryFeature::Statistics);
+	if (bWriterDirty && Writer != nullptr)
+	{
+		Writer->Flush();
+		bWriterDirty = false;
+	}
+
+	if (bFlushing)
+	{
+		bFlushAgain = true;
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (!bSessionActive || NumPending() == 0 || StartTime < RetryAfterTime)
+	{
+		return;
+	}
+
+	bFlushing = true;
+	Stats.MaxWriteAgeMs = FMath::Max(Stats.MaxWriteAgeMs, static_cast<float>((StartTime - OldestWriteTime) * 1000.0));
+	OldestWriteTime = 0.0;
+	FlushingStats = MoveTemp(PendingStats);
+	FlushingAttributes = MoveTemp(PendingAttributes);
+	PendingStats.Reset();
+	PendingAttributes.Reset();
+	NumPendingAttributes = 0;
+
+	TArray<FRequest> Requests;
+	for (const TPair<FString, FStatWrite>& Pair : FlushingStats)
+	{
+		if (Requests.Num() == 0 || Requests.Last().StatItems.Num() >= Settings.MaxStatsPerRequest)
+		{
+			Requests.AddDefaulted();
+		}
+
+		FAccelByteModelsUpdateUserStatItemWithStatCode& Item = Requests.Last().StatItems.AddDefaulted_GetRef();
+		Item.StatCode = Pair.Key;
+		Item.UpdateStrategy = Pair.Value.bOverride ? EAccelByteStatisticUpdateStrategy::OVERRIDE : EAccelByteStatisticUpdateStrategy::INCREMENT;
+		Item.Value = Pair.Value.bOverride ? Pair.Value.Value : Pair.Value.Increment;
+	}
+	for (const TPair<FString, FAttributes>& Profile : FlushingAttributes)
+	{
+		for (const TPair<FString, FString>& Attribute : Profile.Value)
+		{
+			FRequest& Request = Requests.AddDefaulted_GetRef();
+			Request.ProfileId = Profile.Key;
+			Request.AttributeKey = Attribute.Key;
+			Request.AttributeValue = Attribute.Value;
+		}
+	}
+	Stats.Requests += Requests.Num();
+
+	TWeakPtr<bool, ESPMode::ThreadSafe> WeakAlive = AliveToken;
+	TArray<FAccelByteTaskPipeline::FTask> Tasks;
+	Tasks.Reserve(Requests.Num());
+	for (FRequest& Request : Requests)
+	{
+		Tasks.Add([this, WeakAlive, Request = MoveTemp(Request)](FSimpleDelegate const& OnDone)
+		{
+			SendRequest(Request, [this, WeakAlive, Request, OnDone](bool bSuccess, bool bRetryable)
+			{
+				if (WeakAlive.IsValid() && (bSuccess || !bRetryable))
+				{
+					// Writes that are not retried are done with, the rest go back into the buffer once the flush ends
+					int32 NumDone = 0;
+					for (FAccelByteModelsUpdateUserStatItemWithStatCode const& Item : Request.StatItems)
+					{
+						NumDone += FlushingStats.Remove(Item.StatCode);
+					}
+					if (FAttributes* Attributes = FlushingAttributes.Find(Request.ProfileId))
+					{
+						NumDone += Attributes->Remove(Request.AttributeKey);
+					}
+					if (!bSuccess)
+					{
+						Stats.Dropped += NumDone;
+					}
+				}
+				if (WeakAlive.IsValid() && !bSuccess)
+				{
+					Stats.FailedRequests++;
+				}
+				OnDone.ExecuteIfBound();
+			});
+		});
+	}
+
+	TSharedRef<FAccelByteTaskPipeline> Pipeline = FAccelByteTaskPipeline::Create(Settings.MaxConcurrency);
+	Pipeline->SetOnDrained(FSimpleDelegate::CreateLambda([this, WeakAlive, StartTime]()
+	{
+		if (WeakAlive.IsValid())
+		{
+			FinishFlush(StartTime);
+		}
+	}));
+	Pipeline->EnqueueAll(MoveTemp(Tasks));
+}
+
+void FAccelByteStatWriteBuffer::FinishFlush(double StartTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	const float FlushMs = static_cast<float>((Now - StartTime) * 1000.0);
+	Stats.Flushes++;
+	TotalFlushMs += FlushMs;
+	Stats.MaxFlushMs = FMath::Max(Stats.MaxFlushMs, FlushMs);
+
+	int32 NumRetried = FlushingStats.Num();
+	for (const TPair<FString, FAttributes>& Profile : FlushingAttributes)
+	{
+		NumRetried += Profile.Value.Num();
+	}
+	if (NumRetried > 0)
+	{
+		UE_LOG(LogAccelByteSampleApp, Display, TEXT("%d stat and profile writes failed to flush, retrying in %.1f seconds"), NumRetried, Settings.FlushIntervalSeconds);
+		RetryAfterTime = Now + Settings.FlushIntervalSeconds;
+		Requeue(MoveTemp(FlushingStats), MoveTemp(FlushingAttributes));
+	}
+	FlushingStats.Reset();
+	FlushingAttributes.Reset();
+	bFlushing = false;
+
+	Compact();
+
+	if (bFlushAgain)
+	{
+		bFlushAgain = false;
+		Flush();
+	}
+}
+
+void FAccelByteStatWriteBuffer::Requeue(TMap<FString, FStatWrite>&& InStats, TMap<FString, FAttributes>&& InAttributes)
+{
+	for (TPair<FString, FStatWrite>& Pair : InStats)
+	{
+		FStatWrite* Newer = PendingStats.Find(Pair.Key);
+		if (Newer != nullptr)
+		{
+			MergeStat(Pair.Value, *Newer);
+			*Newer = Pair.Value;
+		}
+		else
+		{
+			PendingStats.Add(Pair.Key, Pair.Value);
+		}
+	}
+
+	for (TPair<FString, FAttributes>& Profile : InAttributes)
+	{
+		if (Profile.Value.Num() == 0)
+		{
+			continue;
+		}
+
+		FAttributes& Attributes = PendingAttributes.FindOrAdd(Profile.Key);
+		for (TPair<FString, FString>& Attribute : Profile.Value)
+		{
+			if (!Attributes.Contains(Attribute.Key))
+			{
+				Attributes.Add(Attribute.Key, MoveTemp(Attribute.Value));
+				NumPendingAttributes++;
+			}
+		}
+	}
+
+	if (NumPending() > 0 && OldestWriteTime <= 0.0)
+	{
+		OldestWriteTime = FPlatformTime::Seconds();
+	}
+}
+
+void FAccelByteStatWriteBuffer::SetRequestHandler(FRequestHandler&& InRequestHandler)
+{
+	RequestHandler = MoveTemp(InRequestHandler);
+}
+
+void FAccelByteStatWriteBuffer::SendRequest(FRequest const& Request, FRequestResult const& OnResult)
+{
+	if (RequestHandler)
+	{
+		RequestHandler(Request, OnResult);
+		return;
+	}
+
+	const AccelByte::FErrorHandler OnError = AccelByte::FErrorHandler::CreateLambda([OnResult](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Stat and profile write flush failed! code: %d - message: %s"), ErrorCode, *ErrorMessage);
+		OnResult(false, IsAccelByteErrorRetryable(ErrorCode));
+	});
+
+	if (Request.StatItems.Num() > 0)
+	{
+		const AccelByte::THandler<TArray<FAccelByteModelsUpdateUserStatItemsResponse>> OnSuccess = AccelByte::THandler<TArray<FAccelByteModelsUpdateUserStatItemsResponse>>::CreateLambda(
+			[OnResult](TArray<FAccelByteModelsUpdateUserStatItemsResponse> const& Results)
+			{
+				// A stat code the service does not know fails on its own, sending it again would not help
+				for (FAccelByteModelsUpdateUserStatItemsResponse const& Result : Results)
+				{
+					if (!Result.Success)
+					{
+						UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Stat %s was not updated"), *Result.StatCode);
+					}
+				}
+				OnResult(true, false);
+			});
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::BulkUpdateUserStatItems);
+		FRegistry::Statistic.BulkUpdateUserStatItemsValue(TEXT(""), Request.StatItems, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+	}
+	else
+	{
+		FAccelByteModelsGameProfileAttribute Attribute;
+		Attribute.name = Request.AttributeKey;
+		Attribute.value = Request.AttributeValue;
+
+		const AccelByte::THandler<FAccelByteModelsGameProfile> OnSuccess = AccelByte::THandler<FAccelByteModelsGameProfile>::CreateLambda([OnResult](FAccelByteModelsGameProfile const& Profile)
+		{
+			OnResult(true, false);
+		});
+		const FAccelByteTelemetry::FRequest Telemetry = FAccelByteTelemetry::Begin(EAccelByteTelemetryOp::UpdateGameProfileAttribute);
+		FRegistry::GameProfile.UpdateGameProfileAttribute(Request.ProfileId, Attribute, FAccelByteTelemetry::WrapSuccess(Telemetry, OnSuccess), FAccelByteTelemetry::WrapError(Telemetry, OnError));
+	}
+}
+
+FAccelByteStatWriteStats FAccelByteStatWriteBuffer::GetStats() const
+{
+	FAccelByteStatWriteStats Result = Stats;
+	Result.Pending = NumPending();
+	Result.AverageFlushMs = Stats.Flushes > 0 ? static_cast<float>(TotalFlushMs / Stats.Flushes) : 0.0f;
+	return Result;
+}
+
+void FAccelByteStatWriteBuffer::AppendLine(TCHAR Op, FString const& Key, FString const& SubKey, FString const& Value)
+{
+	if (Writer == nullptr)
+	{
+		Writer = IFileManager::Get().CreateFileWriter(*Path, FILEWRITE_Append | FILEWRITE_AllowRead);
+		if (Writer == nullptr)
+		{
+			return;
+		}
+	}
+
+	FTCHARToUTF8 Utf8Line(*SerializeLine(Op, Key, SubKey, Value));
+	Writer->Serialize(const_cast<ANSICHAR*>(Utf8Line.Get()), Utf8Line.Length());
+	bWriterDirty = true;
+}
+
+void FAccelByteStatWriteBuffer::Compact()
+{
+	CloseWriter();
+
+	// Writes of a running flush stay in the file until the flush has answered for them
+	FString Content;
+	if (!UserId.IsEmpty())
+	{
+		Content += SerializeLine(STAT_BUFFER_OP_USER, UserId, TEXT(""), TEXT(""));
+	}
+	for (TMap<FString, FStatWrite> const* Writes : { &FlushingStats, &PendingStats })
+	{
+		for (const TPair<FString, FStatWrite>& Pair : *Writes)
+		{
+			if (Pair.Value.bOverride)
+			{
+				Content += SerializeLine(STAT_BUFFER_OP_SET, Pair.Key, TEXT(""), FormatFloat(Pair.Value.Value));
+			}
+			else
+			{
+				Content += SerializeLine(STAT_BUFFER_OP_INCREMENT, Pair.Key, TEXT(""), FormatFloat(Pair.Value.Increment));
+			}
+		}
+	}
+	for (TMap<FString, FAttributes> const* Writes : { &FlushingAttributes, &PendingAttributes })
+	{
+		for (const TPair<FString, FAttributes>& Profile : *Writes)
+		{
+			for (const TPair<FString, FString>& Attribute : Profile.Value)
+			{
+				Content += SerializeLine(STAT_BUFFER_OP_ATTRIBUTE, Profile.Key, Attribute.Key, Attribute.Value);
+			}
+		}
+	}
+
+	const FString TempPath = Path + TEXT(".tmp");
+	if (!FFileHelper::SaveStringToFile(Content, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM)
+		|| !IFileManager::Get().Move(*Path, *TempPath, true))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to rewrite stat write buffer %s"), *Path);
+	}
+}
+
+void FAccelByteStatWriteBuffer::CloseWriter()
+{
+	if (Writer != nullptr)
+	{
+		Writer->Close();
+		delete Writer;
+		Writer = nullptr;
+	}
+	bWriterDirty = false;
+}
+
+FString FAccelByteStatWriteBuffer::SerializeLine(TCHAR Op, FString const& Key, FString const& SubKey, FString const& Value)
+{
+	// Attribute values are free text, escaping keeps tabs and line breaks out of the line
+	const FString Body = FString::Printf(TEXT("%c\t%s\t%s\t%s"), Op, *Key.ReplaceCharWithEscapedChar(), *SubKey.ReplaceCharWithEscapedChar(), *Value.ReplaceCharWithEscapedChar());
+	FTCHARToUTF8 Utf8Body(*Body);
+	const uint32 Crc = FCrc::MemCrc32(Utf8Body.Get(), Utf8Body.Length());
+	return FString::Printf(TEXT("%08x\t%s\n"), Crc, *Body);
+}
+
+bool FAccelByteStatWriteBuffer::ParseLine(FString const& Line, TCHAR& OutOp, FString& OutKey, FString& OutSubKey, FString& OutValue)
+{
+	if (Line.Len() < 10 || Line[8] != TEXT('\t'))
+	{
+		return false;
+	}
+
+	const FString Body = Line.Mid(9);
+	FTCHARToUTF8 Utf8Body(*Body);
+	const uint32 Crc = FCString::Strtoui64(*Line.Left(8), nullptr, 16);
+	if (Crc != FCrc::MemCrc32(Utf8Body.Get(), Utf8Body.Length()))
+	{
+		return false;
+	}
+
+	TArray<FString> Fields;
+	Body.ParseIntoArray(Fields, TEXT("\t"), false);
+	if (Fields.Num() != 4 || Fields[0].Len() != 1)
+	{
+		return false;
+	}
+
+	OutOp = Fields[0][0];
+	OutKey = Fields[1].ReplaceEscapedCharWithChar();
+	OutSubKey = Fields[2].ReplaceEscapedCharWithChar();
+	OutValue = Fields[3].ReplaceEscapedCharWithChar();
+	return OutOp == STAT_BUFFER_OP_USER || OutOp == STAT_BUFFER_OP_INCREMENT || OutOp == STAT_BUFFER_OP_SET || OutOp == STAT_BUFFER_OP_ATTRIBUTE;
+}
@@ -0,0 +1,193 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Models/AccelByteStatisticModels.h"
+#include "AccelByteStatWriteBuffer.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteStatWriteStats
+{
+	GENERATED_BODY()
+
+	// Stat and profile writes made by the game
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Writes = 0;
+
+	// Writes folded into a write already pending for the same stat code or attribute
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Merged = 0;
+
+	// Backend calls sent by the flushes, without the buffer every write is one
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Requests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 FailedRequests = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Flushes = 0;
+
+	// Writes rejected by the backend and not retried
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Dropped = 0;
+
+	// Writes read back from the buffer file of a previous run
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Recovered = 0;
+
+	// Stat codes and profile attributes waiting for the next flush
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	int32 Pending = 0;
+
+	// From the start of a flush until its last request has answered
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	float AverageFlushMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	float MaxFlushMs = 0.0f;
+
+	// Time the oldest write of a flush waited in the buffer
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Statistics")
+	float MaxWriteAgeMs = 0.0f;
+};
+
+/**
+ * Write-behind buffer for the user statistics and game profile attributes the game updates during a match.
+ *
+ * Increments of the same stat code are summed and a set replaces whatever is pending for the code, so each flush
+ * sends at most one write per stat code, all of them in bulk update requests. Profile attributes keep their last
+ * value; the game profile service only updates attributes one at a time, so they cost a request per attribute
+ * that changed rather than per write. A flush is started by the interval, by the number of pending stat codes and
+ * attributes reaching the threshold, when the application exits or goes to the background, or by Flush.
+ *
+ * Every write is also appended to a buffer file, which is rewritten with what is still pending after each flush.
+ * Writes a crash kept from being sent are read back on the next launch and sent once the same user is logged in
+ * again. A write whose flush was cut short can be sent twice. Only meant to be used from the game thread.
+ */
+class FAccelByteStatWriteBuffer
+{
+public:
+	struct FSettings
+	{
+		float FlushIntervalSeconds = 10.0f;
+		// Pending stat codes and attributes that start a flush before the interval
+		int32 FlushThreshold = 32;
+		int32 MaxStatsPerRequest = 50;
+		// Attribute updates in flight at once
+		int32 MaxConcurrency = 4;
+	};
+
+	// One backend call, either a bulk stat update or a single profile attribute
+	struct FRequest
+	{
+		TArray<FAccelByteModelsUpdateUserStatItemWithStatCode> StatItems;
+		FString ProfileId;
+		FString AttributeKey;
+		FString AttributeValue;
+	};
+
+	// A failure that is retryable puts the writes of the request back into the buffer
+	using FRequestResult = TFunction<void(bool bSuccess, bool bRetryable)>;
+	using FRequestHandler = TFunction<void(FRequest const& Request, FRequestResult const& OnResult)>;
+
+	static FAccelByteStatWriteBuffer& Get();
+
+	explicit FAccelByteStatWriteBuffer(FString const& InPath);
+	~FAccelByteStatWriteBuffer();
+
+	void Configure(FSettings const& InSettings);
+
+	// Reads the writes left by a previous run, they wait for the user they were made by. Only the first call reads
+	// the file, the writes it holds are already pending or sent afterwards and would be applied twice
+	void Load();
+
+	// Writes made before a user logs in are attributed to that user, leftovers of another user are dropped
+	void BeginSession(FString const& InUserId);
+
+	void IncrementStat(FString const& StatCode, float Delta);
+	void SetStat(FString const& StatCode, float Value);
+	void SetProfileAttribute(FString const& ProfileId, FString const& Key, FString const& Value);
+
+	// Sends everything pending, a flush requested while one is running follows it
+	void Flush();
+
+	// Replaces the backend calls, used to measure the buffer without a backend
+	void SetRequestHandler(FRequestHandler&& InRequestHandler);
+
+	bool IsFlushing() const { return bFlushing; }
+	int32 NumPending() const { return PendingStats.Num() + NumPendingAttributes; }
+
+	FAccelByteStatWriteStats GetStats() const;
+
+private:
+	struct FStatWrite
+	{
+		float Increment = 0.0f;
+		bool bOverride = false;
+		float Value = 0.0f;
+	};
+
+	using FAttributes = TMap<FString, FString>;
+
+	// Return true when the write was folded into a pending one
+	bool ApplyStat(FString const& StatCode, bool bOverride, float Value);
+	bool ApplyAttribute(FString const& ProfileId, FString const& Key, FString const& Value);
+
+	bool Tick(float DeltaSeconds);
+	void OnWrite(bool bMerged);
+
+	void FinishFlush(double StartTime);
+	void SendRequest(FRequest const& Request, FRequestResult const& OnResult);
+
+	// Puts the writes of a failed flush back under the ones made since
+	void Requeue(TMap<FString, FStatWrite>&& InStats, TMap<FString, FAttributes>&& InAttributes);
+
+	static void MergeStat(FStatWrite& Into, FStatWrite const& Newer);
+
+	void AppendLine(TCHAR Op, FString const& Key, FString const& SubKey, FString const& Value);
+	void Compact();
+	void CloseWriter();
+
+	static FString SerializeLine(TCHAR Op, FString const& Key, FString const& SubKey, FString const& Value);
+	static bool ParseLine(FString const& Line, TCHAR& OutOp, FString& OutKey, FString& OutSubKey, FString& OutValue);
+
+	FSettings Settings;
+	FString Path;
+	FArchive* Writer = nullptr;
+	bool bWriterDirty = false;
+	bool bLoaded = false;
+
+	// User the pending writes belong to, empty until a session begins or the file names one
+	FString UserId;
+	bool bSessionActive = false;
+
+	TMap<FString, FStatWrite> PendingStats;
+	TMap<FString, FAttributes> PendingAttributes;
+	int32 NumPendingAttributes = 0;
+	// Time of the oldest pending write, zero when nothing is pending
+	double OldestWriteTime = 0.0;
+	// Set by a flush with retryable failures so a backend that is down is not hit by every write
+	double RetryAfterTime = 0.0;
+
+	// Writes sent by the running flush
+	TMap<FString, FStatWrite> FlushingStats;
+	TMap<FString, FAttributes> FlushingAttributes;
+	bool bFlushing = false;
+	bool bFlushAgain = false;
+
+	FRequestHandler RequestHandler;
+	FDelegateHandle TickerHandle;
+	FDelegateHandle PreExitHandle;
+	FDelegateHandle BackgroundHandle;
+
+	FAccelByteStatWriteStats Stats;
+	double TotalFlushMs = 0.0;
+
+	// Shared with request callbacks so they can detect that the buffer has been destroyed
+	TSharedRef<bool, ESPMode::ThreadSafe> AliveToken;
+};
@@ -0,0 +1,207 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteSteamAuthReadiness.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+#if WITH_ACCELBYTE_STEAMWORKS
+#pragma push_macro("ARRAY_COUNT")
+#undef ARRAY_COUNT
+THIRD_PARTY_INCLUDES_START
+#include "steam/steam_api.h"
+THIRD_PARTY_INCLUDES_END
+#pragma pop_macro("ARRAY_COUNT")
+#endif
+
+float FAccelByteSteamAuthReadiness::FallbackSeconds = 2.0f;
+FAccelByteSteamTicketStats FAccelByteSteamAuthReadiness::Stats;
+
+namespace AccelByteSteamAuthReadiness
+{
+#if WITH_ACCELBYTE_STEAMWORKS
+	/** Requests the ticket of a login and reports when Steam has registered it. Steam callbacks run on the online subsystem thread. */
+	class FTicketRequest
+	{
+	public:
+		explicit FTicketRequest(TFunction<void(bool)>&& InOnResponse)
+			: OnResponse(MoveTemp(InOnResponse))
+		{
+			ISteamUser* SteamUserPtr = SteamUser();
+			if (SteamUserPtr == nullptr || !SteamUserPtr->BLoggedOn())
+			{
+				return;
+			}
+
+			// Registered first so a response dispatched right away is not missed, the lock holds it back until the
+			// ticket handle is known
+			FScopeLock Lock(&CallbackLock);
+			TicketResponseCallback.Register(this, &FTicketRequest::OnTicketResponse);
+			uint8 TicketBuffer[1024];
+			uint32 TicketSize = 0;
+			Ticket = SteamUserPtr->GetAuthSessionTicket(TicketBuffer, sizeof(TicketBuffer), &TicketSize);
+			if (Ticket != k_HAuthTicketInvalid)
+			{
+				TicketHex = BytesToHex(TicketBuffer, TicketSize);
+			}
+		}
+
+		~FTicketRequest()
+		{
+			// Whether or not Steam handed out a ticket, the callback must not outlive the request
+			FScopeLock Lock(&CallbackLock);
+			TicketResponseCallback.Unregister();
+		}
+
+		bool IsValid() const
+		{
+			return Ticket != k_HAuthTicketInvalid;
+		}
+
+		HAuthTicket GetTicket() const { return Ticket; }
+		FString const& GetTicketHex() const { return TicketHex; }
+
+	private:
+		STEAM_CALLBACK_MANUAL(FTicketRequest, OnTicketResponse, GetAuthSessionTicketResponse_t, TicketResponseCallback);
+
+		TFunction<void(bool)> OnResponse;
+		HAuthTicket Ticket = k_HAuthTicketInvalid;
+		FString TicketHex;
+		FCriticalSection CallbackLock;
+	};
+
+	void FTicketRequest::OnTicketResponse(GetAuthSessionTicketResponse_t* Response)
+	{
+		FScopeLock Lock(&CallbackLock);
+		if (Response != nullptr && Ticket != k_HAuthTicketInvalid && Response->m_hAuthTicket == Ticket)
+		{
+			OnResponse(Response->m_eResult == k_EResultOK);
+		}
+	}
+
+	// Ticket handed to the previous login, the backend is done with it once another login starts
+	static HAuthTicket LastTicket = k_HAuthTicketInvalid;
+#endif
+
+	struct FWaiter : public TSharedFromThis<FWaiter, ESPMode::ThreadSafe>
+	{
+		FAccelByteSteamAuthReadiness::FOnTicket OnTicket;
+		FString Ticket;
+		double StartTime = 0.0;
+		bool bDone = false;
+		FDelegateHandle FallbackTickerHandle;
+#if WITH_ACCELBYTE_STEAMWORKS
+		TUniquePtr<FTicketRequest> Request;
+#endif
+	};
+}
+
+using namespace AccelByteSteamAuthReadiness;
+
+void FAccelByteSteamAuthReadiness::RequestTicket(FOnTicket&& OnTicket)
+{
+	TSharedRef<FWaiter, ESPMode::ThreadSafe> Waiter = MakeShared<FWaiter, ESPMode::ThreadSafe>();
+	Waiter->OnTicket = MoveTemp(OnTicket);
+	Waiter->StartTime = FPlatformTime::Seconds();
+
+	// Runs on the game thread, whichever of the ticket response and the fallback timeout comes first wins
+	auto Complete = [](TSharedRef<FWaiter, ESPMode::ThreadSafe> const& InWaiter, ETicketOutcome Result)
+	{
+		if (InWaiter->bDone)
+		{
+			return;
+		}
+		InWaiter->bDone = true;
+
+		FTicker::GetCoreTicker().RemoveTicker(InWaiter->FallbackTickerHandle);
+#if WITH_ACCELBYTE_STEAMWORKS
+		InWaiter->Request.Reset();
+#endif
+		// A ticket Steam refused is of no use to the backend, the caller falls back to the online subsystem
+		if (Result == ETicketOutcome::Failed)
+		{
+			InWaiter->Ticket.Empty();
+		}
+		RecordResult(Result, FPlatformTime::Seconds() - InWaiter->StartTime);
+		InWaiter->OnTicket(Result == ETicketOutcome::Ready, InWaiter->Ticket);
+	};
+
+#if WITH_ACCELBYTE_STEAMWORKS
+	if (LastTicket != k_HAuthTicketInvalid)
+	{
+		if (ISteamUser* SteamUserPtr = SteamUser())
+		{
+			SteamUserPtr->CancelAuthTicket(LastTicket);
+		}
+		LastTicket = k_HAuthTicketInvalid;
+	}
+
+	TWeakPtr<FWaiter, ESPMode::ThreadSafe> WeakWaiter = Waiter;
+	Waiter->Request = MakeUnique<FTicketRequest>([WeakWaiter, Complete](bool bTicketReady)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakWaiter, Complete, bTicketReady]()
+		{
+			TSharedPtr<FWaiter, ESPMode::ThreadSafe> PinnedWaiter = WeakWaiter.Pin();
+			if (PinnedWaiter.IsValid())
+			{
+				Complete(PinnedWaiter.ToSharedRef(), bTicketReady ? ETicketOutcome::Ready : ETicketOutcome::Failed);
+			}
+		});
+	});
+
+	if (Waiter->Request->IsValid())
+	{
+		LastTicket = Waiter->Request->GetTicket();
+		Waiter->Ticket = Waiter->Request->GetTicketHex();
+
+		// Only a response that never arrives is waited out
+		Waiter->FallbackTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Waiter, Complete](float)
+		{
+			Complete(Waiter, ETicketOutcome::TimedOut);
+			return false;
+		}), FallbackSeconds);
+		return;
+	}
+
+	UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Steam user is not logged on, no auth ticket can be requested"));
+#endif
+	Complete(Waiter, ETicketOutcome::Failed);
+}
+
+void FAccelByteSteamAuthReadiness::SetFallbackSeconds(float InFallbackSeconds)
+{
+	FallbackSeconds = FMath::Max(0.0f, InFallbackSeconds);
+}
+
+FAccelByteSteamTicketStats FAccelByteSteamAuthReadiness::GetStats()
+{
+	return Stats;
+}
+
+void FAccelByteSteamAuthReadiness::RecordResult(ETicketOutcome Result, double LatencySeconds)
+{
+	const float LatencyMs = static_cast<float>(LatencySeconds * 1000.0);
+	if (Result == ETicketOutcome::TimedOut)
+	{
+		Stats.TimeoutCount++;
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Steam auth ticket readiness timed out after %.0f ms"), LatencyMs);
+		return;
+	}
+	if (Result == ETicketOutcome::Failed)
+	{
+		Stats.FailedCount++;
+		return;
+	}
+
+	Stats.LastReadyMs = LatencyMs;
+	Stats.MinReadyMs = Stats.ReadyCount == 0 ? LatencyMs : FMath::Min(Stats.MinReadyMs, LatencyMs);
+	Stats.MaxReadyMs = FMath::Max(Stats.MaxReadyMs, LatencyMs);
+	Stats.AverageReadyMs = (Stats.AverageReadyMs * Stats.ReadyCount + LatencyMs) / (Stats.ReadyCount + 1);
+	Stats.ReadyCount++;
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Steam auth ticket ready after %.0f ms"), LatencyMs);
+}
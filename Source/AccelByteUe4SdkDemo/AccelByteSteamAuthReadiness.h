@@ -0,0 +1,76 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AccelByteSteamAuthReadiness.generated.h"
+
+USTRUCT(BlueprintType)
+struct FAccelByteSteamTicketStats
+{
+	GENERATED_BODY()
+
+	// Waits that ended because Steam reported the login's auth ticket as ready
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	int32 ReadyCount = 0;
+
+	// Waits that ended on the fallback timeout
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	int32 TimeoutCount = 0;
+
+	// Requests that ended right away without a ticket, Steam refused it or no Steam user was logged on
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	int32 FailedCount = 0;
+
+	// Latency from the native login completing to the ticket being ready, timeouts excluded
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float LastReadyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float MinReadyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float MaxReadyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AccelByte | SampleApp | Login")
+	float AverageReadyMs = 0.0f;
+};
+
+/**
+ * Gets a Steam auth session ticket for the AccelByte login and waits until Steam has registered it.
+ *
+ * A ticket is rejected by the backend until Steam has registered it, which can take a while right after a Steam
+ * login. Instead of always waiting a fixed delay, the ticket sent to AccelByte is requested here and handed over as
+ * soon as Steam reports it through GetAuthSessionTicketResponse_t, bounded by a fallback timeout for a response that
+ * never arrives. The ticket of the previous login is cancelled when a new one is requested. Builds without
+ * Steamworks, a Steam user that is not logged on and a ticket Steam reports as failed all hand over an empty ticket
+ * right away, and the caller falls back to the online subsystem's GetAuthToken.
+ */
+class FAccelByteSteamAuthReadiness
+{
+public:
+	// Called on the game thread with the ticket in hex. bTicketReady is false when the fallback timeout was hit, the
+	// ticket is then handed over all the same, and when no ticket could be had, the ticket is then empty
+	using FOnTicket = TFunction<void(bool bTicketReady, FString const& Ticket)>;
+
+	static void RequestTicket(FOnTicket&& OnTicket);
+
+	static void SetFallbackSeconds(float InFallbackSeconds);
+
+	static FAccelByteSteamTicketStats GetStats();
+
+private:
+	enum class ETicketOutcome : uint8
+	{
+		Ready,
+		TimedOut,
+		Failed
+	};
+
+	static void RecordResult(ETicketOutcome Result, double LatencySeconds);
+
+	static float FallbackSeconds;
+	static FAccelByteSteamTicketStats Stats;
+};
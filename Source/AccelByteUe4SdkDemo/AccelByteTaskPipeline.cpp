@@ -0,0 +1,72 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteTaskPipeline.h"
+
+TSharedRef<FAccelByteTaskPipeline> FAccelByteTaskPipeline::Create(int32 MaxInFlight)
+{
+	return MakeShareable(new FAccelByteTaskPipeline(MaxInFlight));
+}
+
+FAccelByteTaskPipeline::FAccelByteTaskPipeline(int32 InMaxInFlight)
+	: MaxInFlight(FMath::Max(1, InMaxInFlight))
+{
+}
+
+void FAccelByteTaskPipeline::Enqueue(FTask&& Task)
+{
+	Queue.Add(MoveTemp(Task));
+	Pump();
+}
+
+void FAccelByteTaskPipeline::EnqueueAll(TArray<FTask>&& Tasks)
+{
+	Queue.Append(MoveTemp(Tasks));
+	Pump();
+}
+
+void FAccelByteTaskPipeline::SetOnDrained(FSimpleDelegate const& InOnDrained)
+{
+	OnDrained = InOnDrained;
+}
+
+void FAccelByteTaskPipeline::Pump()
+{
+	// Tasks that complete synchronously (e.g. cache hits) call back into Pump, the outer loop picks up their slot instead
+	if (bPumping)
+	{
+		return;
+	}
+
+	TSharedRef<FAccelByteTaskPipeline> Self = AsShared();
+	bPumping = true;
+	while (InFlight < MaxInFlight && QueueHead < Queue.Num())
+	{
+		FTask Task = MoveTemp(Queue[QueueHead]);
+		QueueHead++;
+		InFlight++;
+		Task(FSimpleDelegate::CreateLambda([Self]()
+		{
+			Self->OnTaskDone();
+		}));
+	}
+
+	if (QueueHead == Queue.Num())
+	{
+		Queue.Reset();
+		QueueHead = 0;
+	}
+	bPumping = false;
+
+	if (IsIdle())
+	{
+		OnDrained.ExecuteIfBound();
+	}
+}
+
+void FAccelByteTaskPipeline::OnTaskDone()
+{
+	InFlight--;
+	Pump();
+}
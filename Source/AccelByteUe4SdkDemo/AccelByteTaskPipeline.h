@@ -0,0 +1,47 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Runs asynchronous tasks in FIFO order with at most MaxInFlight of them started and not yet finished.
+ *
+ * A task receives a completion delegate that it must execute exactly once, usually from the handler of
+ * the SDK call it started. The completion delegate holds a reference to the pipeline, so a pipeline stays
+ * alive until its last task has finished even if the caller drops its own reference.
+ */
+class FAccelByteTaskPipeline : public TSharedFromThis<FAccelByteTaskPipeline>
+{
+public:
+	using FTask = TFunction<void(FSimpleDelegate const& OnDone)>;
+
+	static TSharedRef<FAccelByteTaskPipeline> Create(int32 MaxInFlight);
+
+	void Enqueue(FTask&& Task);
+
+	// Queues every task before starting any of them, so tasks that finish synchronously cannot drain the pipeline early
+	void EnqueueAll(TArray<FTask>&& Tasks);
+
+	// Called every time the pipeline runs out of queued and in-flight tasks
+	void SetOnDrained(FSimpleDelegate const& InOnDrained);
+
+	int32 NumQueued() const { return Queue.Num() - QueueHead; }
+	int32 NumInFlight() const { return InFlight; }
+	bool IsIdle() const { return NumQueued() == 0 && InFlight == 0; }
+
+private:
+	explicit FAccelByteTaskPipeline(int32 InMaxInFlight);
+
+	void Pump();
+	void OnTaskDone();
+
+	TArray<FTask> Queue;
+	int32 QueueHead = 0;
+	int32 InFlight = 0;
+	int32 MaxInFlight = 1;
+	bool bPumping = false;
+	FSimpleDelegate OnDrained;
+};
@@ -0,0 +1,273 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteTelemetry.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests in flight"), STAT_AccelByteSample_InFlight, STATGROUP_AccelByteSample);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests completed"), STAT_AccelByteSample_Completed, STATGROUP_AccelByteSample);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Requests failed"), STAT_AccelByteSample_Failed, STATGROUP_AccelByteSample);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Last request latency (ms)"), STAT_AccelByteSample_LastLatency, STATGROUP_AccelByteSample);
+
+namespace AccelByteTelemetry
+{
+	static bool bEnabled = true;
+
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("AccelByte.Sample.Telemetry.Enabled"),
+		bEnabled,
+		TEXT("Record latency histograms of the AccelByte calls made by the sample app"));
+
+	// Bucket i holds latencies up to MinBucketMs * BucketRatio^i, the last bucket covers about ten minutes
+	constexpr int32 NumBuckets = 64;
+	constexpr double MinBucketMs = 0.5;
+	constexpr double BucketRatio = 1.25;
+
+	struct FOpStats
+	{
+		int64 Count = 0;
+		int64 Errors = 0;
+		int32 InFlight = 0;
+		double SumMs = 0.0;
+		double MaxMs = 0.0;
+		uint32 Buckets[NumBuckets] = {};
+		TMap<int32, int64> ErrorCodes;
+	};
+
+	static FOpStats Ops[static_cast<uint8>(EAccelByteTelemetryOp::Count)];
+
+	static int32 GetBucket(double LatencyMs)
+	{
+		if (LatencyMs <= MinBucketMs)
+		{
+			return 0;
+		}
+		const int32 Bucket = FMath::CeilToInt(static_cast<float>(FMath::Loge(LatencyMs / MinBucketMs) / FMath::Loge(BucketRatio)));
+		return FMath::Clamp(Bucket, 0, NumBuckets - 1);
+	}
+
+	static double GetBucketUpperBound(int32 Bucket)
+	{
+		return MinBucketMs * FMath::Pow(BucketRatio, Bucket);
+	}
+
+	static float GetPercentile(FOpStats const& Stats, double Percentile)
+	{
+		if (Stats.Count == 0)
+		{
+			return 0.0f;
+		}
+
+		const int64 Rank = FMath::Max<int64>(1, FMath::CeilToInt(static_cast<float>(Percentile * Stats.Count)));
+		int64 Seen = 0;
+		for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+		{
+			Seen += Stats.Buckets[Bucket];
+			if (Seen >= Rank)
+			{
+				return static_cast<float>(FMath::Min(GetBucketUpperBound(Bucket), Stats.MaxMs));
+			}
+		}
+		return static_cast<float>(Stats.MaxMs);
+	}
+}
+
+using namespace AccelByteTelemetry;
+
+TCHAR const* FAccelByteTelemetry::GetOpName(EAccelByteTelemetryOp Op)
+{
+	switch (Op)
+	{
+	case EAccelByteTelemetryOp::LoginWithOtherPlatform: return TEXT("LoginWithOtherPlatform");
+	case EAccelByteTelemetryOp::LoginWithRefreshToken: return TEXT("LoginWithRefreshToken");
+	case EAccelByteTelemetryOp::GetItemBySku: return TEXT("GetItemBySku");
+	case EAccelByteTelemetryOp::GetItemsByCriteria: return TEXT("GetItemsByCriteria");
+	case EAccelByteTelemetryOp::SyncPurchaseGoogle: return TEXT("SyncMobilePlatformPurchaseGooglePlay");
+	case EAccelByteTelemetryOp::SyncPurchaseApple: return TEXT("SyncMobilePlatformPurchaseApple");
+	case EAccelByteTelemetryOp::FinalizePurchase: return TEXT("FinalizePurchase");
+	case EAccelByteTelemetryOp::QueryUserEntitlements: return TEXT("QueryUserEntitlements");
+	case EAccelByteTelemetryOp::GetWalletInfo: return TEXT("GetWalletInfoByCurrencyCode");
+	case EAccelByteTelemetryOp::BulkUpdateUserStatItems: return TEXT("BulkUpdateUserStatItemsValue");
+	case EAccelByteTelemetryOp::UpdateGameProfileAttribute: return TEXT("UpdateGameProfileAttribute");
+	case EAccelByteTelemetryOp::ServerLoginWithClientCredentials: return TEXT("ServerLoginWithClientCredentials");
+	case EAccelByteTelemetryOp::ServerSyncPurchaseGoogle: return TEXT("ServerSyncMobilePlatformPurchaseGooglePlay");
+	case EAccelByteTelemetryOp::ServerSyncPurchaseApple: return TEXT("ServerSyncMobilePlatformPurchaseApple");
+	case EAccelByteTelemetryOp::ServerGrantEntitlements: return TEXT("ServerGrantUserEntitlements");
+	case EAccelByteTelemetryOp::ServerVerifyUser: return TEXT("ServerVerifyUser");
+	default: return TEXT("Unknown");
+	}
+}
+
+void FAccelByteTelemetry::SetEnabled(bool bInEnabled)
+{
+	bEnabled = bInEnabled;
+}
+
+bool FAccelByteTelemetry::IsEnabled()
+{
+	return bEnabled;
+}
+
+FAccelByteTelemetry::FRequest FAccelByteTelemetry::Begin(EAccelByteTelemetryOp Op)
+{
+	FRequest Request;
+	if (!bEnabled)
+	{
+		return Request;
+	}
+
+	Request.Op = Op;
+	Request.StartTime = FPlatformTime::Seconds();
+	Ops[static_cast<uint8>(Op)].InFlight++;
+	INC_DWORD_STAT(STAT_AccelByteSample_InFlight);
+	TRACE_BOOKMARK(TEXT("AccelByte %s begin"), GetOpName(Op));
+	return Request;
+}
+
+void FAccelByteTelemetry::End(FRequest const& Request, int32 ErrorCode)
+{
+	if (!Request.IsActive())
+	{
+		return;
+	}
+
+	const double LatencyMs = (FPlatformTime::Seconds() - Request.StartTime) * 1000.0;
+	FOpStats& Stats = Ops[static_cast<uint8>(Request.Op)];
+	// A Reset while the request was in flight already cleared the gauge
+	Stats.InFlight = FMath::Max(0, Stats.InFlight - 1);
+	Stats.Count++;
+	Stats.SumMs += LatencyMs;
+	Stats.MaxMs = FMath::Max(Stats.MaxMs, LatencyMs);
+	Stats.Buckets[GetBucket(LatencyMs)]++;
+	if (ErrorCode != 0)
+	{
+		Stats.Errors++;
+		Stats.ErrorCodes.FindOrAdd(ErrorCode)++;
+		INC_DWORD_STAT(STAT_AccelByteSample_Failed);
+	}
+
+	DEC_DWORD_STAT(STAT_AccelByteSample_InFlight);
+	INC_DWORD_STAT(STAT_AccelByteSample_Completed);
+	SET_FLOAT_STAT(STAT_AccelByteSample_LastLatency, static_cast<float>(LatencyMs));
+	TRACE_BOOKMARK(TEXT("AccelByte %s end (%d)"), GetOpName(Request.Op), ErrorCode);
+}
+
+FSimpleDelegate FAccelByteTelemetry::WrapSuccess(FRequest const& Request, FSimpleDelegate const& OnSuccess)
+{
+	if (!Request.IsActive())
+	{
+		return OnSuccess;
+	}
+	return FSimpleDelegate::CreateLambda([Request, OnSuccess]()
+	{
+		End(Request);
+		OnSuccess.ExecuteIfBound();
+	});
+}
+
+AccelByte::FErrorHandler FAccelByteTelemetry::WrapError(FRequest const& Request, AccelByte::FErrorHandler const& OnError)
+{
+	if (!Request.IsActive())
+	{
+		return OnError;
+	}
+	return AccelByte::FErrorHandler::CreateLambda([Request, OnError](int32 ErrorCode, FString const& ErrorMessage)
+	{
+		End(Request, ErrorCode);
+		OnError.ExecuteIfBound(ErrorCode, ErrorMessage);
+	});
+}
+
+TArray<FAccelByteTelemetry::FOpSummary> FAccelByteTelemetry::Summarize()
+{
+	TArray<FOpSummary> Summaries;
+	for (uint8 OpIndex = 0; OpIndex < static_cast<uint8>(EAccelByteTelemetryOp::Count); OpIndex++)
+	{
+		FOpStats const& Stats = Ops[OpIndex];
+		if (Stats.Count == 0 && Stats.InFlight == 0)
+		{
+			continue;
+		}
+
+		FOpSummary& Summary = Summaries.AddDefaulted_GetRef();
+		Summary.Operation = GetOpName(static_cast<EAccelByteTelemetryOp>(OpIndex));
+		Summary.Count = Stats.Count;
+		Summary.Errors = Stats.Errors;
+		Summary.InFlight = Stats.InFlight;
+		Summary.P50Ms = GetPercentile(Stats, 0.50);
+		Summary.P95Ms = GetPercentile(Stats, 0.95);
+		Summary.P99Ms = GetPercentile(Stats, 0.99);
+		Summary.MaxMs = static_cast<float>(Stats.MaxMs);
+		Summary.MeanMs = Stats.Count > 0 ? static_cast<float>(Stats.SumMs / Stats.Count) : 0.0f;
+		Summary.ErrorCodes = Stats.ErrorCodes;
+	}
+	return Summaries;
+}
+
+void FAccelByteTelemetry::Reset()
+{
+	for (FOpStats& Stats : Ops)
+	{
+		Stats = FOpStats();
+	}
+}
+
+FString FAccelByteTelemetry::DumpCsv(FString const& Path)
+{
+	const FString OutputPath = !Path.IsEmpty()
+		? Path
+		: FPaths::ProjectSavedDir() / TEXT("AccelByte") / FString::Printf(TEXT("Telemetry-%s.csv"), *FDateTime::Now().ToString());
+
+	FString Csv = TEXT("Operation,Count,Errors,InFlight,P50Ms,P95Ms,P99Ms,MaxMs,MeanMs,ErrorCodes\n");
+	for (FOpSummary const& Summary : Summarize())
+	{
+		// code:count pairs separated by spaces so the column needs no quoting
+		FString ErrorCodes;
+		for (TPair<int32, int64> const& ErrorCode : Summary.ErrorCodes)
+		{
+			ErrorCodes += FString::Printf(TEXT("%s%d:%lld"), ErrorCodes.IsEmpty() ? TEXT("") : TEXT(" "), ErrorCode.Key, ErrorCode.Value);
+		}
+
+		Csv += FString::Printf(TEXT("%s,%lld,%lld,%d,%.1f,%.1f,%.1f,%.1f,%.1f,%s\n")
+			, *Summary.Operation
+			, Summary.Count
+			, Summary.Errors
+			, Summary.InFlight
+			, Summary.P50Ms
+			, Summary.P95Ms
+			, Summary.P99Ms
+			, Summary.MaxMs
+			, Summary.MeanMs
+			, *ErrorCodes);
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Failed to write telemetry to %s"), *OutputPath);
+		return TEXT("");
+	}
+
+	UE_LOG(LogAccelByteSampleApp, Display, TEXT("Telemetry written to %s"), *OutputPath);
+	return OutputPath;
+}
+
+static FAutoConsoleCommand AccelByteTelemetryDumpCsvCommand(
+	TEXT("AccelByte.Sample.Telemetry.DumpCsv"),
+	TEXT("Write the AccelByte call latency histograms to a CSV file. Usage: AccelByte.Sample.Telemetry.DumpCsv [Path]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](TArray<FString> const& Args)
+	{
+		FAccelByteTelemetry::DumpCsv(Args.Num() > 0 ? Args[0] : TEXT(""));
+	}));
+
+static FAutoConsoleCommand AccelByteTelemetryResetCommand(
+	TEXT("AccelByte.Sample.Telemetry.Reset"),
+	TEXT("Clear the AccelByte call latency histograms"),
+	FConsoleCommandDelegate::CreateStatic(&FAccelByteTelemetry::Reset));
@@ -0,0 +1,100 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Core/AccelByteError.h"
+
+DECLARE_STATS_GROUP(TEXT("AccelByte Sample"), STATGROUP_AccelByteSample, STATCAT_Advanced);
+
+enum class EAccelByteTelemetryOp : uint8
+{
+	LoginWithOtherPlatform,
+	LoginWithRefreshToken,
+	GetItemBySku,
+	GetItemsByCriteria,
+	SyncPurchaseGoogle,
+	SyncPurchaseApple,
+	FinalizePurchase,
+	QueryUserEntitlements,
+	GetWalletInfo,
+	BulkUpdateUserStatItems,
+	UpdateGameProfileAttribute,
+	ServerLoginWithClientCredentials,
+	ServerSyncPurchaseGoogle,
+	ServerSyncPurchaseApple,
+	ServerGrantEntitlements,
+	ServerVerifyUser,
+	Count
+};
+
+/**
+ * Latency histograms, error code counts and in-flight gauges of the SDK and online subsystem calls the module makes.
+ *
+ * Begin returns a small token that is copied into the response handler and passed to End. While disabled Begin
+ * returns an inactive token and End returns right away, so an instrumented call costs a branch. Latencies are
+ * kept in fixed log scale buckets, percentiles are the upper bound of the bucket they fall in. Each call also
+ * places begin and end bookmarks in Unreal Insights and updates the STATGROUP_AccelByteSample counters.
+ * Only meant to be used from the game thread, where the SDK calls its handlers.
+ */
+class FAccelByteTelemetry
+{
+public:
+	struct FRequest
+	{
+		EAccelByteTelemetryOp Op = EAccelByteTelemetryOp::Count;
+		double StartTime = 0.0;
+
+		bool IsActive() const { return Op != EAccelByteTelemetryOp::Count; }
+	};
+
+	struct FOpSummary
+	{
+		FString Operation;
+		int64 Count = 0;
+		int64 Errors = 0;
+		int32 InFlight = 0;
+		float P50Ms = 0.0f;
+		float P95Ms = 0.0f;
+		float P99Ms = 0.0f;
+		float MaxMs = 0.0f;
+		float MeanMs = 0.0f;
+		TMap<int32, int64> ErrorCodes;
+	};
+
+	static FRequest Begin(EAccelByteTelemetryOp Op);
+	static void End(FRequest const& Request, int32 ErrorCode = 0);
+
+	// Wrap the handlers passed to an SDK call so whichever one fires ends the request, inactive requests return the handler as is
+	template <typename T>
+	static AccelByte::THandler<T> WrapSuccess(FRequest const& Request, AccelByte::THandler<T> const& OnSuccess)
+	{
+		if (!Request.IsActive())
+		{
+			return OnSuccess;
+		}
+		return AccelByte::THandler<T>::CreateLambda([Request, OnSuccess](T const& Result)
+		{
+			End(Request);
+			OnSuccess.ExecuteIfBound(Result);
+		});
+	}
+
+	static FSimpleDelegate WrapSuccess(FRequest const& Request, FSimpleDelegate const& OnSuccess);
+	static AccelByte::FErrorHandler WrapError(FRequest const& Request, AccelByte::FErrorHandler const& OnError);
+
+	// Also toggled by the AccelByte.Sample.Telemetry.Enabled console variable
+	static void SetEnabled(bool bInEnabled);
+	static bool IsEnabled();
+
+	static TArray<FOpSummary> Summarize();
+	static void Reset();
+
+	// Writes one row per operation that has been called, an empty path writes under Saved/AccelByte, returns the path or an empty string
+	static FString DumpCsv(FString const& Path = TEXT(""));
+
+	static TCHAR const* GetOpName(EAccelByteTelemetryOp Op);
+};
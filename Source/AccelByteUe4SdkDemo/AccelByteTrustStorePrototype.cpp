@@ -0,0 +1,479 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "AccelByteTrustStorePrototype.h"
+#include "AccelByteUe4SdkDemo.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_ACCELBYTE_OPENSSL
+#define UI UI_ST
+THIRD_PARTY_INCLUDES_START
+#include "openssl/bio.h"
+#include "openssl/err.h"
+#include "openssl/pem.h"
+#include "openssl/x509.h"
+#include "openssl/x509_vfy.h"
+THIRD_PARTY_INCLUDES_END
+#undef UI
+#endif
+
+// 'ABTS', then the version of the layout below
+#define TRUST_STORE_MAGIC 0x53544241u
+#define TRUST_STORE_VERSION 1u
+
+// The bundle is only hashed outside shipping, a shipping build trusts the size of the bundle it was packaged with
+#define TRUST_STORE_VERIFY_SOURCE_CRC !UE_BUILD_SHIPPING
+
+namespace AccelByteTrustStorePrototype
+{
+	// Little endian, followed by the index sorted by subject hash and then the DER of every certificate
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 SourceSize;
+		uint32 SourceCrc;
+		uint32 NumCertificates;
+	};
+
+#if WITH_ACCELBYTE_OPENSSL
+	// Parses every certificate of a PEM bundle, the caller frees them
+	static bool ParseBundle(TArray<uint8> const& Pem, TArray<X509*>& OutCertificates)
+	{
+		BIO* Bio = BIO_new_mem_buf(Pem.GetData(), Pem.Num());
+		if (Bio == nullptr)
+		{
+			return false;
+		}
+
+		while (X509* Certificate = PEM_read_bio_X509(Bio, nullptr, nullptr, nullptr))
+		{
+			OutCertificates.Add(Certificate);
+		}
+		BIO_free(Bio);
+
+		// Reading stops with a no start line error at the end of the bundle
+		ERR_clear_error();
+		return OutCertificates.Num() > 0;
+	}
+
+	struct FLookup
+	{
+		static bool Install(FAccelByteTrustStorePrototype& TrustStore, X509_STORE* Store, X509_NAME* Name)
+		{
+			const uint32 Hash = static_cast<uint32>(X509_NAME_hash(Name));
+
+			// First entry with the hash, different subjects can share one
+			int32 Low = 0;
+			int32 High = TrustStore.NumEntries;
+			while (Low < High)
+			{
+				const int32 Middle = Low + (High - Low) / 2;
+				if (TrustStore.Entries[Middle].SubjectHash < Hash)
+				{
+					Low = Middle + 1;
+				}
+				else
+				{
+					High = Middle;
+				}
+			}
+
+			bool bFound = false;
+			for (int32 Index = Low; Index < TrustStore.NumEntries && TrustStore.Entries[Index].SubjectHash == Hash; Index++)
+			{
+				FAccelByteTrustStorePrototype::FEntry const& Entry = TrustStore.Entries[Index];
+				unsigned char const* Der = TrustStore.CacheData + Entry.Offset;
+				X509* Certificate = d2i_X509(nullptr, &Der, static_cast<long>(Entry.Size));
+				if (Certificate == nullptr)
+				{
+					continue;
+				}
+
+				// A root renewed with the same subject is in the bundle twice, both are candidates for the chain
+				if (X509_NAME_cmp(X509_get_subject_name(Certificate), Name) == 0 && X509_STORE_add_cert(Store, Certificate) == 1)
+				{
+					TrustStore.Installed.Increment();
+					bFound = true;
+				}
+				X509_free(Certificate);
+			}
+			ERR_clear_error();
+			return bFound;
+		}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+		static int GetBySubject(X509_LOOKUP* Lookup, X509_LOOKUP_TYPE Type, X509_NAME* Name, X509_OBJECT* Result)
+		{
+			FAccelByteTrustStorePrototype* TrustStore = static_cast<FAccelByteTrustStorePrototype*>(X509_LOOKUP_get_method_data(Lookup));
+			X509_STORE* Store = X509_LOOKUP_get_store(Lookup);
+			if (TrustStore == nullptr || Store == nullptr || Type != X509_LU_X509 || Name == nullptr || !Install(*TrustStore, Store, Name))
+			{
+				return 0;
+			}
+
+			// Like the directory lookup, the result borrows the reference the store holds and is not freed by the caller
+			X509* Certificate = nullptr;
+			X509_STORE_lock(Store);
+			X509_OBJECT* Object = X509_OBJECT_retrieve_by_subject(X509_STORE_get0_objects(Store), X509_LU_X509, Name);
+			if (Object != nullptr)
+			{
+				Certificate = X509_OBJECT_get0_X509(Object);
+			}
+			X509_STORE_unlock(Store);
+
+			if (Certificate == nullptr || X509_OBJECT_set1_X509(Result, Certificate) != 1)
+			{
+				return 0;
+			}
+			X509_free(Certificate);
+			return 1;
+		}
+#endif
+	};
+#endif
+}
+
+using namespace AccelByteTrustStorePrototype;
+
+FString FAccelByteTrustStorePrototype::GetDefaultPemPath()
+{
+	return FPaths::ProjectContentDir() / TEXT("Certificates") / TEXT("cacert.pem");
+}
+
+FAccelByteTrustStorePrototype::FAccelByteTrustStorePrototype(FString const& InPemPath, FString const& InCachePath)
+	: PemPath(InPemPath)
+	, CachePath(InCachePath)
+{
+}
+
+FAccelByteTrustStorePrototype::~FAccelByteTrustStorePrototype()
+{
+	Close();
+}
+
+bool FAccelByteTrustStorePrototype::Load()
+{
+	FScopeLock Lock(&LoadLock);
+	if (bLoaded)
+	{
+		return bLoadSucceeded;
+	}
+	bLoaded = true;
+
+#if WITH_ACCELBYTE_OPENSSL
+	const double StartTime = FPlatformTime::Seconds();
+	if (OpenCache())
+	{
+		Stats.bFromCache = true;
+		Stats.NumCertificates = NumEntries;
+		bLoadSucceeded = true;
+	}
+	else
+	{
+		Close();
+		Stats.bMapped = false;
+		bLoadSucceeded = ParsePem();
+		Stats.NumCertificates = PemCertificates.Num();
+	}
+	Stats.LoadMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (bLoadSucceeded)
+	{
+		UE_LOG(LogAccelByteSampleApp, Log, TEXT("Trust store loaded %d certificates from %s in %.2f ms"), Stats.NumCertificates, Stats.bFromCache ? *CachePath : *PemPath, Stats.LoadMs);
+	}
+	else
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store could not read %s nor %s"), *CachePath, *PemPath);
+	}
+#endif
+	return bLoadSucceeded;
+}
+
+bool FAccelByteTrustStorePrototype::OpenCache()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (!PlatformFile.FileExists(*CachePath))
+	{
+		UE_LOG(LogAccelByteSampleApp, Log, TEXT("Trust store cache %s not found"), *CachePath);
+		return false;
+	}
+
+	// Pak files of some platforms cannot be mapped, the cache is small enough to be read instead
+	MappedHandle = PlatformFile.OpenMapped(*CachePath);
+	if (MappedHandle != nullptr)
+	{
+		MappedRegion = MappedHandle->MapRegion(0, MappedHandle->GetFileSize());
+	}
+	if (MappedRegion != nullptr)
+	{
+		CacheData = MappedRegion->GetMappedPtr();
+		CacheSize = MappedRegion->GetMappedSize();
+		Stats.bMapped = true;
+	}
+	else if (FFileHelper::LoadFileToArray(CacheBytes, *CachePath, FILEREAD_Silent))
+	{
+		CacheData = CacheBytes.GetData();
+		CacheSize = CacheBytes.Num();
+	}
+	else
+	{
+		return false;
+	}
+
+	if (CacheSize < static_cast<int64>(sizeof(FHeader)))
+	{
+		return false;
+	}
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, CacheData, sizeof(FHeader));
+	if (Header.Magic != TRUST_STORE_MAGIC || Header.Version != TRUST_STORE_VERSION)
+	{
+		UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store cache %s has an unknown format"), *CachePath);
+		return false;
+	}
+
+	const int64 IndexEnd = sizeof(FHeader) + static_cast<int64>(Header.NumCertificates) * sizeof(FEntry);
+	if (Header.NumCertificates == 0 || IndexEnd > CacheSize)
+	{
+		return false;
+	}
+
+	// A cache without its bundle is used as is, the bundle may have been left out of the build on purpose
+	const int64 PemSize = IFileManager::Get().FileSize(*PemPath);
+	if (PemSize >= 0)
+	{
+		bool bStale = PemSize != Header.SourceSize;
+#if TRUST_STORE_VERIFY_SOURCE_CRC
+		TArray<uint8> Pem;
+		if (!bStale && FFileHelper::LoadFileToArray(Pem, *PemPath, FILEREAD_Silent))
+		{
+			bStale = FCrc::MemCrc32(Pem.GetData(), Pem.Num()) != Header.SourceCrc;
+		}
+#endif
+		if (bStale)
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store cache %s was built from another %s, falling back to the bundle"), *CachePath, *PemPath);
+			return false;
+		}
+	}
+
+	Entries = reinterpret_cast<FEntry const*>(CacheData + sizeof(FHeader));
+	NumEntries = static_cast<int32>(Header.NumCertificates);
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		FEntry const& Entry = Entries[Index];
+		if (Entry.Offset < IndexEnd || static_cast<int64>(Entry.Offset) + Entry.Size > CacheSize
+			|| (Index > 0 && Entries[Index - 1].SubjectHash > Entry.SubjectHash))
+		{
+			UE_LOG(LogAccelByteSampleApp, Warning, TEXT("Trust store cache %s is corrupt"), *CachePath);
+			Entries = nullptr;
+			NumEntries = 0;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FAccelByteTrustStorePrototype::ParsePem()
+{
+#if WITH_ACCELBYTE_OPENSSL
+	TArray<uint8> Pem;
+	if (!FFileHelper::LoadFileToArray(Pem, *PemPath, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	TArray<X509*> Certificates;
+	const bool bParsed = ParseBundle(Pem, Certificates);
+	for (X509* Certificate : Certificates)
+	{
+		PemCertificates.Add(Certificate);
+	}
+	return bParsed;
+#else
+	return false;
+#endif
+}
+
+void FAccelByteTrustStorePrototype::Close()
+{
+	Entries = nullptr;
+	NumEntries = 0;
+	CacheData = nullptr;
+	CacheSize = 0;
+	CacheBytes.Empty();
+	delete MappedRegion;
+	MappedRegion = nullptr;
+	delete MappedHandle;
+	MappedHandle = nullptr;
+
+#if WITH_ACCELBYTE_OPENSSL
+	for (void* Certificate : PemCertificates)
+	{
+		X509_free(static_cast<X509*>(Certificate));
+	}
+	PemCertificates.Empty();
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	if (LookupMethod != nullptr)
+	{
+		X509_LOOKUP_meth_free(static_cast<X509_LOOKUP_METHOD*>(LookupMethod));
+		LookupMethod = nullptr;
+	}
+#endif
+#endif
+}
+
+bool FAccelByteTrustStorePrototype::AddToStore(void* X509Store)
+{
+#if WITH_ACCELBYTE_OPENSSL
+	X509_STORE* Store = static_cast<X509_STORE*>(X509Store);
+	if (Store == nullptr || !Load())
+	{
+		return false;
+	}
+
+	if (!Stats.bFromCache)
+	{
+		for (void* Certificate : PemCertificates)
+		{
+			X509_STORE_add_cert(Store, static_cast<X509*>(Certificate));
+		}
+		ERR_clear_error();
+		return true;
+	}
+
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+	{
+		FScopeLock Lock(&LoadLock);
+		if (LookupMethod == nullptr)
+		{
+			X509_LOOKUP_METHOD* Method = X509_LOOKUP_meth_new("AccelByte trust store");
+			if (Method == nullptr || X509_LOOKUP_meth_set_get_by_subject(Method, &FLookup::GetBySubject) != 1)
+			{
+				X509_LOOKUP_meth_free(Method);
+				return false;
+			}
+			LookupMethod = Method;
+		}
+	}
+
+	X509_LOOKUP* Lookup = X509_STORE_add_lookup(Store, static_cast<X509_LOOKUP_METHOD*>(LookupMethod));
+	return Lookup != nullptr && X509_LOOKUP_set_method_data(Lookup, this) == 1;
+#else
+	// Lookup methods cannot be defined before OpenSSL 1.1, the cache still spares the PEM parsing
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		unsigned char const* Der = CacheData + Entries[Index].Offset;
+		if (X509* Certificate = d2i_X509(nullptr, &Der, static_cast<long>(Entries[Index].Size)))
+		{
+			X509_STORE_add_cert(Store, Certificate);
+			X509_free(Certificate);
+			Installed.Increment();
+		}
+	}
+	ERR_clear_error();
+	return true;
+#endif
+#else
+	return false;
+#endif
+}
+
+bool FAccelByteTrustStorePrototype::BuildCache(FString const& InPemPath, FString const& InCachePath, int32& OutNumCertificates, FString& OutError)
+{
+	OutNumCertificates = 0;
+#if WITH_ACCELBYTE_OPENSSL
+	TArray<uint8> Pem;
+	if (!FFileHelper::LoadFileToArray(Pem, *InPemPath, FILEREAD_Silent))
+	{
+		OutError = FString::Printf(TEXT("Cannot read %s"), *InPemPath);
+		return false;
+	}
+
+	TArray<X509*> Certificates;
+	ParseBundle(Pem, Certificates);
+
+	struct FBlob
+	{
+		uint32 SubjectHash;
+		TArray<uint8> Der;
+	};
+
+	TArray<FBlob> Blobs;
+	Blobs.Reserve(Certificates.Num());
+	for (X509* Certificate : Certificates)
+	{
+		const int32 DerSize = i2d_X509(Certificate, nullptr);
+		if (DerSize > 0)
+		{
+			FBlob& Blob = Blobs.AddDefaulted_GetRef();
+			Blob.SubjectHash = static_cast<uint32>(X509_NAME_hash(X509_get_subject_name(Certificate)));
+			Blob.Der.SetNumUninitialized(DerSize);
+			unsigned char* Out = Blob.Der.GetData();
+			i2d_X509(Certificate, &Out);
+		}
+		X509_free(Certificate);
+	}
+
+	if (Blobs.Num() == 0)
+	{
+		OutError = FString::Printf(TEXT("No certificate in %s"), *InPemPath);
+		return false;
+	}
+
+	// Stable so certificates sharing a subject keep the order of the bundle
+	Blobs.StableSort([](FBlob const& A, FBlob const& B)
+	{
+		return A.SubjectHash < B.SubjectHash;
+	});
+
+	FHeader Header;
+	Header.Magic = TRUST_STORE_MAGIC;
+	Header.Version = TRUST_STORE_VERSION;
+	Header.SourceSize = static_cast<uint32>(Pem.Num());
+	Header.SourceCrc = FCrc::MemCrc32(Pem.GetData(), Pem.Num());
+	Header.NumCertificates = static_cast<uint32>(Blobs.Num());
+
+	TArray<uint8> Cache;
+	FMemoryWriter Writer(Cache);
+	Writer.Serialize(&Header, sizeof(FHeader));
+
+	uint32 Offset = sizeof(FHeader) + Blobs.Num() * sizeof(FEntry);
+	for (FBlob const& Blob : Blobs)
+	{
+		FEntry Entry{ Blob.SubjectHash, Offset, static_cast<uint32>(Blob.Der.Num()) };
+		Writer.Serialize(&Entry, sizeof(FEntry));
+		Offset += Entry.Size;
+	}
+	for (FBlob& Blob : Blobs)
+	{
+		Writer.Serialize(Blob.Der.GetData(), Blob.Der.Num());
+	}
+
+	const FString TempPath = InCachePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Cache, *TempPath) || !IFileManager::Get().Move(*InCachePath, *TempPath, true))
+	{
+		OutError = FString::Printf(TEXT("Cannot write %s"), *InCachePath);
+		return false;
+	}
+
+	OutNumCertificates = Blobs.Num();
+	return true;
+#else
+	OutError = TEXT("OpenSSL is not available on this platform");
+	return false;
+#endif
+}
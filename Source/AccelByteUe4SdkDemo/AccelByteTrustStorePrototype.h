@@ -0,0 +1,102 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/ThreadSafeCounter.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace AccelByteTrustStorePrototype
+{
+	struct FLookup;
+}
+
+/**
+ * Prototype of a binary trust store for the root certificates of Content/Certificates/cacert.pem, only used by
+ * AccelByte.Sample.Bench.TrustStore to measure what it would save over parsing the PEM bundle.
+ *
+ * It is not installed anywhere at runtime and no cache is staged. The engine's SSL certificate manager parses the
+ * bundle and fills the TLS contexts of HTTP and WebSockets itself, with no callback a game module can use to hand
+ * them another store. The benchmark builds the cache it reads from the bundle every run.
+ *
+ * The cache holds the certificates in DER, indexed by the hash of their subject name, along with the size and CRC
+ * of the bundle it was built from. It is memory mapped when the platform file allows it and read whole otherwise.
+ * A store given to AddToStore gets a lookup on the index rather than the certificates: a certificate is decoded
+ * and added to the store the first time a chain asks for its subject, the rest of the bundle is never touched.
+ * When the cache is missing, unreadable or built from another bundle, the PEM is parsed and every certificate is
+ * added as before. Load is called by the first AddToStore; after it the store may be used from any thread.
+ */
+class FAccelByteTrustStorePrototype
+{
+public:
+	struct FStats
+	{
+		bool bFromCache = false;
+		bool bMapped = false;
+		int32 NumCertificates = 0;
+		// Opening and validating the cache, or parsing the bundle on the fallback
+		double LoadMs = 0.0;
+	};
+
+	static FString GetDefaultPemPath();
+
+	FAccelByteTrustStorePrototype(FString const& InPemPath, FString const& InCachePath);
+	~FAccelByteTrustStorePrototype();
+
+	// Returns false when neither the cache nor the bundle could be read
+	bool Load();
+
+	// Takes an X509_STORE
+	bool AddToStore(void* X509Store);
+
+	FStats GetStats() const { return Stats; }
+
+	// Certificates decoded by lookups, across every store the cache was added to
+	int32 NumInstalled() const { return Installed.GetValue(); }
+
+	// Converts a PEM bundle into the cache format, the cache has to be rebuilt whenever the bundle changes
+	static bool BuildCache(FString const& InPemPath, FString const& InCachePath, int32& OutNumCertificates, FString& OutError);
+
+private:
+	friend struct AccelByteTrustStorePrototype::FLookup;
+
+	struct FEntry
+	{
+		uint32 SubjectHash;
+		uint32 Offset;
+		uint32 Size;
+	};
+
+	bool OpenCache();
+	bool ParsePem();
+	void Close();
+
+	FString PemPath;
+	FString CachePath;
+	bool bLoaded = false;
+	bool bLoadSucceeded = false;
+	FCriticalSection LoadLock;
+
+	// The cache, either mapped or read into CacheBytes
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	TArray<uint8> CacheBytes;
+	uint8 const* CacheData = nullptr;
+	int64 CacheSize = 0;
+	// Points into the cache, sorted by subject hash
+	FEntry const* Entries = nullptr;
+	int32 NumEntries = 0;
+
+	// X509 certificates of the bundle when the cache could not be used
+	TArray<void*> PemCertificates;
+
+	// X509_LOOKUP_METHOD shared by the stores the cache is added to
+	void* LookupMethod = nullptr;
+
+	FStats Stats;
+	FThreadSafeCounter Installed;
+};
@@ -29,11 +29,18 @@ public class AccelByteUe4SdkDemo : ModuleRules
 				"OnlineSubsystem",
 				"OnlineSubsystemUtils",
 				"Http", 
-				"WebSockets"
+				"HTTPServer",
+				"ImageWrapper",
+				"WebSockets",
+				"Sockets",
+				"Networking"
 			});
 			
         PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+        // Steam auth ticket readiness listens to Steamworks callbacks directly
+        bool bWithSteamworks = false;
+
         
         if (Target.Type != TargetType.Server)
         {
@@ -47,11 +54,18 @@ public class AccelByteUe4SdkDemo : ModuleRules
 		        EngineIni.GetString("OnlineSubsystem", "NativePlatformService", out NativePlatformService);
 	        }
 
-	        if (Target.Platform == UnrealTargetPlatform.AllDesktop)
+	        // AllDesktop is a wildcard, no target platform is ever equal to it
+	        if (Target.Platform.IsInGroup(UnrealPlatformGroup.Desktop))
 	        {
 		        if (NativePlatformService == "Steam")
 		        {
 			        PrivateDependencyModuleNames.Add("OnlineSubsystemSteam");
+			        AddEngineThirdPartyPrivateStaticDependencies(Target, "Steamworks");
+			        bWithSteamworks = true;
+		        }
+		        else
+		        {
+			        PrivateDependencyModuleNames.Add("OnlineSubsystemNull");
 		        }
 	        }
 	        else if (Target.Platform == UnrealTargetPlatform.XboxOne)
@@ -86,6 +100,27 @@ public class AccelByteUe4SdkDemo : ModuleRules
 	        PrivateDependencyModuleNames.Add("OnlineSubsystemNull");
         }
 
+        PrivateDefinitions.Add("WITH_ACCELBYTE_STEAMWORKS=" + (bWithSteamworks ? "1" : "0"));
+
+        // The trust store prototype decodes the root certificates and the session cache draws its key with the engine's OpenSSL
+        bool bWithOpenSsl = Target.Platform == UnrealTargetPlatform.Win64
+	        || Target.Platform == UnrealTargetPlatform.Mac
+	        || Target.Platform == UnrealTargetPlatform.Linux
+	        || Target.Platform == UnrealTargetPlatform.Android
+	        || Target.Platform == UnrealTargetPlatform.IOS;
+        if (bWithOpenSsl)
+        {
+	        AddEngineThirdPartyPrivateStaticDependencies(Target, "OpenSSL");
+        }
+
+        PrivateDefinitions.Add("WITH_ACCELBYTE_OPENSSL=" + (bWithOpenSsl ? "1" : "0"));
+
+        // The session cache seals its key with DPAPI
+        if (Target.Platform == UnrealTargetPlatform.Win64)
+        {
+	        PublicSystemLibraries.Add("crypt32.lib");
+        }
+
         // Uncomment if you are using Slate UI
         // PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
     }
@@ -5,4 +5,16 @@
 #include "AccelByteUe4SdkDemo.h"
 #include "Modules/ModuleManager.h"
 
+#include "Core/AccelByteError.h"
+
+DEFINE_LOG_CATEGORY(LogAccelByteSampleApp);
+
+bool IsAccelByteErrorRetryable(int32 ErrorCode)
+{
+	return ErrorCode == static_cast<int32>(AccelByte::ErrorCodes::NetworkError)
+		|| ErrorCode == 408
+		|| ErrorCode == 429
+		|| (ErrorCode >= 500 && ErrorCode < 600);
+}
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, AccelByteUe4SdkDemo, "AccelByteUe4SdkDemo" );
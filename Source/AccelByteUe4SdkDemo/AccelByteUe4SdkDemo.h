@@ -6,3 +6,11 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogAccelByteSampleApp, Log, All);
+
+/**
+ * Whether a failed AccelByte call may succeed when it is sent again: no response from the network, a timeout, the
+ * backend throttling or a server error. Services report a rejected request with their own codes (20001, 12xxx...)
+ * which are above any HTTP status, those are final.
+ */
+bool IsAccelByteErrorRetryable(int32 ErrorCode);
@@ -1,18 +1,68 @@
 ﻿#include "AccelByteUtilitiesBlueprints.h"
+#include "AccelByteByteConversion.h"
+#include "AccelByteSaveContainer.h"
 
 FString UAccelByteUtilitiesBlueprints::ConvertToString(TArray<uint8> const& Bytes)
 {
-	uint32 Size = Bytes.Num();
-	FString Data = BytesToString(Bytes.GetData(), Size);
-	return Data;
+	FString Result;
+	FAccelByteByteConversion::BytesToString(Bytes.GetData(), Bytes.Num(), Result);
+	return Result;
 }
 
 TArray<uint8> UAccelByteUtilitiesBlueprints::ConvertToBytes(FString const& String)
 {
-	int32 Length = String.Len();
-	uint8* Output = new uint8[Length];
-	TArray<uint8> Return;
-	Return.AddUninitialized(Length);
-	StringToBytes(String, Return.GetData(), Length);
-	return Return;
-}
\ No newline at end of file
+	TArray<uint8> Result;
+	FAccelByteByteConversion::StringToBytes(String, Result);
+	return Result;
+}
+
+FString UAccelByteUtilitiesBlueprints::ConvertUtf8ToString(TArray<uint8> const& Bytes)
+{
+	FString Result;
+	FAccelByteByteConversion::Utf8ToString(Bytes.GetData(), Bytes.Num(), Result);
+	return Result;
+}
+
+TArray<uint8> UAccelByteUtilitiesBlueprints::ConvertStringToUtf8(FString const& String)
+{
+	TArray<uint8> Result;
+	FAccelByteByteConversion::StringToUtf8(String, Result);
+	return Result;
+}
+
+TArray<uint8> UAccelByteUtilitiesBlueprints::EncodeSaveContainer(TArray<FAccelByteSaveSection> const& Sections, EAccelByteSaveCompression Compression)
+{
+	FAccelByteSaveWriter Writer(Compression);
+	for (FAccelByteSaveSection const& Section : Sections)
+	{
+		Writer.AddSection(Section.Tag, Section.SchemaVersion, Section.Data);
+	}
+	TArray<uint8> Result;
+	Writer.Finish(Result);
+	return Result;
+}
+
+bool UAccelByteUtilitiesBlueprints::DecodeSaveContainer(TArray<uint8> const& Bytes, TArray<FAccelByteSaveSection>& OutSections, FString& OutErrorMessage)
+{
+	OutSections.Reset();
+	FAccelByteSaveReader Reader;
+	if (!Reader.Open(Bytes))
+	{
+		OutErrorMessage = Reader.GetErrorMessage();
+		return false;
+	}
+
+	for (FName const& Tag : Reader.GetTags())
+	{
+		FAccelByteSaveSection& Section = OutSections.AddDefaulted_GetRef();
+		Section.Tag = Tag;
+		Section.SchemaVersion = Reader.GetSchemaVersion(Tag);
+		if (!Reader.ReadSection(Tag, Section.Data))
+		{
+			OutErrorMessage = Reader.GetErrorMessage();
+			OutSections.Reset();
+			return false;
+		}
+	}
+	return true;
+}
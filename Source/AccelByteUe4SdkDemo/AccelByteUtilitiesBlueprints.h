@@ -8,6 +8,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "Core/AccelByteError.h"
+#include "AccelByteSaveContainer.h"
 #include "AccelByteUtilitiesBlueprints.generated.h"
 
 UCLASS(Blueprintable, BlueprintType)
@@ -16,9 +17,25 @@ class UAccelByteUtilitiesBlueprints : public UBlueprintFunctionLibrary
 	GENERATED_BODY()
 public:
 
+	// One character per byte, the inverse of ConvertToBytes
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
 	static FString ConvertToString(TArray<uint8> const& Bytes);
 
 	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
 	static TArray<uint8> ConvertToBytes(FString const& String);
+
+	// Invalid sequences decode to U+FFFD
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
+	static FString ConvertUtf8ToString(TArray<uint8> const& Bytes);
+
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
+	static TArray<uint8> ConvertStringToUtf8(FString const& String);
+
+	// Packs the sections of a cloud slot into a binary container with a checksum, each section compressed when it helps
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
+	static TArray<uint8> EncodeSaveContainer(TArray<FAccelByteSaveSection> const& Sections, EAccelByteSaveCompression Compression = EAccelByteSaveCompression::Default);
+
+	// Returns false with the reason when the container or one of its sections is corrupted
+	UFUNCTION(BlueprintCallable, Category = "AccelByte | Utilities ")
+	static bool DecodeSaveContainer(TArray<uint8> const& Bytes, TArray<FAccelByteSaveSection>& OutSections, FString& OutErrorMessage);
 };